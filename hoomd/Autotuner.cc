@@ -11,6 +11,9 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cfloat>
+#include <deque>
+#include <map>
+#include <mutex>
 
 using namespace std;
 namespace py = pybind11;
@@ -20,6 +23,18 @@ namespace py = pybind11;
     \brief Definition of Autotuner
 */
 
+namespace
+{
+//! Protects the registry of live autotuners and the presets
+std::mutex autotuner_registry_mutex;
+
+//! All autotuners that currently exist
+std::vector<Autotuner *> autotuner_registry;
+
+//! Parameters for autotuners constructed in the future, by name and in order of construction
+std::map<std::string, std::deque<unsigned int> > autotuner_presets;
+}
+
 /*! \param parameters List of valid parameters
     \param nsamples Number of time samples to take at each parameter
     \param period Number of calls to begin() before sampling is redone
@@ -57,14 +72,19 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, CPU computes are also tuned and time with the host clock
     #ifdef ENABLE_HIP
-    hipEventCreate(&m_start);
-    hipEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipEventCreate(&m_start);
+        hipEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
+
+    registerTuner();
     }
 
 
@@ -121,23 +141,37 @@ Autotuner::Autotuner(unsigned int start,
 
     m_current_param = m_parameters[m_current_element];
 
-    // create CUDA events
+    // create CUDA events, CPU computes are also tuned and time with the host clock
     #ifdef ENABLE_HIP
-    hipEventCreate(&m_start);
-    hipEventCreate(&m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipEventCreate(&m_start);
+        hipEventCreate(&m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
 
     m_sync = false;
+
+    registerTuner();
     }
 
 Autotuner::~Autotuner()
     {
     m_exec_conf->msg->notice(5) << "Destroying Autotuner " << m_name << endl;
+
+        {
+        std::lock_guard<std::mutex> lock(autotuner_registry_mutex);
+        autotuner_registry.erase(std::remove(autotuner_registry.begin(), autotuner_registry.end(), this),
+                                 autotuner_registry.end());
+        }
     #ifdef ENABLE_HIP
-    hipEventDestroy(m_start);
-    hipEventDestroy(m_stop);
-    CHECK_CUDA_ERROR();
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipEventDestroy(m_start);
+        hipEventDestroy(m_stop);
+        CHECK_CUDA_ERROR();
+        }
     #endif
     }
 
@@ -147,15 +181,21 @@ void Autotuner::begin()
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_HIP
-    // if we are scanning, record a cuda event - otherwise do nothing
+    // if we are scanning, record a cuda event or the wall clock time - otherwise do nothing
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_start, 0);
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+        #ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            hipEventRecord(m_start, 0);
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            return;
+            }
+        #endif
+
+        m_wall_start = std::chrono::steady_clock::now();
         }
-    #endif
     }
 
 void Autotuner::end()
@@ -164,20 +204,34 @@ void Autotuner::end()
     if (!m_enabled)
         return;
 
-    #ifdef ENABLE_HIP
     // handle timing updates if scanning
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_stop, 0);
-        hipEventSynchronize(m_stop);
-        hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
-        m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
-                                     << ") = " << m_samples[m_current_element][m_current_sample] << endl;
+        float& sample = m_samples[m_current_element][m_current_sample];
+        bool timed = false;
+
+        #ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            hipEventRecord(m_stop, 0);
+            hipEventSynchronize(m_stop);
+            hipEventElapsedTime(&sample, m_start, m_stop);
 
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            timed = true;
+            }
+        #endif
+
+        if (!timed)
+            {
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_wall_start;
+            sample = elapsed.count();
+            }
+
+        m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
+                                     << ") = " << sample << endl;
         }
-    #endif
 
     // handle state data updates and transitions
     if (m_state == STARTUP)
@@ -352,6 +406,59 @@ unsigned int Autotuner::computeOptimalParameter()
     return opt;
     }
 
+/*! Adds the autotuner to the registry. If a preset exists for its name, the initial scan is skipped and the preset
+    parameter is used right away. Later periodic scans take place as usual.
+*/
+void Autotuner::registerTuner()
+    {
+    std::lock_guard<std::mutex> lock(autotuner_registry_mutex);
+    autotuner_registry.push_back(this);
+
+    auto it = autotuner_presets.find(m_name);
+    if (it == autotuner_presets.end() || it->second.empty())
+        return;
+
+    unsigned int param = it->second.front();
+    it->second.pop_front();
+
+    if (std::find(m_parameters.begin(), m_parameters.end(), param) != m_parameters.end())
+        {
+        m_exec_conf->msg->notice(5) << "Autotuner " << m_name << " starts with preset parameter " << param << endl;
+        m_current_param = param;
+        m_state = IDLE;
+        }
+    }
+
+/*! \returns The name and the current optimal parameter of every autotuner that has completed its initial scan, in
+             order of construction
+*/
+std::vector< std::pair<std::string, unsigned int> > Autotuner::getTunedParameters()
+    {
+    std::lock_guard<std::mutex> lock(autotuner_registry_mutex);
+
+    std::vector< std::pair<std::string, unsigned int> > result;
+    for (auto tuner : autotuner_registry)
+        {
+        if (tuner->m_state == IDLE)
+            result.push_back(std::make_pair(tuner->m_name, tuner->m_current_param));
+        }
+    return result;
+    }
+
+/*! \param presets Name and parameter of the autotuners to preset, in order of construction
+
+    Autotuners constructed after this call take the first remaining preset with their name (see registerTuner()).
+    Existing presets are replaced.
+*/
+void Autotuner::setPresets(const std::vector< std::pair<std::string, unsigned int> >& presets)
+    {
+    std::lock_guard<std::mutex> lock(autotuner_registry_mutex);
+
+    autotuner_presets.clear();
+    for (auto& preset : presets)
+        autotuner_presets[preset.first].push_back(preset.second);
+    }
+
 void export_Autotuner(py::module& m)
     {
     py::class_<Autotuner>(m,"Autotuner")
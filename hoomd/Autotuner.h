@@ -14,6 +14,8 @@
 
 #include <vector>
 #include <string>
+#include <utility>
+#include <chrono>
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -23,11 +25,14 @@
 #include <pybind11/pybind11.h>
 #endif
 
-//! Autotuner for low level GPU kernel parameters
+//! Autotuner for low level GPU kernel parameters and CPU algorithm choices
 /*! **Overview** <br>
     Autotuner is a helper class that autotunes GPU kernel parameters (such as block size) for performance. It runs an
     internal state machine and makes sweeps over all valid parameter values. Performance is measured just for the single
-    kernel in question with cudaEvent timers. A number of sweeps are combined with a median to determine the fastest
+    kernel in question with cudaEvent timers. When the execution configuration runs on the CPU, the time between
+    begin() and end() is measured with a wall clock instead, so the same state machine can choose between discrete
+    options of CPU code paths (algorithms, buffer sizes, update periods). The options are registered as the list of
+    parameters, which may simply be indices into a list of choices kept by the caller. A number of sweeps are combined with a median to determine the fastest
     parameter. Additional timing sweeps are performed at a defined period in order to update to changing conditions.
     The sampling mode can also be changed to average or maximum. The latter is helpful when the distribution of kernel
     runtimes is bimodal, e.g. because it depends on input of variable size.
@@ -44,8 +49,15 @@
 
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
-    Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires ENABLE_HIP=on.
-    Behavior of Autotuner is undefined when ENABLE_HIP=off.
+    All Autotuner instances are kept in a registry. getTunedParameters() lists the decisions of all autotuners that
+    completed their initial scan, and setPresets() hands such a list to autotuners constructed later (matched by name
+    and order of construction), which then start in the idle state with the preset parameter. CheckpointWriter and
+    CheckpointReader use this to carry tuning decisions over a restart.
+
+    Wall clock samples include everything that runs between begin() and end(), so CPU tuned regions should be long
+    enough (typically several whole time steps) to average out noise. With setSync(true), the samples of all MPI ranks
+    are combined on the root rank and the decision is broadcast, so all ranks switch to the same parameter at the same
+    call. All ranks must then call end() the same number of times.
 
     ** Implementation ** <br>
     Internally, m_nsamples is the number of samples to take (odd for median computation). m_current_sample is the
@@ -181,9 +193,18 @@ class PYBIND11_EXPORT Autotuner
             return v;
             }
 
+        //! Get the parameters of all autotuners that completed their initial scan
+        static std::vector< std::pair<std::string, unsigned int> > getTunedParameters();
+
+        //! Preset the parameters of autotuners constructed later
+        static void setPresets(const std::vector< std::pair<std::string, unsigned int> >& presets);
+
     protected:
         unsigned int computeOptimalParameter();
 
+        //! Add this autotuner to the registry and apply a preset parameter
+        void registerTuner();
+
         //! State names
         enum State
            {
@@ -216,6 +237,8 @@ class PYBIND11_EXPORT Autotuner
         hipEvent_t m_stop;       //!< CUDA event for recording end times
         #endif
 
+        std::chrono::steady_clock::time_point m_wall_start; //!< Wall clock start time when tuning on the CPU
+
         bool m_sync;              //!< If true, synchronize results via MPI
         mode_Enum m_mode;         //!< The sampling mode
     };
@@ -14,6 +14,8 @@
 
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -43,7 +45,7 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true), m_local_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
@@ -51,6 +53,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     // connect to particle sort signal
     m_pdata->getParticleSortSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
         &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+    m_pdata->getGhostParticlesRemovedSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::setLocalTableDirty>(this);
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -85,13 +89,15 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true), m_local_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
     // connect to particle sort signal
     m_pdata->getParticleSortSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
         &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+    m_pdata->getGhostParticlesRemovedSignal().template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::setLocalTableDirty>(this);
 
     // initialize from snapshot
     initializeFromSnapshot(snapshot);
@@ -111,6 +117,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::~BondedGroupData()
     {
     m_pdata->getParticleSortSignal().template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
         &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
+    m_pdata->getGhostParticlesRemovedSignal().template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
+        &BondedGroupData<group_size, Group, name, has_type_mapping>::setLocalTableDirty>(this);
     #ifdef ENABLE_MPI
     m_pdata->getSingleParticleMoveSignal().template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
         &BondedGroupData<group_size, Group, name, has_type_mapping>::moveParticleGroups>(this);
@@ -824,6 +832,49 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
         }
     }
 
+/*! The groups are ordered by the smallest local index of their members with a counting sort. Members that are not
+    local have the index NOT_LOCAL, the force computes report such incomplete groups.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildLocalTable()
+    {
+    if (m_prof) m_prof->push("update " + std::string(name) + " local table");
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+
+    unsigned int n_groups = getN();
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // smallest member index of every group, groups with no local members go last
+    std::vector<unsigned int> key(n_groups);
+    std::vector<unsigned int> offset(max_local+2, 0);
+    for (unsigned int i = 0; i < n_groups; i++)
+        {
+        unsigned int min_idx = max_local;
+        for (unsigned int j = 0; j < group_size; j++)
+            min_idx = std::min(min_idx, h_rtag.data[h_groups.data[i].tag[j]]);
+        key[i] = min_idx;
+        offset[min_idx+1]++;
+        }
+
+    for (unsigned int k = 1; k < max_local+2; k++)
+        offset[k] += offset[k-1];
+
+    m_local_table.resize(n_groups);
+    for (unsigned int i = 0; i < n_groups; i++)
+        {
+        local_t& g = m_local_table[offset[key[i]]++];
+        for (unsigned int j = 0; j < group_size; j++)
+            g.idx[j] = h_rtag.data[h_groups.data[i].tag[j]];
+        g.group = i;
+        g.typeval = h_typeval.data[i];
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_HIP
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTableGPU()
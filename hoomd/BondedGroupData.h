@@ -63,6 +63,15 @@ union typeval_union
 
 typedef typeval_union typeval_t;
 
+//! Bonded group with the local particle indices of its members
+template<unsigned int group_size>
+struct local_group_storage
+    {
+    unsigned int idx[group_size];    //!< Local particle indices of the members
+    unsigned int group;              //!< Index of the group in the group arrays
+    typeval_t typeval;               //!< Type of bonded group or constraint value
+    };
+
 #ifdef ENABLE_MPI
 //! Packed group entry for communication
 template<unsigned int group_size>
@@ -131,6 +140,9 @@ class BondedGroupData
         //! Group data element type
         typedef union group_storage<group_size> members_t;
 
+        //! Local group table element type
+        typedef local_group_storage<group_size> local_t;
+
         //! True if typeval is an integer
         static const bool typemap_val = has_type_mapping;
 
@@ -547,6 +559,27 @@ class BondedGroupData
             return m_gpu_n_groups;
             }
 
+        /*
+         * CPU group table
+         */
+
+        //! Return the local groups with the particle indices of their members
+        /*! The table lists the same groups as getMembersArray() (getN() entries), ordered by the smallest local
+            index of their members, so that loops over the table access the particle data in the order of the
+            particle sort. It is rebuilt lazily after particles are sorted, migrated or exchanged as ghosts, or
+            groups change.
+         */
+        const std::vector<local_t>& getLocalTable()
+            {
+            if (m_local_table_dirty)
+                {
+                rebuildLocalTable();
+                m_local_table_dirty = false;
+                }
+
+            return m_local_table;
+            }
+
         /*
          * add/remove groups globally
          */
@@ -587,6 +620,7 @@ class BondedGroupData
             {
             // set flag to trigger rebuild of GPU table
             m_groups_dirty = true;
+            m_local_table_dirty = true;
 
             // notify subscribers
             m_group_reorder_signal.emit();
@@ -596,6 +630,7 @@ class BondedGroupData
         void setDirty()
             {
             m_groups_dirty = true;
+            m_local_table_dirty = true;
             }
 
     protected:
@@ -645,6 +680,8 @@ class BondedGroupData
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        bool m_local_table_dirty;                    //!< Is it necessary to rebuild the local group table?
+        std::vector<local_t> m_local_table;          //!< Local groups ordered by particle index
 
         Nano::Signal<void ()> m_group_num_change_signal; //!< Signal that is triggered when groups are added or deleted (globally)
         Nano::Signal<void ()> m_group_reorder_signal;    //!< Signal that is triggered when groups are added or deleted locally
@@ -658,6 +695,15 @@ class BondedGroupData
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Helper function to rebuild the local group table
+        void rebuildLocalTable();
+
+        //! Mark the local group table for a rebuild after the ghost particles changed
+        void setLocalTableDirty()
+            {
+            m_local_table_dirty = true;
+            }
+
         //! Resize internal tables
         /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
          */
@@ -0,0 +1,228 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointFormat.h
+    \brief Binary layout helpers shared by CheckpointWriter and CheckpointReader
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_FORMAT_H__
+#define __CHECKPOINT_FORMAT_H__
+
+#include "ParticleData.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//! Helpers to read and write checkpoint files
+/*! A checkpoint is a directory. The file \c meta holds the global state, and each rank writes the particles it owns
+    to its own file, so all ranks write in parallel. Two slots of rank files are kept and \c meta names the slot that
+    belongs to it. A new checkpoint is written into the other slot, and \c meta is replaced atomically once every rank
+    has finished, so an interrupted write always leaves the previous checkpoint intact.
+
+    All values are stored in native byte order. Every file starts with the 8 byte magic string \c HOOMDCKP followed
+    by a uint32 format version. Vectors are stored as a uint64 element count followed by the raw elements, strings
+    as a uint64 length followed by the characters.
+
+    \b meta: uint64 time step, uint32 slot, uint32 number of ranks, uint32 dimensions, the global box (3 float64
+    lengths, 3 float64 tilt factors, 3 uint8 periodic flags), uint8 decomposition flag, and if set the uint32 grid
+    size in x, y and z, the float64 cumulative fractions in x, y and z and the uint32 map of domain indices to ranks.
+    Then the uint32 number of particles, the bond, angle, dihedral, improper, constraint and pair groups (types,
+    values, members and type names), and the integrator variables (uint32 count, then the type name and float64
+    values of each).
+
+    \b slot<i>.rank<r>: uint64 time step, uint32 rank, the tuned autotuner parameters (uint32 count, then the name
+    and uint32 value of each), the particle type names, and the uint32 number of local particles followed by their
+    tags and all per-particle fields in double precision.
+*/
+namespace checkpoint
+{
+//! Magic string at the start of every checkpoint file
+const char MAGIC[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'K', 'P'};
+
+//! Version of the checkpoint file format
+const uint32_t VERSION = 1;
+
+//! Name of the file that holds the global state
+inline std::string metaFileName(const std::string& dirname)
+    {
+    return dirname + "/meta";
+    }
+
+//! Name of the file that holds the particles of one rank
+inline std::string rankFileName(const std::string& dirname, unsigned int slot, unsigned int rank)
+    {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "/slot%u.rank%05u", slot, rank);
+    return dirname + std::string(buf);
+    }
+
+//! Write a plain value
+template<class T>
+void write(std::ostream& out, const T& v)
+    {
+    out.write((const char *)&v, sizeof(T));
+    }
+
+//! Read a plain value
+template<class T>
+void read(std::istream& in, T& v)
+    {
+    in.read((char *)&v, sizeof(T));
+    }
+
+//! Write a vector of plain values
+template<class T>
+void write(std::ostream& out, const std::vector<T>& v)
+    {
+    uint64_t n = v.size();
+    write(out, n);
+    if (n > 0)
+        out.write((const char *)v.data(), sizeof(T)*n);
+    }
+
+//! Read a vector of plain values
+template<class T>
+void read(std::istream& in, std::vector<T>& v)
+    {
+    uint64_t n = 0;
+    read(in, n);
+    if (!in.good())
+        return;
+    v.resize(n);
+    if (n > 0)
+        in.read((char *)v.data(), sizeof(T)*n);
+    }
+
+//! Write a string
+inline void write(std::ostream& out, const std::string& s)
+    {
+    uint64_t n = s.size();
+    write(out, n);
+    out.write(s.data(), n);
+    }
+
+//! Read a string
+inline void read(std::istream& in, std::string& s)
+    {
+    uint64_t n = 0;
+    read(in, n);
+    if (!in.good())
+        return;
+    s.resize(n);
+    if (n > 0)
+        in.read(&s[0], n);
+    }
+
+//! Write a list of strings
+inline void write(std::ostream& out, const std::vector<std::string>& v)
+    {
+    uint64_t n = v.size();
+    write(out, n);
+    for (unsigned int i = 0; i < n; i++)
+        write(out, v[i]);
+    }
+
+//! Read a list of strings
+inline void read(std::istream& in, std::vector<std::string>& v)
+    {
+    uint64_t n = 0;
+    read(in, n);
+    if (!in.good())
+        return;
+    v.resize(n);
+    for (unsigned int i = 0; i < n && in.good(); i++)
+        read(in, v[i]);
+    }
+
+//! Write the header of a checkpoint file
+inline void writeHeader(std::ostream& out)
+    {
+    out.write(MAGIC, sizeof(MAGIC));
+    write(out, VERSION);
+    }
+
+//! Read and check the header of a checkpoint file
+/*! \returns true if the magic string and the version match
+*/
+inline bool readHeader(std::istream& in)
+    {
+    char magic[8];
+    uint32_t version = 0;
+    in.read(magic, sizeof(magic));
+    read(in, version);
+    return in.good() && std::equal(magic, magic + sizeof(magic), MAGIC) && version == VERSION;
+    }
+
+//! Write a bonded group snapshot
+template<class Snapshot>
+void writeGroups(std::ostream& out, const Snapshot& snap)
+    {
+    write(out, snap.type_id);
+    std::vector<double> val(snap.val.begin(), snap.val.end());
+    write(out, val);
+    write(out, snap.groups);
+    write(out, snap.type_mapping);
+    }
+
+//! Read a bonded group snapshot
+template<class Snapshot>
+void readGroups(std::istream& in, Snapshot& snap)
+    {
+    std::vector<double> val;
+    read(in, snap.type_id);
+    read(in, val);
+    read(in, snap.groups);
+    read(in, snap.type_mapping);
+    snap.val.assign(val.begin(), val.end());
+    snap.size = (unsigned int)snap.groups.size();
+    }
+
+//! Write the per-particle fields of a snapshot
+inline void writeParticles(std::ostream& out, const SnapshotParticleData<double>& snap)
+    {
+    write(out, snap.pos);
+    write(out, snap.vel);
+    write(out, snap.accel);
+    write(out, snap.type);
+    write(out, snap.mass);
+    write(out, snap.charge);
+    write(out, snap.diameter);
+    write(out, snap.image);
+    write(out, snap.body);
+    write(out, snap.orientation);
+    write(out, snap.angmom);
+    write(out, snap.inertia);
+    write(out, (uint8_t)snap.is_accel_set);
+    }
+
+//! Read the per-particle fields of a snapshot
+inline void readParticles(std::istream& in, SnapshotParticleData<double>& snap, unsigned int N)
+    {
+    uint8_t is_accel_set = 0;
+    read(in, snap.pos);
+    read(in, snap.vel);
+    read(in, snap.accel);
+    read(in, snap.type);
+    read(in, snap.mass);
+    read(in, snap.charge);
+    read(in, snap.diameter);
+    read(in, snap.image);
+    read(in, snap.body);
+    read(in, snap.orientation);
+    read(in, snap.angmom);
+    read(in, snap.inertia);
+    read(in, is_accel_set);
+    snap.is_accel_set = is_accel_set;
+    snap.size = N;
+    }
+} // end namespace checkpoint
+
+#endif
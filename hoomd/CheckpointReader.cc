@@ -0,0 +1,393 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+#include "CheckpointFormat.h"
+#include "Autotuner.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <cmath>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param exec_conf The execution configuration
+    \param dirname Directory of the checkpoint
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& dirname)
+    : m_exec_conf(exec_conf), m_dirname(dirname), m_timestep(0), m_slot(0), m_n_ranks(1), m_N(0),
+      m_has_decomposition(false), m_grid(make_uint3(1,1,1))
+    {
+    m_snapshot = std::shared_ptr< SnapshotSystemData<double> >(new SnapshotSystemData<double>());
+
+    bool ok = true;
+    if (m_exec_conf->isRoot())
+        ok = readMetaFile();
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        bcast(ok, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (!ok)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: Unable to read checkpoint " << m_dirname << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    broadcastMeta();
+
+    m_exec_conf->msg->notice(2) << "init.read_checkpoint: read checkpoint of " << m_N << " particles at step "
+                                << m_timestep << " written by " << m_n_ranks << " rank(s)" << endl;
+    }
+
+/*! \returns true on success
+*/
+bool CheckpointReader::readMetaFile()
+    {
+    ifstream in(checkpoint::metaFileName(m_dirname).c_str(), ios_base::in | ios_base::binary);
+    if (!in.good() || !checkpoint::readHeader(in))
+        return false;
+
+    uint32_t slot = 0, n_ranks = 0, dimensions = 0;
+    checkpoint::read(in, m_timestep);
+    checkpoint::read(in, slot);
+    checkpoint::read(in, n_ranks);
+    checkpoint::read(in, dimensions);
+    m_slot = slot;
+    m_n_ranks = n_ranks;
+    m_snapshot->dimensions = dimensions;
+
+    double L[3], tilt[3];
+    uint8_t periodic[3];
+    for (unsigned int i = 0; i < 3; i++)
+        checkpoint::read(in, L[i]);
+    for (unsigned int i = 0; i < 3; i++)
+        checkpoint::read(in, tilt[i]);
+    for (unsigned int i = 0; i < 3; i++)
+        checkpoint::read(in, periodic[i]);
+
+    BoxDim box(L[0], L[1], L[2]);
+    box.setTiltFactors(tilt[0], tilt[1], tilt[2]);
+    box.setPeriodic(make_uchar3(periodic[0], periodic[1], periodic[2]));
+    m_snapshot->global_box = box;
+
+    uint8_t has_decomposition = 0;
+    checkpoint::read(in, has_decomposition);
+    m_has_decomposition = has_decomposition;
+    if (m_has_decomposition)
+        {
+        checkpoint::read(in, m_grid.x);
+        checkpoint::read(in, m_grid.y);
+        checkpoint::read(in, m_grid.z);
+        for (unsigned int dir = 0; dir < 3; dir++)
+            checkpoint::read(in, m_cum_frac[dir]);
+        checkpoint::read(in, m_cart_ranks);
+        }
+
+    uint32_t N = 0;
+    checkpoint::read(in, N);
+    m_N = N;
+
+    checkpoint::readGroups(in, m_snapshot->bond_data);
+    checkpoint::readGroups(in, m_snapshot->angle_data);
+    checkpoint::readGroups(in, m_snapshot->dihedral_data);
+    checkpoint::readGroups(in, m_snapshot->improper_data);
+    checkpoint::readGroups(in, m_snapshot->constraint_data);
+    checkpoint::readGroups(in, m_snapshot->pair_data);
+
+    uint32_t n_integrators = 0;
+    checkpoint::read(in, n_integrators);
+    for (unsigned int i = 0; i < n_integrators && in.good(); i++)
+        {
+        IntegratorVariables v;
+        std::vector<double> variable;
+        checkpoint::read(in, v.type);
+        checkpoint::read(in, variable);
+        v.variable.assign(variable.begin(), variable.end());
+        m_snapshot->integrator_data.push_back(v);
+        }
+
+    return in.good();
+    }
+
+/*! Bonded groups stay on the root rank, BondedGroupData distributes them. Everything else is needed on all ranks.
+*/
+void CheckpointReader::broadcastMeta()
+    {
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() == 1)
+        return;
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    bcast(m_timestep, 0, mpi_comm);
+    bcast(m_slot, 0, mpi_comm);
+    bcast(m_n_ranks, 0, mpi_comm);
+    bcast(m_N, 0, mpi_comm);
+    bcast(m_has_decomposition, 0, mpi_comm);
+    bcast(m_grid.x, 0, mpi_comm);
+    bcast(m_grid.y, 0, mpi_comm);
+    bcast(m_grid.z, 0, mpi_comm);
+    for (unsigned int dir = 0; dir < 3; dir++)
+        bcast(m_cum_frac[dir], 0, mpi_comm);
+    bcast(m_cart_ranks, 0, mpi_comm);
+    bcast(m_snapshot->dimensions, 0, mpi_comm);
+    bcast(m_snapshot->global_box, 0, mpi_comm);
+    bcast(m_snapshot->integrator_data, 0, mpi_comm);
+    #endif
+    }
+
+/*! \param rank Rank that wrote the file
+    \param particles True to read the particles, false to only read the autotuner parameters
+    \param tuned Output: autotuner parameters
+    \param snap Output: particles of the rank
+    \param tags Output: tags of the particles
+    \returns true on success
+*/
+bool CheckpointReader::readRankFile(unsigned int rank,
+                                    bool particles,
+                                    std::vector< std::pair<std::string, unsigned int> >& tuned,
+                                    SnapshotParticleData<double>& snap,
+                                    std::vector<unsigned int>& tags)
+    {
+    ifstream in(checkpoint::rankFileName(m_dirname, m_slot, rank).c_str(), ios_base::in | ios_base::binary);
+    if (!in.good() || !checkpoint::readHeader(in))
+        return false;
+
+    // the slot may only be paired with the meta file of the same checkpoint
+    uint64_t timestep = 0;
+    uint32_t file_rank = 0;
+    checkpoint::read(in, timestep);
+    checkpoint::read(in, file_rank);
+    if (!in.good() || timestep != m_timestep || file_rank != rank)
+        return false;
+
+    uint32_t n_tuned = 0;
+    checkpoint::read(in, n_tuned);
+    tuned.clear();
+    for (unsigned int i = 0; i < n_tuned && in.good(); i++)
+        {
+        std::string name;
+        uint32_t value = 0;
+        checkpoint::read(in, name);
+        checkpoint::read(in, value);
+        tuned.push_back(std::make_pair(name, value));
+        }
+
+    if (!particles)
+        return in.good();
+
+    uint32_t n = 0;
+    checkpoint::read(in, snap.type_mapping);
+    checkpoint::read(in, n);
+    checkpoint::read(in, tags);
+    checkpoint::readParticles(in, snap, n);
+
+    return in.good() && snap.validate() && tags.size() == n;
+    }
+
+/*! \param decomposition Domain decomposition of the new simulation
+    \returns true if every rank can read the particles written by the rank that owned the same domain
+*/
+bool CheckpointReader::isCompatible(std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    #ifdef ENABLE_MPI
+    if (!m_has_decomposition || m_n_ranks != m_exec_conf->getNRanks())
+        return false;
+
+    uint3 grid = decomposition->getGridSize();
+    if (grid.x != m_grid.x || grid.y != m_grid.y || grid.z != m_grid.z)
+        return false;
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        std::vector<Scalar> cum_frac = decomposition->getCumulativeFractions(dir);
+        if (cum_frac.size() != m_cum_frac[dir].size())
+            return false;
+        for (unsigned int i = 0; i < cum_frac.size(); i++)
+            if (std::fabs(double(cum_frac[i]) - m_cum_frac[dir][i]) > 1e-6)
+                return false;
+        }
+
+    return true;
+    #else
+    return false;
+    #endif
+    }
+
+#ifdef ENABLE_MPI
+/*! \returns The decomposition stored in the checkpoint, or a null pointer if it cannot be used with the current
+    number of ranks
+*/
+std::shared_ptr<DomainDecomposition> CheckpointReader::makeDomainDecomposition()
+    {
+    if (!m_has_decomposition || m_n_ranks != m_exec_conf->getNRanks())
+        return std::shared_ptr<DomainDecomposition>();
+
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(m_exec_conf,
+                                                                               m_snapshot->global_box.getL(),
+                                                                               m_grid.x,
+                                                                               m_grid.y,
+                                                                               m_grid.z));
+
+    uint3 grid = decomposition->getGridSize();
+    if (grid.x != m_grid.x || grid.y != m_grid.y || grid.z != m_grid.z)
+        return std::shared_ptr<DomainDecomposition>();
+
+    // restore the cut planes chosen by the load balancer
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        std::vector<Scalar> cum_frac(m_cum_frac[dir].begin(), m_cum_frac[dir].end());
+        decomposition->setCumulativeFractions(dir, cum_frac, 0);
+        }
+
+    return decomposition;
+    }
+#endif
+
+/*! \returns true on success
+
+    Assembles the particles of all rank files ordered by tag.
+*/
+bool CheckpointReader::readGlobalParticles()
+    {
+    SnapshotParticleData<double>& snap = m_snapshot->particle_data;
+    snap.resize(m_N);
+    snap.is_accel_set = false;
+
+    std::vector<bool> found(m_N, false);
+    unsigned int n_found = 0;
+
+    for (unsigned int rank = 0; rank < m_n_ranks; rank++)
+        {
+        std::vector< std::pair<std::string, unsigned int> > tuned;
+        SnapshotParticleData<double> part;
+        std::vector<unsigned int> tags;
+        if (!readRankFile(rank, true, tuned, part, tags))
+            return false;
+
+        if (rank == 0)
+            snap.type_mapping = part.type_mapping;
+        snap.is_accel_set = snap.is_accel_set || part.is_accel_set;
+
+        for (unsigned int i = 0; i < part.size; i++)
+            {
+            unsigned int tag = tags[i];
+            if (tag >= m_N || found[tag])
+                return false;
+            found[tag] = true;
+            n_found++;
+
+            snap.pos[tag] = part.pos[i];
+            snap.vel[tag] = part.vel[i];
+            snap.accel[tag] = part.accel[i];
+            snap.type[tag] = part.type[i];
+            snap.mass[tag] = part.mass[i];
+            snap.charge[tag] = part.charge[i];
+            snap.diameter[tag] = part.diameter[i];
+            snap.image[tag] = part.image[i];
+            snap.body[tag] = part.body[i];
+            snap.orientation[tag] = part.orientation[i];
+            snap.angmom[tag] = part.angmom[i];
+            snap.inertia[tag] = part.inertia[i];
+            }
+        }
+
+    return n_found == m_N;
+    }
+
+/*! \param decomposition Domain decomposition of the new simulation (may be null)
+    \returns The snapshot to initialize the SystemDefinition with
+*/
+std::shared_ptr< SnapshotSystemData<double> > CheckpointReader::readSnapshot(
+    std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::vector< std::pair<std::string, unsigned int> > tuned;
+    bool local = false;
+
+    #ifdef ENABLE_MPI
+    if (decomposition && isCompatible(decomposition))
+        {
+        const unsigned int my_rank = m_exec_conf->getRank();
+        SnapshotParticleData<double>& snap = m_snapshot->particle_data;
+
+        // read the file of the rank that owned this domain
+        unsigned int old_rank;
+            {
+            ArrayHandle<unsigned int> h_inv_cart_ranks(decomposition->getInverseCartRanks(), access_location::host,
+                                                       access_mode::read);
+            old_rank = m_cart_ranks[h_inv_cart_ranks.data[my_rank]];
+            }
+
+        // checkpoints are written between migrations, so particles may lie slightly outside of the domain they
+        // belong to, the first migration of the Communicator moves them to their owner
+        local = readRankFile(old_rank, true, tuned, snap, m_snapshot->particle_tags);
+
+        MPI_Allreduce(MPI_IN_PLACE, &local, 1, MPI_C_BOOL, MPI_LAND, m_exec_conf->getMPICommunicator());
+
+        if (local)
+            {
+            m_snapshot->particles_local = true;
+            m_exec_conf->msg->notice(3) << "init.read_checkpoint: every rank reads its own particles" << endl;
+            }
+        else
+            {
+            snap = SnapshotParticleData<double>();
+            m_snapshot->particle_tags.clear();
+            m_exec_conf->msg->notice(3) << "init.read_checkpoint: rank files unreadable, reading all particles on "
+                                        << "the root" << endl;
+            }
+        }
+    #endif
+
+    if (!local)
+        {
+        bool ok = true;
+        if (m_exec_conf->isRoot())
+            ok = readGlobalParticles();
+
+        // ranks that did not exist in the old run take the autotuner parameters of rank 0
+        unsigned int rank = m_exec_conf->getRank() < m_n_ranks ? m_exec_conf->getRank() : 0;
+        SnapshotParticleData<double> unused;
+        std::vector<unsigned int> unused_tags;
+        ok = readRankFile(rank, false, tuned, unused, unused_tags) && ok;
+
+        #ifdef ENABLE_MPI
+        if (m_exec_conf->getNRanks() > 1)
+            MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_C_BOOL, MPI_LAND, m_exec_conf->getMPICommunicator());
+        #endif
+
+        if (!ok)
+            {
+            m_exec_conf->msg->error() << "init.read_checkpoint: Unable to read the particles of checkpoint "
+                                      << m_dirname << endl;
+            throw runtime_error("Error reading checkpoint");
+            }
+        }
+
+    Autotuner::setPresets(tuned);
+
+    return m_snapshot;
+    }
+
+void export_CheckpointReader(py::module& m)
+    {
+    py::class_< CheckpointReader, std::shared_ptr<CheckpointReader> >(m,"CheckpointReader")
+    .def(py::init<std::shared_ptr<ExecutionConfiguration>, const string&>())
+    .def("getTimeStep", &CheckpointReader::getTimeStep)
+    .def("getGlobalBox", &CheckpointReader::getGlobalBox, py::return_value_policy::copy)
+    .def("getNRanks", &CheckpointReader::getNRanks)
+    #ifdef ENABLE_MPI
+    .def("makeDomainDecomposition", &CheckpointReader::makeDomainDecomposition)
+    #endif
+    .def("readSnapshot", &CheckpointReader::readSnapshot)
+    ;
+    }
@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_READER_H__
+#define __CHECKPOINT_READER_H__
+
+#include "SnapshotSystemData.h"
+#include "DomainDecomposition.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+//! Reads a checkpoint written by CheckpointWriter
+/*! The root rank reads the global state in the constructor and broadcasts the time step, box, decomposition and
+    integrator variables. readSnapshot() then loads the particles.
+
+    When the simulation restarts on the same number of ranks with the same domain decomposition (see
+    makeDomainDecomposition()), every rank reads the file that the rank owning the same domain wrote and keeps the
+    particles local, so a restart reads all files in parallel. Particles that left their domain since the last
+    migration are moved to their owner by the first migration of the Communicator. Otherwise, the root rank
+    reads all rank files and assembles a global snapshot that ParticleData distributes as usual.
+
+    The autotuner parameters stored in the checkpoint are handed to Autotuner::setPresets(), so that autotuners
+    constructed after the restart start with the previous decisions instead of scanning again.
+
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT CheckpointReader
+    {
+    public:
+        //! Reads the global state of the checkpoint
+        CheckpointReader(std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& dirname);
+
+        //! Returns the time step of the checkpoint
+        uint64_t getTimeStep() const
+            {
+            return m_timestep;
+            }
+
+        //! Returns the global box of the checkpoint
+        const BoxDim& getGlobalBox() const
+            {
+            return m_snapshot->global_box;
+            }
+
+        //! Returns the number of ranks that wrote the checkpoint
+        unsigned int getNRanks() const
+            {
+            return m_n_ranks;
+            }
+
+        #ifdef ENABLE_MPI
+        //! Construct the domain decomposition stored in the checkpoint
+        std::shared_ptr<DomainDecomposition> makeDomainDecomposition();
+        #endif
+
+        //! Read the particles and return the snapshot to initialize the system with
+        std::shared_ptr< SnapshotSystemData<double> > readSnapshot(std::shared_ptr<DomainDecomposition> decomposition);
+
+    private:
+        std::shared_ptr<ExecutionConfiguration> m_exec_conf;        //!< The execution configuration
+        std::string m_dirname;                                      //!< Directory of the checkpoint
+        uint64_t m_timestep;                                        //!< Time step of the checkpoint
+        unsigned int m_slot;                                        //!< Slot that holds the rank files
+        unsigned int m_n_ranks;                                     //!< Number of ranks that wrote the checkpoint
+        unsigned int m_N;                                           //!< Number of particles
+        bool m_has_decomposition;                                   //!< True if the checkpoint has a decomposition
+        uint3 m_grid;                                               //!< Domain grid of the checkpoint
+        std::vector<double> m_cum_frac[3];                          //!< Cumulative fractions of the checkpoint
+        std::vector<unsigned int> m_cart_ranks;                     //!< Ranks of the domains in the checkpoint
+        std::shared_ptr< SnapshotSystemData<double> > m_snapshot;   //!< Snapshot with the global state
+
+        //! Read the global state (root rank only)
+        bool readMetaFile();
+
+        //! Broadcast the global state from the root rank
+        void broadcastMeta();
+
+        //! Read the file written by one rank
+        bool readRankFile(unsigned int rank,
+                          bool particles,
+                          std::vector< std::pair<std::string, unsigned int> >& tuned,
+                          SnapshotParticleData<double>& snap,
+                          std::vector<unsigned int>& tags);
+
+        //! Test if the particles of the checkpoint can be read locally with the given decomposition
+        bool isCompatible(std::shared_ptr<DomainDecomposition> decomposition);
+
+        //! Read the particles of all ranks on the root rank
+        bool readGlobalParticles();
+    };
+
+//! Exports CheckpointReader to python
+void export_CheckpointReader(pybind11::module& m);
+
+#endif
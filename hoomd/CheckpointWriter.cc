@@ -0,0 +1,289 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+#include "CheckpointFormat.h"
+#include "Autotuner.h"
+#include "SnapshotSystemData.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace py = pybind11;
+using namespace std;
+
+//! Flush a written file to the storage device
+/*! \param fname File to flush
+    \returns true on success
+*/
+static bool syncFile(const std::string& fname)
+    {
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    bool ok = (fsync(fd) == 0);
+    return (close(fd) == 0) && ok;
+    }
+
+/*! \param sysdef SystemDefinition containing the ParticleData to dump
+    \param dirname Directory to write the checkpoint to
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& dirname)
+    : Analyzer(sysdef), m_dirname(dirname), m_slot(-1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << m_dirname << endl;
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+    }
+
+/*! The root rank creates the directory and reads the slot of a checkpoint that is already there, so that the first
+    write does not overwrite it.
+*/
+void CheckpointWriter::initializeSlot()
+    {
+    int slot = -1;
+    bool ok = true;
+
+    if (m_exec_conf->isRoot())
+        {
+        if (mkdir(m_dirname.c_str(), 0755) != 0 && errno != EEXIST)
+            {
+            m_exec_conf->msg->error() << "dump.checkpoint: Unable to create directory " << m_dirname << endl;
+            ok = false;
+            }
+
+        ifstream meta(checkpoint::metaFileName(m_dirname).c_str(), ios_base::in | ios_base::binary);
+        if (ok && meta.good() && checkpoint::readHeader(meta))
+            {
+            uint64_t timestep = 0;
+            uint32_t old_slot = 0;
+            checkpoint::read(meta, timestep);
+            checkpoint::read(meta, old_slot);
+            if (meta.good())
+                slot = old_slot;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        bcast(ok, 0, m_exec_conf->getMPICommunicator());
+        bcast(slot, 0, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (!ok)
+        throw runtime_error("Error writing checkpoint");
+
+    m_slot = slot;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every rank writes its particles into the slot that is not in use. After all ranks succeeded, the root rank writes
+    the global state to a temporary file and renames it over \c meta, which switches to the new slot atomically.
+    All files are flushed to disk with fsync() before the rename, so a crash cannot leave a truncated checkpoint.
+*/
+void CheckpointWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("Checkpoint");
+
+    // particle data is stored by tag, so the tags must cover 0..N-1
+    if (m_pdata->getNGlobal() > 0 && m_pdata->getMaximumTag() + 1 != m_pdata->getNGlobal())
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Particle tags are not contiguous. Checkpoints require that no "
+                                  << "particles have been removed." << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    if (m_slot < 0)
+        initializeSlot();
+    unsigned int slot = (m_slot == 0) ? 1 : 0;
+
+    // bonded groups and integrator variables are gathered on the root, particles stay local
+    std::shared_ptr< SnapshotSystemData<double> > snap
+        = m_sysdef->takeLocalSnapshot<double>(true, true, true, true, true, true, true, true);
+
+    // the rank files must be on disk before meta refers to them
+    const string rank_name = checkpoint::rankFileName(m_dirname, slot, m_exec_conf->getRank());
+    bool ok = writeRankFile(rank_name, timestep, *snap) && syncFile(rank_name);
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        // also acts as the barrier before the root commits the checkpoint
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_C_BOOL, MPI_LAND, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (!ok)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: I/O error while writing checkpoint " << m_dirname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    if (m_exec_conf->isRoot())
+        {
+        const string meta_name = checkpoint::metaFileName(m_dirname);
+        const string tmp_name = meta_name + ".tmp";
+        // a crash before the rename leaves the old checkpoint, a crash after it the complete new one
+        ok = writeMetaFile(tmp_name, timestep, slot, *snap) && syncFile(tmp_name);
+        if (ok && rename(tmp_name.c_str(), meta_name.c_str()) != 0)
+            ok = false;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        bcast(ok, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (!ok)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: I/O error while writing checkpoint " << m_dirname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    m_slot = slot;
+    m_exec_conf->msg->notice(4) << "dump.checkpoint: wrote checkpoint at step " << timestep << " to slot " << slot
+                                << endl;
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param fname File to write
+    \param timestep Current time step
+    \param snap Snapshot with the local particles
+    \returns true on success
+*/
+bool CheckpointWriter::writeRankFile(const std::string& fname,
+                                     unsigned int timestep,
+                                     const SnapshotSystemData<double>& snap)
+    {
+    ofstream out(fname.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+    if (!out.good())
+        return false;
+
+    checkpoint::writeHeader(out);
+    checkpoint::write(out, (uint64_t)timestep);
+    checkpoint::write(out, (uint32_t)m_exec_conf->getRank());
+
+    std::vector< std::pair<std::string, unsigned int> > tuned = Autotuner::getTunedParameters();
+    checkpoint::write(out, (uint32_t)tuned.size());
+    for (unsigned int i = 0; i < tuned.size(); i++)
+        {
+        checkpoint::write(out, tuned[i].first);
+        checkpoint::write(out, (uint32_t)tuned[i].second);
+        }
+
+    checkpoint::write(out, snap.particle_data.type_mapping);
+    checkpoint::write(out, (uint32_t)snap.particle_data.size);
+    checkpoint::write(out, snap.particle_tags);
+    checkpoint::writeParticles(out, snap.particle_data);
+
+    out.flush();
+    return out.good();
+    }
+
+/*! \param fname File to write
+    \param timestep Current time step
+    \param slot Slot that holds the rank files of this checkpoint
+    \param snap Snapshot with the bonded groups and integrator variables
+    \returns true on success
+*/
+bool CheckpointWriter::writeMetaFile(const std::string& fname,
+                                     unsigned int timestep,
+                                     unsigned int slot,
+                                     const SnapshotSystemData<double>& snap)
+    {
+    ofstream out(fname.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+    if (!out.good())
+        return false;
+
+    checkpoint::writeHeader(out);
+    checkpoint::write(out, (uint64_t)timestep);
+    checkpoint::write(out, (uint32_t)slot);
+    checkpoint::write(out, (uint32_t)m_exec_conf->getNRanks());
+    checkpoint::write(out, (uint32_t)m_sysdef->getNDimensions());
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 L = box.getL();
+    uchar3 periodic = box.getPeriodic();
+    checkpoint::write(out, (double)L.x);
+    checkpoint::write(out, (double)L.y);
+    checkpoint::write(out, (double)L.z);
+    checkpoint::write(out, (double)box.getTiltFactorXY());
+    checkpoint::write(out, (double)box.getTiltFactorXZ());
+    checkpoint::write(out, (double)box.getTiltFactorYZ());
+    checkpoint::write(out, (uint8_t)periodic.x);
+    checkpoint::write(out, (uint8_t)periodic.y);
+    checkpoint::write(out, (uint8_t)periodic.z);
+
+    uint8_t has_decomposition = 0;
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        has_decomposition = 1;
+    #endif
+    checkpoint::write(out, has_decomposition);
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        const Index3D& di = decomposition->getDomainIndexer();
+        checkpoint::write(out, (uint32_t)di.getW());
+        checkpoint::write(out, (uint32_t)di.getH());
+        checkpoint::write(out, (uint32_t)di.getD());
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            std::vector<Scalar> cum_frac = decomposition->getCumulativeFractions(dir);
+            checkpoint::write(out, std::vector<double>(cum_frac.begin(), cum_frac.end()));
+            }
+
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host,
+                                               access_mode::read);
+        checkpoint::write(out, std::vector<unsigned int>(h_cart_ranks.data, h_cart_ranks.data + di.getNumElements()));
+        }
+    #endif
+
+    checkpoint::write(out, (uint32_t)m_pdata->getNGlobal());
+
+    checkpoint::writeGroups(out, snap.bond_data);
+    checkpoint::writeGroups(out, snap.angle_data);
+    checkpoint::writeGroups(out, snap.dihedral_data);
+    checkpoint::writeGroups(out, snap.improper_data);
+    checkpoint::writeGroups(out, snap.constraint_data);
+    checkpoint::writeGroups(out, snap.pair_data);
+
+    checkpoint::write(out, (uint32_t)snap.integrator_data.size());
+    for (unsigned int i = 0; i < snap.integrator_data.size(); i++)
+        {
+        const IntegratorVariables& v = snap.integrator_data[i];
+        checkpoint::write(out, v.type);
+        checkpoint::write(out, std::vector<double>(v.variable.begin(), v.variable.end()));
+        }
+
+    out.flush();
+    return out.good();
+    }
+
+void export_CheckpointWriter(py::module& m)
+    {
+    py::class_<CheckpointWriter, Analyzer, std::shared_ptr<CheckpointWriter> >(m,"CheckpointWriter")
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::string >())
+    ;
+    }
@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_WRITER_H__
+#define __CHECKPOINT_WRITER_H__
+
+#include "Analyzer.h"
+
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+//! Analyzer for writing restartable checkpoints
+/*! CheckpointWriter saves everything needed to continue a simulation bit for bit: all particle fields in double
+    precision, the bonded groups, the integrator variables, the current time step, the domain decomposition including
+    the cut planes chosen by the load balancer, and the parameters chosen by the autotuners. See checkpoint for the
+    layout on disk.
+
+    Each rank writes the particles it owns into its own file without any communication, so the cost of a checkpoint
+    does not grow with the number of ranks. Bonded groups and integrator variables are small and are gathered and
+    written by the root rank. Random numbers in HOOMD are generated from the seed, the time step and the particle
+    tags, so the time step and the integrator variables capture the complete random number state.
+
+    Checkpoints are double buffered: a new checkpoint only replaces the previous one after every rank has written its
+    file successfully. Particle tags must be contiguous (no particles removed since initialization).
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CheckpointWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& dirname);
+
+        //! Destructor
+        ~CheckpointWriter();
+
+        //! Write a checkpoint
+        void analyze(unsigned int timestep);
+
+    private:
+        std::string m_dirname;      //!< Directory that holds the checkpoint
+        int m_slot;                 //!< Slot of the last complete checkpoint, -1 before the first write
+
+        //! Find the slot of an existing checkpoint in the directory
+        void initializeSlot();
+
+        //! Write the file with the particles of this rank
+        bool writeRankFile(const std::string& fname, unsigned int timestep, const SnapshotSystemData<double>& snap);
+
+        //! Write the file with the global state (root rank only)
+        bool writeMetaFile(const std::string& fname, unsigned int timestep, unsigned int slot,
+                           const SnapshotSystemData<double>& snap);
+    };
+
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
+
+#endif
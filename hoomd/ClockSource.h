@@ -25,6 +25,7 @@
 #include <iostream>
 
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <pybind11/pybind11.h>
@@ -39,9 +40,9 @@ inline void Sleep(int msec)
     }
 
 //! Source of time measurements
-/*! Access the operating system's timer and reports a time since construction in nanoseconds.
-    The resolution of the timer is system dependent, though typically around 10 microseconds
-    or better. Critical accessor methods are inlined for low overhead
+/*! Access the operating system's monotonic timer and reports a time since construction in nanoseconds.
+    The timer is not affected by changes of the system time. Its resolution is system dependent, though
+    typically a few nanoseconds. Critical accessor methods are inlined for low overhead
     \ingroup utils
 */
 class PYBIND11_EXPORT ClockSource
@@ -65,10 +66,10 @@ void export_ClockSource(pybind11::module& m);
 
 inline int64_t ClockSource::getTime() const
     {
-    timeval t;
-    gettimeofday(&t, NULL);
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
 
-    int64_t nsec = int64_t(t.tv_sec) * int64_t(1000000000) + int64_t(t.tv_usec)*int64_t(1000);
+    int64_t nsec = int64_t(t.tv_sec) * int64_t(1000000000) + int64_t(t.tv_nsec);
     return nsec - m_start_time;
     }
 
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 #include <numeric>
 
 using namespace std;
@@ -105,6 +106,102 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
     initializeCumulativeFractions(try_fxs, try_fys, try_fzs);
     }
 
+/*!
+ * \param exec_conf The execution configuration
+ * \param global_box Global simulation box
+ * \param snap Snapshot with the particles (only read on the root rank)
+ * \param nx Requested number of domains along the x direction (0 == choose)
+ * \param ny Requested number of domains along the y direction (0 == choose)
+ * \param nz Requested number of domains along the z direction (0 == choose)
+ * \param min_width Minimum width of a domain
+ *
+ * The root rank chooses the grid and the cut planes with findBalancedDecomposition() and broadcasts them. If no grid
+ * with the requested dimensions can hold domains of \a min_width, the default uniform decomposition is used.
+ */
+template<class Real>
+DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                         const BoxDim& global_box,
+                                         const SnapshotParticleData<Real>& snap,
+                                         unsigned int nx,
+                                         unsigned int ny,
+                                         unsigned int nz,
+                                         Scalar min_width)
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
+
+    Scalar3 L = global_box.getL();
+    std::vector<Scalar> cum_frac[3];
+    bool balanced = false;
+
+    if (m_exec_conf->isRoot())
+        {
+        // the cut planes only need to resolve the density profile, so a sample of the particles is enough
+        const unsigned int max_sample = 1 << 20;
+        unsigned int stride = snap.size/max_sample + 1;
+
+        std::vector<Scalar3> frac;
+        frac.reserve(snap.size/stride + 1);
+        for (unsigned int i = 0; i < snap.size; i += stride)
+            {
+            Scalar3 f = global_box.makeFraction(make_scalar3(snap.pos[i].x, snap.pos[i].y, snap.pos[i].z));
+
+            // particles slightly outside the box are placed into the boundary domains
+            f.x = std::min(std::max(f.x, Scalar(0.0)), Scalar(1.0));
+            f.y = std::min(std::max(f.y, Scalar(0.0)), Scalar(1.0));
+            f.z = std::min(std::max(f.z, Scalar(0.0)), Scalar(1.0));
+            frac.push_back(f);
+            }
+
+        Scalar3 min_frac = make_scalar3(min_width, min_width, min_width) / global_box.getNearestPlaneDistance();
+        balanced = findBalancedDecomposition(frac, L, min_frac, nx, ny, nz, cum_frac);
+        if (! balanced)
+            {
+            m_exec_conf->msg->warning() << "Unable to balance the particles with the requested dimensions and"
+                 << " minimum domain width. Choosing uniform spacing." << endl;
+            }
+        }
+    bcast(balanced, 0, m_mpi_comm);
+
+    // the root rank passes the balanced grid, the grid dimensions are broadcast from there
+    initializeDomainGrid(L, nx, ny, nz, false);
+
+    // fractions are broadcast from the root rank, the other ranks only need arrays of the right size
+    unsigned int n[3] = {m_nx, m_ny, m_nz};
+    std::vector<Scalar> fs[3];
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        fs[dir].resize(n[dir]-1, Scalar(1.0)/Scalar(n[dir]));
+        if (balanced && m_exec_conf->isRoot())
+            {
+            for (unsigned int k = 0; k < n[dir]-1; ++k)
+                fs[dir][k] = cum_frac[dir][k+1] - cum_frac[dir][k];
+            }
+        }
+    initializeCumulativeFractions(fs[0], fs[1], fs[2]);
+
+    if (balanced)
+        {
+        m_exec_conf->msg->notice(2) << "Domain decomposition cut planes placed to balance "
+            << snap.size << " particles" << std::endl;
+        }
+    }
+
+template DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                  const BoxDim& global_box,
+                                                  const SnapshotParticleData<float>& snap,
+                                                  unsigned int nx,
+                                                  unsigned int ny,
+                                                  unsigned int nz,
+                                                  Scalar min_width);
+template DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                  const BoxDim& global_box,
+                                                  const SnapshotParticleData<double>& snap,
+                                                  unsigned int nx,
+                                                  unsigned int ny,
+                                                  unsigned int nz,
+                                                  Scalar min_width);
+
 /*!
  * \param L Box lengths of global box to sub-divide
  * \param nx Requested number of domains along the x direction (0 == choose default)
@@ -370,6 +467,166 @@ bool DomainDecomposition::findDecomposition(unsigned int nranks, const Scalar3 L
     return found_decomposition;
     }
 
+/*!
+ * \param frac Fractional coordinates of the particles
+ * \param L Box lengths of the global box, used to break ties by the surface area between domains
+ * \param min_frac Minimum fractional width of a domain along each axis
+ * \param nx Requested number of domains along the x direction (0 == choose), set to the chosen grid on success
+ * \param ny Requested number of domains along the y direction (0 == choose), set to the chosen grid on success
+ * \param nz Requested number of domains along the z direction (0 == choose), set to the chosen grid on success
+ * \param cum_frac Cumulative fractions of the chosen grid along each axis
+ * \returns true if a grid was found
+ *
+ * For every grid with nx*ny*nz equal to the number of ranks, the cut planes along each axis are placed by bisect() and
+ * then moved apart so that no domain is narrower than \a min_frac or a tenth of the uniform width. The particles are
+ * binned into the domains of the grid, and the grid with the smallest maximum number of particles per domain is
+ * chosen. Ties are broken by the surface area between domains, as in findDecomposition().
+ */
+bool DomainDecomposition::findBalancedDecomposition(const std::vector<Scalar3>& frac, Scalar3 L, Scalar3 min_frac,
+    unsigned int& nx, unsigned int& ny, unsigned int& nz, std::vector<Scalar> (&cum_frac)[3])
+    {
+    unsigned int nranks = m_exec_conf->getNRanks();
+    Scalar min_w[3] = {min_frac.x, min_frac.y, min_frac.z};
+
+    // sorted coordinates along each axis
+    std::vector<Scalar> coords[3];
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        coords[dir].resize(frac.size());
+        for (unsigned int i = 0; i < frac.size(); ++i)
+            coords[dir][i] = (dir == 0) ? frac[i].x : ((dir == 1) ? frac[i].y : frac[i].z);
+        std::sort(coords[dir].begin(), coords[dir].end());
+        }
+
+    // cut planes along each axis by number of domains, empty if the domains cannot be made wide enough
+    std::map<unsigned int, std::vector<Scalar> > cuts[3];
+
+    bool found = false;
+    unsigned int min_load = 0;
+    double min_surface_area = 0.0;
+    std::vector<unsigned int> count(nranks);
+
+    for (unsigned int nx_try = 1; nx_try <= nranks; nx_try++)
+        {
+        if (nx != 0 && nx_try != nx)
+            continue;
+        for (unsigned int ny_try = 1; nx_try*ny_try <= nranks; ny_try++)
+            {
+            if (ny != 0 && ny_try != ny)
+                continue;
+            for (unsigned int nz_try = 1; nx_try*ny_try*nz_try <= nranks; nz_try++)
+                {
+                if (nz != 0 && nz_try != nz)
+                    continue;
+                if (nx_try*ny_try*nz_try != nranks) continue;
+
+                unsigned int n_try[3] = {nx_try, ny_try, nz_try};
+                const std::vector<Scalar> *c[3];
+                bool feasible = true;
+                for (unsigned int dir = 0; dir < 3; ++dir)
+                    {
+                    unsigned int n = n_try[dir];
+                    if (cuts[dir].count(n) == 0)
+                        {
+                        std::vector<Scalar>& cd = cuts[dir][n];
+                        Scalar w = std::max(min_w[dir], Scalar(0.1)/Scalar(n));
+                        if (Scalar(n)*w <= Scalar(1.0))
+                            {
+                            cd.push_back(Scalar(0.0));
+                            bisect(coords[dir], 0, coords[dir].size(), Scalar(0.0), Scalar(1.0), n, cd);
+                            cd.push_back(Scalar(1.0));
+
+                            // move the cut planes apart where the domains are too narrow
+                            for (unsigned int k = 1; k < n; ++k)
+                                cd[k] = std::max(cd[k], cd[k-1] + w);
+                            for (unsigned int k = n-1; k > 0; --k)
+                                cd[k] = std::min(cd[k], cd[k+1] - w);
+                            }
+                        }
+                    c[dir] = &cuts[dir][n];
+                    if (c[dir]->empty())
+                        feasible = false;
+                    }
+                if (!feasible) continue;
+
+                // count the particles per domain
+                Index3D di(nx_try, ny_try, nz_try);
+                std::fill(count.begin(), count.end(), 0);
+                for (unsigned int i = 0; i < frac.size(); ++i)
+                    {
+                    Scalar f[3] = {frac[i].x, frac[i].y, frac[i].z};
+                    unsigned int idx[3];
+                    for (unsigned int dir = 0; dir < 3; ++dir)
+                        {
+                        // number of interior cut planes at or below the coordinate
+                        idx[dir] = std::upper_bound(c[dir]->begin() + 1, c[dir]->end() - 1, f[dir])
+                            - (c[dir]->begin() + 1);
+                        }
+                    count[di(idx[0], idx[1], idx[2])]++;
+                    }
+                unsigned int load = *std::max_element(count.begin(), count.end());
+
+                double surface_area = L.x*L.y*(double)(nz_try-1) + L.x*L.z*(double)(ny_try-1) + L.y*L.z*(double)(nx_try-1);
+                if (!found || load < min_load || (load == min_load && surface_area < min_surface_area))
+                    {
+                    for (unsigned int dir = 0; dir < 3; ++dir)
+                        cum_frac[dir] = *c[dir];
+                    min_load = load;
+                    min_surface_area = surface_area;
+                    found = true;
+                    }
+                }
+            }
+        }
+
+    if (found)
+        {
+        nx = cum_frac[0].size() - 1;
+        ny = cum_frac[1].size() - 1;
+        nz = cum_frac[2].size() - 1;
+        }
+    return found;
+    }
+
+/*!
+ * \param coords Sorted coordinates
+ * \param first Index of the first coordinate in the range
+ * \param last Index one past the last coordinate in the range
+ * \param lo Lower boundary of the range
+ * \param hi Upper boundary of the range
+ * \param n Number of domains to place between \a lo and \a hi
+ * \param cum_frac The cut planes between \a lo and \a hi are appended in ascending order
+ *
+ * The range is split into n/2 and n - n/2 domains by a cut plane that divides the coordinates in the same proportion,
+ * and both halves are bisected again.
+ */
+void DomainDecomposition::bisect(const std::vector<Scalar>& coords, unsigned int first, unsigned int last,
+    Scalar lo, Scalar hi, unsigned int n, std::vector<Scalar>& cum_frac)
+    {
+    if (n < 2)
+        return;
+
+    unsigned int n_left = n/2;
+    unsigned int mid = first + (unsigned int)((uint64_t)(last - first)*n_left/n);
+
+    Scalar cut;
+    if (first == last)
+        {
+        // no particles, split the range uniformly
+        cut = lo + (hi - lo)*Scalar(n_left)/Scalar(n);
+        }
+    else
+        {
+        Scalar below = (mid > first) ? coords[mid-1] : lo;
+        Scalar above = (mid < last) ? coords[mid] : hi;
+        cut = Scalar(0.5)*(below + above);
+        }
+
+    bisect(coords, first, mid, lo, cut, n_left, cum_frac);
+    cum_frac.push_back(cut);
+    bisect(coords, mid, last, cut, hi, n - n_left, cum_frac);
+    }
+
 //! Find a two-level decomposition of the global grid
 void DomainDecomposition::subdivide(unsigned int n_node_ranks, Scalar3 L,
     unsigned int nx, unsigned int ny, unsigned int nz,
@@ -677,6 +934,20 @@ void export_DomainDecomposition(py::module& m)
               const std::vector<Scalar>&,
               const std::vector<Scalar>&,
               const std::vector<Scalar>&>())
+    .def(py::init<std::shared_ptr<ExecutionConfiguration>,
+              const BoxDim&,
+              const SnapshotParticleData<float>&,
+              unsigned int,
+              unsigned int,
+              unsigned int,
+              Scalar>())
+    .def(py::init<std::shared_ptr<ExecutionConfiguration>,
+              const BoxDim&,
+              const SnapshotParticleData<double>&,
+              unsigned int,
+              unsigned int,
+              unsigned int,
+              Scalar>())
     .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
     ;
     }
@@ -20,6 +20,8 @@
 #include <set>
 #include <vector>
 
+template<class Real> struct SnapshotParticleData;
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -44,6 +46,13 @@
  *  ranks does not match the number that is available, behavior is reverted to the normal default with
  *  uniform cuts along each dimension.
  *
+ *  The cut planes can also be density balanced at initialization. For every grid that is commensurate with the number
+ *  of ranks, the axis-aligned cut planes along each axis are found by bisection of the particle coordinates, so that
+ *  the slabs on either side of every cut hold the same number of particles per domain. The domains remain a Cartesian
+ *  grid, this is not a recursive coordinate bisection with arbitrary domain neighbors.
+ *  The grid with the smallest maximum number of particles per domain is chosen. A strongly inhomogeneous system, such
+ *  as a droplet or a liquid slab, then starts out balanced instead of relying on many small steps of the LoadBalancer.
+ *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
  */
 class PYBIND11_EXPORT DomainDecomposition
@@ -72,6 +81,16 @@ class PYBIND11_EXPORT DomainDecomposition
                             const std::vector<Scalar>& fys,
                             const std::vector<Scalar>& fzs);
 
+        //! Constructor that places density-balanced initial cut planes for the particles of a snapshot
+        template<class Real>
+        DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                            const BoxDim& global_box,
+                            const SnapshotParticleData<Real>& snap,
+                            unsigned int nx = 0,
+                            unsigned int ny = 0,
+                            unsigned int nz = 0,
+                            Scalar min_width = Scalar(0.0));
+
         //! Calculate MPI ranks of neighboring domain.
         unsigned int getNeighborRank(unsigned int dir) const;
 
@@ -182,6 +201,14 @@ class PYBIND11_EXPORT DomainDecomposition
         bool findDecomposition(unsigned int nranks, Scalar3 L,
             unsigned int& nx, unsigned int& ny, unsigned int& nz);
 
+        //! Find the grid and the cut planes that balance the particles between domains
+        bool findBalancedDecomposition(const std::vector<Scalar3>& frac, Scalar3 L, Scalar3 min_frac,
+            unsigned int& nx, unsigned int& ny, unsigned int& nz, std::vector<Scalar> (&cum_frac)[3]);
+
+        //! Place the cut planes between n domains by recursive bisection of sorted coordinates
+        static void bisect(const std::vector<Scalar>& coords, unsigned int first, unsigned int last,
+            Scalar lo, Scalar hi, unsigned int n, std::vector<Scalar>& cum_frac);
+
         //! Find a two-level decomposition of the global grid
         void subdivide(unsigned int n_node_ranks, Scalar3 L,
             unsigned int nx, unsigned int ny, unsigned int nz,
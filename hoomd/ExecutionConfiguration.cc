@@ -245,6 +245,10 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         }
     #endif
 
+    // host arrays draw from a memory pool when running on the CPU
+    if (exec_mode == CPU)
+        m_host_pool.reset(new HostMemoryPool());
+
     #if defined(ENABLE_HIP)
     // setup synchronization events
     m_events.resize(m_gpu_id.size());
@@ -35,6 +35,7 @@
 
 #include "Messenger.h"
 #include "MemoryTraceback.h"
+#include "HostMemoryPool.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -316,11 +317,20 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         }
     #endif
 
+    //! Returns the pool for host memory allocations, or NULL when running on the GPU
+    HostMemoryPool *getHostMemoryPool() const
+        {
+        return m_host_pool.get();
+        }
+
     //! Set up memory tracing
     void setMemoryTracing(bool enable)
         {
         if (enable)
+            {
             m_memory_traceback = std::unique_ptr<MemoryTraceback>(new MemoryTraceback);
+            m_memory_traceback->setHostMemoryPool(m_host_pool.get());
+            }
         else
             m_memory_traceback = std::unique_ptr<MemoryTraceback>();
         }
@@ -390,6 +400,7 @@ private:
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback;    //!< Keeps track of allocations
+    std::unique_ptr<HostMemoryPool> m_host_pool;            //!< Pool for host allocations on the CPU
     };
 
 
@@ -27,11 +27,34 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-     : Compute(sysdef), m_particles_sorted(false)
+     : Compute(sysdef), m_particles_sorted(false), m_arrays_released(false), m_keep_arrays(false),
+       m_direct_pending(false), m_direct_timestep(0), m_prof_region(0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
 
+    allocateArrays();
+
+    // connect to the ParticleData to receive notifications when particles change order in memory
+     m_pdata->getParticleSortSignal().connect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
+
+    // connect to the ParticleData to receive notifications when the maximum number of particles changes
+     m_pdata->getMaxParticleNumberChangeSignal().connect<ForceCompute, &ForceCompute::reallocate>(this);
+
+    // reset external virial
+    for (unsigned int i = 0; i < 6; ++i)
+        m_external_virial[i] = Scalar(0.0);
+
+    m_external_energy = Scalar(0.0);
+
+    // initialize GPU memory hints
+    updateGPUAdvice();
+    }
+
+/*! \post m_force, m_virial and m_torque are allocated with the current maximum particle number and set to zero
+*/
+void ForceCompute::allocateArrays()
+    {
     // allocate data on the host
     unsigned int max_num_particles = m_pdata->getMaxN();
     GlobalArray<Scalar4>  force(max_num_particles,m_exec_conf);
@@ -70,27 +93,30 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
     #endif
 
     m_virial_pitch = m_virial.getPitch();
+    m_arrays_released = false;
+    }
 
-    // connect to the ParticleData to receive notifications when particles change order in memory
-     m_pdata->getParticleSortSignal().connect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
-
-    // connect to the ParticleData to receive notifications when the maximum number of particles changes
-     m_pdata->getMaxParticleNumberChangeSignal().connect<ForceCompute, &ForceCompute::reallocate>(this);
-
-    // reset external virial
-    for (unsigned int i = 0; i < 6; ++i)
-        m_external_virial[i] = Scalar(0.0);
-
-    m_external_energy = Scalar(0.0);
-
-    // initialize GPU memory hints
-    updateGPUAdvice();
+/*! \post m_force, m_virial and m_torque hold no memory until allocateArrays() is called
+*/
+void ForceCompute::releaseArrays()
+    {
+    GlobalArray<Scalar4> force;
+    GlobalArray<Scalar> virial;
+    GlobalArray<Scalar4> torque;
+    m_force.swap(force);
+    m_virial.swap(virial);
+    m_torque.swap(torque);
+    m_arrays_released = true;
     }
 
 /*! \post m_force, m_virial and m_torque are resized to the current maximum particle number
  */
 void ForceCompute::reallocate()
     {
+    // released arrays are allocated with the new size when they are needed
+    if (m_arrays_released)
+        return;
+
     m_force.resize(m_pdata->getMaxN());
     m_virial.resize(m_pdata->getMaxN(),6);
     m_torque.resize(m_pdata->getMaxN());
@@ -166,6 +192,7 @@ ForceCompute::~ForceCompute()
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    materialize();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -190,6 +217,7 @@ Scalar ForceCompute::calcEnergySum()
 */
 Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
     {
+    materialize();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
 
@@ -215,6 +243,7 @@ Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
 
 vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
     {
+    materialize();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
 
@@ -240,6 +269,7 @@ vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
 */
 std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup> group)
     {
+    materialize();
     const unsigned int group_size = group->getNumMembers();
     const ArrayHandle<Scalar> h_virial(m_virial,access_location::host,access_mode::read);
 
@@ -273,12 +303,77 @@ std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup>
 
 void ForceCompute::compute(unsigned int timestep)
     {
+    // the forces of this step were accumulated directly, evaluate them again into the per particle arrays
+    if (m_direct_pending && m_direct_timestep == timestep)
+        {
+        materialize();
+        m_last_computed = timestep;
+        m_first_compute = false;
+        m_particles_sorted = false;
+        return;
+        }
+
     // skip if we shouldn't compute this step
     if (!m_particles_sorted && !shouldCompute(timestep))
         return;
 
+    if (m_arrays_released)
+        {
+        allocateArrays();
+        m_keep_arrays = true;
+        }
+
     computeForces(timestep);
     m_particles_sorted = false;
+    m_direct_pending = false;
+    }
+
+/*! \param prof Profiler to use
+
+    The region of m_prof_name is looked up once here, so that derived classes push it by id on every step.
+*/
+void ForceCompute::setProfiler(std::shared_ptr<Profiler> prof)
+    {
+    Compute::setProfiler(prof);
+    if (m_prof && !m_prof_name.empty())
+        m_prof_region = m_prof->getRegion(m_prof_name);
+    }
+
+/*! \param timestep Current time step
+    \param target Arrays to add the forces to
+
+    The forces are always evaluated, since the caller zeroes \a target before every step. On the first call, the
+    per particle arrays are released. They are only allocated again when per particle data is requested, and then
+    kept for later requests.
+*/
+void ForceCompute::computeDirect(unsigned int timestep, const ForceTarget& target)
+    {
+    assert(supportsDirectAccumulation());
+
+    if (!m_arrays_released && !m_keep_arrays)
+        releaseArrays();
+
+    accumulateForces(timestep, target);
+    m_direct_timestep = timestep;
+    m_direct_pending = true;
+    m_particles_sorted = false;
+    }
+
+/*! If the forces of the last step were only accumulated directly, they are evaluated again with the current
+    particle data into m_force, m_virial and m_torque.
+*/
+void ForceCompute::materialize()
+    {
+    if (!m_direct_pending)
+        return;
+
+    if (m_arrays_released)
+        allocateArrays();
+    m_keep_arrays = true;
+
+    // clear the flag first, computeForces() may access the arrays through the public accessors
+    m_direct_pending = false;
+    computeForces(m_direct_timestep);
     }
 
 /*! \param num_iters Number of iterations to average for the benchmark
@@ -290,6 +385,10 @@ void ForceCompute::compute(unsigned int timestep)
 double ForceCompute::benchmark(unsigned int num_iters)
     {
     ClockSource t;
+
+    if (m_arrays_released)
+        allocateArrays();
+
     // warm up run
     computeForces(0);
 
@@ -321,6 +420,7 @@ double ForceCompute::benchmark(unsigned int num_iters)
  */
 Scalar4 ForceCompute::getTorque(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar4 result = make_scalar4(0.0,0.0,0.0,0.0);
@@ -344,6 +444,7 @@ Scalar4 ForceCompute::getTorque(unsigned int tag)
  */
 Scalar3 ForceCompute::getForce(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar3 result = make_scalar3(0.0,0.0,0.0);
@@ -368,6 +469,7 @@ Scalar3 ForceCompute::getForce(unsigned int tag)
  */
 Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -391,6 +493,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -35,6 +35,18 @@
 #ifndef __FORCECOMPUTE_H__
 #define __FORCECOMPUTE_H__
 
+//! Arrays that a ForceCompute adds its forces to in direct accumulation
+/*! The arrays are indexed like the particle data. \a force and \a virial are laid out like m_force and m_virial,
+    \a virial_pitch is the pitch of the virial array.
+*/
+struct ForceTarget
+    {
+    Scalar4 *force;             //!< Force and potential energy
+    Scalar *virial;             //!< Per particle virial
+    unsigned int virial_pitch;  //!< Pitch of the virial array
+    Scalar4 *torque;            //!< Torque
+    };
+
 //! Handy structure for passing the force arrays around
 /*! \c fx, \c fy, \c fz have length equal to the number of particles and store the x,y,z
     components of the force on that particle. \a pe is also included as the potential energy
@@ -75,6 +87,20 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Computes the forces
         virtual void compute(unsigned int timestep);
 
+        //! Sets the profiler for the compute to use
+        virtual void setProfiler(std::shared_ptr<Profiler> prof);
+
+        //! Returns true if this ForceCompute can add its forces directly to external arrays
+        /*! Derived classes that implement accumulateForces() should override this to return true.
+        */
+        virtual bool supportsDirectAccumulation()
+            {
+            return false;
+            }
+
+        //! Computes the forces and adds them to the given arrays
+        void computeDirect(unsigned int timestep, const ForceTarget& target);
+
         //! Benchmark the force compute
         virtual double benchmark(unsigned int num_iters);
 
@@ -105,18 +131,21 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Get the array of computed forces
         GlobalArray<Scalar4>& getForceArray()
             {
+            materialize();
             return m_force;
             }
 
         //! Get the array of computed virials
         GlobalArray<Scalar>& getVirialArray()
             {
+            materialize();
             return m_virial;
             }
 
         //! Get the array of computed torques
         GlobalArray<Scalar4>& getTorqueArray()
             {
+            materialize();
             return m_torque;
             }
 
@@ -169,6 +198,15 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Reallocate internal arrays
         void reallocate();
 
+        //! Allocate the per particle arrays and set them to zero
+        void allocateArrays();
+
+        //! Release the per particle arrays
+        void releaseArrays();
+
+        //! Fill the per particle arrays if the last forces were only accumulated directly
+        void materialize();
+
         //! Update GPU memory hints
         void updateGPUAdvice();
 
@@ -190,12 +228,29 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         Scalar m_external_virial[6]; //!< Stores external contribution to virial
         Scalar m_external_energy;    //!< Stores external contribution to potential energy
 
+        bool m_arrays_released;           //!< True if m_force, m_virial and m_torque are not allocated
+        bool m_keep_arrays;               //!< True once per particle data was requested after direct accumulation
+        bool m_direct_pending;            //!< True if the per particle arrays lag behind a direct accumulation
+        unsigned int m_direct_timestep;   //!< Time step of the last direct accumulation
+
+        std::string m_prof_name;          //!< Name of the profiler region of derived classes that set it
+        unsigned int m_prof_region;       //!< Id of m_prof_name in the current profiler
+
         //! Actually perform the computation of the forces
         /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
             the base class compute() when the forces need to be computed.
             \param timestep Current time step
         */
         virtual void computeForces(unsigned int timestep){}
+
+        //! Add the forces to the given arrays
+        /*! Derived classes that support direct accumulation implement this to add the forces, energies, virials and
+            torques at \a timestep to \a target, which they must not overwrite. It is called instead of
+            computeForces() when the integrator accumulates the net force directly.
+            \param timestep Current time step
+            \param target Arrays to add the forces to
+        */
+        virtual void accumulateForces(unsigned int timestep, const ForceTarget& target){}
     };
 
 //! Exports the ForceCompute class to python
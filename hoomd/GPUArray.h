@@ -128,15 +128,18 @@ class host_deleter
     public:
         //! Default constructor
         host_deleter()
-            : m_use_device(false), m_N(0)
+            : m_use_device(false), m_N(0), m_pooled(false)
             {}
 
         //! Ctor
         /*! \param exec_conf Execution configuration
             \param use_device whether the array is managed or on the host
+            \param N number of elements
+            \param pooled true if the memory was obtained from the host memory pool of \a exec_conf
          */
-        host_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf, bool use_device, const unsigned int N)
-            : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N)
+        host_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf, bool use_device, const unsigned int N,
+            bool pooled=false)
+            : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N), m_pooled(pooled)
             { }
 
         //! Delete the CUDA array
@@ -162,14 +165,41 @@ class host_deleter
                 }
 
             // free the allocation
-            free(ptr);
+            if (m_pooled)
+                m_exec_conf->getHostMemoryPool()->deallocate(ptr, m_N*sizeof(T));
+            else
+                free(ptr);
             }
 
     private:
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
         bool m_use_device;     //!< Whether to use hostMallocManaged
         unsigned int m_N;      //!< Number of elements in array
+        bool m_pooled;         //!< True if the memory belongs to the host memory pool
     };
+
+//! Allocate 32 byte aligned host memory for an array
+/*! \param exec_conf Execution configuration (may be NULL)
+    \param num_bytes Size of the allocation
+    \param pooled Set to true if the memory was obtained from the host memory pool
+    \returns The allocation, or NULL on failure
+
+    Memory that is not registered with the GPU is taken from the host memory pool of \a exec_conf if there is one.
+*/
+inline void *allocate_host_memory(std::shared_ptr<const ExecutionConfiguration> exec_conf, size_t num_bytes,
+    bool& pooled)
+    {
+    pooled = false;
+    if (exec_conf && !exec_conf->isCUDAEnabled() && exec_conf->getHostMemoryPool())
+        {
+        pooled = true;
+        return exec_conf->getHostMemoryPool()->allocate(num_bytes);
+        }
+
+    void *ptr = nullptr;
+    int retval = posix_memalign(&ptr, 32, num_bytes);
+    return (retval == 0) ? ptr : nullptr;
+    }
 } // end namespace detail
 
 } // end namespace hoomd
@@ -903,12 +933,11 @@ template<class T> void GPUArray<T>::allocate()
     if (m_exec_conf)
         m_exec_conf->msg->notice(7) << "GPUArray: Allocating " << float(m_num_elements*sizeof(T))/1024.0f/1024.0f << " MB" << std::endl;
 
-    void *host_ptr = nullptr;
-
     // allocate host memory
     // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign(&host_ptr, 32, m_num_elements*sizeof(T));
-    if (retval != 0)
+    bool pooled;
+    void *host_ptr = hoomd::detail::allocate_host_memory(m_exec_conf, m_num_elements*sizeof(T), pooled);
+    if (host_ptr == nullptr)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -930,7 +959,7 @@ template<class T> void GPUArray<T>::allocate()
 #endif
 
     // store in smart ptr with custom deleter
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements, pooled);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(reinterpret_cast<T *>(host_ptr), host_deleter);
 
 #if defined (ENABLE_HIP)
@@ -1242,12 +1271,10 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
     if (isNull()) return NULL;
 
     // allocate resized array
-    T *h_tmp = NULL;
-
-    // allocate host memory
     // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_tmp, 32, num_elements*sizeof(T));
-    if (retval != 0)
+    bool pooled;
+    T *h_tmp = reinterpret_cast<T *>(hoomd::detail::allocate_host_memory(m_exec_conf, num_elements*sizeof(T), pooled));
+    if (h_tmp == nullptr)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -1272,7 +1299,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
 
     // update smart pointer
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements, pooled);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(h_tmp, host_deleter);
 
 #ifdef ENABLE_HIP
@@ -1300,13 +1327,11 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
 template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned int new_pitch, unsigned int height, unsigned int new_height )
     {
     // allocate resized array
-    T *h_tmp = NULL;
-
-    // allocate host memory
     // at minimum, alignment needs to be 32 bytes for AVX
     unsigned int size = new_pitch*new_height*sizeof(T);
-    int retval = posix_memalign((void**)&h_tmp, 32, size);
-    if (retval != 0)
+    bool pooled;
+    T *h_tmp = reinterpret_cast<T *>(hoomd::detail::allocate_host_memory(m_exec_conf, size, pooled));
+    if (h_tmp == nullptr)
         {
         if (m_exec_conf)
             m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
@@ -1335,7 +1360,7 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
 
     // update smart pointer
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch*new_height);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch*new_height, pooled);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(h_tmp, host_deleter);
 
 #ifdef ENABLE_HIP
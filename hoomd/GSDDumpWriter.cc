@@ -22,6 +22,11 @@
 #include <string.h>
 #include <stdexcept>
 #include <list>
+#include <algorithm>
+#include <errno.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 namespace py = pybind11;
 
@@ -44,6 +49,8 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
+                        m_distributed(false),
+                        m_fd(-1),
                         m_group(group)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
@@ -161,6 +168,9 @@ GSDDumpWriter::~GSDDumpWriter()
         m_exec_conf->msg->notice(5) << "dump.gsd: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
+
+    if (m_fd >= 0)
+        close(m_fd);
     }
 
 /*! \param timestep Current time step of the simulation
@@ -172,20 +182,33 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     {
     int retval;
     bool root=true;
+    bool distributed=false;
 
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
+    distributed = m_distributed && m_pdata->getDomainDecomposition();
 #endif
 
+    // take particle data snapshot
+    SnapshotParticleData<float> snapshot;
+    std::map<unsigned int, unsigned int> map;
+    if (distributed)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking local particle data snapshot" << endl;
+        std::vector<unsigned int> tags;
+        m_pdata->takeLocalSnapshot<float>(snapshot, tags);
+        computeLocalRows(tags);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+        }
+
     // open the file if it is not yet opened
     if (! m_is_initialized && root)
         initFileIO();
@@ -209,12 +232,27 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
     #endif
 
+    // write out the frame header on all frames
     if (root)
-        {
-        // write out the frame header on all frames
         writeFrameHeader(timestep);
 
-        // only write out data chunk categories if requested, or if on frame 0
+    // only write out data chunk categories if requested, or if on frame 0
+    if (distributed)
+        {
+        if (m_write_attribute || nframes == 0)
+            writeLocalAttributes(snapshot, nframes);
+        if (m_write_property || nframes == 0)
+            writeLocalProperties(snapshot, nframes);
+        if (m_write_momentum || nframes == 0)
+            writeLocalMomenta(snapshot, nframes);
+
+        #ifdef ENABLE_MPI
+        // all rows must be in the file before the root rank ends the frame
+        MPI_Barrier(m_exec_conf->getMPICommunicator());
+        #endif
+        }
+    else if (root)
+        {
         if (m_write_attribute || nframes == 0)
             writeAttributes(snapshot, map);
         if (m_write_property || nframes == 0)
@@ -699,6 +737,409 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
     }
 
+/*! \param tags Global tags of the particles in the local snapshot
+
+    Rows in the file are in the order of the group members, which are sorted by tag. Local particles that are not in
+    the group are skipped. The rows are sorted so that consecutive rows can be written with a single call.
+*/
+void GSDDumpWriter::computeLocalRows(const std::vector<unsigned int>& tags)
+    {
+    const unsigned int n_members = m_group->getNumMembersGlobal();
+    ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(), access_location::host, access_mode::read);
+    const unsigned int *begin = h_member_tags.data;
+    const unsigned int *end = h_member_tags.data + n_members;
+
+    std::vector< std::pair<uint64_t, unsigned int> > rows;
+    rows.reserve(tags.size());
+    for (unsigned int i = 0; i < tags.size(); i++)
+        {
+        const unsigned int *it = std::lower_bound(begin, end, tags[i]);
+        if (it != end && *it == tags[i])
+            rows.push_back(std::make_pair(uint64_t(it - begin), i));
+        }
+    std::sort(rows.begin(), rows.end());
+
+    m_local_rows.resize(rows.size());
+    m_local_order.resize(rows.size());
+    for (unsigned int k = 0; k < rows.size(); k++)
+        {
+        m_local_rows[k] = rows[k].first;
+        m_local_order[k] = rows[k].second;
+        }
+    }
+
+/*! \param location Location of the chunk in the file
+    \param data Local rows of the chunk in the order of m_local_rows
+    \param row_bytes Size of one row in bytes
+*/
+void GSDDumpWriter::writeLocalRows(int64_t location, const char *data, size_t row_bytes)
+    {
+    if (m_fd < 0)
+        {
+        m_fd = open(m_fname.c_str(), O_WRONLY);
+        if (m_fd < 0)
+            {
+            m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
+            throw runtime_error("Error writing GSD file");
+            }
+        }
+
+    size_t start = 0;
+    while (start < m_local_rows.size())
+        {
+        // extend the run while the rows are consecutive
+        size_t stop = start + 1;
+        while (stop < m_local_rows.size() && m_local_rows[stop] == m_local_rows[stop-1] + 1)
+            stop++;
+
+        const char *src = data + start*row_bytes;
+        size_t bytes = (stop - start)*row_bytes;
+        off_t offset = location + m_local_rows[start]*row_bytes;
+        while (bytes > 0)
+            {
+            ssize_t bytes_written = pwrite(m_fd, src, bytes, offset);
+            if (bytes_written == -1 && errno == EINTR)
+                continue;
+            if (bytes_written <= 0)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
+                throw runtime_error("Error writing GSD file");
+                }
+
+            src += bytes_written;
+            bytes -= bytes_written;
+            offset += bytes_written;
+            }
+
+        start = stop;
+        }
+    }
+
+/*! \param name Name of the chunk
+    \param type Type of the chunk data
+    \param M Number of columns
+    \param data Local rows in the order of m_local_rows, M values per row
+    \param all_default True if all local values have their default value
+    \param nframes Number of frames in the file
+
+    The chunk is skipped under the same rules as in the default mode, with \a all_default reduced over all ranks.
+
+    gsd_write_chunk() of gsd 2.x (file layout version 2) writes chunks of at least half of its write buffer directly
+    to the end of the file. For those, the root rank writes a placeholder chunk that holds its own rows and zeros
+    elsewhere, then every other rank overwrites its own rows in place. The rows of the other ranks are written twice,
+    but no rank holds more than its own rows in memory. Smaller chunks would only be copied into the write buffer, and
+    all chunks of files with another layout version are gathered on the root rank and written as a whole.
+*/
+template<class T>
+void GSDDumpWriter::writeLocalChunk(const std::string& name,
+                                    gsd_type type,
+                                    unsigned int M,
+                                    const std::vector<T>& data,
+                                    bool all_default,
+                                    uint64_t nframes)
+    {
+    #ifdef ENABLE_MPI
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+    int local_default = all_default ? 1 : 0;
+    int global_default = 0;
+    MPI_Allreduce(&local_default, &global_default, 1, MPI_INT, MPI_LAND, mpi_comm);
+
+    const uint64_t N = m_group->getNumMembersGlobal();
+    const size_t row_bytes = sizeof(T)*M;
+    const bool root = m_exec_conf->isRoot();
+
+    // whether the chunk is written, whether it is written in place, and its location
+    int64_t chunk[3] = {0, 0, 0};
+    if (root && (!global_default || (nframes > 0 && m_nondefault[name])))
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+        if (nframes == 0)
+            m_nondefault[name] = true;
+        chunk[0] = 1;
+
+        // the in place write depends on where gsd 2.x puts large chunks
+        const bool known_layout = m_handle.header.gsd_version >= gsd_make_version(2, 0)
+                                  && m_handle.header.gsd_version < gsd_make_version(3, 0);
+        if (known_layout && N*row_bytes >= m_handle.write_buffer.reserved/2)
+            {
+            // calloc maps zero pages lazily, so the placeholder only takes memory for the rows of this rank
+            std::unique_ptr<char, void (*)(void *)> placeholder(static_cast<char *>(calloc(N, row_bytes)), free);
+            if (!placeholder)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: failed to allocate memory for " << name << endl;
+                throw runtime_error("Error writing GSD file");
+                }
+            const char *src = reinterpret_cast<const char *>(data.data());
+            for (size_t k = 0; k < m_local_rows.size(); k++)
+                memcpy(placeholder.get() + m_local_rows[k]*row_bytes, src + k*row_bytes, row_bytes);
+
+            chunk[1] = 1;
+            chunk[2] = m_handle.file_size;
+            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, N, M, 0, placeholder.get());
+            checkError(retval);
+            if (m_handle.file_size != chunk[2] + int64_t(N*row_bytes))
+                {
+                m_exec_conf->msg->error() << "dump.gsd: " << name << " was not written to the end of the file" << endl;
+                throw runtime_error("Error writing GSD file");
+                }
+            }
+        }
+    MPI_Bcast(chunk, 3, MPI_INT64_T, 0, mpi_comm);
+
+    if (chunk[1])
+        {
+        // the placeholder already holds the rows of the root rank
+        if (!root)
+            writeLocalRows(chunk[2], reinterpret_cast<const char *>(data.data()), row_bytes);
+        }
+    else if (chunk[0])
+        {
+        const unsigned int n_ranks = m_exec_conf->getNRanks();
+        int n_local = int(m_local_rows.size());
+        std::vector<int> counts(n_ranks), displs(n_ranks), byte_counts(n_ranks), byte_displs(n_ranks);
+        MPI_Gather(&n_local, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi_comm);
+        for (unsigned int r = 1; r < n_ranks; r++)
+            displs[r] = displs[r-1] + counts[r-1];
+        for (unsigned int r = 0; r < n_ranks; r++)
+            {
+            byte_counts[r] = counts[r]*int(row_bytes);
+            byte_displs[r] = displs[r]*int(row_bytes);
+            }
+
+        std::vector<uint64_t> rows(root ? N : 0);
+        std::vector<char> gathered(root ? N*row_bytes : 0);
+        MPI_Gatherv(m_local_rows.data(), n_local, MPI_UINT64_T,
+                    rows.data(), counts.data(), displs.data(), MPI_UINT64_T, 0, mpi_comm);
+        MPI_Gatherv(data.data(), n_local*int(row_bytes), MPI_BYTE,
+                    gathered.data(), byte_counts.data(), byte_displs.data(), MPI_BYTE, 0, mpi_comm);
+
+        if (root)
+            {
+            // put the rows in file order
+            std::vector<char> sorted(N*row_bytes);
+            for (uint64_t k = 0; k < N; k++)
+                memcpy(&sorted[rows[k]*row_bytes], &gathered[k*row_bytes], row_bytes);
+
+            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, N, M, 0, (void *)sorted.data());
+            checkError(retval);
+            }
+        }
+    #endif
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param nframes Number of frames in the file
+
+    Distributed counterpart of writeAttributes().
+*/
+void GSDDumpWriter::writeLocalAttributes(const SnapshotParticleData<float>& snapshot, uint64_t nframes)
+    {
+    const unsigned int n = (unsigned int)m_local_order.size();
+
+    if (m_exec_conf->isRoot())
+        {
+        writeTypeMapping("particles/types", snapshot.type_mapping);
+        }
+
+        {
+        std::vector<uint32_t> type(n);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.type[i] != 0)
+                all_default = false;
+            type[k] = uint32_t(snapshot.type[i]);
+            }
+        writeLocalChunk("particles/typeid", GSD_TYPE_UINT32, 1, type, all_default, nframes);
+        }
+
+        {
+        std::vector<float> data(n);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.mass[i] != float(1.0))
+                all_default = false;
+            data[k] = float(snapshot.mass[i]);
+            }
+        writeLocalChunk("particles/mass", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+
+        all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.charge[i] != float(0.0))
+                all_default = false;
+            data[k] = float(snapshot.charge[i]);
+            }
+        writeLocalChunk("particles/charge", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+
+        all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.diameter[i] != float(1.0))
+                all_default = false;
+            data[k] = float(snapshot.diameter[i]);
+            }
+        writeLocalChunk("particles/diameter", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+        }
+
+        {
+        std::vector<int32_t> body(n);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.body[i] != NO_BODY)
+                all_default = false;
+            body[k] = int32_t(snapshot.body[i]);
+            }
+        writeLocalChunk("particles/body", GSD_TYPE_INT32, 1, body, all_default, nframes);
+        }
+
+        {
+        std::vector<float> data(uint64_t(n)*3);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.inertia[i].x != float(0.0) ||
+                snapshot.inertia[i].y != float(0.0) ||
+                snapshot.inertia[i].z != float(0.0))
+                {
+                all_default = false;
+                }
+
+            data[k*3+0] = float(snapshot.inertia[i].x);
+            data[k*3+1] = float(snapshot.inertia[i].y);
+            data[k*3+2] = float(snapshot.inertia[i].z);
+            }
+        writeLocalChunk("particles/moment_inertia", GSD_TYPE_FLOAT, 3, data, all_default, nframes);
+        }
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param nframes Number of frames in the file
+
+    Distributed counterpart of writeProperties().
+*/
+void GSDDumpWriter::writeLocalProperties(const SnapshotParticleData<float>& snapshot, uint64_t nframes)
+    {
+    const unsigned int n = (unsigned int)m_local_order.size();
+
+        {
+        std::vector<float> data(uint64_t(n)*3);
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            data[k*3+0] = float(snapshot.pos[i].x);
+            data[k*3+1] = float(snapshot.pos[i].y);
+            data[k*3+2] = float(snapshot.pos[i].z);
+            }
+
+        // positions are always written
+        writeLocalChunk("particles/position", GSD_TYPE_FLOAT, 3, data, false, nframes);
+        }
+
+        {
+        std::vector<float> data(uint64_t(n)*4);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.orientation[i].s != float(1.0) ||
+                snapshot.orientation[i].v.x != float(0.0) ||
+                snapshot.orientation[i].v.y != float(0.0) ||
+                snapshot.orientation[i].v.z != float(0.0))
+                {
+                all_default = false;
+                }
+
+            data[k*4+0] = float(snapshot.orientation[i].s);
+            data[k*4+1] = float(snapshot.orientation[i].v.x);
+            data[k*4+2] = float(snapshot.orientation[i].v.y);
+            data[k*4+3] = float(snapshot.orientation[i].v.z);
+            }
+        writeLocalChunk("particles/orientation", GSD_TYPE_FLOAT, 4, data, all_default, nframes);
+        }
+    }
+
+/*! \param snapshot Local particle data snapshot
+    \param nframes Number of frames in the file
+
+    Distributed counterpart of writeMomenta().
+*/
+void GSDDumpWriter::writeLocalMomenta(const SnapshotParticleData<float>& snapshot, uint64_t nframes)
+    {
+    const unsigned int n = (unsigned int)m_local_order.size();
+
+        {
+        std::vector<float> data(uint64_t(n)*3);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.vel[i].x != float(0.0) ||
+                snapshot.vel[i].y != float(0.0) ||
+                snapshot.vel[i].z != float(0.0))
+                {
+                all_default = false;
+                }
+
+            data[k*3+0] = float(snapshot.vel[i].x);
+            data[k*3+1] = float(snapshot.vel[i].y);
+            data[k*3+2] = float(snapshot.vel[i].z);
+            }
+        writeLocalChunk("particles/velocity", GSD_TYPE_FLOAT, 3, data, all_default, nframes);
+        }
+
+        {
+        std::vector<float> data(uint64_t(n)*4);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.angmom[i].s != float(0.0) ||
+                snapshot.angmom[i].v.x != float(0.0) ||
+                snapshot.angmom[i].v.y != float(0.0) ||
+                snapshot.angmom[i].v.z != float(0.0))
+                {
+                all_default = false;
+                }
+
+            data[k*4+0] = float(snapshot.angmom[i].s);
+            data[k*4+1] = float(snapshot.angmom[i].v.x);
+            data[k*4+2] = float(snapshot.angmom[i].v.y);
+            data[k*4+3] = float(snapshot.angmom[i].v.z);
+            }
+        writeLocalChunk("particles/angmom", GSD_TYPE_FLOAT, 4, data, all_default, nframes);
+        }
+
+        {
+        std::vector<int32_t> data(uint64_t(n)*3);
+        bool all_default = true;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            unsigned int i = m_local_order[k];
+            if (snapshot.image[i].x != 0 ||
+                snapshot.image[i].y != 0 ||
+                snapshot.image[i].z != 0)
+                {
+                all_default = false;
+                }
+
+            data[k*3+0] = snapshot.image[i].x;
+            data[k*3+1] = snapshot.image[i].y;
+            data[k*3+2] = snapshot.image[i].z;
+            }
+        writeLocalChunk("particles/image", GSD_TYPE_INT32, 3, data, all_default, nframes);
+        }
+    }
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -989,6 +1430,7 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setDistributed", &GSDDumpWriter::setDistributed)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
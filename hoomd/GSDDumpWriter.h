@@ -11,6 +11,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -31,6 +32,11 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    In distributed mode (see setDistributed()), the large per-particle chunks are not gathered on the root rank. Every
+    rank takes a local snapshot of its own particles, the root rank writes each large chunk with its own rows and
+    zeros elsewhere, and the other ranks overwrite their rows in place (see writeLocalChunk()). The resulting file has content equivalent to the one written
+    in the default mode. Small chunks, topology and user data are still gathered and written by the root rank.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -67,6 +73,12 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control whether each rank writes its own particles
+        void setDistributed(bool b)
+            {
+            m_distributed = b;
+            }
+
         //! Destructor
         ~GSDDumpWriter();
 
@@ -85,6 +97,10 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
         gsd_handle m_handle;                //!< Handle to the file
+        bool m_distributed;                 //!< True if every rank writes its own particles
+        int m_fd;                           //!< File descriptor used to write the local rows (-1 if not open)
+        std::vector<unsigned int> m_local_order;    //!< Local snapshot index of every written local row
+        std::vector<uint64_t> m_local_rows;         //!< Ascending rows in the file of the local particles
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
@@ -110,6 +126,30 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
+        //! Find the rows of the local particles in the file
+        void computeLocalRows(const std::vector<unsigned int>& tags);
+
+        //! Write particle attributes from all ranks
+        void writeLocalAttributes(const SnapshotParticleData<float>& snapshot, uint64_t nframes);
+
+        //! Write particle properties from all ranks
+        void writeLocalProperties(const SnapshotParticleData<float>& snapshot, uint64_t nframes);
+
+        //! Write particle momenta from all ranks
+        void writeLocalMomenta(const SnapshotParticleData<float>& snapshot, uint64_t nframes);
+
+        //! Write a per-particle chunk from all ranks
+        template<class T>
+        void writeLocalChunk(const std::string& name,
+                             gsd_type type,
+                             unsigned int M,
+                             const std::vector<T>& data,
+                             bool all_default,
+                             uint64_t nframes);
+
+        //! Write the local rows of a chunk at its location in the file
+        void writeLocalRows(int64_t location, const char *data, size_t row_bytes);
+
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
                            AngleData::Snapshot& angle,
@@ -13,6 +13,8 @@
 #include "ExecutionConfiguration.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -23,21 +25,25 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Open the file on all ranks and read the particles later with readLocalParticles()
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
-    memory (on the root rank).
+    memory (on the root rank). In distributed mode, every rank reads the header and the particle types, and the root
+    rank reads the bonded groups.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(distributed),
+      m_is_open(false), m_N(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -47,6 +53,7 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
     m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << name << endl;
     int retval = gsd_open(&m_handle, name.c_str(), GSD_OPEN_READONLY);
     checkError(retval);
+    m_is_open = true;
 
     // validate schema
     if (string(m_handle.header.schema) != string("hoomd"))
@@ -73,21 +80,37 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
-    readParticles();
-    readTopology();
+
+    if (m_distributed)
+        {
+        // the particles are read once the domain decomposition is known
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+        }
+    else
+        {
+        readParticles();
+        }
+
+    if (m_exec_conf->isRoot())
+        readTopology();
     }
 
 GSDReader::~GSDReader()
     {
-    #ifdef ENABLE_MPI
-    // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
-        {
-        return;
-        }
-    #endif
+    if (m_is_open)
+        gsd_close(&m_handle);
+    }
 
-    gsd_close(&m_handle);
+/*! \param frame Frame index to read from
+    \param name Name of the data chunk
+    \returns The index entry of the chunk in \a frame or frame 0, NULL if it is in neither
+*/
+const struct gsd_index_entry* GSDReader::findChunk(uint64_t frame, const char *name)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+    return entry;
     }
 
 /*! \param data Pointer to data to read into
@@ -106,9 +129,7 @@ GSDReader::~GSDReader()
 */
 bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n)
     {
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    const struct gsd_index_entry* entry = findChunk(frame, name);
 
     if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
         {
@@ -149,9 +170,7 @@ std::vector<std::string> GSDReader::readTypes(uint64_t frame, const char *name)
     if (std::string(name) == "particles/types")
         type_mapping.push_back("A");
 
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    const struct gsd_index_entry* entry = findChunk(frame, name);
 
     if (entry == NULL)
         return type_mapping;
@@ -195,14 +214,15 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_N = N;
     }
 
 /*! Read the same data chunks for particles
 */
 void GSDReader::readParticles()
     {
-    uint64_t N = m_snapshot->particle_data.size;
+    uint64_t N = m_N;
+    m_snapshot->particle_data.resize(m_N);
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
@@ -291,6 +311,324 @@ void GSDReader::readTopology()
         }
     }
 
+namespace
+{
+//! Read only memory map of a range of rows of one data chunk
+/*! Pages are only read from disk when they are touched. When the rows cannot be mapped, they are read into memory
+    instead.
+*/
+class MappedChunk
+    {
+    public:
+        //! Map the rows [first, first+n) of the chunk described by \a entry
+        MappedChunk(gsd_handle& handle, const struct gsd_index_entry* entry, uint64_t first, uint64_t n)
+            : m_map(MAP_FAILED), m_map_len(0), m_data(NULL)
+            {
+            size_t row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+            size_t size = entry->N * row_size;
+            if (entry->location == 0 || entry->location + size > (uint64_t)handle.file_size || first + n > entry->N)
+                throw runtime_error("Error reading GSD file");
+            if (n == 0)
+                return;
+
+            size_t location = entry->location + first*row_size;
+            size_t page_size = sysconf(_SC_PAGESIZE);
+            size_t offset = (location / page_size) * page_size;
+            m_map_len = n*row_size + (location - offset);
+            m_map = mmap(NULL, m_map_len, PROT_READ, MAP_SHARED, handle.fd, offset);
+            if (m_map != MAP_FAILED)
+                {
+                // rows are always visited in increasing order
+                posix_madvise(m_map, m_map_len, POSIX_MADV_SEQUENTIAL);
+                m_data = (const char *)m_map + (location - offset);
+                }
+            else
+                {
+                m_buffer.resize(n*row_size);
+                size_t n_read = 0;
+                while (n_read < m_buffer.size())
+                    {
+                    ssize_t retval = pread(handle.fd, m_buffer.data() + n_read, m_buffer.size() - n_read,
+                                           location + n_read);
+                    if (retval <= 0)
+                        throw runtime_error("Error reading GSD file");
+                    n_read += retval;
+                    }
+                m_data = m_buffer.data();
+                }
+            }
+
+        ~MappedChunk()
+            {
+            if (m_map != MAP_FAILED)
+                munmap(m_map, m_map_len);
+            }
+
+        MappedChunk(const MappedChunk&) = delete;
+        MappedChunk& operator=(const MappedChunk&) = delete;
+
+        //! Get the data of the first mapped row
+        const char *getData() const
+            {
+            return m_data;
+            }
+
+    private:
+        void *m_map;                //!< Mapped pages (MAP_FAILED if not mapped)
+        size_t m_map_len;           //!< Length of the mapping
+        const char *m_data;         //!< Start of the row data
+        std::vector<char> m_buffer; //!< Row data when it could not be mapped
+    };
+
+#ifdef ENABLE_MPI
+//! Determine the rank that owns a particle, with the same wrapping as ParticleData::initializeFromSnapshot
+/*! \param global_box The global simulation box
+    \param decomposition The domain decomposition
+    \param cart_ranks Map of cartesian domain indices to ranks
+    \param pos Position of the particle, wrapped if it lies on the upper boundary
+    \param img Image of the particle, updated if the particle is wrapped
+*/
+unsigned int placeSnapshotParticle(const BoxDim& global_box,
+                                   DomainDecomposition& decomposition,
+                                   const unsigned int *cart_ranks,
+                                   Scalar3& pos,
+                                   int3& img)
+    {
+    const Index3D& di = decomposition.getDomainIndexer();
+    Scalar3 f = global_box.makeFraction(pos);
+    int i = f.x * ((Scalar)di.getW());
+    int j = f.y * ((Scalar)di.getH());
+    int k = f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        flags.x = 1;
+    if (j == (int) di.getH())
+        flags.y = 1;
+    if (k == (int) di.getD())
+        flags.z = 1;
+
+    if (flags.x || flags.y || flags.z)
+        {
+        BoxDim box = global_box;
+        box.setPeriodic(make_uchar3(flags.x,flags.y,flags.z));
+        box.wrap(pos, img, flags);
+        }
+
+    return decomposition.placeParticle(global_box, pos, cart_ranks);
+    }
+
+//! One particle read from the file, sent to the rank that owns it
+struct gsd_particle
+    {
+    vec3<float> pos;            //!< Position
+    vec3<float> vel;            //!< Velocity
+    quat<float> orientation;    //!< Orientation
+    quat<float> angmom;         //!< Angular momentum
+    vec3<float> inertia;        //!< Moments of inertia
+    int3 image;                 //!< Image
+    float mass;                 //!< Mass
+    float charge;               //!< Charge
+    float diameter;             //!< Diameter
+    unsigned int type;          //!< Type id
+    unsigned int body;          //!< Body id
+    unsigned int tag;           //!< Row in the file
+    };
+#endif
+}
+
+/*! \param data Pointer to the output, with room for \a n rows
+    \param name Name of the per-particle data chunk
+    \param row_size Size of one row in bytes
+    \param first First row to copy
+    \param n Number of rows to copy
+
+    Follows the same rules as readChunk(): a chunk missing in the current frame is read from frame 0, and a chunk
+    with a different N is ignored. Only the pages holding the selected rows are read from disk.
+
+    \returns true if the rows were read from the file
+*/
+bool GSDReader::readRows(void *data, const char *name, size_t row_size, unsigned int first, unsigned int n)
+    {
+    const struct gsd_index_entry* entry = findChunk(m_frame, name);
+    if (entry == NULL || entry->N != m_N)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading rows " << first << " to " << first + n
+                                << " of chunk " << name << endl;
+    size_t actual_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << row_size << " bytes per row in " << name
+                                  << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    MappedChunk chunk(m_handle, entry, first, n);
+    if (n > 0)
+        memcpy(data, chunk.getData(), n*row_size);
+
+    return true;
+    }
+
+/*! \param decomposition The domain decomposition of the simulation (may be NULL)
+
+    Collective call in distributed mode. Without a domain decomposition, the root rank reads all particles as usual.
+    Otherwise every rank reads an equal, contiguous slab of rows from each per-particle chunk, places the particles
+    in the domains with the same wrapping as ParticleData::initializeFromSnapshot, and sends them to their owners in
+    a single all to all exchange. Every rank ends up with the particles in its domain, with their index in the file as
+    the tag.
+*/
+void GSDReader::readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    if (!m_distributed)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: readLocalParticles requires a distributed reader" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    if (!decomposition)
+        {
+        if (m_exec_conf->isRoot())
+            readParticles();
+        return;
+        }
+
+    #ifdef ENABLE_MPI
+    const BoxDim& global_box = m_snapshot->global_box;
+    const unsigned int my_rank = m_exec_conf->getRank();
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    SnapshotParticleData<float>& snap = m_snapshot->particle_data;
+
+    const struct gsd_index_entry* entry = findChunk(m_frame, "particles/position");
+    if (entry == NULL || entry->N != m_N)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: particles/position is required to read the particles "
+                                  << "in parallel" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    // the rows [first, first+n_slab) are read by this rank
+    const unsigned int first = (unsigned int)(uint64_t(m_N) * my_rank / n_ranks);
+    const unsigned int n_slab = (unsigned int)(uint64_t(m_N) * (my_rank + 1) / n_ranks) - first;
+
+    m_exec_conf->msg->notice(4) << "data.gsd_snapshot: rank " << my_rank << " reads rows " << first << " to "
+                                << first + n_slab << endl;
+
+    // the snapshot already has default values, if a chunk is not found, the value
+    // is already at the default, and the failed read is not a problem
+    SnapshotParticleData<float> slab(n_slab);
+    readRows(slab.type.data(), "particles/typeid", 4, first, n_slab);
+    readRows(slab.mass.data(), "particles/mass", 4, first, n_slab);
+    readRows(slab.charge.data(), "particles/charge", 4, first, n_slab);
+    readRows(slab.diameter.data(), "particles/diameter", 4, first, n_slab);
+    readRows(slab.body.data(), "particles/body", 4, first, n_slab);
+    readRows(slab.inertia.data(), "particles/moment_inertia", 12, first, n_slab);
+    readRows(slab.pos.data(), "particles/position", 12, first, n_slab);
+    readRows(slab.orientation.data(), "particles/orientation", 16, first, n_slab);
+    readRows(slab.vel.data(), "particles/velocity", 12, first, n_slab);
+    readRows(slab.angmom.data(), "particles/angmom", 16, first, n_slab);
+    readRows(slab.image.data(), "particles/image", 12, first, n_slab);
+
+    // place the particles of the slab and group them by their owner
+    std::vector<unsigned int> owner(n_slab);
+    std::vector<int> n_send(n_ranks, 0);
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host,
+                                               access_mode::read);
+        for (unsigned int i = 0; i < n_slab; i++)
+            {
+            Scalar3 p = vec_to_scalar3(slab.pos[i]);
+            int3 img = slab.image[i];
+            owner[i] = placeSnapshotParticle(global_box, *decomposition, h_cart_ranks.data, p, img);
+            slab.pos[i] = vec3<float>(p);
+            slab.image[i] = img;
+            n_send[owner[i]]++;
+            }
+        }
+
+    std::vector<int> send_offset(n_ranks, 0);
+    for (unsigned int r = 1; r < n_ranks; r++)
+        send_offset[r] = send_offset[r-1] + n_send[r-1];
+
+    std::vector<gsd_particle> send_buf(n_slab);
+        {
+        std::vector<int> pos_in_buf(send_offset);
+        for (unsigned int i = 0; i < n_slab; i++)
+            {
+            gsd_particle& q = send_buf[pos_in_buf[owner[i]]++];
+            q.pos = slab.pos[i];
+            q.vel = slab.vel[i];
+            q.orientation = slab.orientation[i];
+            q.angmom = slab.angmom[i];
+            q.inertia = slab.inertia[i];
+            q.image = slab.image[i];
+            q.mass = slab.mass[i];
+            q.charge = slab.charge[i];
+            q.diameter = slab.diameter[i];
+            q.type = slab.type[i];
+            q.body = slab.body[i];
+            q.tag = first + i;
+            }
+        }
+
+    // exchange the particles, the slabs are in rank order, so the received tags are sorted
+    std::vector<int> n_recv(n_ranks, 0);
+    MPI_Alltoall(n_send.data(), 1, MPI_INT, n_recv.data(), 1, MPI_INT, mpi_comm);
+    std::vector<int> recv_offset(n_ranks, 0);
+    for (unsigned int r = 1; r < n_ranks; r++)
+        recv_offset[r] = recv_offset[r-1] + n_recv[r-1];
+    unsigned int n_local = recv_offset[n_ranks-1] + n_recv[n_ranks-1];
+
+    std::vector<gsd_particle> recv_buf(n_local);
+    MPI_Datatype mpi_particle;
+    MPI_Type_contiguous(sizeof(gsd_particle), MPI_BYTE, &mpi_particle);
+    MPI_Type_commit(&mpi_particle);
+    MPI_Alltoallv(send_buf.data(), n_send.data(), send_offset.data(), mpi_particle,
+                  recv_buf.data(), n_recv.data(), recv_offset.data(), mpi_particle, mpi_comm);
+    MPI_Type_free(&mpi_particle);
+
+    // every particle must be placed on exactly one rank
+    unsigned int n_placed = n_local;
+    MPI_Allreduce(MPI_IN_PLACE, &n_placed, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (n_placed != m_N)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: placed " << n_placed << " of " << m_N << " particles" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    m_exec_conf->msg->notice(4) << "data.gsd_snapshot: rank " << my_rank << " owns " << n_local << " particles"
+                                << endl;
+
+    snap.resize(n_local);
+    std::vector<unsigned int> tags(n_local);
+    for (unsigned int i = 0; i < n_local; i++)
+        {
+        const gsd_particle& q = recv_buf[i];
+        snap.pos[i] = q.pos;
+        snap.vel[i] = q.vel;
+        snap.orientation[i] = q.orientation;
+        snap.angmom[i] = q.angmom;
+        snap.inertia[i] = q.inertia;
+        snap.image[i] = q.image;
+        snap.mass[i] = q.mass;
+        snap.charge[i] = q.charge;
+        snap.diameter[i] = q.diameter;
+        snap.type[i] = q.type;
+        snap.body[i] = q.body;
+        tags[i] = q.tag;
+        }
+
+    m_snapshot->particle_tags = tags;
+    m_snapshot->particles_local = true;
+    #endif
+    }
+
 pybind11::list GSDReader::readTypeShapesPy(uint64_t frame)
     {
     std::vector<std::string> type_mapping = this->readTypes(frame, "particles/type_shapes");
@@ -360,9 +698,12 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
     .def("readTypeShapesPy", &GSDReader::readTypeShapesPy)
+    .def("readLocalParticles", &GSDReader::readLocalParticles)
+    .def("isDistributed", &GSDReader::isDistributed)
     ;
     }
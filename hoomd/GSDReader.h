@@ -30,6 +30,15 @@ template <class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    By default, only the root rank opens the file and reads the whole frame, which ParticleData then scatters to the
+    other ranks. In distributed mode, every rank opens the file. The chunk index is memory mapped by gsd_open and
+    searched with a binary search, so only the pages touched by the lookups are read from disk, independent of the
+    number of frames in the file. After the domain decomposition is known, readLocalParticles() has each rank read an
+    equal slab of rows from every per-particle chunk through a read only memory map and send the particles to the
+    ranks that own them. The resulting snapshot holds the local particles with their tags (see
+    SnapshotSystemData::particles_local), so no rank ever holds or reads all particles and nothing is scattered from
+    rank 0. Bonded groups are still read on the root rank.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -39,7 +48,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -70,6 +80,15 @@ class PYBIND11_EXPORT GSDReader
             return m_frame;
             }
 
+        //! Read the particles in the local domain on every rank (distributed mode)
+        void readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition);
+
+        //! Test if the reader was opened in distributed mode
+        bool isDistributed() const
+            {
+            return m_distributed;
+            }
+
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
@@ -94,10 +113,19 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if every rank reads the file
+        bool m_is_open;                                              //!< True if this rank opened the file
+        unsigned int m_N;                                            //!< Number of particles in the frame
+
+        //! Find a chunk in the given frame, falling back to frame 0
+        const struct gsd_index_entry* findChunk(uint64_t frame, const char *name);
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
 
+        //! Copy a contiguous range of rows of a per-particle chunk
+        bool readRows(void *data, const char *name, size_t row_size, unsigned int first, unsigned int n);
+
         // helper functions to read sections of the file
         void readHeader();
         void readParticles();
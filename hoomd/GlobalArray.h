@@ -91,7 +91,7 @@ class managed_deleter
     public:
         //! Default constructor
         managed_deleter()
-            : m_use_device(false), m_N(0), m_allocation_ptr(nullptr), m_allocation_bytes(0)
+            : m_use_device(false), m_N(0), m_allocation_ptr(nullptr), m_allocation_bytes(0), m_pooled(false)
             {}
 
         //! Ctor
@@ -100,11 +100,12 @@ class managed_deleter
             \param N number of elements
             \param allocation_ptr true start of allocation, before alignment
             \param allocation_bytes Size of allocation
+            \param pooled true if the host memory was obtained from the host memory pool
          */
         managed_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf,
-            bool use_device, std::size_t N, void *allocation_ptr, size_t allocation_bytes)
+            bool use_device, std::size_t N, void *allocation_ptr, size_t allocation_bytes, bool pooled=false)
             : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N),
-            m_allocation_ptr(allocation_ptr), m_allocation_bytes(allocation_bytes)
+            m_allocation_ptr(allocation_ptr), m_allocation_bytes(allocation_bytes), m_pooled(pooled)
             { }
 
         //! Set the tag
@@ -159,6 +160,11 @@ class managed_deleter
                 }
             else
             #endif
+            if (m_pooled)
+                {
+                m_exec_conf->getHostMemoryPool()->deallocate(m_allocation_ptr, m_allocation_bytes);
+                }
+            else
                 {
                 free(m_allocation_ptr);
                 }
@@ -175,6 +181,7 @@ class managed_deleter
         unsigned int m_N;      //!< Number of elements in array
         void *m_allocation_ptr;  //!< Start of unaligned allocation
         size_t m_allocation_bytes; //!< Size of actual allocation
+        bool m_pooled;         //!< True if the allocation belongs to the host memory pool
         std::string m_tag;     //!< Name of the array
     };
 
@@ -696,6 +703,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             void *ptr = nullptr;
             void *allocation_ptr = nullptr;
             bool use_device = this->m_exec_conf && this->m_exec_conf->isCUDAEnabled();
+            bool pooled = false;
             size_t allocation_bytes;
 
             #ifdef ENABLE_HIP
@@ -731,8 +739,8 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             else
             #endif
                 {
-                int retval = posix_memalign((void **) &ptr, 32, m_num_elements*sizeof(T));
-                if (retval != 0)
+                ptr = hoomd::detail::allocate_host_memory(this->m_exec_conf, m_num_elements*sizeof(T), pooled);
+                if (ptr == nullptr)
                     {
                     throw std::runtime_error("Error allocating aligned memory");
                     }
@@ -759,7 +767,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
 
             // store allocation and custom deleter in unique_ptr
             hoomd::detail::managed_deleter<T> deleter(this->m_exec_conf,use_device,
-                m_num_elements, allocation_ptr, allocation_bytes);
+                m_num_elements, allocation_ptr, allocation_bytes, pooled);
             deleter.setTag(m_tag);
             m_data = std::unique_ptr<T, decltype(deleter)>(reinterpret_cast<T *>(ptr), deleter);
 
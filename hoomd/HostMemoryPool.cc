@@ -0,0 +1,193 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file HostMemoryPool.cc
+    \brief Defines the HostMemoryPool class
+*/
+
+#include "HostMemoryPool.h"
+#include "Messenger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+//! Alignment of all blocks in bytes
+const size_t HOST_POOL_ALIGNMENT = 64;
+
+//! Smallest size class in bytes
+const size_t HOST_POOL_MIN_BLOCK = 64;
+
+//! Blocks of at least this size are first touched in parallel
+const size_t HOST_POOL_PARALLEL_TOUCH_BYTES = 1024*1024;
+
+//! Granularity of the parallel first touch (a typical page size)
+const size_t HOST_POOL_TOUCH_CHUNK = 4096;
+
+HostMemoryPool::HostMemoryPool(size_t max_cached_bytes)
+    : m_max_cached_bytes(max_cached_bytes), m_bytes_cached(0), m_bytes_in_use(0), m_peak_bytes(0),
+      m_num_hits(0), m_num_misses(0)
+    {
+    }
+
+HostMemoryPool::~HostMemoryPool()
+    {
+    releaseCache();
+    }
+
+/*! \param num_bytes Requested size
+    \returns The size of the block that serves the request
+
+    Classes are 64 bytes and then four evenly spaced sizes in every interval (2^p, 2^(p+1)].
+*/
+size_t HostMemoryPool::roundToSizeClass(size_t num_bytes)
+    {
+    if (num_bytes <= HOST_POOL_MIN_BLOCK)
+        return HOST_POOL_MIN_BLOCK;
+
+    // find p with 2^p < num_bytes <= 2^(p+1)
+    unsigned int p = 0;
+    while ((size_t(2) << p) < num_bytes)
+        p++;
+
+    const size_t base = size_t(1) << p;
+    const size_t step = base >> 2;
+    const size_t k = (num_bytes - base + step - 1) / step;
+    return base + k*step;
+    }
+
+/*! \param num_bytes Number of bytes to allocate
+    \returns A 64 byte aligned block of at least \a num_bytes
+*/
+void *HostMemoryPool::allocate(size_t num_bytes)
+    {
+    const size_t block_bytes = roundToSizeClass(num_bytes);
+
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bytes_in_use += block_bytes;
+
+        auto it = m_free.find(block_bytes);
+        if (it != m_free.end() && !it->second.empty())
+            {
+            void *ptr = it->second.back();
+            it->second.pop_back();
+            m_bytes_cached -= block_bytes;
+            m_num_hits++;
+            return ptr;
+            }
+
+        m_num_misses++;
+        m_peak_bytes = std::max(m_peak_bytes, m_bytes_in_use + m_bytes_cached);
+        }
+
+    void *ptr = nullptr;
+    int retval = posix_memalign(&ptr, HOST_POOL_ALIGNMENT, block_bytes);
+    if (retval != 0)
+        {
+        // give the cache back to the system and try once more
+        releaseCache();
+        retval = posix_memalign(&ptr, HOST_POOL_ALIGNMENT, block_bytes);
+        }
+
+    if (retval != 0)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bytes_in_use -= block_bytes;
+        throw std::runtime_error("Error allocating aligned memory");
+        }
+
+    // first touch the pages from the threads that will later work on them
+    #ifdef ENABLE_TBB
+    if (block_bytes >= HOST_POOL_PARALLEL_TOUCH_BYTES)
+        {
+        char *bytes = reinterpret_cast<char *>(ptr);
+        const size_t n_chunks = (block_bytes + HOST_POOL_TOUCH_CHUNK - 1) / HOST_POOL_TOUCH_CHUNK;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n_chunks),
+            [&](const tbb::blocked_range<size_t>& r)
+            {
+            const size_t begin = r.begin()*HOST_POOL_TOUCH_CHUNK;
+            const size_t end = std::min(r.end()*HOST_POOL_TOUCH_CHUNK, block_bytes);
+            memset(bytes + begin, 0, end - begin);
+            });
+        }
+    #endif
+
+    return ptr;
+    }
+
+/*! \param ptr Block returned by allocate()
+    \param num_bytes Size that was passed to allocate()
+*/
+void HostMemoryPool::deallocate(void *ptr, size_t num_bytes)
+    {
+    if (ptr == nullptr)
+        return;
+
+    const size_t block_bytes = roundToSizeClass(num_bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bytes_in_use -= block_bytes;
+
+    m_free[block_bytes].push_back(ptr);
+    m_bytes_cached += block_bytes;
+
+    if (m_bytes_cached > m_max_cached_bytes)
+        trimCache();
+    }
+
+void HostMemoryPool::releaseCache()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_free.begin(); it != m_free.end(); ++it)
+        {
+        for (auto ptr : it->second)
+            free(ptr);
+        it->second.clear();
+        }
+    m_free.clear();
+    m_bytes_cached = 0;
+    }
+
+/*! \param max_cached_bytes Maximum total size of the cached free blocks
+*/
+void HostMemoryPool::setMaxCachedBytes(size_t max_cached_bytes)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_cached_bytes = max_cached_bytes;
+    trimCache();
+    }
+
+/*! The largest blocks are released first, since the small classes see the most reuse.
+    \pre m_mutex is held
+*/
+void HostMemoryPool::trimCache()
+    {
+    for (auto it = m_free.rbegin(); it != m_free.rend() && m_bytes_cached > m_max_cached_bytes; ++it)
+        {
+        while (!it->second.empty() && m_bytes_cached > m_max_cached_bytes)
+            {
+            free(it->second.back());
+            it->second.pop_back();
+            m_bytes_cached -= it->first;
+            }
+        }
+    }
+
+/*! \param msg Messenger to print to
+*/
+void HostMemoryPool::printStats(std::shared_ptr<Messenger> msg) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t n_requests = m_num_hits + m_num_misses;
+    msg->notice(2) << "Host memory pool: " << n_requests << " allocations, " << m_num_hits << " served from the cache ("
+                   << (n_requests ? 100.0*double(m_num_hits)/double(n_requests) : 0.0) << "%)" << std::endl;
+    msg->notice(2) << "Host memory pool: " << double(m_bytes_in_use)/1024.0/1024.0 << " MB in use, "
+                   << double(m_bytes_cached)/1024.0/1024.0 << " MB cached, peak "
+                   << double(m_peak_bytes)/1024.0/1024.0 << " MB" << std::endl;
+    }
@@ -0,0 +1,109 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file HostMemoryPool.h
+    \brief Declares a pooled allocator for host memory
+*/
+
+#ifndef __HOST_MEMORY_POOL_H__
+#define __HOST_MEMORY_POOL_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Messenger;
+
+//! Pooled allocator for the host memory of GPUArray and GlobalArray
+/*! When running on the CPU, GPUArray and GlobalArray obtain their host memory from a HostMemoryPool owned by the
+    ExecutionConfiguration. Arrays are resized frequently (communication buffers, ghost particles, neighbor lists,
+    particle migration), and every resize used to be a fresh posix_memalign, page faults on first use and a free of the
+    old block. The pool keeps freed blocks in per size class free lists and hands them out again on the next request of
+    the same class, so steady state resizes do not touch the system allocator.
+
+    Requests are rounded up to size classes with four classes per power of two, so at most 25% of a block is unused.
+    Blocks are 64 byte aligned. Cached free blocks are released back to the system once their total size exceeds the
+    maximum cache size.
+
+    Blocks obtained from the system are first touched in parallel when HOOMD is built with TBB. On NUMA machines this
+    places the pages close to the threads that later operate on them instead of on the node of the allocating thread.
+
+    The allocator is thread safe. Statistics are printed with the memory traceback (see MemoryTraceback).
+*/
+class HostMemoryPool
+    {
+    public:
+        //! Constructor
+        /*! \param max_cached_bytes Maximum total size of the cached free blocks
+        */
+        HostMemoryPool(size_t max_cached_bytes=size_t(512)*1024*1024);
+
+        //! Destructor
+        ~HostMemoryPool();
+
+        HostMemoryPool(const HostMemoryPool&) = delete;
+        HostMemoryPool& operator=(const HostMemoryPool&) = delete;
+
+        //! Allocate a block
+        void *allocate(size_t num_bytes);
+
+        //! Return a block to the pool
+        void deallocate(void *ptr, size_t num_bytes);
+
+        //! Release all cached free blocks
+        void releaseCache();
+
+        //! Set the maximum total size of the cached free blocks
+        void setMaxCachedBytes(size_t max_cached_bytes);
+
+        //! Print the statistics of the pool
+        void printStats(std::shared_ptr<Messenger> msg) const;
+
+        //! Get the number of requests served from the cache
+        size_t getNumHits() const
+            {
+            return m_num_hits;
+            }
+
+        //! Get the number of requests that went to the system allocator
+        size_t getNumMisses() const
+            {
+            return m_num_misses;
+            }
+
+        //! Get the number of bytes handed out and not yet returned
+        size_t getBytesInUse() const
+            {
+            return m_bytes_in_use;
+            }
+
+        //! Get the number of bytes held in the free lists
+        size_t getBytesCached() const
+            {
+            return m_bytes_cached;
+            }
+
+        //! Round a request up to its size class
+        static size_t roundToSizeClass(size_t num_bytes);
+
+    private:
+        mutable std::mutex m_mutex;                         //!< Protects the free lists and the counters
+        std::map<size_t, std::vector<void *> > m_free;      //!< Cached free blocks by size class
+        size_t m_max_cached_bytes;                          //!< Maximum total size of the cached blocks
+        size_t m_bytes_cached;                              //!< Total size of the cached blocks
+        size_t m_bytes_in_use;                              //!< Total size of the blocks handed out
+        size_t m_peak_bytes;                                //!< Peak of m_bytes_in_use + m_bytes_cached
+        size_t m_num_hits;                                  //!< Number of requests served from the cache
+        size_t m_num_misses;                                //!< Number of requests that went to the system
+
+        //! Free cached blocks until the cache fits into m_max_cached_bytes
+        void trimCache();
+    };
+
+#endif
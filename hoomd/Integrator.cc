@@ -24,7 +24,9 @@ using namespace std;
 /*! \param sysdef System to update
     \param deltaT Time step to use
 */
-Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
+    : Updater(sysdef), m_deltaT(deltaT), m_force_compute_time(0), m_direct_net_force(false), m_prof_integrate(0),
+      m_prof_sum_accel(0), m_prof_net_force(0)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -239,8 +241,8 @@ void Integrator::computeAccelerations(unsigned int timestep)
 
     if (m_prof)
         {
-        m_prof->push("Integrate");
-        m_prof->push("Sum accel");
+        m_prof->push(m_prof_integrate);
+        m_prof->push(m_prof_sum_accel);
         }
 
     // now, get our own access to the arrays and calculate the accelerations
@@ -305,17 +307,25 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
           if the forces and/or integrator are on the GPU. Call computeNetForcesGPU() to sum the forces on the GPU
+
+    With direct accumulation enabled (see setDirectNetForce()), the force computes that support it add their forces
+    to the zeroed net force arrays themselves, and only the remaining force computes are summed up.
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
+    uint64_t start_time = m_force_clk.getTime();
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+        {
+        if (!(m_direct_net_force && (*force_compute)->supportsDirectAccumulation()))
+            (*force_compute)->compute(timestep);
+        }
+    m_force_compute_time += m_force_clk.getTime() - start_time;
 
     if (m_prof)
         {
-        m_prof->push("Integrate");
-        m_prof->push("Net force");
+        m_prof->push(m_prof_integrate);
+        m_prof->push(m_prof_net_force);
         }
 
     Scalar external_virial[6];
@@ -348,8 +358,34 @@ void Integrator::computeNetForce(unsigned int timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
+        if (m_direct_net_force)
+            {
+            ForceTarget target;
+            target.force = h_net_force.data;
+            target.virial = h_net_virial.data;
+            target.virial_pitch = net_virial_pitch;
+            target.torque = h_net_torque.data;
+
+            start_time = m_force_clk.getTime();
+            for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+                {
+                if ((*force_compute)->supportsDirectAccumulation())
+                    (*force_compute)->computeDirect(timestep, target);
+                }
+            m_force_compute_time += m_force_clk.getTime() - start_time;
+            }
+
         for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
             {
+            if (m_direct_net_force && (*force_compute)->supportsDirectAccumulation())
+                {
+                for (unsigned int k = 0; k < 6; k++)
+                    external_virial[k] += (*force_compute)->getExternalVirial(k);
+
+                external_energy += (*force_compute)->getExternalEnergy();
+                continue;
+                }
+
             GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
             GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
@@ -419,8 +455,8 @@ void Integrator::computeNetForce(unsigned int timestep)
 
     if (m_prof)
         {
-        m_prof->push("Integrate");
-        m_prof->push("Net force");
+        m_prof->push(m_prof_integrate);
+        m_prof->push(m_prof_net_force);
         }
 
         {
@@ -500,15 +536,17 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
 
     // compute all the normal forces first
 
+    uint64_t start_time = m_force_clk.getTime();
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->compute(timestep);
+    m_force_compute_time += m_force_clk.getTime() - start_time;
 
     if (m_prof)
         {
-        m_prof->push(m_exec_conf, "Integrate");
-        m_prof->push(m_exec_conf, "Net force");
+        m_prof->push(m_exec_conf, m_prof_integrate);
+        m_prof->push(m_exec_conf, m_prof_net_force);
         }
 
     Scalar external_virial[6];
@@ -698,8 +736,8 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
 
     if (m_prof)
         {
-        m_prof->push("Integrate");
-        m_prof->push(m_exec_conf, "Net force");
+        m_prof->push(m_prof_integrate);
+        m_prof->push(m_exec_conf, m_prof_net_force);
         }
 
         {
@@ -854,6 +892,21 @@ void Integrator::update(unsigned int timestep)
     {
     }
 
+/*! \param prof The profiler to set
+
+    The regions are looked up once here, so that they are pushed by id on every step.
+*/
+void Integrator::setProfiler(std::shared_ptr<Profiler> prof)
+    {
+    Updater::setProfiler(prof);
+    if (m_prof)
+        {
+        m_prof_integrate = m_prof->getRegion("Integrate");
+        m_prof_sum_accel = m_prof->getRegion("Sum accel");
+        m_prof_net_force = m_prof->getRegion("Net force");
+        }
+    }
+
 /*! prepRun() is to be called at the very beginning of each run, before any analyzers are called, but after the full
     simulation is defined. It allows the integrator to perform any one-off setup tasks and update net_force and
     net_virial, if needed.
@@ -911,10 +964,12 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
 void Integrator::computeCallback(unsigned int timestep)
     {
     // pre-compute all active forces
+    uint64_t start_time = m_force_clk.getTime();
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->preCompute(timestep);
+    m_force_compute_time += m_force_clk.getTime() - start_time;
     }
 #endif
 
@@ -945,6 +1000,8 @@ void export_Integrator(py::module& m)
     .def("removeForceComputes", &Integrator::removeForceComputes)
     .def("removeHalfStepHook", &Integrator::removeHalfStepHook)
     .def("setDeltaT", &Integrator::setDeltaT)
+    .def("setDirectNetForce", &Integrator::setDirectNetForce)
+    .def("getDirectNetForce", &Integrator::getDirectNetForce)
     .def("getNDOF", &Integrator::getNDOF)
     .def("getRotationalNDOF", &Integrator::getRotationalNDOF)
     ;
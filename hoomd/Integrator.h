@@ -20,6 +20,7 @@
 #include "ForceConstraint.h"
 #include "HalfStepHook.h"
 #include "ParticleGroup.h"
+#include "ClockSource.h"
 #include <string>
 #include <vector>
 #include <pybind11/pybind11.h>
@@ -129,6 +130,9 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Sets the profiler for the integrator to use
+        virtual void setProfiler(std::shared_ptr<Profiler> prof);
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -139,6 +143,34 @@ class PYBIND11_EXPORT Integrator : public Updater
         void computeCallback(unsigned int timestep);
         #endif
 
+        //! Set whether force computes accumulate directly into the net force
+        /*! \param direct True to let the force computes that support it add their forces directly to the net force
+
+            Direct accumulation only applies to computeNetForce() on the CPU. The per particle arrays of these force
+            computes are released and only evaluated again when per particle data is requested from them.
+        */
+        void setDirectNetForce(bool direct)
+            {
+            m_direct_net_force = direct;
+            }
+
+        //! Get whether force computes accumulate directly into the net force
+        bool getDirectNetForce() const
+            {
+            return m_direct_net_force;
+            }
+
+        //! Get the total wall clock time spent computing forces
+        /*! \returns Time in nanoseconds, summed over all calls since construction
+
+            The time includes the neighbor list builds triggered by the force computes. On the GPU, kernels run
+            asynchronously and only the time to launch them is counted.
+        */
+        uint64_t getForceComputeTime() const
+            {
+            return m_force_compute_time;
+            }
+
     protected:
         Scalar m_deltaT;                                            //!< The time step
         std::vector< std::shared_ptr<ForceCompute> > m_forces;    //!< List of all the force computes
@@ -147,6 +179,14 @@ class PYBIND11_EXPORT Integrator : public Updater
 
         std::shared_ptr<HalfStepHook> m_half_step_hook;    //!< The HalfStepHook, if active
 
+        ClockSource m_force_clk;                //!< Clock to measure the time spent computing forces
+        uint64_t m_force_compute_time;          //!< Total time spent computing forces (ns)
+        bool m_direct_net_force;                //!< True if force computes accumulate directly into the net force
+
+        unsigned int m_prof_integrate;          //!< Profiler region "Integrate"
+        unsigned int m_prof_sum_accel;          //!< Profiler region "Sum accel"
+        unsigned int m_prof_net_force;          //!< Profiler region "Net force"
+
 
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
@@ -33,8 +33,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
         : Updater(sysdef), m_decomposition(decomposition), m_mpi_comm(m_exec_conf->getMPICommunicator()),
           m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
           m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-          m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
-          m_n_iterations(0), m_n_rebalances(0)
+          m_weight_mode(particles), m_damping(Scalar(0.5)), m_N_own(m_pdata->getN()), m_cost(Scalar(1.0)),
+          m_total_load(Scalar(m_pdata->getNGlobal())), m_has_cost(false), m_has_last_time(false), m_last_time(0),
+          m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0), m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
 
@@ -66,6 +67,9 @@ void LoadBalancer::update(unsigned int timestep)
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
+    // measure the cost of the particles on this rank
+    updateCost(timestep);
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -112,17 +116,17 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> W_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(W_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, W_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -154,13 +158,61 @@ void LoadBalancer::update(unsigned int timestep)
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \param timestep Current time step of the simulation
+ *
+ * In the \c compute_time mode, the force compute time of the integrator since the last call is divided by the number
+ * of local particles. The result is normalized by the average time per particle over all ranks and blended with the
+ * previous cost using the damping factor. Ranks without particles use the average cost. Without a measurement (first
+ * call, no integrator, or no time spent computing forces), every particle costs 1 and the load is the particle count.
+ *
+ * \post m_cost holds the cost per particle on this rank and m_total_load the sum of the loads of all ranks.
+ */
+void LoadBalancer::updateCost(unsigned int timestep)
+    {
+    if (m_weight_mode == particles || !m_integrator)
+        {
+        m_cost = Scalar(1.0);
+        m_total_load = Scalar(m_pdata->getNGlobal());
+        m_has_cost = false;
+        return;
+        }
+
+    // time spent on this rank since the last update
+    const uint64_t cur_time = m_integrator->getForceComputeTime();
+    double local[2];
+    local[0] = (m_has_last_time && cur_time >= m_last_time) ? double(cur_time - m_last_time) : 0.0;
+    local[1] = double(m_pdata->getN());
+    m_last_time = cur_time;
+    m_has_last_time = true;
+
+    double global[2];
+    MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+    if (global[0] > 0.0 && global[1] > 0.0)
+        {
+        const double avg_cost = global[0] / global[1];
+        const Scalar measured = (local[1] > 0.0) ? Scalar(local[0] / local[1] / avg_cost) : Scalar(1.0);
+
+        m_cost = m_has_cost ? m_damping * m_cost + (Scalar(1.0) - m_damping) * measured : measured;
+        m_has_cost = true;
+        }
+    else if (!m_has_cost)
+        {
+        m_cost = Scalar(1.0);
+        }
+
+    Scalar load = m_cost * Scalar(m_pdata->getN());
+    MPI_Allreduce(&load, &m_total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+    }
+
+/*!
+ * Computes the imbalance factor I = W / <W> for each rank, and computes the maximum among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoad() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -175,34 +227,34 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param W_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a W_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a W_i holds the load (see getLoad()) of each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
  *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
- *       actually needs to allocate memory for \a N_i.
+ *       actually needs to allocate memory for \a W_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a reduce_root. This
  * operation may be suboptimal for very large numbers of processors, and could be replaced by cascading send operations
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& W_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1) return false;
+    if (W_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> W_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar W_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&W_own, 1, MPI_HOOMD_SCALAR, &W_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -210,62 +262,62 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> W_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        W_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = W_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear(); N_i.resize(di.getW());
+        W_i.clear(); W_i.resize(di.getW());
         for (unsigned int i=0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            W_i[i] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int j=0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i,j,k)];
+                    W_i[i] += W_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear(); N_i.resize(di.getH());
+        W_i.clear(); W_i.resize(di.getH());
         for (unsigned int j=0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            W_i[j] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i,j,k)];
+                    W_i[j] += W_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear(); N_i.resize(di.getD());
+        W_i.clear(); W_i.resize(di.getD());
         for (unsigned int k=0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            W_i[k] = Scalar(0.0);
             for (unsigned int j=0; j < di.getH(); ++j)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i,j,k)];
+                    W_i[k] += W_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
         }
     else
         {
-        m_exec_conf->msg->error() << "comm.balance: unknown dimension for particle reduction" << endl;
-        throw runtime_error("Unknown dimension for particle reduction");
+        m_exec_conf->msg->error() << "comm.balance: unknown dimension for load reduction" << endl;
+        throw runtime_error("Unknown dimension for load reduction");
         }
 
     return true;
@@ -273,7 +325,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param W_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -291,30 +343,30 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& W_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per slice is uniform distribution
+    const Scalar target = m_total_load / Scalar(W_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(W_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i=0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(W_i.size());
+    for (unsigned int i=0; i < W_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
-        Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+        const Scalar imb_factor = W_i[i] / target;
+        Scalar scale_factor = (W_i[i] > Scalar(0.0)) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
@@ -334,7 +386,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to enforce the inequality
     // constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = N_i.size();
+    unsigned int m = W_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2*m,n+m);
     A(0,0) = 1.0; A(m,0) = eps;
@@ -571,13 +623,24 @@ void LoadBalancer::resetStats()
 
 void export_LoadBalancer(py::module& m)
     {
-    py::class_<LoadBalancer, Updater, std::shared_ptr<LoadBalancer> >(m,"LoadBalancer")
-    .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    py::class_<LoadBalancer, Updater, std::shared_ptr<LoadBalancer> > loadbalancer(m,"LoadBalancer");
+    loadbalancer.def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
     .def("enableDimension", &LoadBalancer::enableDimension)
     .def("getTolerance", &LoadBalancer::getTolerance)
     .def("setTolerance", &LoadBalancer::setTolerance)
     .def("getMaxIterations", &LoadBalancer::getMaxIterations)
     .def("setMaxIterations", &LoadBalancer::setMaxIterations)
+    .def("setWeightMode", &LoadBalancer::setWeightMode)
+    .def("getWeightMode", &LoadBalancer::getWeightMode)
+    .def("setDamping", &LoadBalancer::setDamping)
+    .def("getDamping", &LoadBalancer::getDamping)
+    .def("setIntegrator", &LoadBalancer::setIntegrator)
+    ;
+
+    py::enum_<LoadBalancer::weightMode>(loadbalancer,"weightMode")
+    .value("particles", LoadBalancer::weightMode::particles)
+    .value("compute_time", LoadBalancer::weightMode::compute_time)
+    .export_values()
     ;
     }
 #endif // ENABLE_MPI
@@ -17,6 +17,7 @@
 #ifndef __LOADBALANCER_H__
 #define __LOADBALANCER_H__
 #include "Updater.h"
+#include "Integrator.h"
 
 #include <memory>
 #include <pybind11/pybind11.h>
@@ -27,8 +28,15 @@
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between them. The load imbalance
- * is defined as the number of particles owned by a rank divided by the average number of particles per rank if the
- * particles had a uniform distribution.
+ * is defined as the load of a rank divided by the average load per rank.
+ *
+ * By default, the load of a rank is the number of particles it owns. With the \c compute_time weight mode, each
+ * particle carries a cost that is measured from the time the Integrator spent computing forces (including neighbor
+ * list builds) since the previous update, divided by the number of particles on the rank and normalized by the average
+ * over all ranks. The load of a rank is then its cost per particle times the number of particles it owns, so that
+ * particles moving to a rank during balancing are assumed to cost as much as the ones already there. Measurements
+ * are smoothed with an exponential moving average (see setDamping()) so that timing noise does not move the domain
+ * boundaries back and forth.
  *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load balance, subject to the
  * following constraints that are imposed to both maintain a stable balancing and to keep communication isolated to the
@@ -50,6 +58,55 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         //! Destructor
         virtual ~LoadBalancer();
 
+        //! Quantities that define the load of a rank
+        enum weightMode
+            {
+            particles = 0,  //!< Number of owned particles
+            compute_time    //!< Number of owned particles weighted by the measured force compute time
+            };
+
+        //! Set the quantity that defines the load of a rank
+        void setWeightMode(weightMode mode)
+            {
+            m_weight_mode = mode;
+            m_has_last_time = false;
+            m_has_cost = false;
+            }
+
+        //! Get the quantity that defines the load of a rank
+        weightMode getWeightMode() const
+            {
+            return m_weight_mode;
+            }
+
+        //! Set the damping of the measured cost
+        /*!
+         * \param damping Weight of the previous cost in the moving average (0 uses only the latest measurement)
+         */
+        void setDamping(Scalar damping)
+            {
+            if (damping < Scalar(0.0) || damping >= Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "comm.balance: damping must be in [0,1)" << std::endl;
+                throw std::runtime_error("Error setting load balancer parameters");
+                }
+            m_damping = damping;
+            }
+
+        //! Get the damping of the measured cost
+        Scalar getDamping() const
+            {
+            return m_damping;
+            }
+
+        //! Set the integrator whose force compute time is measured
+        void setIntegrator(std::shared_ptr<Integrator> integrator)
+            {
+            if (integrator != m_integrator)
+                m_has_last_time = false;
+            m_integrator = integrator;
+            }
+
         //! Get the tolerance for load balancing
         Scalar getTolerance() const
             {
@@ -118,8 +175,17 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the loads per rank down to one dimension
+        bool reduce(std::vector<Scalar>& W_i, unsigned int dim, unsigned int reduce_root);
+
+        //! Measure the cost per particle and the total load
+        void updateCost(unsigned int timestep);
+
+        //! Gets the load of this rank
+        Scalar getLoad()
+            {
+            return m_cost * Scalar(getNOwn());
+            }
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -131,7 +197,7 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& W_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
@@ -169,9 +235,19 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         const Scalar m_max_scale;   //!< Maximum fraction to rescale either direction (5%)
 
+        weightMode m_weight_mode;                   //!< Quantity that defines the load
+        Scalar m_damping;                           //!< Weight of the previous cost in the moving average
+        std::shared_ptr<Integrator> m_integrator;   //!< Integrator whose force compute time is measured
+
     private:
         unsigned int m_N_own;               //!< Number of particles owned by this rank
 
+        Scalar m_cost;                      //!< Cost per particle on this rank (relative to the average)
+        Scalar m_total_load;                //!< Total load of all ranks
+        bool m_has_cost;                    //!< True if m_cost holds a measurement
+        bool m_has_last_time;               //!< True if m_last_time is valid
+        uint64_t m_last_time;               //!< Force compute time of the integrator at the last update
+
         Scalar m_max_max_imbalance;     //!< The maximum imbalance of any check
         double m_total_max_imbalance;   //!< The average imbalance over checks
         uint64_t m_n_calls;             //!< The number of times the updater was called
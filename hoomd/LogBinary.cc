@@ -0,0 +1,311 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.cc
+    \brief Defines the LogBinary class
+*/
+
+#include "LogBinary.h"
+#include "Filesystem.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+namespace py = pybind11;
+
+#include <stdexcept>
+using namespace std;
+
+//! Number of chunks in the ring buffer
+const unsigned int LOG_BINARY_RING_SIZE = 4;
+
+//! Magic string at the start of every binary log file
+const char LOG_BINARY_MAGIC[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'O', 'L'};
+
+//! Version of the binary log file format
+const uint32_t LOG_BINARY_VERSION = 1;
+
+//! Block tags in the binary log file
+const uint32_t LOG_BINARY_SCHEMA = 1;
+const uint32_t LOG_BINARY_DATA = 2;
+
+/*! \param sysdef Specified for Logger, but not used directly by Logger
+    \param fname File name to write the log to
+    \param chunk_size Number of rows buffered per chunk
+    \param overwrite Will overwrite an exiting file if true (default is to append)
+*/
+LogBinary::LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                     const std::string& fname,
+                     unsigned int chunk_size,
+                     bool overwrite)
+    : Logger(sysdef), m_filename(fname), m_chunk_size(chunk_size), m_appending(!overwrite), m_file_output(true),
+      m_active(0), m_n_columns(0), m_stop(false), m_write_error(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LogBinary: " << fname << " " << chunk_size << " " << overwrite
+                                << endl;
+
+    if (m_chunk_size == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: chunk_size must be positive" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+#ifdef ENABLE_MPI
+    // only output to file on root processor
+    if (m_exec_conf->getNRanks() > 1 && !m_exec_conf->isRoot())
+        m_file_output = false;
+#endif
+
+    if (m_file_output)
+        openOutputFile();
+
+    allocateChunks();
+    }
+
+LogBinary::~LogBinary()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LogBinary" << endl;
+
+    if (!m_file_output)
+        return;
+
+    // write out everything that is still buffered, then stop the writer
+    if (m_ring[m_active].n_rows > 0)
+        submitActiveChunk();
+
+    // the writer thread exits once the queue is empty
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    lock.unlock();
+    m_cond.notify_all();
+    m_writer.join();
+
+    m_file.flush();
+    }
+
+void LogBinary::openOutputFile()
+    {
+    // open the file
+    if (filesystem::exists(m_filename) && m_appending)
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Appending log to existing file \"" << m_filename << "\""
+                                    << endl;
+        m_file.open(m_filename.c_str(), ios_base::out | ios_base::binary | ios_base::app);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Creating new log in file \"" << m_filename << "\""
+                                    << endl;
+        m_file.open(m_filename.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+        m_appending = false;
+
+        m_file.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+        m_file.write((const char *)&LOG_BINARY_VERSION, sizeof(uint32_t));
+        }
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: Error opening log file " << m_filename << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    m_writer = std::thread(&LogBinary::writerLoop, this);
+    }
+
+/*! All chunks must be idle when this is called.
+*/
+void LogBinary::allocateChunks()
+    {
+    m_n_columns = (unsigned int)m_logged_quantities.size();
+
+    m_ring.resize(LOG_BINARY_RING_SIZE);
+    m_chunk_busy.assign(LOG_BINARY_RING_SIZE, false);
+    for (unsigned int i = 0; i < LOG_BINARY_RING_SIZE; i++)
+        {
+        m_ring[i].n_rows = 0;
+        m_ring[i].timestep.resize(m_chunk_size);
+        m_ring[i].values.resize(m_chunk_size * m_n_columns);
+        }
+    m_active = 0;
+    }
+
+/*! \param quantities A list of quantities to log
+
+    Buffered rows of the previous quantities are written out first, followed by a schema block for the new ones.
+*/
+void LogBinary::setLoggedQuantities(const std::vector< std::string >& quantities)
+    {
+    // finish writing rows with the old layout
+    flush();
+
+    Logger::setLoggedQuantities(quantities);
+
+    if (quantities.size() == 0)
+        m_exec_conf->msg->warning() << "analyze.log_binary: No quantities specified for logging" << endl;
+
+    allocateChunks();
+
+    // the writer thread is idle after flush()
+    if (m_file_output)
+        writeSchema();
+    }
+
+/*! \param timestep Time step to write out data for
+*/
+void LogBinary::analyze(unsigned int timestep)
+    {
+    //Call the base class to cache all values.
+    Logger::analyze(timestep);
+
+    if (!m_file_output)
+        return;
+
+    if (m_prof) m_prof->push("LogBinary");
+
+    checkWriteError();
+
+    // store the row in the active chunk
+    Chunk& chunk = m_ring[m_active];
+    unsigned int row = chunk.n_rows;
+    chunk.timestep[row] = timestep;
+    for (unsigned int i = 0; i < m_n_columns; i++)
+        chunk.values[i * m_chunk_size + row] = double(m_cached_quantities[i]);
+    chunk.n_rows++;
+
+    if (chunk.n_rows == m_chunk_size)
+        submitActiveChunk();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! Submits the partially filled active chunk and blocks until the writer thread has written all chunks.
+*/
+void LogBinary::flush()
+    {
+    if (!m_file_output)
+        return;
+
+    if (m_ring[m_active].n_rows > 0)
+        submitActiveChunk();
+
+    waitForWriter();
+
+    m_file.flush();
+    checkWriteError();
+    }
+
+/*! Blocks only when all chunks in the ring are still waiting to be written.
+*/
+void LogBinary::submitActiveChunk()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_chunk_busy[m_active] = true;
+    m_pending.push_back(m_active);
+    m_cond.notify_all();
+
+    // select the next chunk in the ring, waiting for the writer to free it if needed
+    unsigned int next = (m_active + 1) % LOG_BINARY_RING_SIZE;
+    m_cond.wait(lock, [this, next] { return !m_chunk_busy[next]; });
+
+    m_active = next;
+    m_ring[m_active].n_rows = 0;
+    }
+
+void LogBinary::waitForWriter()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this]
+        {
+        for (unsigned int i = 0; i < m_chunk_busy.size(); i++)
+            if (m_chunk_busy[i])
+                return false;
+        return true;
+        });
+    }
+
+/*! \param chunk Chunk to write
+
+    The chunk is stored in the same column major layout as on disk, so every column is written with a single call.
+*/
+void LogBinary::writeChunk(const Chunk& chunk)
+    {
+    uint32_t n_rows = chunk.n_rows;
+    m_file.write((const char *)&LOG_BINARY_DATA, sizeof(uint32_t));
+    m_file.write((const char *)&n_rows, sizeof(uint32_t));
+    m_file.write((const char *)chunk.timestep.data(), sizeof(uint64_t) * n_rows);
+
+    for (unsigned int i = 0; i < m_n_columns; i++)
+        m_file.write((const char *)(chunk.values.data() + i * m_chunk_size), sizeof(double) * n_rows);
+    }
+
+void LogBinary::writeSchema()
+    {
+    uint32_t n_columns = m_n_columns;
+    m_file.write((const char *)&LOG_BINARY_SCHEMA, sizeof(uint32_t));
+    m_file.write((const char *)&n_columns, sizeof(uint32_t));
+
+    for (unsigned int i = 0; i < m_n_columns; i++)
+        {
+        uint32_t len = (uint32_t)m_logged_quantities[i].size();
+        m_file.write((const char *)&len, sizeof(uint32_t));
+        m_file.write(m_logged_quantities[i].c_str(), len);
+        }
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: I/O error while writing log file" << endl;
+        throw runtime_error("Error writing log file");
+        }
+    }
+
+/*! The writer thread only touches the file and the chunks it has been handed, and never calls into Python.
+*/
+void LogBinary::writerLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+        {
+        m_cond.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+
+        if (m_pending.empty())
+            {
+            // m_stop is set and there is nothing left to write
+            break;
+            }
+
+        unsigned int idx = m_pending.front();
+        m_pending.pop_front();
+
+        // write without holding the lock so that analyze() can keep filling the next chunk
+        lock.unlock();
+        writeChunk(m_ring[idx]);
+        bool good = m_file.good();
+        lock.lock();
+
+        if (!good)
+            m_write_error = true;
+
+        m_chunk_busy[idx] = false;
+        m_cond.notify_all();
+        }
+    }
+
+void LogBinary::checkWriteError()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_write_error)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: I/O error while writing log file" << endl;
+        throw runtime_error("Error writing log file");
+        }
+    }
+
+void export_LogBinary(py::module& m)
+    {
+    py::class_<LogBinary, Logger, std::shared_ptr<LogBinary> >(m,"LogBinary")
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string&, unsigned int, bool>())
+    ;
+    }
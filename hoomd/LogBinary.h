@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.h
+    \brief Declares the LogBinary class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Logger.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#ifndef __LOGBINARY_H__
+#define __LOGBINARY_H__
+
+//! Logs registered quantities to a binary columnar file
+/*! LogBinary evaluates the logged quantities through the resolved source handles of Logger and stores each row in a
+    preallocated ring of chunks. A chunk holds \a chunk_size rows in column major order: first the time steps, then
+    each quantity in turn. Full chunks are handed to a background thread that appends them to the file, so the
+    simulation never waits on disk I/O or text formatting unless every chunk in the ring is still pending.
+
+    \b File format
+
+    All values are stored in native byte order. The file starts with the 8 byte magic string \c HOOMDCOL followed by
+    a uint32 format version. The remainder of the file is a sequence of blocks, each starting with a uint32 tag:
+
+    - schema (tag 1): uint32 number of quantities, then for each quantity a uint32 length and its name.
+    - data (tag 2): uint32 number of rows \a n, \a n uint64 time steps, then \a n float64 values for each quantity
+      in the order of the most recent schema block.
+
+    A schema block is written whenever the logged quantities change and when appending to an existing file.
+
+    Buffered rows are written when a chunk fills, on flush(), when the logged quantities change, and on destruction.
+    In MPI simulations, only the root rank writes the file.
+
+    \ingroup analyzers
+*/
+class LogBinary : public Logger
+    {
+    public:
+        //! Constructs the logger and opens the file
+        LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                  const std::string& fname,
+                  unsigned int chunk_size,
+                  bool overwrite=false);
+
+        //! Destructor
+        virtual ~LogBinary();
+
+        //! Selects which quantities to log
+        virtual void setLoggedQuantities(const std::vector< std::string >& quantities);
+
+        //! Record the data for the current timestep
+        virtual void analyze(unsigned int timestep);
+
+        //! Write all buffered rows to the file
+        virtual void flush();
+
+    private:
+        //! A block of rows stored in column major order
+        struct Chunk
+            {
+            unsigned int n_rows;                //!< Number of rows filled
+            std::vector<uint64_t> timestep;     //!< Time step column
+            std::vector<double> values;         //!< Quantity columns, indexed by column*capacity + row
+            };
+
+        std::string m_filename;                 //!< The output file name
+        unsigned int m_chunk_size;              //!< Number of rows per chunk
+        bool m_appending;                       //!< True if appending to an existing file
+        bool m_file_output;                     //!< True if this rank writes the file
+        std::ofstream m_file;                   //!< The file we write out to
+
+        std::vector<Chunk> m_ring;              //!< Ring of preallocated chunks
+        std::vector<bool> m_chunk_busy;         //!< True for chunks queued for or being written
+        unsigned int m_active;                  //!< Index of the chunk being filled
+        std::deque<unsigned int> m_pending;     //!< Full chunks waiting for the writer thread
+        unsigned int m_n_columns;               //!< Number of quantity columns in the chunks
+
+        std::thread m_writer;                   //!< Background writer thread
+        std::mutex m_mutex;                     //!< Protects the queue and the busy flags
+        std::condition_variable m_cond;         //!< Signals changes to the queue and the busy flags
+        bool m_stop;                            //!< Requests the writer thread to exit
+        bool m_write_error;                     //!< Set by the writer thread on an I/O error
+
+        //! Open the output file and start the writer thread
+        void openOutputFile();
+
+        //! Allocate the chunks for the current number of columns
+        void allocateChunks();
+
+        //! Queue the active chunk for writing and select the next free one
+        void submitActiveChunk();
+
+        //! Block until all queued chunks have been written
+        void waitForWriter();
+
+        //! Write a single chunk to the file
+        void writeChunk(const Chunk& chunk);
+
+        //! Write a schema block for the current quantities
+        void writeSchema();
+
+        //! Main loop of the writer thread
+        void writerLoop();
+
+        //! Throw if the writer thread encountered an error
+        void checkWriteError();
+    };
+
+//! Exports the LogBinary class to python
+void export_LogBinary(pybind11::module& m);
+
+#endif
@@ -24,7 +24,7 @@ using namespace std;
 /*! \param sysdef Specified for Analyzer, but not used directly by Logger
 */
 Logger::Logger(std::shared_ptr<SystemDefinition> sysdef)
-    : Analyzer(sysdef)
+    : Analyzer(sysdef), m_cached_timestep(-1), m_sources_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing Logger: " << endl;
     }
@@ -62,6 +62,8 @@ void Logger::registerCompute(std::shared_ptr<Compute> compute)
         m_compute_quantities[provided_quantities[i]] = compute;
         m_exec_conf->msg->notice(6) << "analyze.log: Registering log quantity " << provided_quantities[i] << endl;
         }
+
+    m_sources_dirty = true;
     }
 
 /*! \param updater The Updater to register
@@ -86,6 +88,8 @@ void Logger::registerUpdater(std::shared_ptr<Updater> updater)
         m_updater_quantities[provided_quantities[i]] = updater;
         m_exec_conf->msg->notice(6) << "analyze.log: Registering log quantity " << provided_quantities[i] << endl;
         }
+
+    m_sources_dirty = true;
     }
 
 /*! \param name Name of the quantity
@@ -106,6 +110,8 @@ void Logger::registerCallback(std::string name, pybind11::handle callback)
 
     pybind11::handle(callback).inc_ref(); // increase the reference count on this handle while we hold it
     m_callback_quantities[name] = callback.ptr();
+
+    m_sources_dirty = true;
     }
 
 /*! After calling removeAll(), no quantities are registered for logging
@@ -117,6 +123,8 @@ void Logger::removeAll()
     //The callbacks are intentionally not cleared, because before each
     //run all compute and updaters should be cleared, but the python
     //callbacks should not be cleared for this.
+
+    m_sources_dirty = true;
     }
 
 /*! \param quantities A list of quantities to log
@@ -131,6 +139,62 @@ void Logger::setLoggedQuantities(const std::vector< std::string >& quantities)
     // prepare or adjust storage for caching the logger properties.
     m_cached_timestep = -1;
     m_cached_quantities.resize(quantities.size());
+    m_sources_dirty = true;
+    }
+
+/*! Looks up the source of every logged quantity in the maps of registered computes, updaters and callbacks.
+    This is done once after each change, so that the per-step evaluation does not need string comparisons.
+*/
+void Logger::resolveSources()
+    {
+    m_logged_sources.resize(m_logged_quantities.size());
+
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        const std::string& quantity = m_logged_quantities[i];
+        LogSource source;
+
+        std::map< std::string, std::shared_ptr<Compute> >::iterator compute_it;
+        std::map< std::string, std::shared_ptr<Updater> >::iterator updater_it;
+        std::map< std::string, PyObject * >::iterator callback_it;
+
+        if (quantity == "time")
+            {
+            source.type = LogSource::time;
+            }
+        else if ((compute_it = m_compute_quantities.find(quantity)) != m_compute_quantities.end())
+            {
+            source.type = LogSource::from_compute;
+            source.compute = compute_it->second;
+            }
+        else if ((updater_it = m_updater_quantities.find(quantity)) != m_updater_quantities.end())
+            {
+            source.type = LogSource::from_updater;
+            source.updater = updater_it->second;
+            }
+        else if ((callback_it = m_callback_quantities.find(quantity)) != m_callback_quantities.end())
+            {
+            source.type = LogSource::from_callback;
+            source.callback = callback_it->second;
+            }
+
+        m_logged_sources[i] = source;
+        }
+
+    m_sources_dirty = false;
+    }
+
+/*! \param timestep Time step to evaluate the logged quantities at
+*/
+void Logger::updateCache(unsigned int timestep)
+    {
+    if (m_sources_dirty)
+        resolveSources();
+
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        m_cached_quantities[i] = getValue(i, timestep);
+
+    m_cached_timestep = timestep;
     }
 
 /*! \param timestep Time step to write out data for
@@ -143,10 +207,7 @@ void Logger::analyze(unsigned int timestep)
     if (m_prof) m_prof->push("Log");
 
     // update info in cache for later use and for immediate output.
-    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
-        m_cached_quantities[i] = getValue(m_logged_quantities[i], timestep);
-
-    m_cached_timestep = timestep;
+    updateCache(timestep);
 
     if (m_prof) m_prof->pop();
     }
@@ -157,11 +218,7 @@ Scalar Logger::getQuantity(const std::string &quantity, unsigned int timestep, b
     {
     // update info in cache for later use
     if (!use_cache && timestep != m_cached_timestep)
-        {
-        for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
-            m_cached_quantities[i] = getValue(m_logged_quantities[i], timestep);
-        m_cached_timestep = timestep;
-        }
+        updateCache(timestep);
 
     // first see if it is the timestep number
     if (quantity == "timestep")
@@ -178,49 +235,46 @@ Scalar Logger::getQuantity(const std::string &quantity, unsigned int timestep, b
     return Scalar(0.0);
     }
 
-/*! \param quantity Quantity to get
+/*! \param i Index of the logged quantity to get
     \param timestep Time step to compute value for (needed for Compute classes)
 */
-Scalar Logger::getValue(const std::string &quantity, int timestep)
+Scalar Logger::getValue(unsigned int i, unsigned int timestep)
     {
-    // first see if it is the built-in time quantity
-    if (quantity == "time")
-        {
-        return Scalar(double(m_clk.getTime())/1e9);
-        }
-    // check to see if the quantity exists in the compute list
-    else if (m_compute_quantities.count(quantity))
-        {
-        // update the compute
-        m_compute_quantities[quantity]->compute(timestep);
-        // get the log value
-        return m_compute_quantities[quantity]->getLogValue(quantity, timestep);
-        }
-    // check to see if the quantity exists in the updaters list
-    else if (m_updater_quantities.count(quantity))
-        {
-        // get the log value
-        return m_updater_quantities[quantity]->getLogValue(quantity, timestep);
-        }
-    else if (m_callback_quantities.count(quantity))
+    const LogSource& source = m_logged_sources[i];
+
+    switch (source.type)
         {
-        // get a quantity from a callback
-        try
-            {
-            py::object rv = pybind11::reinterpret_borrow<py::object>(m_callback_quantities[quantity])(timestep);
-            Scalar extracted_rv = rv.cast<Scalar>();
-            return extracted_rv;
-            }
-        catch (const py::cast_error&)
-            {
-                m_exec_conf->msg->warning() << "analyze.log: Log callback " << quantity << " returned invalid value, logging 0." << endl;
+        case LogSource::time:
+            // the built-in time quantity
+            return Scalar(double(m_clk.getTime())/1e9);
+
+        case LogSource::from_compute:
+            // update the compute and get the log value
+            source.compute->compute(timestep);
+            return source.compute->getLogValue(m_logged_quantities[i], timestep);
+
+        case LogSource::from_updater:
+            return source.updater->getLogValue(m_logged_quantities[i], timestep);
+
+        case LogSource::from_callback:
+            // get a quantity from a callback
+            try
+                {
+                py::object rv = pybind11::reinterpret_borrow<py::object>(source.callback)(timestep);
+                Scalar extracted_rv = rv.cast<Scalar>();
+                return extracted_rv;
+                }
+            catch (const py::cast_error&)
+                {
+                m_exec_conf->msg->warning() << "analyze.log: Log callback " << m_logged_quantities[i]
+                                            << " returned invalid value, logging 0." << endl;
                 return Scalar(0.0);
-            }
-        }
-    else
-        {
-        m_exec_conf->msg->warning() << "analyze.log: Log quantity " << quantity << " is not registered, logging a value of 0" << endl;
-        return Scalar(0.0);
+                }
+
+        default:
+            m_exec_conf->msg->warning() << "analyze.log: Log quantity " << m_logged_quantities[i]
+                                        << " is not registered, logging a value of 0" << endl;
+            return Scalar(0.0);
         }
     }
 
@@ -235,5 +289,6 @@ void export_Logger(py::module& m)
     .def("setLoggedQuantities", &Logger::setLoggedQuantities)
     .def("getLoggedQuantities", &Logger::getLoggedQuantities)
     .def("getQuantity", &Logger::getQuantity)
+    .def("flush", &Logger::flush)
     ;
     }
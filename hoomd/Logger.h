@@ -43,6 +43,10 @@
     The removeAll method can be used to clear all registered computes and updaters. hoomd will
     removeAll() and re-register all active computes and updaters before every run()
 
+    The source of each logged quantity is resolved once into a LogSource handle, so that analyze() does not search
+    the quantity maps by name. Handles are resolved again on the next evaluation after the logged quantities or the
+    registered sources change.
+
     \ingroup analyzers
 */
 class __attribute__((visibility("default"))) Logger : public Analyzer
@@ -78,6 +82,9 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         //! Write out the data for the current timestep
         virtual void analyze(unsigned int timestep);
 
+        //! Write out any buffered data
+        virtual void flush() { }
+
         //! Get needed pdata flags
         /*! Logger may potentially log any of the optional quantities, enable all of the bits.
         */
@@ -92,6 +99,28 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
             }
 
     protected:
+        //! Resolved source of a single logged quantity
+        struct LogSource
+            {
+            //! Kinds of sources a quantity can be obtained from
+            enum Type
+                {
+                none = 0,
+                time,
+                from_compute,
+                from_updater,
+                from_callback
+                };
+
+            Type type;                              //!< Kind of source
+            std::shared_ptr<Compute> compute;       //!< Compute providing the quantity
+            std::shared_ptr<Updater> updater;       //!< Updater providing the quantity
+            PyObject *callback;                     //!< Callback providing the quantity
+
+            //! Default constructor
+            LogSource() : type(none), callback(NULL) { }
+            };
+
         //! A map of computes indexed by logged quantity that they provide
         std::map< std::string, std::shared_ptr<Compute> > m_compute_quantities;
         //! A map of updaters indexed by logged quantity that they provide
@@ -106,10 +135,20 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         unsigned int m_cached_timestep;
         //! The values of the logged quantities at the last logger update.
         std::vector< Scalar > m_cached_quantities;
+        //! Resolved sources of the logged quantities, in the same order as m_logged_quantities
+        std::vector< LogSource > m_logged_sources;
+        //! True when m_logged_sources must be resolved again
+        bool m_sources_dirty;
+
+        //! Evaluate all logged quantities into m_cached_quantities
+        void updateCache(unsigned int timestep);
 
     private:
-        //! Helper function to get a value for a given quantity
-        Scalar getValue(const std::string &quantity, int timestep);
+        //! Resolve the source of each logged quantity
+        void resolveSources();
+
+        //! Helper function to get a value for a given logged quantity
+        Scalar getValue(unsigned int i, unsigned int timestep);
     };
 
 //! exports the Logger class to python
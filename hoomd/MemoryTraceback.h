@@ -12,12 +12,18 @@
 #include <map>
 
 #include "Messenger.h"
+#include "HostMemoryPool.h"
 
 #include <pybind11/pybind11.h>
 
 class PYBIND11_EXPORT MemoryTraceback
     {
     public:
+        //! Constructor
+        MemoryTraceback()
+            : m_host_pool(nullptr)
+            { }
+
         //! Register a memory allocation along with a stacktrace
         /*! \param ptr The pointer to the memory address being allocated
             \param nbytes The size of the allocation in bytes
@@ -40,7 +46,14 @@ class PYBIND11_EXPORT MemoryTraceback
          */
         void updateTag(const void *ptr, unsigned int nbytes, const std::string& tag) const;
 
+        //! Set the host memory pool whose statistics are reported with the traces
+        void setHostMemoryPool(const HostMemoryPool *pool)
+            {
+            m_host_pool = pool;
+            }
+
     private:
+        const HostMemoryPool *m_host_pool;  //!< Host memory pool (may be NULL)
         mutable std::map<std::pair<const void *,unsigned int>, std::vector<void *> > m_traces;  //!< A stacktrace per memory allocation
         mutable std::map<std::pair<const void *,unsigned int>, std::string > m_type_hints;      //!< Types of memory allocations
         mutable std::map<std::pair<const void *,unsigned int>, std::string > m_tags;            //!< Tags of memory allocations
@@ -63,7 +63,8 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
           m_nglobal(0),
           m_accel_set(false),
           m_resize_factor(9./8.),
-          m_arrays_allocated(false)
+          m_arrays_allocated(false),
+          m_hot_field_layout(aos)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -144,7 +145,8 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
       m_nglobal(0),
       m_accel_set(false),
       m_resize_factor(9./8.),
-      m_arrays_allocated(false)
+      m_arrays_allocated(false),
+      m_hot_field_layout(aos)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -192,6 +194,68 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     m_o_image = make_int3(0,0,0);
     }
 
+/*! Loads the particles owned by this rank into the internal arrays, without a detour through rank 0.
+ * \param snapshot The particles owned by this rank
+ * \param tags Global tags of the particles in \a snapshot
+ * \param global_box The dimensions of the global simulation box
+ * \param exec_conf The execution configuration
+ * \param decomposition (optional) Domain decomposition layout
+ */
+template <class Real>
+ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
+                           const std::vector<unsigned int>& tags,
+                           const BoxDim& global_box,
+                           std::shared_ptr<ExecutionConfiguration> exec_conf,
+                           std::shared_ptr<DomainDecomposition> decomposition
+                          )
+    : m_exec_conf(exec_conf),
+      m_nparticles(0),
+      m_nghosts(0),
+      m_max_nparticles(0),
+      m_nglobal(0),
+      m_accel_set(false),
+      m_resize_factor(9./8.),
+      m_arrays_allocated(false),
+      m_hot_field_layout(aos)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
+
+    #ifdef ENABLE_MPI
+    // Set up domain decomposition information
+    if (decomposition) setDomainDecomposition(decomposition);
+    #endif
+
+    // initialize box dimensions on all processors
+    setGlobalBox(global_box);
+
+    #ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
+        m_memory_advice_last_Nmax = UINT_MAX;
+        }
+    #endif
+
+    // initialize rtag array
+    GlobalVector<unsigned int>(exec_conf).swap(m_rtag);
+    TAG_ALLOCATION(m_rtag);
+
+    // initialize particle data with the local slice
+    initializeFromLocalSnapshot(snapshot, tags);
+
+    // reset external virial
+    for (unsigned int i = 0; i < 6; i++)
+        m_external_virial[i] = Scalar(0.0);
+
+    m_external_energy = Scalar(0.0);
+
+    // default constructed shared ptr is null as desired
+    m_prof = std::shared_ptr<Profiler>();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+    }
 
 ParticleData::~ParticleData()
     {
@@ -578,6 +642,27 @@ void ParticleData::setNGlobal(unsigned int nglobal)
     #endif
     }
 
+/*! \param layout Layout of the hot fields used by the CPU kernels
+
+    Switching back to \a aos releases the buffers of the structure-of-arrays views.
+*/
+void ParticleData::setHotFieldLayout(hotFieldLayout layout)
+    {
+    if (m_soa_pos.in_use || m_soa_vel.in_use)
+        {
+        m_exec_conf->msg->error() << "Cannot change the particle data layout while a view is held" << endl;
+        throw std::runtime_error("Error changing particle data layout");
+        }
+
+    m_hot_field_layout = layout;
+
+    if (layout == aos)
+        {
+        m_soa_pos = ParticleSoAScratch();
+        m_soa_vel = ParticleSoAScratch();
+        }
+    }
+
 /*! \param new_nparticles New particle number
  */
 void ParticleData::resize(unsigned int new_nparticles)
@@ -1177,6 +1262,149 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+//! Initialize from the slice of the particles owned by this rank
+/*! \param snapshot The particles owned by this rank. Particles slightly outside of the local domain are moved to
+                    their owner by the first migration.
+    \param tags Global tag of every particle in \a snapshot
+
+    Every rank passes its own particles, so no rank ever holds the whole system. The tags of all ranks together
+    must be exactly 0 .. N_global-1. The type mapping must be set on all ranks.
+
+    \post the particle data arrays are initialized from the snapshot, in index order
+    \pre In parallel simulations, the local box size must be set before a call to initializeFromLocalSnapshot().
+ */
+template <class Real>
+void ParticleData::initializeFromLocalSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                               const std::vector<unsigned int>& tags)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from local snapshot" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // check that all fields in the snapshot have correct length and all types are valid, on all ranks
+    int valid = snapshot.validate() && tags.size() == snapshot.size;
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "init.*: invalid local particle data snapshot on rank "
+                                  << m_exec_conf->getRank() << std::endl << std::endl;
+        }
+    #ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+    if (!valid)
+        {
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    // global number of particles
+    unsigned int nglobal = snapshot.size;
+    #ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    for (unsigned int idx = 0; idx < snapshot.size; idx++)
+        {
+        if (tags[idx] >= nglobal)
+            {
+            m_exec_conf->msg->error() << "init.*: particle tag " << tags[idx] << " out of range (N = "
+                                      << nglobal << ")" << std::endl;
+            throw std::runtime_error("Error initializing particle data.");
+            }
+        }
+
+    // update list of active tags
+    m_tag_set.clear();
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        m_tag_set.insert(tag);
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // resize particle data
+    m_nparticles = snapshot.size;
+    resize(m_nparticles);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx] = make_scalar4(snapshot.pos[idx].x,
+                                           snapshot.pos[idx].y,
+                                           snapshot.pos[idx].z,
+                                           __int_as_scalar(snapshot.type[idx]));
+            h_vel.data[idx] = make_scalar4(snapshot.vel[idx].x,
+                                           snapshot.vel[idx].y,
+                                           snapshot.vel[idx].z,
+                                           snapshot.mass[idx]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[idx]);
+            h_charge.data[idx] = snapshot.charge[idx];
+            h_diameter.data[idx] = snapshot.diameter[idx];
+            h_image.data[idx] = snapshot.image[idx];
+            h_tag.data[idx] = tags[idx];
+            h_rtag.data[tags[idx]] = idx;
+            h_body.data[idx] = snapshot.body[idx];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[idx]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[idx]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[idx]);
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // initialize type mapping
+    m_type_mapping = snapshot.type_mapping;
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1415,6 +1643,64 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
     return index;
     }
 
+//! Take a snapshot of the particles owned by this rank
+/* \param snapshot The snapshot to write to, resized to the local number of particles
+   \param tags Set to the global tag of every particle in \a snapshot
+
+   Nothing is communicated, so every rank only ever holds its own particles. Particles are stored in local index
+   order, with positions relative to the origin and wrapped into the global box, as in takeSnapshot(). The result can
+   be passed back to initializeFromLocalSnapshot() with the same domain decomposition.
+*/
+template <class Real>
+void ParticleData::takeLocalSnapshot(SnapshotParticleData<Real> &snapshot, std::vector<unsigned int>& tags)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: taking local snapshot" << std::endl;
+
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::read);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 >  h_orientation(m_orientation, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 >  h_angmom(m_angmom, access_location::host, access_mode::read);
+    ArrayHandle< Scalar3 >  h_inertia(m_inertia, access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+
+    snapshot.resize(m_nparticles);
+    tags.resize(m_nparticles);
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        int3 image = h_image.data[idx];
+        image.x -= m_o_image.x;
+        image.y -= m_o_image.y;
+        image.z -= m_o_image.z;
+
+        // make sure the position stored in the snapshot is within the boundaries
+        Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+        m_global_box.wrap(pos, image);
+
+        snapshot.pos[idx] = vec3<Real>(pos);
+        snapshot.vel[idx] = vec3<Real>(make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z));
+        snapshot.accel[idx] = vec3<Real>(h_accel.data[idx]);
+        snapshot.type[idx] = __scalar_as_int(h_pos.data[idx].w);
+        snapshot.mass[idx] = h_vel.data[idx].w;
+        snapshot.charge[idx] = h_charge.data[idx];
+        snapshot.diameter[idx] = h_diameter.data[idx];
+        snapshot.image[idx] = image;
+        snapshot.body[idx] = h_body.data[idx];
+        snapshot.orientation[idx] = quat<Real>(h_orientation.data[idx]);
+        snapshot.angmom[idx] = quat<Real>(h_angmom.data[idx]);
+        snapshot.inertia[idx] = vec3<Real>(h_inertia.data[idx]);
+        tags[idx] = h_tag.data[idx];
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+    snapshot.is_accel_set = m_accel_set;
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -2491,7 +2777,17 @@ template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
+                                           const std::vector<unsigned int>& tags,
+                                           const BoxDim& global_box,
+                                           std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                           std::shared_ptr<DomainDecomposition> decomposition
+                                          );
+template void ParticleData::initializeFromLocalSnapshot<double>(const SnapshotParticleData<double> & snapshot,
+                                                                const std::vector<unsigned int>& tags);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
+template void ParticleData::takeLocalSnapshot<double>(SnapshotParticleData<double> &snapshot,
+                                                      std::vector<unsigned int>& tags);
 
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
@@ -2500,13 +2796,23 @@ template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
+                                           const std::vector<unsigned int>& tags,
+                                           const BoxDim& global_box,
+                                           std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                           std::shared_ptr<DomainDecomposition> decomposition
+                                          );
+template void ParticleData::initializeFromLocalSnapshot<float>(const SnapshotParticleData<float> & snapshot,
+                                                               const std::vector<unsigned int>& tags);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
+template void ParticleData::takeLocalSnapshot<float>(SnapshotParticleData<float> &snapshot,
+                                                     std::vector<unsigned int>& tags);
 
 
 void export_ParticleData(py::module& m)
     {
-    py::class_<ParticleData, std::shared_ptr<ParticleData> >(m,"ParticleData")
-    .def(py::init<unsigned int, const BoxDim&, unsigned int, std::shared_ptr<ExecutionConfiguration> >())
+    py::class_<ParticleData, std::shared_ptr<ParticleData> > pdata(m,"ParticleData");
+    pdata.def(py::init<unsigned int, const BoxDim&, unsigned int, std::shared_ptr<ExecutionConfiguration> >())
     .def("getGlobalBox", &ParticleData::getGlobalBox, py::return_value_policy::reference_internal)
     .def("getBox", &ParticleData::getBox, py::return_value_policy::reference_internal)
     .def("setGlobalBoxL", &ParticleData::setGlobalBoxL)
@@ -2557,6 +2863,14 @@ void export_ParticleData(py::module& m)
     .def("getDomainDecomposition", &ParticleData::getDomainDecomposition)
 #endif
     .def("addType", &ParticleData::addType)
+    .def("setHotFieldLayout", &ParticleData::setHotFieldLayout)
+    .def("getHotFieldLayout", &ParticleData::getHotFieldLayout)
+    ;
+
+    py::enum_<ParticleData::hotFieldLayout>(pdata, "hotFieldLayout")
+        .value("aos", ParticleData::hotFieldLayout::aos)
+        .value("soa", ParticleData::hotFieldLayout::soa)
+        .export_values()
     ;
     }
 
@@ -2620,6 +2934,13 @@ bool SnapshotParticleData<Real>::validate() const
         inertia.size() != size)
         return false;
 
+    // Check that every type falls in the range of known types
+    for (unsigned int i = 0; i < size; i++)
+        {
+        if (type[i] >= type_mapping.size())
+            return false;
+        }
+
     return true;
     }
 
@@ -73,6 +73,9 @@ class Profiler;
 // Forward declaration of IntegratorData
 class IntegratorData;
 
+// Forward declaration of ParticleGroupMembership
+class ParticleGroupMembership;
+
 //! List of optional fields that can be enabled in ParticleData
 struct pdata_flag
     {
@@ -261,6 +264,21 @@ struct pdata_element
     Scalar net_virial[6];      //!< net virial
     };
 
+//! Host buffers backing a structure-of-arrays view of the particle data
+/*! The buffers are owned by ParticleData so that repeated views do not allocate. See ParticleDataSoA.h.
+*/
+struct ParticleSoAScratch
+    {
+    ParticleSoAScratch() : in_use(false) { }
+
+    std::vector<Scalar> x;              //!< x components
+    std::vector<Scalar> y;              //!< y components
+    std::vector<Scalar> z;              //!< z components
+    std::vector<Scalar> w;              //!< Scalar fourth component (mass of the velocity view)
+    std::vector<unsigned int> type;     //!< Compact type ids (position view)
+    bool in_use;                        //!< True while a view holds the buffers
+    };
+
 //! Manages all of the data arrays for the particles
 /*! <h1> General </h1>
     ParticleData stores and manages particle coordinates, velocities, accelerations, type,
@@ -404,6 +422,16 @@ struct pdata_element
 class PYBIND11_EXPORT ParticleData
     {
     public:
+        //! Layout of the hot per-particle fields used by the CPU kernels
+        /*! The packed Scalar4 arrays always hold the particle data. With \a soa, CPU kernels that support it acquire
+            the positions and velocities through the structure-of-arrays views in ParticleDataSoA.h instead.
+        */
+        enum hotFieldLayout
+            {
+            aos,    //!< Kernels read the packed Scalar4 arrays directly
+            soa     //!< Kernels read contiguous x, y, z arrays through the SoA views
+            };
+
         //! Construct with N particles in the given box
         ParticleData(unsigned int N,
                      const BoxDim &global_box,
@@ -422,6 +450,16 @@ class PYBIND11_EXPORT ParticleData
                         = std::shared_ptr<DomainDecomposition>()
                      );
 
+        //! Construct from the slice of the particles owned by this rank
+        template<class Real>
+        ParticleData(const SnapshotParticleData<Real>& snapshot,
+                     const std::vector<unsigned int>& tags,
+                     const BoxDim& global_box,
+                     std::shared_ptr<ExecutionConfiguration> exec_conf,
+                     std::shared_ptr<DomainDecomposition> decomposition
+                        = std::shared_ptr<DomainDecomposition>()
+                     );
+
         //! Destructor
         virtual ~ParticleData();
 
@@ -582,6 +620,15 @@ class PYBIND11_EXPORT ParticleData
             return d_max;
             }
 
+        //! Select the layout of the hot per-particle fields used by the CPU kernels
+        void setHotFieldLayout(hotFieldLayout layout);
+
+        //! Get the layout of the hot per-particle fields used by the CPU kernels
+        hotFieldLayout getHotFieldLayout() const
+            {
+            return m_hot_field_layout;
+            }
+
         //! Return positions and types
         const GlobalArray< Scalar4 >& getPositions() const { return m_pos; }
 
@@ -977,10 +1024,19 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        //! Initialize from the slice of the particles owned by this rank
+        template <class Real>
+        void initializeFromLocalSnapshot(const SnapshotParticleData<Real> & snapshot,
+                                         const std::vector<unsigned int>& tags);
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
 
+        //! Take a snapshot of the particles owned by this rank
+        template <class Real>
+        void takeLocalSnapshot(SnapshotParticleData<Real> &snapshot, std::vector<unsigned int>& tags);
+
         //! Add ghost particles at the end of the local particle data
         void addGhostParticles(const unsigned int nghosts);
 
@@ -1192,6 +1248,17 @@ class PYBIND11_EXPORT ParticleData
 
         bool m_arrays_allocated;                     //!< True if arrays have been initialized
 
+        hotFieldLayout m_hot_field_layout;           //!< Layout of the hot fields used by the CPU kernels
+        ParticleSoAScratch m_soa_pos;                //!< Buffers backing the SoA position view
+        ParticleSoAScratch m_soa_vel;                //!< Buffers backing the SoA velocity view
+
+        //! Membership bits shared by the particle groups (owned by the groups)
+        std::weak_ptr<ParticleGroupMembership> m_group_membership;
+
+        friend class PositionsSoAHandle;
+        friend class VelocitiesSoAHandle;
+        friend class ParticleGroupMembership;
+
         #ifdef ENABLE_HIP
         GPUPartition m_gpu_partition;                //!< The partition of the local number of particles across GPUs
         unsigned int m_memory_advice_last_Nmax;      //!< Nmax at which memory hints were last set
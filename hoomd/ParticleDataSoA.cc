@@ -0,0 +1,131 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleDataSoA.cc
+    \brief Defines the structure-of-arrays views of the hot particle data fields
+*/
+
+#include "ParticleDataSoA.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+//! Claim the scratch buffers of a view and make them large enough
+/*! \param exec_conf Execution configuration for error messages
+    \param scratch Buffers to claim
+    \param N Number of particles in the view
+    \param with_type True to size the type array, false to size the \a w array
+*/
+void claimScratch(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                  ParticleSoAScratch& scratch,
+                  unsigned int N,
+                  bool with_type)
+    {
+    if (scratch.in_use)
+        {
+        exec_conf->msg->error() << "Only one structure-of-arrays view of a particle field may be held at a time"
+                                << endl;
+        throw runtime_error("Error acquiring particle data view");
+        }
+    scratch.in_use = true;
+
+    // grow only, so repeated views do not reallocate
+    if (scratch.x.size() < N)
+        {
+        scratch.x.resize(N);
+        scratch.y.resize(N);
+        scratch.z.resize(N);
+        }
+    if (with_type && scratch.type.size() < N)
+        scratch.type.resize(N);
+    if (!with_type && scratch.w.size() < N)
+        scratch.w.resize(N);
+    }
+}
+
+/*! \param pdata Particle data to view
+    \param mode Access mode. The values are not gathered with access_mode::overwrite.
+    \param include_ghosts True to include the ghost particles in the view
+*/
+PositionsSoAHandle::PositionsSoAHandle(ParticleData& pdata, access_mode::Enum mode, bool include_ghosts)
+    : m_pdata(pdata), m_mode(mode)
+    {
+    N = pdata.getN() + (include_ghosts ? pdata.getNGhosts() : 0);
+
+    ParticleSoAScratch& scratch = pdata.m_soa_pos;
+    claimScratch(pdata.getExecConf(), scratch, N, true);
+    x = scratch.x.data();
+    y = scratch.y.data();
+    z = scratch.z.data();
+    type = scratch.type.data();
+
+    if (mode != access_mode::overwrite)
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const Scalar4 postype = h_pos.data[i];
+            x[i] = postype.x;
+            y[i] = postype.y;
+            z[i] = postype.z;
+            type[i] = __scalar_as_int(postype.w);
+            }
+        }
+    }
+
+PositionsSoAHandle::~PositionsSoAHandle()
+    {
+    if (m_mode != access_mode::read)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata.getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            h_pos.data[i] = make_scalar4(x[i], y[i], z[i], __int_as_scalar(type[i]));
+        }
+
+    m_pdata.m_soa_pos.in_use = false;
+    }
+
+/*! \param pdata Particle data to view
+    \param mode Access mode. The values are not gathered with access_mode::overwrite.
+    \param include_ghosts True to include the ghost particles in the view
+*/
+VelocitiesSoAHandle::VelocitiesSoAHandle(ParticleData& pdata, access_mode::Enum mode, bool include_ghosts)
+    : m_pdata(pdata), m_mode(mode)
+    {
+    N = pdata.getN() + (include_ghosts ? pdata.getNGhosts() : 0);
+
+    ParticleSoAScratch& scratch = pdata.m_soa_vel;
+    claimScratch(pdata.getExecConf(), scratch, N, false);
+    x = scratch.x.data();
+    y = scratch.y.data();
+    z = scratch.z.data();
+    mass = scratch.w.data();
+
+    if (mode != access_mode::overwrite)
+        {
+        ArrayHandle<Scalar4> h_vel(pdata.getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const Scalar4 velmass = h_vel.data[i];
+            x[i] = velmass.x;
+            y[i] = velmass.y;
+            z[i] = velmass.z;
+            mass[i] = velmass.w;
+            }
+        }
+    }
+
+VelocitiesSoAHandle::~VelocitiesSoAHandle()
+    {
+    if (m_mode != access_mode::read)
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata.getVelocities(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            h_vel.data[i] = make_scalar4(x[i], y[i], z[i], mass[i]);
+        }
+
+    m_pdata.m_soa_vel.in_use = false;
+    }
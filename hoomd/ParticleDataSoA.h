@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleDataSoA.h
+    \brief Declares structure-of-arrays views of the hot particle data fields
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __PARTICLE_DATA_SOA_H__
+#define __PARTICLE_DATA_SOA_H__
+
+#include "ParticleData.h"
+
+//! Host view of the particle positions and types as separate contiguous arrays
+/*! ParticleData stores positions and types packed into a Scalar4 array, which suits the GPU but forces CPU loops to
+    stride over the type in \a w and prevents the compiler from vectorizing over particles. A PositionsSoAHandle
+    gathers the positions into contiguous \a x, \a y and \a z arrays and the types into a compact unsigned int array
+    while it is alive. When acquired with access_mode::readwrite or access_mode::overwrite, the (possibly modified)
+    values are scattered back into the Scalar4 array on destruction, so all other consumers of getPositions() keep
+    working unchanged.
+
+    Acquiring a view costs one pass over the particles (and a second one for writable views), so a kernel should
+    only use it when it reads the arrays in vectorized loops that outweigh the copy, not as a drop-in replacement for
+    an ArrayHandle in a gather loop such as a neighbor list traversal.
+
+    The arrays are owned by ParticleData and reused between views. Only one position view may exist at a time, and
+    the Scalar4 array must not be accessed while a writable view is held.
+
+    Usage:
+    \code
+    PositionsSoAHandle pos(*m_pdata, access_mode::read);
+    for (unsigned int i = 0; i < pos.N; i++)
+        r2[i] = pos.x[i]*pos.x[i] + pos.y[i]*pos.y[i] + pos.z[i]*pos.z[i];
+    \endcode
+*/
+class PYBIND11_EXPORT PositionsSoAHandle
+    {
+    public:
+        //! Gather the positions and types
+        PositionsSoAHandle(ParticleData& pdata, access_mode::Enum mode, bool include_ghosts=false);
+
+        //! Scatter the positions and types back if they were writable
+        ~PositionsSoAHandle();
+
+        Scalar* x;                  //!< x coordinates
+        Scalar* y;                  //!< y coordinates
+        Scalar* z;                  //!< z coordinates
+        unsigned int* type;         //!< Type ids
+        unsigned int N;             //!< Number of particles in the view
+
+    private:
+        ParticleData& m_pdata;      //!< The particle data
+        access_mode::Enum m_mode;   //!< Access mode of the view
+    };
+
+//! Host view of the particle velocities and masses as separate contiguous arrays
+/*! The velocity counterpart of PositionsSoAHandle. The masses are stored in \a mass.
+*/
+class PYBIND11_EXPORT VelocitiesSoAHandle
+    {
+    public:
+        //! Gather the velocities and masses
+        VelocitiesSoAHandle(ParticleData& pdata, access_mode::Enum mode, bool include_ghosts=false);
+
+        //! Scatter the velocities and masses back if they were writable
+        ~VelocitiesSoAHandle();
+
+        Scalar* x;                  //!< x components
+        Scalar* y;                  //!< y components
+        Scalar* z;                  //!< z components
+        Scalar* mass;               //!< Masses
+        unsigned int N;             //!< Number of particles in the view
+
+    private:
+        ParticleData& m_pdata;      //!< The particle data
+        access_mode::Enum m_mode;   //!< Access mode of the view
+    };
+
+#endif
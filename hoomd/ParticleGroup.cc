@@ -357,6 +357,204 @@ std::vector<unsigned int> ParticleSelectorCuboid::getSelectedTags() const
     return member_tags;
     }
 
+//////////////////////////////////////////////////////////////////////////////
+// ParticleGroupMembership
+
+/*! \param pdata Particle data of the groups
+*/
+ParticleGroupMembership::ParticleGroupMembership(std::shared_ptr<ParticleData> pdata)
+    : m_pdata(pdata), m_n_words(1), m_idx_dirty(true)
+    {
+    m_pdata->getParticleSortSignal().connect<ParticleGroupMembership, &ParticleGroupMembership::slotParticleSort>(this);
+    }
+
+ParticleGroupMembership::~ParticleGroupMembership()
+    {
+    m_pdata->getParticleSortSignal().disconnect<ParticleGroupMembership, &ParticleGroupMembership::slotParticleSort>(this);
+    }
+
+/*! \param pdata Particle data of the groups
+    \returns The membership of \a pdata, created if no group of \a pdata exists yet
+
+    The ParticleData only holds a weak reference, the membership is owned by the groups.
+*/
+std::shared_ptr<ParticleGroupMembership> ParticleGroupMembership::get(std::shared_ptr<ParticleData> pdata)
+    {
+    std::shared_ptr<ParticleGroupMembership> membership = pdata->m_group_membership.lock();
+    if (!membership)
+        {
+        membership = std::shared_ptr<ParticleGroupMembership>(new ParticleGroupMembership(pdata));
+        pdata->m_group_membership = membership;
+        }
+    return membership;
+    }
+
+/*! \param group Group to register
+    \returns The bit assigned to the group
+*/
+unsigned int ParticleGroupMembership::addGroup(const ParticleGroup *group)
+    {
+    // reuse the bit of a destroyed group
+    for (unsigned int slot = 0; slot < m_groups.size(); slot++)
+        {
+        if (m_groups[slot] == nullptr)
+            {
+            m_groups[slot] = group;
+            return slot;
+            }
+        }
+
+    m_groups.push_back(group);
+    if (m_groups.size() > 64*m_n_words)
+        resizeMasks(m_n_words + 1);
+
+    return (unsigned int)m_groups.size() - 1;
+    }
+
+/*! \param slot Bit of the group
+    \param tags Current member tags of the group
+    \param n Number of member tags
+*/
+void ParticleGroupMembership::removeGroup(unsigned int slot, const unsigned int *tags, unsigned int n)
+    {
+    setMembers(slot, tags, n, nullptr, 0);
+    m_groups[slot] = nullptr;
+    }
+
+/*! \param slot Bit of the group
+    \param old_tags Previous member tags of the group
+    \param n_old Number of previous member tags
+    \param new_tags New member tags of the group
+    \param n_new Number of new member tags
+
+    Only the bits of the old and new members are changed.
+*/
+void ParticleGroupMembership::setMembers(unsigned int slot,
+                                         const unsigned int *old_tags,
+                                         unsigned int n_old,
+                                         const unsigned int *new_tags,
+                                         unsigned int n_new)
+    {
+    resizeTags();
+
+    const unsigned int word = slot / 64;
+    const uint64_t bit = uint64_t(1) << (slot % 64);
+
+    for (unsigned int i = 0; i < n_old; i++)
+        m_tag_mask[size_t(old_tags[i])*m_n_words + word] &= ~bit;
+
+    for (unsigned int i = 0; i < n_new; i++)
+        m_tag_mask[size_t(new_tags[i])*m_n_words + word] |= bit;
+
+    m_idx_dirty = true;
+    }
+
+/*! \param slot Bit of the group whose index list is requested
+
+    Besides the requested group, the index lists of all groups that have not been rebuilt since the last particle sort
+    are written in the same pass. Groups that still have to update their member tags are left for later.
+*/
+void ParticleGroupMembership::rebuildIndexLists(unsigned int slot)
+    {
+    m_pdata->getExecConf()->msg->notice(10) << "ParticleGroupMembership: rebuilding index lists" << std::endl;
+
+    resizeTags();
+
+    // select the groups to rebuild
+    const unsigned int n_groups = (unsigned int)m_groups.size();
+    std::vector<uint64_t> target(m_n_words, 0);
+    std::vector< std::unique_ptr< ArrayHandle<unsigned int> > > h_member_idx(n_groups);
+    std::vector<unsigned int> n_members(n_groups, 0);
+    for (unsigned int g = 0; g < n_groups; g++)
+        {
+        const ParticleGroup *group = m_groups[g];
+        if (group == nullptr)
+            continue;
+
+        if (g == slot || (group->m_particles_sorted && !group->m_global_ptl_num_change))
+            {
+            target[g / 64] |= uint64_t(1) << (g % 64);
+            h_member_idx[g].reset(new ArrayHandle<unsigned int>(group->m_member_idx,
+                                                                 access_location::host,
+                                                                 access_mode::overwrite));
+            }
+        }
+
+    const unsigned int nparticles = m_pdata->getN();
+    const unsigned int n_words = m_n_words;
+    const bool gather = m_idx_dirty || m_idx_mask.size() < size_t(nparticles)*n_words;
+    if (gather && m_idx_mask.size() < size_t(nparticles)*n_words)
+        m_idx_mask.resize(size_t(nparticles)*n_words);
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int idx = 0; idx < nparticles; idx++)
+        {
+        uint64_t *idx_mask = &m_idx_mask[size_t(idx)*n_words];
+        if (gather)
+            {
+            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+            const uint64_t *tag_mask = &m_tag_mask[size_t(h_tag.data[idx])*n_words];
+            for (unsigned int w = 0; w < n_words; w++)
+                idx_mask[w] = tag_mask[w];
+            }
+
+        for (unsigned int w = 0; w < n_words; w++)
+            {
+            uint64_t bits = idx_mask[w] & target[w];
+            while (bits)
+                {
+                const unsigned int g = w*64 + __builtin_ctzll(bits);
+                assert(n_members[g] < m_groups[g]->m_member_idx.getNumElements());
+                h_member_idx[g]->data[n_members[g]++] = idx;
+                bits &= bits - 1;
+                }
+            }
+        }
+
+    m_idx_dirty = false;
+
+    for (unsigned int g = 0; g < n_groups; g++)
+        {
+        if (h_member_idx[g])
+            {
+            m_groups[g]->m_num_local_members = n_members[g];
+            m_groups[g]->m_particles_sorted = false;
+            }
+        }
+    }
+
+/*! \param n_words New number of words per mask
+
+    Both the tag and the index masks keep their bits, so the index lists of groups that are up to date stay valid.
+*/
+void ParticleGroupMembership::resizeMasks(unsigned int n_words)
+    {
+    restrideMask(m_tag_mask, n_words);
+    restrideMask(m_idx_mask, n_words);
+    m_n_words = n_words;
+    }
+
+/*! \param mask Masks with m_n_words words each
+    \param n_words New number of words per mask
+*/
+void ParticleGroupMembership::restrideMask(std::vector<uint64_t>& mask, unsigned int n_words) const
+    {
+    const size_t n = mask.size() / m_n_words;
+    std::vector<uint64_t> new_mask(n*n_words, 0);
+    for (size_t i = 0; i < n; i++)
+        for (unsigned int w = 0; w < std::min(n_words, m_n_words); w++)
+            new_mask[i*n_words + w] = mask[i*m_n_words + w];
+
+    mask.swap(new_mask);
+    }
+
+void ParticleGroupMembership::resizeTags()
+    {
+    const size_t n_tags = m_pdata->getRTags().size();
+    if (m_tag_mask.size() < n_tags*m_n_words)
+        m_tag_mask.resize(n_tags*m_n_words, 0);
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleGroup
 
@@ -378,13 +576,21 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
       m_global_ptl_num_change(false),
       m_selector(selector),
       m_update_tags(update_tags),
-      m_warning_printed(false)
+      m_warning_printed(false),
+      m_slot(0)
     {
     #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
     #endif
 
+    // on the CPU, the membership flags are shared by all groups
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_membership = ParticleGroupMembership::get(m_pdata);
+        m_slot = m_membership->addGroup(this);
+        }
+
     // update member tag arrays
     updateMemberTags(true);
 
@@ -415,7 +621,8 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
       m_reallocated(false),
       m_global_ptl_num_change(false),
       m_update_tags(false),
-      m_warning_printed(false)
+      m_warning_printed(false),
+      m_slot(0)
     {
     // check input
     unsigned int max_tag = m_pdata->getMaximumTag();
@@ -457,17 +664,27 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
         std::copy(sorted_member_tags.begin(), sorted_member_tags.end(), h_member_tags.data);
         }
 
-    // one byte per particle to indicate membership in the group, initialize with current number of local particles
-    GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
-    m_is_member.swap(is_member);
-    TAG_ALLOCATION(m_is_member);
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        // on the CPU, the membership flags are shared by all groups
+        m_membership = ParticleGroupMembership::get(m_pdata);
+        m_slot = m_membership->addGroup(this);
+        m_membership->setMembers(m_slot, nullptr, 0, sorted_member_tags.data(), (unsigned int)sorted_member_tags.size());
+        }
+    else
+        {
+        // one byte per particle to indicate membership in the group, initialize with current number of local particles
+        GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
+        m_is_member.swap(is_member);
+        TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
 
-    // build the reverse lookup table for tags
-    buildTagHash();
+        // build the reverse lookup table for tags
+        buildTagHash();
+        }
 
     GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
     m_member_idx.swap(member_idx);
@@ -494,6 +711,82 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
     updateGPUAdvice();
     }
 
+/*! \param other Group to copy
+
+    The copy is registered with the signals of the particle data and, on the CPU, gets its own bit in the shared
+    membership masks.
+*/
+ParticleGroup::ParticleGroup(const ParticleGroup& other)
+    : m_num_local_members(0),
+      m_slot(0)
+    {
+    *this = other;
+    }
+
+/*! \param other Group to copy
+    \returns This group
+*/
+ParticleGroup& ParticleGroup::operator=(const ParticleGroup& other)
+    {
+    if (this == &other)
+        return *this;
+
+    // release the connections and the membership bit of the current group
+    if (m_pdata)
+        {
+        m_pdata->getParticleSortSignal().disconnect<ParticleGroup, &ParticleGroup::slotParticleSort>(this);
+        m_pdata->getMaxParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
+        m_pdata->getGlobalParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+        }
+
+    if (m_membership)
+        {
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
+        m_membership->removeGroup(m_slot, h_member_tags.data, (unsigned int)m_member_tags.getNumElements());
+        m_membership.reset();
+        m_slot = 0;
+        }
+
+    m_sysdef = other.m_sysdef;
+    m_pdata = other.m_pdata;
+    m_exec_conf = other.m_exec_conf;
+    m_is_member = other.m_is_member;
+    m_member_idx = other.m_member_idx;
+    m_member_tags = other.m_member_tags;
+    m_num_local_members = other.m_num_local_members;
+    m_particles_sorted = other.m_particles_sorted;
+    m_reallocated = other.m_reallocated;
+    m_global_ptl_num_change = other.m_global_ptl_num_change;
+    m_is_member_tag = other.m_is_member_tag;
+    m_selector = other.m_selector;
+    m_update_tags = other.m_update_tags;
+    m_warning_printed = other.m_warning_printed;
+    #ifdef ENABLE_HIP
+    m_gpu_partition = other.m_gpu_partition;
+    #endif
+
+    if (other.m_membership)
+        {
+        // the copy has the same members under a bit of its own
+        m_membership = other.m_membership;
+        m_slot = m_membership->addGroup(this);
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
+        m_membership->setMembers(m_slot, nullptr, 0, h_member_tags.data, (unsigned int)m_member_tags.getNumElements());
+
+        // the index mask of the new bit is filled by the next rebuild
+        m_particles_sorted = true;
+        }
+
+    if (m_pdata)
+        {
+        m_pdata->getParticleSortSignal().connect<ParticleGroup, &ParticleGroup::slotParticleSort>(this);
+        m_pdata->getMaxParticleNumberChangeSignal().connect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
+        m_pdata->getGlobalParticleNumberChangeSignal().connect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+        }
+
+    return *this;
+    }
+
 ParticleGroup::~ParticleGroup()
     {
     // disconnect the sort connection, but only if there was a particle data to connect it to in the first place
@@ -503,6 +796,12 @@ ParticleGroup::~ParticleGroup()
         m_pdata->getMaxParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
         m_pdata->getGlobalParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
         }
+
+    if (m_membership)
+        {
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
+        m_membership->removeGroup(m_slot, h_member_tags.data, (unsigned int)m_member_tags.getNumElements());
+        }
     }
 
 /*! \param force_update If true, always update member tags
@@ -549,6 +848,17 @@ void ParticleGroup::updateMemberTags(bool force_update) const
             }
         #endif
 
+        // only the bits of the old and new members change
+        if (m_membership)
+            {
+            ArrayHandle<unsigned int> h_old_tags(m_member_tags, access_location::host, access_mode::read);
+            m_membership->setMembers(m_slot,
+                                     h_old_tags.data,
+                                     (unsigned int)m_member_tags.getNumElements(),
+                                     member_tags.data(),
+                                     (unsigned int)member_tags.size());
+            }
+
         // store member tags in GlobalArray
         GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
         m_member_tags.swap(member_tags_array);
@@ -567,17 +877,20 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         TAG_ALLOCATION(m_member_idx);
         }
 
-    // one byte per particle to indicate membership in the group, initialize with current number of local particles
-    GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
-    m_is_member.swap(is_member);
-    TAG_ALLOCATION(m_is_member);
+    if (!m_membership)
+        {
+        // one byte per particle to indicate membership in the group, initialize with current number of local particles
+        GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
+        m_is_member.swap(is_member);
+        TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
 
-    // build the reverse lookup table for tags
-    buildTagHash();
+        // build the reverse lookup table for tags
+        buildTagHash();
+        }
 
     // now that the tag list is completely set up and all memory is allocated, rebuild the index list
     rebuildIndexList();
@@ -585,6 +898,10 @@ void ParticleGroup::updateMemberTags(bool force_update) const
 
 void ParticleGroup::reallocate() const
     {
+    // the shared membership masks grow on demand
+    if (m_membership)
+        return;
+
     m_is_member.resize(m_pdata->getMaxN());
 
     if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
@@ -825,27 +1142,8 @@ void ParticleGroup::rebuildIndexList() const
     else
     #endif
         {
-
-        // rebuild the membership flags for the  indices in the group and construct member list
-        ArrayHandle<unsigned int> h_is_member(m_is_member, access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::read);
-        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-        ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
-        unsigned int nparticles = m_pdata->getN();
-        unsigned int cur_member = 0;
-        for (unsigned int idx = 0; idx < nparticles; idx ++)
-            {
-            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
-            h_is_member.data[idx] =  is_member;
-            if (is_member)
-                {
-                h_member_idx.data[cur_member] = idx;
-                cur_member++;
-                }
-            }
-
-        m_num_local_members = cur_member;
+        // rebuild the index lists of all groups at once
+        m_membership->rebuildIndexLists(m_slot);
         assert(m_num_local_members <= m_member_tags.getNumElements());
         }
 
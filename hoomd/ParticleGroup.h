@@ -17,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
 #include <pybind11/pybind11.h>
 
 #include "GlobalArray.h"
@@ -175,6 +176,84 @@ class PYBIND11_EXPORT ParticleSelectorRigidCenter : public ParticleSelector
     };
 
 
+class ParticleGroup;
+
+//! Membership bits of all particle groups of one ParticleData
+/*! On the CPU, every ParticleGroup registers with the ParticleGroupMembership of its ParticleData and is assigned one
+    bit. The membership stores one bit mask per tag, with the bit of every group that contains the tag set, and one bit
+    mask per local particle index. Tags do not change when particles are sorted or migrate to another rank, so the
+    tag masks only change when the member tags of a group change, and then only the bits of its old and new members
+    are touched.
+
+    After particles have been sorted, migrated, added or removed, rebuildIndexLists() gathers the index masks from the
+    tag masks in a single pass over the local particles, and the same pass writes the index lists of all groups that
+    need them. A particle sort costs O(N) for all groups together, instead of O(N) per group.
+
+    One membership exists per ParticleData, which keeps a weak reference to it. It is created by the first group (see
+    get()) and destroyed with the last.
+*/
+class PYBIND11_EXPORT ParticleGroupMembership
+    {
+    public:
+        //! Constructor
+        ParticleGroupMembership(std::shared_ptr<ParticleData> pdata);
+
+        //! Destructor
+        ~ParticleGroupMembership();
+
+        //! Get the membership shared by all groups of a ParticleData
+        static std::shared_ptr<ParticleGroupMembership> get(std::shared_ptr<ParticleData> pdata);
+
+        //! Register a group and assign its bit
+        unsigned int addGroup(const ParticleGroup *group);
+
+        //! Unregister a group and clear the bits of its members
+        void removeGroup(unsigned int slot, const unsigned int *tags, unsigned int n);
+
+        //! Replace the member tags of a group
+        void setMembers(unsigned int slot,
+                        const unsigned int *old_tags,
+                        unsigned int n_old,
+                        const unsigned int *new_tags,
+                        unsigned int n_new);
+
+        //! Rebuild the index list of a group, and those of all other groups that are out of date, in one pass
+        void rebuildIndexLists(unsigned int slot);
+
+        //! Test if a particle index is a member of a group
+        /*! \param slot Bit of the group
+            \param idx Index of the particle
+            \pre The index list of the group is up to date
+        */
+        bool isMember(unsigned int slot, unsigned int idx) const
+            {
+            return (m_idx_mask[idx*m_n_words + slot/64] >> (slot % 64)) & 1;
+            }
+
+    private:
+        std::shared_ptr<ParticleData> m_pdata;          //!< The particle data
+        std::vector<const ParticleGroup *> m_groups;    //!< Group of every bit (null for unused bits)
+        unsigned int m_n_words;                         //!< Number of 64 bit words per mask
+        std::vector<uint64_t> m_tag_mask;               //!< Membership bits of every tag
+        std::vector<uint64_t> m_idx_mask;               //!< Membership bits of every local particle index
+        bool m_idx_dirty;                               //!< True if the index masks must be gathered again
+
+        //! Change the number of words per mask
+        void resizeMasks(unsigned int n_words);
+
+        //! Copy a set of masks to a new number of words per mask
+        void restrideMask(std::vector<uint64_t>& mask, unsigned int n_words) const;
+
+        //! Grow the tag masks to the size of the reverse tag table
+        void resizeTags();
+
+        //! Helper function to be called when the particles are resorted
+        void slotParticleSort()
+            {
+            m_idx_dirty = true;
+            }
+    };
+
 //! Describes a group of particles
 /*! \b Overview
 
@@ -212,6 +291,9 @@ class PYBIND11_EXPORT ParticleSelectorRigidCenter : public ParticleSelector
     For that it needs a list of indices of all the particles in the group. To facilitates this, the list of indices
     in the group will be stored in a GPUArray.
 
+    On the CPU, the by-tag and by-index membership flags are not stored per group. All groups of a ParticleData share
+    the bit masks of a ParticleGroupMembership, which rebuilds the index lists of all groups in one pass after a sort.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT ParticleGroup
@@ -221,7 +303,7 @@ class PYBIND11_EXPORT ParticleGroup
         // @{
 
         //! Constructs an empty particle group
-        ParticleGroup() : m_num_local_members(0) {};
+        ParticleGroup() : m_num_local_members(0), m_slot(0) {};
 
         //! Constructs a particle group of all particles that meet the given selection
         ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ParticleSelector> selector,
@@ -230,6 +312,12 @@ class PYBIND11_EXPORT ParticleGroup
         //! Constructs a particle group given a list of tags
         ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std::vector<unsigned int>& member_tags);
 
+        //! Copy constructor
+        ParticleGroup(const ParticleGroup& other);
+
+        //! Copy assignment operator
+        ParticleGroup& operator=(const ParticleGroup& other);
+
         //! Destructor
         ~ParticleGroup();
 
@@ -302,6 +390,9 @@ class PYBIND11_EXPORT ParticleGroup
             {
             checkRebuild();
 
+            if (m_membership)
+                return m_membership->isMember(m_slot, idx);
+
             ArrayHandle<unsigned int> h_handle(m_is_member, access_location::host, access_mode::read);
             return h_handle.data[idx] == 1;
             }
@@ -320,6 +411,17 @@ class PYBIND11_EXPORT ParticleGroup
             return m_member_idx;
             }
 
+        //! Direct access to the list of member tags
+        /*! \returns The tags of all members of the group (on all ranks), in ascending order
+            \note The caller \b must \b not write to or change the array.
+        */
+        const GlobalArray<unsigned int>& getMemberTagArray() const
+            {
+            checkRebuild();
+
+            return m_member_tags;
+            }
+
         #ifdef ENABLE_HIP
         //! Return the load balancing GPU partition
         const GPUPartition& getGPUPartition() const
@@ -375,6 +477,8 @@ class PYBIND11_EXPORT ParticleGroup
 
         bool m_update_tags;                             //!< True if tags should be updated when global number of particles changes
         mutable bool m_warning_printed;                         //!< True if warning about static groups has been printed
+        std::shared_ptr<ParticleGroupMembership> m_membership;  //!< Shared membership bits (CPU only)
+        unsigned int m_slot;                            //!< Bit of this group in m_membership
 
         #ifdef ENABLE_HIP
         mutable GPUPartition m_gpu_partition;           //!< A handy struct to store load balancing info for this group's local members
@@ -442,6 +546,7 @@ class PYBIND11_EXPORT ParticleGroup
         void rebuildIndexListGPU() const;
 #endif
 
+        friend class ParticleGroupMembership;
     };
 
 //! Exports the ParticleGroup class to python
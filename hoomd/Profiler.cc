@@ -10,8 +10,17 @@
 
 #include "Profiler.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
 
 using namespace std;
@@ -188,10 +197,113 @@ void ProfileDataElem::output_line(std::ostream &o,
     o << endl;
     }
 
+////////////////////////////////////////////////////////////////////
+// TraceBuffer
+
+//! One region recorded in tracing mode
+struct TraceEvent
+    {
+    int64_t start;          //!< Start time in nanoseconds
+    int64_t duration;       //!< Duration in nanoseconds
+    unsigned int region;    //!< Region id
+    unsigned int depth;     //!< Number of enclosing regions
+    };
+
+//! Events recorded by one thread in tracing mode
+/*! Only the owning thread writes to the buffer, so recording needs no locks. The events are kept in a ring that
+    overwrites the oldest events when it is full, while the time and number of calls per region keep counting.
+*/
+class TraceBuffer
+    {
+    public:
+        //! Construct a buffer
+        /*! \param thread Thread that owns the buffer
+            \param tid Index of the thread in the trace
+            \param capacity Number of events kept in the ring
+        */
+        TraceBuffer(std::thread::id thread, unsigned int tid, unsigned int capacity)
+            : m_thread(thread), m_tid(tid), m_events(capacity), m_count(0)
+            {
+            }
+
+        //! Record the start of a region
+        void begin(unsigned int region, int64_t t)
+            {
+            m_open.push_back(std::make_pair(region, t));
+            }
+
+        //! Record the end of the innermost region
+        void end(int64_t t)
+            {
+            assert(!m_open.empty());
+            std::pair<unsigned int, int64_t> r = m_open.back();
+            m_open.pop_back();
+
+            TraceEvent& e = m_events[m_count % m_events.size()];
+            e.start = r.second;
+            e.duration = t - r.second;
+            e.region = r.first;
+            e.depth = (unsigned int)m_open.size();
+            m_count++;
+
+            if (r.first >= m_total.size())
+                {
+                m_total.resize(r.first+1, 0);
+                m_calls.resize(r.first+1, 0);
+                }
+            m_total[r.first] += e.duration;
+            m_calls[r.first]++;
+            }
+
+        std::thread::id m_thread;   //!< Thread that owns the buffer
+        unsigned int m_tid;         //!< Index of the thread in the trace
+        std::unordered_map<std::string, unsigned int> m_cache;  //!< Region ids of the names seen by this thread
+        std::vector< std::pair<unsigned int, int64_t> > m_open; //!< Open regions and their start times
+        std::vector<TraceEvent> m_events;   //!< Ring of recorded events
+        uint64_t m_count;                   //!< Total number of events recorded
+        std::vector<int64_t> m_total;       //!< Total time per region
+        std::vector<uint64_t> m_calls;      //!< Number of calls per region
+    };
+
+namespace
+{
+//! Number of events kept per thread
+const unsigned int trace_capacity = 1 << 18;
+
+//! Source of unique profiler ids
+std::atomic<uint64_t> next_profiler_id(1);
+
+//! Cached trace buffer of the calling thread and the profiler it belongs to
+struct ThreadTraceBuffer
+    {
+    uint64_t profiler;  //!< Id of the profiler that owns the buffer
+    TraceBuffer *buf;   //!< Buffer of the calling thread
+    };
+
+thread_local ThreadTraceBuffer thread_trace_buffer = {0, NULL};
+
+//! Escape a string for JSON output
+std::string jsonEscape(const std::string& s)
+    {
+    std::string out;
+    for (unsigned int i = 0; i < s.size(); i++)
+        {
+        if (s[i] == '"' || s[i] == '\\')
+            out += '\\';
+        out += s[i];
+        }
+    return out;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
-Profiler::Profiler(const std::string& name) : m_name(name)
+/*! \param name Name of the profile
+    \param trace Set to true to record a trace instead of the tree
+*/
+Profiler::Profiler(const std::string& name, bool trace)
+    : m_name(name), m_trace(trace), m_id(next_profiler_id++)
     {
     // push the root onto the top of the stack so that it is the default
     m_stack.push(&m_root);
@@ -223,6 +335,246 @@ void Profiler::output(std::ostream &o)
     m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
     }
 
+Profiler::~Profiler()
+    {
+    }
+
+/*! \param name Name of the region
+    \returns The id of the region
+*/
+unsigned int Profiler::getRegion(const std::string& name)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unordered_map<std::string, unsigned int>::iterator it = m_region_ids.find(name);
+    if (it != m_region_ids.end())
+        return it->second;
+
+    unsigned int region = (unsigned int)m_region_names.size();
+    m_region_names.push_back(name);
+    m_region_ids[name] = region;
+    return region;
+    }
+
+/*! \param region Id of the region returned by getRegion()
+*/
+void Profiler::push(unsigned int region)
+    {
+    // nvtools ranges are pushed by name, see push(const std::string&)
+    #ifndef ENABLE_NVTOOLS
+    if (m_trace)
+        {
+        pushTrace(region);
+        return;
+        }
+    #endif
+
+    std::string name;
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        name = m_region_names[region];
+        }
+    push(name);
+    }
+
+/*! The buffer is looked up once per thread and then cached in thread local storage.
+*/
+TraceBuffer& Profiler::getThreadBuffer()
+    {
+    if (thread_trace_buffer.profiler == m_id)
+        return *thread_trace_buffer.buf;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::thread::id thread = std::this_thread::get_id();
+    TraceBuffer *buf = NULL;
+    for (unsigned int i = 0; i < m_buffers.size(); i++)
+        {
+        if (m_buffers[i]->m_thread == thread)
+            buf = m_buffers[i].get();
+        }
+
+    if (!buf)
+        {
+        m_buffers.push_back(std::unique_ptr<TraceBuffer>(
+            new TraceBuffer(thread, (unsigned int)m_buffers.size(), trace_capacity)));
+        buf = m_buffers.back().get();
+        }
+
+    thread_trace_buffer.profiler = m_id;
+    thread_trace_buffer.buf = buf;
+    return *buf;
+    }
+
+/*! \param name Name of the region
+*/
+void Profiler::pushTrace(const std::string& name)
+    {
+    TraceBuffer& buf = getThreadBuffer();
+
+    unsigned int region;
+    std::unordered_map<std::string, unsigned int>::iterator it = buf.m_cache.find(name);
+    if (it != buf.m_cache.end())
+        {
+        region = it->second;
+        }
+    else
+        {
+        region = getRegion(name);
+        buf.m_cache[name] = region;
+        }
+
+    buf.begin(region, m_clk.getTime());
+    }
+
+/*! \param region Id of the region
+*/
+void Profiler::pushTrace(unsigned int region)
+    {
+    getThreadBuffer().begin(region, m_clk.getTime());
+    }
+
+void Profiler::popTrace()
+    {
+    int64_t t = m_clk.getTime();
+    getThreadBuffer().end(t);
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname File to write
+
+    Each rank appears as one process and each thread as one thread in the trace. Only the most recent events that fit
+    in the ring buffers are written.
+*/
+void Profiler::writeTrace(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ofstream f(fname.c_str());
+    if (!f.good())
+        {
+        exec_conf->msg->error() << "Unable to open trace file " << fname << endl;
+        throw runtime_error("Error writing trace");
+        }
+
+    unsigned int pid = exec_conf->getRank();
+    f << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << endl;
+    f << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+      << ",\"args\":{\"name\":\"rank " << pid << "\"}}";
+
+    f << setiosflags(ios::fixed) << setprecision(3);
+    for (unsigned int i = 0; i < m_buffers.size(); i++)
+        {
+        const TraceBuffer& buf = *m_buffers[i];
+        uint64_t n = std::min(buf.m_count, (uint64_t)buf.m_events.size());
+        uint64_t first = buf.m_count - n;
+        for (uint64_t k = first; k < buf.m_count; k++)
+            {
+            const TraceEvent& e = buf.m_events[k % buf.m_events.size()];
+            f << "," << endl << "{\"name\":\"" << jsonEscape(m_region_names[e.region])
+              << "\",\"ph\":\"X\",\"ts\":" << double(e.start)/1e3 << ",\"dur\":" << double(e.duration)/1e3
+              << ",\"pid\":" << pid << ",\"tid\":" << buf.m_tid << "}";
+            }
+        }
+    f << endl << "]}" << endl;
+
+    if (!f.good())
+        {
+        exec_conf->msg->error() << "I/O error while writing trace file " << fname << endl;
+        throw runtime_error("Error writing trace");
+        }
+    }
+
+/*! \param exec_conf Execution configuration
+    \returns The summary on the root rank, an empty string on all other ranks
+
+    The time of each region is summed over the threads of a rank. The root rank gathers the totals of all ranks and
+    lists the minimum, average and maximum over the ranks, and the ratio of maximum to average as a measure of the
+    load imbalance.
+*/
+std::string Profiler::getTraceSummary(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    // total time and number of calls per region name on this rank
+    std::map<std::string, std::pair<int64_t, uint64_t> > local;
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (unsigned int i = 0; i < m_buffers.size(); i++)
+            {
+            const TraceBuffer& buf = *m_buffers[i];
+            for (unsigned int region = 0; region < buf.m_total.size(); region++)
+                {
+                if (buf.m_calls[region] == 0)
+                    continue;
+                std::pair<int64_t, uint64_t>& r = local[m_region_names[region]];
+                r.first += buf.m_total[region];
+                r.second += buf.m_calls[region];
+                }
+            }
+        }
+
+    std::vector< std::map<std::string, std::pair<int64_t, uint64_t> > > all(1, local);
+    #ifdef ENABLE_MPI
+    if (exec_conf->getNRanks() > 1)
+        gather_v(local, all, 0, exec_conf->getMPICommunicator());
+    #endif
+
+    if (!exec_conf->isRoot())
+        return std::string();
+
+    // minimum, average, maximum time and maximum number of calls over the ranks
+    struct Stats
+        {
+        double min, avg, max;
+        uint64_t calls;
+        };
+    std::map<std::string, Stats> stats;
+    for (unsigned int rank = 0; rank < all.size(); rank++)
+        {
+        std::map<std::string, std::pair<int64_t, uint64_t> >::const_iterator it;
+        for (it = all[rank].begin(); it != all[rank].end(); ++it)
+            stats[it->first] = Stats{0.0, 0.0, 0.0, 0};
+        }
+
+    for (std::map<std::string, Stats>::iterator it = stats.begin(); it != stats.end(); ++it)
+        {
+        Stats& st = it->second;
+        for (unsigned int rank = 0; rank < all.size(); rank++)
+            {
+            std::map<std::string, std::pair<int64_t, uint64_t> >::const_iterator r = all[rank].find(it->first);
+            double sec = (r == all[rank].end()) ? 0.0 : double(r->second.first)/1e9;
+            uint64_t calls = (r == all[rank].end()) ? 0 : r->second.second;
+            st.min = (rank == 0) ? sec : std::min(st.min, sec);
+            st.max = std::max(st.max, sec);
+            st.avg += sec/double(all.size());
+            st.calls = std::max(st.calls, calls);
+            }
+        }
+
+    // list the regions by their maximum time
+    std::vector< std::pair<double, std::string> > order;
+    unsigned int name_width = 6;
+    for (std::map<std::string, Stats>::iterator it = stats.begin(); it != stats.end(); ++it)
+        {
+        order.push_back(std::make_pair(-it->second.max, it->first));
+        name_width = std::max(name_width, (unsigned int)it->first.size());
+        }
+    std::sort(order.begin(), order.end());
+
+    ostringstream o;
+    o << m_name << " trace summary over " << all.size() << " rank(s), time in seconds" << endl;
+    o << setw(name_width) << left << "Region" << right << setw(12) << "calls" << setw(12) << "min" << setw(12) << "avg"
+      << setw(12) << "max" << setw(12) << "max/avg" << endl;
+    o << setiosflags(ios::fixed);
+    for (unsigned int i = 0; i < order.size(); i++)
+        {
+        const Stats& st = stats[order[i].second];
+        o << setw(name_width) << left << order[i].second << right << setw(12) << st.calls
+          << setprecision(4) << setw(12) << st.min << setw(12) << st.avg << setw(12) << st.max
+          << setprecision(3) << setw(12) << ((st.avg > 0.0) ? st.max/st.avg : 1.0) << endl;
+        }
+
+    return o.str();
+    }
+
 /*! \param o Stream to output to
     \param prof Profiler to print
 */
@@ -26,6 +26,11 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <iostream>
 #include <cassert>
 
@@ -42,6 +47,7 @@
 // forward declarations
 class ProfileDataElem;
 class Profiler;
+class TraceBuffer;
 
 /*! \ingroup hoomd_lib
     @{
@@ -115,23 +121,52 @@ class PYBIND11_EXPORT ProfileDataElem
 
     There are versions of push() and pop() that take in a reference to an ExecutionConfiguration.
     These methods automatically synchronize with the asynchronous GPU execution stream in order
-    to provide accurate timing information.
+    to provide accurate timing information. In tracing mode they do not synchronize, so the trace shows the
+    host timeline and GPU regions only measure the time to launch their kernels.
 
     These profiles can of course be output via normal ostream operators.
+
+    In tracing mode, the profiler does not build the tree. Every pop() instead records one event with the region, its
+    start time and its duration into a ring buffer that belongs to the calling thread, so recording takes no locks and
+    the memory use is bounded. Region names are interned to integer ids; each thread caches the ids of the names it has
+    seen, and hot code can look up an id once with getRegion() and push() it directly. writeTrace() writes the events
+    in the Chrome trace event format that Perfetto and chrome://tracing load, and getTraceSummary() reports the time
+    per region with its minimum, average and maximum over the MPI ranks.
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
     {
     public:
         //! Constructs an empty profiler and starts its timer ticking
-        Profiler(const std::string& name = "Profile");
+        Profiler(const std::string& name = "Profile", bool trace = false);
+        //! Destructor
+        ~Profiler();
         //! Pushes a new sub-category into the current category
         void push(const std::string& name);
+        //! Pushes a region by its id
+        void push(unsigned int region);
         //! Pops back up to the next super-category
         void pop(uint64_t flop_count = 0, uint64_t byte_count = 0);
 
+        //! Get the id of a region, registering the name on first use
+        unsigned int getRegion(const std::string& name);
+
+        //! Returns true if the profiler records a trace instead of the tree
+        bool isTracing() const
+            {
+            return m_trace;
+            }
+
+        //! Write the recorded events of this rank in the Chrome trace event format
+        void writeTrace(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname);
+
+        //! Summarize the time per region over all ranks (collective call)
+        std::string getTraceSummary(std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
         //! Pushes a new sub-category into the current category & syncs the GPUs
         void push(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name);
+        //! Pushes a region by its id & syncs the GPUs
+        void push(std::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int region);
         //! Pops back up to the next super-category & syncs the GPUs
         void pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count = 0, uint64_t byte_count = 0);
 
@@ -141,6 +176,25 @@ class PYBIND11_EXPORT Profiler
         ProfileDataElem m_root; //!< The root profile element
         std::stack<ProfileDataElem *> m_stack;  //!< A stack of data elements for the push/pop structure
 
+        bool m_trace;       //!< True in tracing mode
+        uint64_t m_id;      //!< Unique id of this profiler, used to find the buffers of the calling thread
+        std::mutex m_mutex; //!< Protects the region table and the list of buffers
+        std::deque<std::string> m_region_names;                     //!< Region id -> name
+        std::unordered_map<std::string, unsigned int> m_region_ids; //!< Region name -> id
+        std::vector< std::unique_ptr<TraceBuffer> > m_buffers;      //!< Event buffers of all threads
+
+        //! Get the event buffer of the calling thread
+        TraceBuffer& getThreadBuffer();
+
+        //! Record the start of a region in tracing mode
+        void pushTrace(const std::string& name);
+
+        //! Record the start of a region by id in tracing mode
+        void pushTrace(unsigned int region);
+
+        //! Record the end of the innermost region in tracing mode
+        void popTrace();
+
         //! Output helper function
         void output(std::ostream &o);
 
@@ -163,8 +217,8 @@ PYBIND11_EXPORT std::ostream& operator<<(std::ostream &o, Profiler& prof);
 inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name)
     {
 #if defined(ENABLE_HIP) && !defined(ENABLE_NVTOOLS)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
-    if(exec_conf->isCUDAEnabled())
+    // nvtools profiling and tracing disable synchronization so that async CPU/GPU overlap can be seen
+    if(exec_conf->isCUDAEnabled() && !m_trace)
         {
         exec_conf->multiGPUBarrier();
         hipDeviceSynchronize();
@@ -173,11 +227,24 @@ inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_co
     push(name);
    }
 
+inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int region)
+    {
+#if defined(ENABLE_HIP) && !defined(ENABLE_NVTOOLS)
+    // nvtools profiling and tracing disable synchronization so that async CPU/GPU overlap can be seen
+    if(exec_conf->isCUDAEnabled() && !m_trace)
+        {
+        exec_conf->multiGPUBarrier();
+        hipDeviceSynchronize();
+        }
+#endif
+    push(region);
+    }
+
 inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count, uint64_t byte_count)
     {
 #if defined(ENABLE_HIP) && !defined(ENABLE_NVTOOLS)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
-    if(exec_conf->isCUDAEnabled())
+    // nvtools profiling and tracing disable synchronization so that async CPU/GPU overlap can be seen
+    if(exec_conf->isCUDAEnabled() && !m_trace)
         {
         exec_conf->multiGPUBarrier();
         hipDeviceSynchronize();
@@ -195,33 +262,46 @@ inline void Profiler::push(const std::string& name)
     nvtxRangePush(name.c_str());
     #endif
 
+    if (m_trace)
+        {
+        pushTrace(name);
+        return;
+        }
+
     // pushing a new record on to the stack involves taking a time sample
     int64_t t = m_clk.getTime();
 
     ProfileDataElem *cur = m_stack.top();
 
     // then creating (or accessing) the named sample and setting the start time
-    cur->m_children[name].m_start_time = t;
+    ProfileDataElem *child = &cur->m_children[name];
+    child->m_start_time = t;
 
     // and updating the stack
-    m_stack.push(&cur->m_children[name]);
+    m_stack.push(child);
 
     #ifdef SCOREP_USER_ENABLE
     // log Score-P region
-    SCOREP_USER_REGION_BEGIN( cur->m_children[name].m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
+    SCOREP_USER_REGION_BEGIN( child->m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
     #endif
     }
 
 inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     {
-    // sanity checks
-    assert(!m_stack.empty());
-    assert(!(m_stack.top() == &m_root));
-
     #ifdef ENABLE_NVTOOLS
     nvtxRangePop();
     #endif
 
+    if (m_trace)
+        {
+        popTrace();
+        return;
+        }
+
+    // sanity checks
+    assert(!m_stack.empty());
+    assert(!(m_stack.top() == &m_root));
+
     // popping up a level in the profile stack involves taking a time sample
     int64_t t = m_clk.getTime();
 
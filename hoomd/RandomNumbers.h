@@ -123,6 +123,8 @@ R123_CUDA_DEVICE R123_STATIC_INLINE Ftype uneg11(Itype in)
 
 namespace hoomd
 {
+class RandomGeneratorBatch;
+
 //! Philox random number generator
 /*! random123 is a counter based random number generator. Given an input seed vector,
      it produces a random output. Outputs from one seed to the next are not correlated.
@@ -166,6 +168,8 @@ class RandomGenerator
     private:
         r123::Philox4x32::key_type m_key;   //!< RNG key
         r123::Philox4x32::ctr_type m_ctr;   //!< RNG counter
+
+        friend class RandomGeneratorBatch;
     };
 
 /*! \param seed1 First seed.
@@ -200,6 +204,126 @@ DEVICE inline r123::Philox4x32::ctr_type RandomGenerator::operator()()
     return u;
     }
 
+//! Philox random number generator for a batch of streams
+/*! A RandomGeneratorBatch evaluates the streams of several RandomGenerators that share the two seeds at once.
+    Each lane holds the counters of one generator, e.g. the tag of one particle, and every call to generate() computes
+    the next value of all lanes. The Philox rounds are evaluated on arrays over the lanes, which the compiler maps to
+    SIMD instructions. Lane \a l of the batch produces exactly the same values as
+    RandomGenerator(seed1, seed2, counter1, counter2, counter3) with the counters set by setLane().
+
+    UniformDistribution::generateBatch() and NormalDistribution::generateBatch() draw one value for every one of the
+    n_lanes lanes, bitwise identical to drawing the value from each generator in turn. When the lanes draw different
+    numbers of values later on, getGenerator() continues the stream of one lane with a RandomGenerator.
+
+    This class is for use on the host only.
+ */
+class RandomGeneratorBatch
+    {
+    public:
+        static const unsigned int n_lanes = 8;  //!< Number of lanes in a batch
+
+        //! Constructor
+        /*! \param seed1 First seed
+            \param seed2 Second seed
+        */
+        RandomGeneratorBatch(uint32_t seed1, uint32_t seed2)
+            : m_step(0)
+            {
+            m_key[0] = seed1;
+            m_key[1] = seed2;
+            for (unsigned int l = 0; l < n_lanes; l++)
+                setLane(l, 0, 0, 0);
+            }
+
+        //! Set the counters of one lane
+        /*! \param lane Index of the lane
+            \param counter1 First counter
+            \param counter2 Second counter
+            \param counter3 Third counter
+
+            \post The streams of all lanes are restarted at their first value.
+        */
+        void setLane(unsigned int lane, uint32_t counter1, uint32_t counter2=0, uint32_t counter3=0)
+            {
+            m_ctr[1][lane] = counter3;
+            m_ctr[2][lane] = counter2;
+            m_ctr[3][lane] = counter1;
+            m_step = 0;
+            }
+
+        //! Generate the next uniformly distributed 32-bit values of all lanes
+        /*! \post The values are available through get() and the state of the generator is advanced one step.
+        */
+        void generate()
+            {
+            uint32_t c0[n_lanes], c1[n_lanes], c2[n_lanes], c3[n_lanes];
+            for (unsigned int l = 0; l < n_lanes; l++)
+                {
+                c0[l] = m_step;
+                c1[l] = m_ctr[1][l];
+                c2[l] = m_ctr[2][l];
+                c3[l] = m_ctr[3][l];
+                }
+
+            // Philox4x32 with 10 rounds, see random123/philox.h
+            uint32_t k0 = m_key[0];
+            uint32_t k1 = m_key[1];
+            for (unsigned int round = 0; round < 10; round++)
+                {
+                if (round > 0)
+                    {
+                    k0 += 0x9E3779B9;
+                    k1 += 0xBB67AE85;
+                    }
+
+                for (unsigned int l = 0; l < n_lanes; l++)
+                    {
+                    uint64_t p0 = uint64_t(0xD2511F53) * c0[l];
+                    uint64_t p1 = uint64_t(0xCD9E8D57) * c2[l];
+                    c0[l] = uint32_t(p1 >> 32) ^ c1[l] ^ k0;
+                    c1[l] = uint32_t(p1);
+                    c2[l] = uint32_t(p0 >> 32) ^ c3[l] ^ k1;
+                    c3[l] = uint32_t(p0);
+                    }
+                }
+
+            for (unsigned int l = 0; l < n_lanes; l++)
+                {
+                m_out[0][l] = c0[l];
+                m_out[1][l] = c1[l];
+                m_out[2][l] = c2[l];
+                m_out[3][l] = c3[l];
+                }
+            m_step++;
+            }
+
+        //! Get a value generated by the last call to generate()
+        /*! \param k Element of the Philox output (0 to 3)
+            \param lane Index of the lane
+        */
+        uint32_t get(unsigned int k, unsigned int lane) const
+            {
+            return m_out[k][lane];
+            }
+
+        //! Get a generator that continues the stream of one lane
+        /*! \param lane Index of the lane
+            \returns A RandomGenerator whose next value is the value the next call to generate() makes for \a lane
+        */
+        RandomGenerator getGenerator(unsigned int lane) const
+            {
+            RandomGenerator rng(m_key[0], m_key[1], m_ctr[3][lane], m_ctr[2][lane], m_ctr[1][lane]);
+            rng.m_ctr.v[0] = m_step;
+            return rng;
+            }
+
+    private:
+        uint32_t m_key[2];                  //!< RNG key
+        uint32_t m_ctr[4][n_lanes];         //!< RNG counters of each lane, element 0 is unused
+        uint32_t m_step;                    //!< Stream counter, shared by all lanes
+        uint32_t m_out[4][n_lanes];         //!< Values of the last step
+    };
+
 namespace detail
 {
 
@@ -272,6 +396,20 @@ class UniformDistribution
             return a + width * detail::generate_canonical<Real>(rng);
             }
 
+        //! Draw one value for every lane of a batch
+        /*! \param out [out] Values, one per lane
+            \param rng Batch random number generator
+        */
+        inline void generateBatch(Real *out, RandomGeneratorBatch& rng)
+            {
+            rng.generate();
+            for (unsigned int l = 0; l < RandomGeneratorBatch::n_lanes; l++)
+                {
+                uint64_t u = uint64_t(rng.get(0, l)) << 32 | rng.get(1, l);
+                out[l] = a + width * r123::u01<Real>(u);
+                }
+            }
+
     private:
         const Real a;     //!< Left end point of the interval
         const Real width; //!< Width of the interval
@@ -334,6 +472,40 @@ class NormalDistribution
             out2 = y + mu;
             }
 
+        //! Draw one value for every lane of a batch
+        /*! \param out [out] Values, one per lane
+            \param rng Batch random number generator
+            \param lane_sigma Standard deviation of each lane, *sigma* is used for all lanes when NULL
+        */
+        inline void generateBatch(Real *out, RandomGeneratorBatch& rng, const Real *lane_sigma=nullptr)
+            {
+            const unsigned int n = RandomGeneratorBatch::n_lanes;
+            rng.generate();
+
+            // the transcendental functions are the same as in the single value draw
+            Real s[n], r[n];
+            for (unsigned int l = 0; l < n; l++)
+                {
+                uint64_t u0 = uint64_t(rng.get(0, l)) << 32 | rng.get(1, l);
+                uint64_t u1 = uint64_t(rng.get(2, l)) << 32 | rng.get(3, l);
+                s[l] = r123::uneg11<Real>(u0);
+                r[l] = r123::u01<Real>(u1);
+                }
+
+            for (unsigned int l = 0; l < n; l++)
+                {
+                Real c;
+                fast::sincospi(s[l], s[l], c);
+                r[l] = fast::sqrt(Real(-2.0) * fast::log(r[l]));
+                }
+
+            for (unsigned int l = 0; l < n; l++)
+                {
+                Real x = s[l] * r[l];
+                out[l] = x * (lane_sigma ? lane_sigma[l] : sigma) + mu;
+                }
+            }
+
     private:
         const Real sigma;     //!< Standard deviation
         const Real mu;        //!< Mean
@@ -10,6 +10,9 @@
 
 #include "SnapshotSystemData.h"
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <stdexcept>
 namespace py = pybind11;
 
 template <class Real>
@@ -19,6 +22,9 @@ void SnapshotSystemData<Real>::replicate(unsigned int nx, unsigned int ny, unsig
     assert(ny > 0);
     assert(nz > 0);
 
+    if (particles_local)
+        throw std::runtime_error("Cannot replicate a distributed snapshot");
+
     // Update global box
     BoxDim old_box = global_box;
     Scalar3 L = global_box.getL();
@@ -75,7 +81,8 @@ void SnapshotSystemData<Real>::broadcast(unsigned int root, std::shared_ptr<Exec
         bcast(has_pair_data, root, exec_conf->getMPICommunicator());
         bcast(has_integrator_data, root, exec_conf->getMPICommunicator());
 
-        if (has_particle_data)
+        // a distributed snapshot already holds the particles of every rank
+        if (has_particle_data && !particles_local)
             {
             particle_data.bcast(root, exec_conf->getMPICommunicator());
             bcast(map, root, exec_conf->getMPICommunicator());
@@ -111,7 +118,8 @@ void SnapshotSystemData<Real>::broadcast_all(unsigned int root, std::shared_ptr<
         bcast(has_pair_data, root, hoomd_world);
         bcast(has_integrator_data, root, hoomd_world);
 
-        if (has_particle_data)
+        // a distributed snapshot already holds the particles of every rank
+        if (has_particle_data && !particles_local)
             {
             particle_data.bcast(root, hoomd_world);
             bcast(map, root, hoomd_world);
@@ -151,6 +159,8 @@ void export_SnapshotSystemData(py::module& m)
     .def_readonly("has_improper_data", &SnapshotSystemData<float>::has_improper_data)
     .def_readonly("has_constraint_data", &SnapshotSystemData<float>::has_constraint_data)
     .def_readonly("has_pair_data", &SnapshotSystemData<float>::has_pair_data)
+    .def_readonly("particles_local", &SnapshotSystemData<float>::particles_local)
+    .def_readonly("particle_tags", &SnapshotSystemData<float>::particle_tags)
     .def("replicate", &SnapshotSystemData<float>::replicate)
     .def("_broadcast_box", &SnapshotSystemData<float>::broadcast_box)
     .def("_broadcast", &SnapshotSystemData<float>::broadcast)
@@ -175,6 +185,8 @@ void export_SnapshotSystemData(py::module& m)
     .def_readonly("has_improper_data", &SnapshotSystemData<double>::has_improper_data)
     .def_readonly("has_constraint_data", &SnapshotSystemData<double>::has_constraint_data)
     .def_readonly("has_pair_data", &SnapshotSystemData<double>::has_pair_data)
+    .def_readonly("particles_local", &SnapshotSystemData<double>::particles_local)
+    .def_readonly("particle_tags", &SnapshotSystemData<double>::particle_tags)
     .def("replicate", &SnapshotSystemData<double>::replicate)
     .def("_broadcast_box", &SnapshotSystemData<double>::broadcast_box)
     .def("_broadcast", &SnapshotSystemData<double>::broadcast)
@@ -64,6 +64,9 @@ struct SnapshotSystemData {
     bool has_pair_data;                    //!< True if snapshot contains pair data
     bool has_integrator_data;              //!< True if snapshot contains integrator data
 
+    bool particles_local;                  //!< True if particle_data only holds the particles owned by this rank
+    std::vector<unsigned int> particle_tags;   //!< Global tags of the particles in particle_data if particles_local
+
     //! Constructor
     SnapshotSystemData()
         {
@@ -78,6 +81,8 @@ struct SnapshotSystemData {
         has_constraint_data = true;
         has_pair_data = true;
         has_integrator_data = true;
+
+        particles_local = false;
         }
 
     // Replicate the system along three spatial dimensions
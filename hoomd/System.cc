@@ -638,7 +638,16 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
     // write out the profile data
     if (m_profiler)
-        m_exec_conf->msg->notice(1) << *m_profiler;
+        {
+        if (m_profiler->isTracing())
+            {
+            m_profiler->writeTrace(m_exec_conf, m_trace_fname);
+            std::string summary = m_profiler->getTraceSummary(m_exec_conf);
+            m_exec_conf->msg->notice(1) << summary;
+            }
+        else
+            m_exec_conf->msg->notice(1) << *m_profiler;
+        }
 
     if (!m_quiet_run)
         printStats();
@@ -658,6 +667,15 @@ void System::enableProfiler(bool enable)
     m_profile = enable;
     }
 
+/*! \param fname File to write the trace of each run to, empty to disable tracing
+
+    Tracing takes precedence over the profile tree set with enableProfiler().
+*/
+void System::enableTracing(const std::string& fname)
+    {
+    m_trace_fname = fname;
+    }
+
 /*! \param logger Logger to register computes and updaters with
     All computes and updaters registered with the system are also registered with the logger.
 */
@@ -719,7 +737,9 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 
 void System::setupProfiling()
     {
-    if (m_profile)
+    if (!m_trace_fname.empty())
+        m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation", true));
+    else if (m_profile)
         m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
     else
         m_profiler = std::shared_ptr<Profiler>();
@@ -927,6 +947,7 @@ void export_System(py::module& m)
     .def("setStatsPeriod", &System::setStatsPeriod)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
+    .def("enableTracing", &System::enableTracing)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
 
@@ -150,6 +150,9 @@ class PYBIND11_EXPORT System
         //! Configures profiling of runs
         void enableProfiler(bool enable);
 
+        //! Configures tracing of runs
+        void enableTracing(const std::string& fname);
+
         //! Toggle whether or not to print the status line and TPS for each run
         void enableQuietRun(bool enable)
             {
@@ -421,6 +424,7 @@ class PYBIND11_EXPORT System
 
         bool m_quiet_run;       //!< True to suppress the status line and TPS from being printed to stdout for each run
         bool m_profile;         //!< True if runs should be profiled
+        std::string m_trace_fname;  //!< File to write the trace of a run to (empty to disable tracing)
         unsigned int m_stats_period; //!< Number of seconds between statistics output lines
 
         // --------- Steps in the simulation run implemented in helper functions
@@ -75,10 +75,22 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
     {
     setNDimensions(snapshot->dimensions);
 
-    m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
-                 snapshot->global_box,
-                 exec_conf,
-                 decomposition));
+    if (snapshot->particles_local)
+        {
+        // every rank holds its own particles
+        m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
+                     snapshot->particle_tags,
+                     snapshot->global_box,
+                     exec_conf,
+                     decomposition));
+        }
+    else
+        {
+        m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
+                     snapshot->global_box,
+                     exec_conf,
+                     decomposition));
+        }
 
     #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
@@ -207,6 +219,48 @@ std::shared_ptr< SnapshotSystemData<Real> > SystemDefinition::takeSnapshot(bool
     return snap;
     }
 
+/*! Same as takeSnapshot(), except that the particle data is not gathered on rank 0. Every rank stores the particles
+    it owns in local order, and their tags in SnapshotSystemData::particle_tags. Bonded groups and integrator data are
+    taken as in takeSnapshot().
+
+    \param particles True if particle data should be saved
+    \param bonds True if bond data should be saved
+    \param angles True if angle data should be saved
+    \param dihedrals True if dihedral data should be saved
+    \param impropers True if improper data should be saved
+    \param constraints True if constraint data should be saved
+    \param integrators True if integrator data should be saved
+    \param pairs True if pair data should be saved
+*/
+template <class Real>
+std::shared_ptr< SnapshotSystemData<Real> > SystemDefinition::takeLocalSnapshot(bool particles,
+                                                   bool bonds,
+                                                   bool angles,
+                                                   bool dihedrals,
+                                                   bool impropers,
+                                                   bool constraints,
+                                                   bool integrators,
+                                                   bool pairs)
+    {
+    std::shared_ptr< SnapshotSystemData<Real> > snap = takeSnapshot<Real>(false,
+                                                                          bonds,
+                                                                          angles,
+                                                                          dihedrals,
+                                                                          impropers,
+                                                                          constraints,
+                                                                          integrators,
+                                                                          pairs);
+
+    if (particles)
+        {
+        m_particle_data->takeLocalSnapshot(snap->particle_data, snap->particle_tags);
+        snap->particles_local = true;
+        snap->has_particle_data = true;
+        }
+
+    return snap;
+    }
+
 //! Re-initialize the system from a snapshot
 template <class Real>
 void SystemDefinition::initializeFromSnapshot(std::shared_ptr< SnapshotSystemData<Real> > snapshot)
@@ -224,7 +278,10 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr< SnapshotSystemDat
     if (snapshot->has_particle_data)
         {
         m_particle_data->setGlobalBox(snapshot->global_box);
-        m_particle_data->initializeFromSnapshot(snapshot->particle_data);
+        if (snapshot->particles_local)
+            m_particle_data->initializeFromLocalSnapshot(snapshot->particle_data, snapshot->particle_tags);
+        else
+            m_particle_data->initializeFromSnapshot(snapshot->particle_data);
         }
 
     if (snapshot->has_bond_data)
@@ -276,6 +333,14 @@ template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeSnap
                                                                                               bool constraints,
                                                                                               bool integrators,
                                                                                               bool pairs);
+template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeLocalSnapshot<float>(bool particles,
+                                                                                              bool bonds,
+                                                                                              bool angles,
+                                                                                              bool dihedrals,
+                                                                                              bool impropers,
+                                                                                              bool constraints,
+                                                                                              bool integrators,
+                                                                                              bool pairs);
 template void SystemDefinition::initializeFromSnapshot<float>(std::shared_ptr< SnapshotSystemData<float> > snapshot);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > snapshot,
@@ -289,6 +354,14 @@ template std::shared_ptr< SnapshotSystemData<double> > SystemDefinition::takeSna
                                                                                               bool constraints,
                                                                                               bool integrators,
                                                                                               bool pairs);
+template std::shared_ptr< SnapshotSystemData<double> > SystemDefinition::takeLocalSnapshot<double>(bool particles,
+                                                                                              bool bonds,
+                                                                                              bool angles,
+                                                                                              bool dihedrals,
+                                                                                              bool impropers,
+                                                                                              bool constraints,
+                                                                                              bool integrators,
+                                                                                              bool pairs);
 template void SystemDefinition::initializeFromSnapshot<double>(std::shared_ptr< SnapshotSystemData<double> > snapshot);
 
 void export_SystemDefinition(py::module& m)
@@ -313,6 +386,8 @@ void export_SystemDefinition(py::module& m)
     .def("getPairData", &SystemDefinition::getPairData)
     .def("takeSnapshot_float", &SystemDefinition::takeSnapshot<float>)
     .def("takeSnapshot_double", &SystemDefinition::takeSnapshot<double>)
+    .def("takeLocalSnapshot_float", &SystemDefinition::takeLocalSnapshot<float>)
+    .def("takeLocalSnapshot_double", &SystemDefinition::takeLocalSnapshot<double>)
     .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<float>)
     .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
     ;
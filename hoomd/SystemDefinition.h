@@ -154,6 +154,17 @@ class PYBIND11_EXPORT SystemDefinition
                                                            bool integrators = false,
                                                            bool pairs = false);
 
+        //! Return a snapshot in which every rank holds the particles it owns
+        template <class Real>
+        std::shared_ptr< SnapshotSystemData<Real> > takeLocalSnapshot(bool particles= true,
+                                                           bool bonds = false,
+                                                           bool angles = false,
+                                                           bool dihedrals = false,
+                                                           bool impropers = false,
+                                                           bool constraints = false,
+                                                           bool integrators = false,
+                                                           bool pairs = false);
+
         //! Re-initialize the system from a snapshot
         template <class Real>
         void initializeFromSnapshot(std::shared_ptr< SnapshotSystemData<Real> > snapshot);
@@ -93,7 +93,8 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     Args:
 
         tsteps (int): Number of time steps to advance the simulation.
-        profile (bool): Set to True to enable high level profiling output at the end of the run.
+        profile (bool or str): Set to True to enable high level profiling output at the end of the run. Set to a file
+                               name to record a trace of the run instead.
         limit_hours (float): If not None, limit this run to a given number of hours.
         limit_multiple (int): When stopping the run due to walltime limits, only stop when the time step is a
                               multiple of limit_multiple.
@@ -106,6 +107,7 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
             hoomd.run(10)
             hoomd.run(10e6, limit_hours=1.0/3600.0, limit_multiple=10)
             hoomd.run(10, profile=True)
+            hoomd.run(10, profile='trace.json')
             hoomd.run(10, quiet=True)
             hoomd.run(10, callback_period=2, callback=lambda step: print(step))
 
@@ -126,6 +128,15 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     portion of the calculation is printed at the end of the run. Collecting this timing information
     slows the simulation.
 
+    When `profile` is a file name, every timed region is recorded as an event with low overhead. Unlike
+    ``profile=True``, tracing does not synchronize with the GPU, so GPU regions show the time to launch their
+    kernels. At the end of the run, each MPI rank writes its events to the file in the Chrome trace
+    event format, which https://ui.perfetto.dev and chrome://tracing display as a timeline. With more than one rank,
+    the rank is inserted before the extension (``trace.json`` becomes ``trace.rank0.json``, ``trace.rank1.json``, ...).
+    A summary lists the time of each region with its minimum, average and maximum over the ranks, which shows the load
+    imbalance between domains. Each thread keeps only its most recent 262144 events for the file; the summary
+    covers the whole run.
+
     **Wallclock limited runs:**
 
     There are a number of mechanisms to limit the time of a running hoomd script. Use these in a job
@@ -179,7 +190,17 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
 
     for logger in context.current.loggers:
         logger.update_quantities();
-    context.current.system.enableProfiler(profile);
+    for updater in context.current.updaters:
+        if hasattr(updater, '_set_integrator'):
+            updater._set_integrator(context.current.integrator);
+    trace_file = ''
+    if isinstance(profile, str):
+        trace_file = profile
+        if context.current.device.comm.num_ranks > 1:
+            root, ext = os.path.splitext(profile)
+            trace_file = '{}.rank{}{}'.format(root, context.current.device.comm.rank, ext)
+    context.current.system.enableProfiler(bool(profile) and not isinstance(profile, str));
+    context.current.system.enableTracing(trace_file);
     context.current.system.enableQuietRun(quiet);
 
     # update all user-defined neighbor lists
@@ -197,6 +218,11 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     if not quiet:
         context.current.device.cpp_msg.notice(1, "** starting run **\n");
     context.current.system.run(int(tsteps), callback_period, callback, limit_hours, int(limit_multiple));
+
+    # write out buffered log data
+    for logger in context.current.loggers:
+        logger.flush();
+
     if not quiet:
         context.current.device.cpp_msg.notice(1, "** run complete **\n");
 
@@ -517,6 +517,15 @@ class log(_analyzer):
         """
         self.cpp_analyzer.registerCallback(name, callback);
 
+    def flush(self):
+        R""" Write out any buffered log data.
+
+        Examples::
+
+            logger.flush()
+        """
+        self.cpp_analyzer.flush();
+
     ## \internal
     # \brief Re-registers all computes and updaters with the logger
     def update_quantities(self):
@@ -558,6 +567,136 @@ class log(_analyzer):
 
         hoomd.context.current.loggers.append(self)
 
+class log_binary(log):
+    R""" Log a number of calculated quantities to a binary columnar file.
+
+    Args:
+        filename (str): File to write the log to.
+        quantities (list): List of quantities to log.
+        period (int): Quantities are logged every *period* time steps.
+        chunk_size (int): Number of rows buffered in memory before they are written as one block.
+        overwrite (bool): When False (the default) an existing log will be appended to. When True, an existing log file will be overwritten instead.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    :py:class:`log_binary` accepts the same quantities as :py:class:`log`, but stores them in a compact binary file
+    instead of delimited text. Rows are collected in memory in blocks of *chunk_size* rows and written to disk
+    on a background thread, which makes it suitable for logging many quantities at short periods.
+
+    Buffered rows are written out when a block is full, when the logged quantities change, and at the end of every
+    :py:func:`hoomd.run()`. Use :py:meth:`flush()` to write them out at any other time.
+
+    Read the file back with :py:func:`read_log_binary()`.
+
+    Examples::
+
+        logger = analyze.log_binary(filename='log.bin', quantities=['potential_energy', 'temperature'], period=10)
+        run(10000)
+        data = analyze.read_log_binary('log.bin')
+        U = data['potential_energy']
+
+    """
+
+    def __init__(self, filename, quantities, period, chunk_size=1024, overwrite=False, phase=0):
+
+        # initialize base class
+        _analyzer.__init__(self);
+
+        # create the c++ mirror class
+        self.cpp_analyzer = _hoomd.LogBinary(hoomd.context.current.system_definition, filename, int(chunk_size), overwrite);
+        self.setupAnalyzer(period, phase);
+
+        # set the logged quantities
+        quantity_list = _hoomd.std_vector_string();
+        for item in quantities:
+            quantity_list.append(str(item));
+        self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+        # add the logger to the list of loggers
+        hoomd.context.current.loggers.append(self);
+
+        # store metadata
+        self.metadata_fields = ['filename','period','chunk_size']
+        self.filename = filename
+        self.period = period
+        self.chunk_size = chunk_size
+
+    def set_params(self, quantities=None):
+        R""" Change the parameters of the log.
+
+        Args:
+            quantities (list): New list of quantities to log (if specified)
+
+        Examples::
+
+            logger.set_params(quantities=['bond_harmonic_energy'])
+        """
+
+        if quantities is not None:
+            # set the logged quantities
+            quantity_list = _hoomd.std_vector_string();
+            for item in quantities:
+                quantity_list.append(str(item));
+            self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+def read_log_binary(filename):
+    R""" Read a file written by :py:class:`log_binary`.
+
+    Args:
+        filename (str): File to read.
+
+    Returns:
+        A dictionary that maps ``'timestep'`` and each logged quantity to a :py:class:`numpy.ndarray`. When the
+        logged quantities changed during the simulation, rows in which a quantity was not logged hold *NaN*.
+
+    Examples::
+
+        data = analyze.read_log_binary('log.bin')
+        pyplot.plot(data['timestep'], data['potential_energy'])
+    """
+
+    with open(filename, 'rb') as f:
+        buf = f.read();
+
+    if buf[0:8] != b'HOOMDCOL':
+        raise RuntimeError("{} is not a binary log file".format(filename));
+
+    pos = 12;
+    names = [];
+    blocks = [];
+    while pos < len(buf):
+        tag, n = numpy.frombuffer(buf, dtype=numpy.uint32, count=2, offset=pos);
+        pos += 8;
+        if tag == 1:
+            names = [];
+            for i in range(n):
+                length = int(numpy.frombuffer(buf, dtype=numpy.uint32, count=1, offset=pos)[0]);
+                pos += 4;
+                names.append(buf[pos:pos+length].decode());
+                pos += length;
+        elif tag == 2:
+            timestep = numpy.frombuffer(buf, dtype=numpy.uint64, count=n, offset=pos);
+            pos += 8*int(n);
+            columns = {};
+            for name in names:
+                columns[name] = numpy.frombuffer(buf, dtype=numpy.float64, count=n, offset=pos);
+                pos += 8*int(n);
+            blocks.append((timestep, columns));
+        else:
+            raise RuntimeError("Corrupt binary log file {}".format(filename));
+
+    all_names = [];
+    for timestep, columns in blocks:
+        for name in columns:
+            if name not in all_names:
+                all_names.append(name);
+
+    result = {};
+    result['timestep'] = numpy.concatenate([b[0] for b in blocks]) if blocks else numpy.zeros(0, dtype=numpy.uint64);
+    for name in all_names:
+        result[name] = numpy.concatenate([b[1][name] if name in b[1] else numpy.full(len(b[0]), numpy.nan)
+                                          for b in blocks]);
+    return result;
+
 class callback(_analyzer):
     R""" Callback analyzer.
 
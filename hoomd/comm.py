@@ -26,6 +26,8 @@ class decomposition(object):
         nz (int): Number of processors to uniformly space in z dimension (if *z* is None)
         linear (bool): (MPI only) Force a slab (1D) decomposition along the z-direction
         onelevel (bool): (MPI only) Disable node-local (two-level) domain decomposition
+        balance (bool): (MPI only) Place density-balanced initial cut planes from the particle distribution
+        min_width (float): (MPI only) Minimum width of a domain when *balance* is True (in distance units)
 
     A single domain decomposition is defined for the simulation.
     A standard domain decomposition divides the simulation box into equal volumes along the Cartesian axes while minimizing
@@ -49,6 +51,18 @@ class decomposition(object):
     decomposition can only be called *before* the system is initialized, at which point the particles are decomposed.
     An error is raised if the system is already initialized.
 
+    With *balance* set to True, the decomposition starts from density-balanced initial cut planes, placed from the
+    particle distribution when the system is initialized. For every grid that is commensurate with the number of ranks
+    (and matches *nx*, *ny* and *nz* when given), the positions of the axis-aligned cut planes along each axis are found
+    by bisection of the particle coordinates, and the grid with the smallest maximum number of particles per domain is
+    chosen. This balances systems with density gradients along the axes, such as a liquid slab, from the first time
+    step. This is not a recursive coordinate bisection: the domains remain a Cartesian grid and every cut plane spans
+    the whole box, so a droplet cannot be separated from the vapor around it. Combine with update.balance() to follow
+    the particles as the system evolves. Set *min_width* to at least the ghost layer width of the pair potentials, so
+    that domains in dense regions do not become too narrow. No domain is made narrower than a tenth of the uniform
+    width. The cut planes are balanced when the system is initialized from a snapshot (init.read_snapshot,
+    init.read_gsd and init.read_getar), otherwise the fractions are uniform.
+
     The decomposition can be adjusted dynamically if the best static decomposition is not known, or the system
     composition is changing dynamically. For this associated command, see update.balance().
 
@@ -59,6 +73,7 @@ class decomposition(object):
 
         comm.decomposition(x=0.4, ny=2, nz=2)
         comm.decomposition(nx=2, y=0.8, z=[0.2,0.3])
+        comm.decomposition(balance=True, min_width=3.0)
 
     Warning:
         The decomposition command will override specified command line options.
@@ -76,7 +91,7 @@ class decomposition(object):
         raised if both are set.
     """
 
-    def __init__(self, x=None, y=None, z=None, nx=None, ny=None, nz=None, linear=False, onelevel=False):
+    def __init__(self, x=None, y=None, z=None, nx=None, ny=None, nz=None, linear=False, onelevel=False, balance=False, min_width=0.0):
 
         # check that the context has been initialized though
         if hoomd.context.current is None:
@@ -91,7 +106,17 @@ class decomposition(object):
         if (x or y or z or nx or ny or nz) and (not _hoomd.is_MPI_available()):
             raise RuntimeError("the x, y, z, nx, ny, nz options are only available in MPI builds")
 
+        if balance and (x is not None or y is not None or z is not None):
+            hoomd.context.current.device.cpp_msg.error("comm.decomposition: cannot set fractions when balancing the particles\n")
+            raise RuntimeError("Cannot set fractions when balancing the particles")
+
+        if min_width < 0.0:
+            hoomd.context.current.device.cpp_msg.error("comm.decomposition: min_width must be non-negative\n")
+            raise RuntimeError("min_width must be non-negative")
+
         self._onelevel = onelevel  # cache this for later when we can make the cpp object
+        self.balance = balance
+        self.min_width = min_width
 
         # check that there are ranks available for decomposition
         if hoomd.context.current.device.comm.cpp_mpi_conf == 1:
@@ -191,7 +216,16 @@ class decomposition(object):
     ## \internal
     # \brief Delayed construction of the C++ object for this balanced decomposition
     # \param box Global simulation box for decomposition
-    def _make_cpp_decomposition(self, box):
+    # \param snapshot Snapshot with the particles to balance (None if not available)
+    def _make_cpp_decomposition(self, box, snapshot=None):
+        # place the cut planes from the particles
+        if self.balance:
+            if snapshot is not None:
+                self.cpp_dd = _hoomd.DomainDecomposition(hoomd.context.current.device.cpp_exec_conf, box, snapshot.particles, self.nx, self.ny, self.nz, self.min_width)
+                return self.cpp_dd
+            else:
+                hoomd.context.current.device.cpp_msg.warning("comm.decomposition: no particles available to balance, using uniform fractions\n")
+
         # if the box is uniform in all directions, just use these values
         if self.uniform_x and self.uniform_y and self.uniform_z:
             self.cpp_dd = _hoomd.DomainDecomposition(hoomd.context.current.device.cpp_exec_conf, box.getL(), self.nx, self.ny, self.nz, not self._onelevel)
@@ -759,7 +759,8 @@ class system_data(hoomd.meta._metadata):
                       pairs=False,
                       integrators=False,
                       all=False,
-                      dtype='float'):
+                      dtype='float',
+                      distributed=False):
         R""" Take a snapshot of the current system data.
 
         Args:
@@ -771,6 +772,8 @@ class system_data(hoomd.meta._metadata):
             integrators (bool): When true, integrator data is included the snapshot.
             all (bool): When true, the entire system state is saved in the snapshot.
             dtype (str): Datatype for the snapshot numpy arrays. Must be either 'float' or 'double'.
+            distributed (bool): When True, the particle data is not gathered on rank 0. Every rank keeps the particles
+                it owns in ``snapshot.particles``, and their tags in ``snapshot.particle_tags``.
 
         Returns:
             The snapshot object.
@@ -785,6 +788,11 @@ class system_data(hoomd.meta._metadata):
             snapshot = system.take_snapshot()
             snapshot = system.take_snapshot()
             snapshot = system.take_snapshot(bonds=true)
+            snapshot = system.take_snapshot(distributed=True)
+
+        A distributed snapshot avoids holding all particles on a single rank in large MPI simulations. It can be
+        passed to :py:meth:`restore_snapshot` while the domain decomposition is unchanged. Bonded groups and integrator
+        data are still gathered on rank 0.
 
         """
 
@@ -796,9 +804,15 @@ class system_data(hoomd.meta._metadata):
 
         # take the snapshot
         if dtype == 'float':
-            cpp_snapshot = self.sysdef.takeSnapshot_float(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
+            if distributed:
+                cpp_snapshot = self.sysdef.takeLocalSnapshot_float(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
+            else:
+                cpp_snapshot = self.sysdef.takeSnapshot_float(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
         elif dtype == 'double':
-            cpp_snapshot = self.sysdef.takeSnapshot_double(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
+            if distributed:
+                cpp_snapshot = self.sysdef.takeLocalSnapshot_double(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
+            else:
+                cpp_snapshot = self.sysdef.takeSnapshot_double(particles,bonds,bonds,bonds,bonds,bonds,integrators,pairs)
         else:
             raise ValueError("dtype must be float or double");
 
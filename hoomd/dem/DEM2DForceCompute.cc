@@ -11,6 +11,7 @@
 #include "DEM2DForceCompute.h"
 #include <pybind11/pybind11.h>
 
+#include <atomic>
 #include <stdexcept>
 
 #ifdef ENABLE_OPENMP
@@ -165,6 +166,7 @@ void DEM2DForceCompute<Real, Real4, Potential>::setParams(
         }
 
     m_shapes[type] = points;
+    m_geometry.setShapes(m_shapes);
     }
 
 /*! DEM2DForceCompute provides
@@ -246,205 +248,296 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
+    const unsigned int N = m_pdata->getN();
+    const unsigned int nVerts = m_geometry.getNumVertices();
+
     // tally up the number of forces calculated
-    int64_t n_calc = 0;
+    std::atomic<int64_t> n_calc(0);
 
-    // for each particle
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // compute the forces on particles [begin, end); contributions to neighbors (third law) go to force_j, torque_j
+    // and virial_j, the forces on the particles in the range go to h_force, h_torque and h_virial
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *force_j, Scalar4 *torque_j,
+        Scalar *virial_j, unsigned int virial_pitch_j)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        quat<Scalar> quati(h_orientation.data[i]);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        vec2<Real> fi;
-        Real ti(0), pei(0);
-        Real viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // If the evaluator needs the diameters of the particles to evaluate, grab particle_i's here
-        // MEM TRANSFER (1 scalar)
-        Scalar di;
-        if (Potential::needsDiameter())
-            {
-            di = h_diameter.data[i];
-            }
+        // the evaluator keeps per-pair state (diameters, velocities), so every range works on its own copy
+        DEMEvaluator<Real, Real4, Potential> evaluator(m_evaluator);
 
-        vec3<Scalar> vi;
-        if(Potential::needsVelocity())
-            vi = vec3<Scalar>(h_velocity.data[i]);
+        // vertices of particles i and j in the lab frame, indexed by vertex index in m_geometry
+        std::vector<vec2<Real> > verts_i(nVerts), verts_j(nVerts);
 
-        // Make a local copy for the rotated vertices for particle i
-        vector<vec2<Real> > vertices_i(m_shapes[typei]);
-        for(typename vector<vec2<Real> >::iterator vertIter(vertices_i.begin());
-            vertIter != vertices_i.end(); ++vertIter)
-            *vertIter = rotate(quati, *vertIter);
+        int64_t n_calc_range = 0;
 
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+        // for each particle
+        for (unsigned int i = begin; i < end; i++)
             {
-            // increment our calculation counter
-            n_calc++;
-
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[myHead + j];
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            quat<Scalar> quati(h_orientation.data[i]);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
             // sanity check
-            assert(k < m_pdata->getN());
-
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            vec3<Scalar> pj(h_pos.data[k].x, h_pos.data[k].y, 0);
-            quat<Scalar> quatj(h_orientation.data[k]);
-            vec3<Scalar> dx3(pj - pi);
+            assert(typei < m_pdata->getNTypes());
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+            // initialize current particle force, potential energy, and virial to 0
+            vec2<Real> fi;
+            Real ti(0), pei(0);
+            Real viriali[6];
+            for (int k = 0; k < 6; k++)
+                viriali[k] = 0.0;
 
-            // apply periodic boundary conditions (FLOPS: 9 (worst case: first branch is missed, the 2nd is taken and the add is done)
-            dx3 = vec3<Scalar>(box.minImage(vec_to_scalar3(dx3)));
-            vec2<Real> dx(dx3.x, dx3.y);
-
-            // If the evaluator needs the diameters of the particles to evaluate, grab particle_j's and
-            // pass in the diameters of the particles here
+            // If the evaluator needs the diameters of the particles to evaluate, grab particle_i's here
             // MEM TRANSFER (1 scalar)
-            Scalar dj;
+            Scalar di;
             if (Potential::needsDiameter())
                 {
-                dj = h_diameter.data[k];
-                m_evaluator.setDiameter(di,dj);
+                di = h_diameter.data[i];
                 }
 
+            vec3<Scalar> vi;
             if(Potential::needsVelocity())
-                m_evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+                vi = vec3<Scalar>(h_velocity.data[i]);
 
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+            // rotate the vertices of particle i once for all neighbors
+            m_geometry.rotate(typei, quati, verts_i.data());
+            const vec2<Real> *vertices_i(verts_i.data() + m_geometry.getFirstVertex(typei));
+            const unsigned int nVertsi(m_geometry.getNumVertices(typei));
 
-            // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
-            if (m_evaluator.withinCutoff(rsq,r_cut_sq))
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // local forces and torques for particles i and j
-                vec2<Real> forceij, forceji;
-                Real torqueij(0), torqueji(0), potentialij(0);
-
-                // Make a local copy for the rotated vertices for particle j
-                vector<vec2<Real> > vertices_j(m_shapes[typej]);
-                for(typename vector<vec2<Real> >::iterator vertIter(vertices_j.begin());
-                    vertIter != vertices_j.end(); ++vertIter)
-                    *vertIter = rotate(quatj, *vertIter);
-
-                // Iterate over each vertex of particle i, if particle j has any edges
-                if (vertices_j.size()>1)
+                // increment our calculation counter
+                n_calc_range++;
+
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int k = h_nlist.data[myHead + j];
+                // sanity check
+                assert(k < m_pdata->getN());
+
+                // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                vec3<Scalar> pj(h_pos.data[k].x, h_pos.data[k].y, 0);
+                quat<Scalar> quatj(h_orientation.data[k]);
+                vec3<Scalar> dx3(pj - pi);
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions (FLOPS: 9 (worst case: first branch is missed, the 2nd is taken and the add is done)
+                dx3 = vec3<Scalar>(box.minImage(vec_to_scalar3(dx3)));
+                vec2<Real> dx(dx3.x, dx3.y);
+
+                // If the evaluator needs the diameters of the particles to evaluate, grab particle_j's and
+                // pass in the diameters of the particles here
+                // MEM TRANSFER (1 scalar)
+                Scalar dj;
+                if (Potential::needsDiameter())
+                    {
+                    dj = h_diameter.data[k];
+                    evaluator.setDiameter(di,dj);
+                    }
+
+                if(Potential::needsVelocity())
+                    evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+
+                // start computing the force
+                // calculate r squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // only compute the force if the particles are closer than the cutoff (FLOPS: 1) and the bounding
+                // spheres of the shapes are within the range of the features
+                if (evaluator.withinCutoff(rsq,r_cut_sq) &&
+                    evaluator.boundingSpheresOverlap(rsq, m_geometry.getRadius(typei), m_geometry.getRadius(typej)))
                     {
-                    for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
-                        viIter != vertices_i.end(); ++viIter)
+                    // local forces and torques for particles i and j
+                    vec2<Real> forceij, forceji;
+                    Real torqueij(0), torqueji(0), potentialij(0);
+
+                    // rotate the vertices of particle j
+                    m_geometry.rotate(typej, quatj, verts_j.data());
+                    const vec2<Real> *vertices_j(verts_j.data() + m_geometry.getFirstVertex(typej));
+                    const unsigned int nVertsj(m_geometry.getNumVertices(typej));
+
+                    // Iterate over each vertex of particle i, if particle j has any edges
+                    if (nVertsj > 1)
                         {
-                        // iterate over each edge of particle j
-                        for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
-                            vjIter + 1 != vertices_j.end(); ++vjIter)
+                        for(unsigned int vertI(0); vertI < nVertsi; ++vertI)
                             {
-                            m_evaluator.vertexEdge(dx, *viIter, *vjIter, *(vjIter + 1),
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
+                            // iterate over each edge of particle j
+                            for(unsigned int vertJ(0); vertJ + 1 < nVertsj; ++vertJ)
+                                {
+                                evaluator.vertexEdge(dx, vertices_i[vertI], vertices_j[vertJ], vertices_j[vertJ + 1],
+                                    potentialij, forceij, torqueij,
+                                    forceji, torqueji);
+                                }
+                            // evaluate for the last edge, but only if we
+                            // didn't just evaluate that edge (i.e. the
+                            // shape isn't a spherocylinder)
+                            if(nVertsj > 2)
+                                evaluator.vertexEdge(dx, vertices_i[vertI], vertices_j[nVertsj - 1], vertices_j[0],
+                                    potentialij, forceij, torqueij,
+                                    forceji, torqueji);
                             }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_j.size() > 2)
-                            m_evaluator.vertexEdge(dx, *viIter, vertices_j.back(), vertices_j.front(),
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
                         }
-                    }
-                // iterate over each vertex of particle j, if vi has any edges
-                if (vertices_i.size()>1)
-                    {
-                    for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
-                        vjIter != vertices_j.end(); ++vjIter)
+                    // iterate over each vertex of particle j, if vertI has any edges
+                    if (nVertsi > 1)
                         {
-                        // iterate over each edge of particle i
-                        for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
-                            viIter + 1 != vertices_i.end(); ++viIter)
+                        for(unsigned int vertJ(0); vertJ < nVertsj; ++vertJ)
                             {
-                            m_evaluator.vertexEdge(-dx, *vjIter, *viIter, *(viIter + 1),
-                                potentialij, forceji, torqueji,
-                                forceij, torqueij);
+                            // iterate over each edge of particle i
+                            for(unsigned int vertI(0); vertI + 1 < nVertsi; ++vertI)
+                                {
+                                evaluator.vertexEdge(-dx, vertices_j[vertJ], vertices_i[vertI], vertices_i[vertI + 1],
+                                    potentialij, forceji, torqueji,
+                                    forceij, torqueij);
+                                }
+                            // evaluate for the last edge, but only if we
+                            // didn't just evaluate that edge (i.e. the
+                            // shape isn't a spherocylinder)
+                            if(nVertsi > 2)
+                                evaluator.vertexEdge(-dx, vertices_j[vertJ], vertices_i[nVertsi - 1], vertices_i[0],
+                                    potentialij, forceji, torqueji,
+                                    forceij, torqueij);
                             }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_i.size() > 2)
-                            m_evaluator.vertexEdge(-dx, *vjIter, vertices_i.back(), vertices_i.front(),
-                                potentialij, forceji, torqueji,
-                                forceij, torqueij);
                         }
-                    }
-                // if i doesn't have any edges and j doesn't have any
-                // edges, both are disks
-                else if(vertices_j.size() <= 1)
-                    {
-                    m_evaluator.vertexVertex(dx, vertices_i[0], dx + vertices_j[0],
-                        potentialij, forceij, torqueij,
-                        forceji, torqueji);
-                    }
+                    // if i doesn't have any edges and j doesn't have any
+                    // edges, both are disks
+                    else if(nVertsj <= 1)
+                        {
+                        evaluator.vertexVertex(dx, vertices_i[0], dx + vertices_j[0],
+                            potentialij, forceij, torqueij,
+                            forceji, torqueji);
+                        }
 
-                // compute the pair energy and virial (FLOPS: 6)
-                Scalar pair_virial[6];
+                    // compute the pair energy and virial (FLOPS: 6)
+                    Scalar pair_virial[6];
 
-                pair_virial[0] = -Scalar(0.5) * dx.x * forceij.x;
-                pair_virial[1] = -Scalar(0.5) * dx.y * forceij.x;
-                pair_virial[3] = -Scalar(0.5) * dx.y * forceij.y;
+                    pair_virial[0] = -Scalar(0.5) * dx.x * forceij.x;
+                    pair_virial[1] = -Scalar(0.5) * dx.y * forceij.x;
+                    pair_virial[3] = -Scalar(0.5) * dx.y * forceij.y;
 
-                // Scale potential energy by half for pairwise contribution
-                potentialij *= Scalar(0.5);
+                    // Scale potential energy by half for pairwise contribution
+                    potentialij *= Scalar(0.5);
 
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += forceij;
-                ti += torqueij;
-                pei += potentialij;
-                viriali[0] += pair_virial[0];
-                viriali[1] += pair_virial[1];
-                viriali[3] += pair_virial[3];
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fi += forceij;
+                    ti += torqueij;
+                    pei += potentialij;
+                    viriali[0] += pair_virial[0];
+                    viriali[1] += pair_virial[1];
+                    viriali[3] += pair_virial[3];
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law && k < m_pdata->getN())
-                    {
-                    h_force.data[k].x  += forceji.x;
-                    h_force.data[k].y  += forceji.y;
-                    h_force.data[k].w  += potentialij;
-                    h_torque.data[k].z += torqueji;
-                    h_virial.data[0*virial_pitch + k] += pair_virial[0];
-                    h_virial.data[1*virial_pitch + k] += pair_virial[1];
-                    h_virial.data[3*virial_pitch + k] += pair_virial[3];
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                    if (third_law && k < N)
+                        {
+                        force_j[k].x  += forceji.x;
+                        force_j[k].y  += forceji.y;
+                        force_j[k].w  += potentialij;
+                        torque_j[k].z += torqueji;
+                        virial_j[0*virial_pitch_j + k] += pair_virial[0];
+                        virial_j[1*virial_pitch_j + k] += pair_virial[1];
+                        virial_j[3*virial_pitch_j + k] += pair_virial[3];
+                        }
                     }
+
                 }
 
+            // finally, increment the force, potential energy and virial for particle i
+            // (MEM TRANSFER: 10 scalars / FLOPS: 5)
+            h_force.data[i].x  += fi.x;
+            h_force.data[i].y  += fi.y;
+            h_force.data[i].w  += pei;
+            h_torque.data[i].z += ti;
+            h_virial.data[0*virial_pitch + i] += viriali[0];
+            h_virial.data[1*virial_pitch + i] += viriali[1];
+            h_virial.data[3*virial_pitch + i] += viriali[3];
             }
 
-        // finally, increment the force, potential energy and virial for particle i
-        // (MEM TRANSFER: 10 scalars / FLOPS: 5)
-        h_force.data[i].x  += fi.x;
-        h_force.data[i].y  += fi.y;
-        h_force.data[i].w  += pei;
-        h_torque.data[i].z += ti;
-        h_virial.data[0*virial_pitch + i] += viriali[0];
-        h_virial.data[1*virial_pitch + i] += viriali[1];
-        h_virial.data[3*virial_pitch + i] += viriali[3];
+        n_calc += n_calc_range;
+        };
+
+    #ifdef ENABLE_TBB
+    if (third_law)
+        {
+        // forces on j are scattered, so every thread accumulates them into its own buffer
+        for (auto& buf : m_thread_force)
+            buf.assign(N, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_torque)
+            buf.assign(N, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_virial)
+            buf.assign(6*N, Scalar(0.0));
         }
 
-    int64_t flops = m_pdata->getN() * 5 + n_calc * (3+5+9+1+14+6+8);
-    if (third_law) flops += n_calc * 8;
-    int64_t mem_transfer = m_pdata->getN() * (5+4+10)*sizeof(Scalar) + n_calc * (1+3+1)*sizeof(Scalar);
-    if (third_law) mem_transfer += n_calc*10*sizeof(Scalar);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        if (!third_law)
+            {
+            // only the particles in the range are written
+            compute_range(r.begin(), r.end(), h_force.data, h_torque.data, h_virial.data, virial_pitch);
+            return;
+            }
+
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar4>& thread_torque = m_thread_torque.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != N)
+            thread_force.assign(N, make_scalar4(0,0,0,0));
+        if (thread_torque.size() != N)
+            thread_torque.assign(N, make_scalar4(0,0,0,0));
+        if (thread_virial.size() != 6*N)
+            thread_virial.assign(6*N, Scalar(0.0));
+
+        compute_range(r.begin(), r.end(), thread_force.data(), thread_torque.data(), thread_virial.data(), N);
+        });
+
+    // reduce the per-thread buffers
+    if (third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto& buf : m_thread_force)
+                {
+                if (buf.size() != N)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_force.data[i].x += buf[i].x;
+                    h_force.data[i].y += buf[i].y;
+                    h_force.data[i].w += buf[i].w;
+                    }
+                }
+            for (auto& buf : m_thread_torque)
+                {
+                if (buf.size() != N)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    h_torque.data[i].z += buf[i].z;
+                }
+            for (auto& buf : m_thread_virial)
+                {
+                if (buf.size() != 6*N)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_virial.data[0*virial_pitch+i] += buf[0*N+i];
+                    h_virial.data[1*virial_pitch+i] += buf[1*N+i];
+                    h_virial.data[3*virial_pitch+i] += buf[3*N+i];
+                    }
+                }
+            });
+        }
+    #else
+    compute_range(0, N, h_force.data, h_torque.data, h_virial.data, virial_pitch);
+    #endif
+
+    int64_t flops = m_pdata->getN() * 5 + n_calc.load() * (3+5+9+1+14+6+8);
+    if (third_law) flops += n_calc.load() * 8;
+    int64_t mem_transfer = m_pdata->getN() * (5+4+10)*sizeof(Scalar) + n_calc.load() * (1+3+1)*sizeof(Scalar);
+    if (third_law) mem_transfer += n_calc.load()*10*sizeof(Scalar);
     if (m_prof) m_prof->pop(flops, mem_transfer);
     }
 
@@ -11,8 +11,13 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "DEMTypeGeometry.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file DEM2DForceCompute.h
   \brief Declares the DEM2DForceCompute class
 */
@@ -36,6 +41,10 @@
   Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
   a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+  The vertices of each particle are rotated once (see DEMTypeGeometry) and pairs whose bounding circles are out of
+  range of each other are skipped. With TBB, the loop over particles runs in parallel and the third law forces on
+  neighbors go to per-thread buffers that are summed at the end.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -99,6 +108,13 @@ class DEM2DForceCompute : public ForceCompute
         Real m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
         DEMEvaluator<Real, Real4, Potential> m_evaluator; //!< Object holding parameters and computation method for the potential
         std::vector<std::vector<vec2<Real> > > m_shapes; //!< Vertices for each type
+        DEMTypeGeometry<Real> m_geometry; //!< Vertices and bounding radii for each type
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_torque; //!< Per-thread torque buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -13,6 +13,7 @@
 #include <pybind11/pybind11.h>
 
 
+#include <atomic>
 #include <stdexcept>
 #include <utility>
 #include <set>
@@ -428,6 +429,9 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         const unsigned int faceSize(m_facesVec[shapeIdx].size());
         h_numTypeFaces.data[shapeIdx] = faceSize;
         }
+
+    // host side copy of the vertices for the CPU force loop
+    m_geometry.setShapes(m_shapes);
     }
 
 /*!
@@ -613,8 +617,6 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     assert(h_pos.data != NULL);
 
     // GPU array handles
-    ArrayHandle<Real4> h_verts(m_verts, access_location::host,
-        access_mode::read);
     ArrayHandle<Real> h_faceRcutSq(m_faceRcutSq, access_location::host,
         access_mode::read);
     ArrayHandle<Real> h_edgeRcutSq(m_edgeRcutSq, access_location::host,
@@ -649,278 +651,372 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
+    const unsigned int N = m_pdata->getN();
+    const unsigned int nVerts = m_geometry.getNumVertices();
+
     // tally up the number of forces calculated
-    int64_t n_calc = 0;
+    std::atomic<int64_t> n_calc(0);
 
-    // for each particle
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // compute the forces on particles [begin, end); contributions to neighbors (third law) go to force_j, torque_j
+    // and virial_j, the forces on the particles in the range go to h_force, h_torque and h_virial
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *force_j, Scalar4 *torque_j,
+        Scalar *virial_j, unsigned int virial_pitch_j)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        quat<Scalar> quati(h_orientation.data[i]);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        vec3<Real> fi;
-        vec3<Real> ti;
-        Real pei(0);
-        Real viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // If the evaluator needs the diameters of the particles to evaluate, grab particle_i's here
-        // MEM TRANSFER (1 scalar)
-        Scalar di;
-        if (Potential::needsDiameter())
-            {
-            di = h_diameter.data[i];
-            }
+        // the evaluator keeps per-pair state (diameters, velocities), so every range works on its own copy
+        DEMEvaluator<Real, Real4, Potential> evaluator(m_evaluator);
 
-        vec3<Scalar> vi;
-        if(Potential::needsVelocity())
-            vi = vec3<Scalar>(h_velocity.data[i]);
+        // vertices of particles i and j in the lab frame, indexed by real vertex index
+        std::vector<vec3<Real> > verts_i(nVerts), verts_j(nVerts);
 
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // increment our calculation counter
-            n_calc++;
+        int64_t n_calc_range = 0;
 
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[myHead + j];
-            // sanity check
-            assert(k < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            vec3<Scalar> pj(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            quat<Scalar> quatj(h_orientation.data[k]);
-            vec3<Scalar> dxScalar(pj - pi);
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+        // for each particle
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            quat<Scalar> quati(h_orientation.data[i]);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
             // sanity check
-            assert(typej < m_pdata->getNTypes());
+            assert(typei < m_pdata->getNTypes());
 
-            // apply periodic boundary conditions (FLOPS: 9 (worst case: first branch is missed, the 2nd is taken and the add is done)
-            dxScalar = vec3<Scalar>(box.minImage(vec_to_scalar3(dxScalar)));
-            const vec3<Real> dx(dxScalar);
+            // initialize current particle force, potential energy, and virial to 0
+            vec3<Real> fi;
+            vec3<Real> ti;
+            Real pei(0);
+            Real viriali[6];
+            for (int k = 0; k < 6; k++)
+                viriali[k] = 0.0;
 
-            // If the evaluator needs the diameters of the particles to evaluate, grab particle_j's and
-            // pass in the diameters of the particles here
+            // If the evaluator needs the diameters of the particles to evaluate, grab particle_i's here
             // MEM TRANSFER (1 scalar)
-            Scalar dj;
+            Scalar di;
             if (Potential::needsDiameter())
                 {
-                dj = h_diameter.data[k];
-                m_evaluator.setDiameter(di,dj);
+                di = h_diameter.data[i];
                 }
 
+            vec3<Scalar> vi;
             if(Potential::needsVelocity())
-                m_evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+                vi = vec3<Scalar>(h_velocity.data[i]);
 
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Real rsq = dot(dx, dx);
+            // rotate the vertices of particle i once for all neighbors
+            m_geometry.rotate(typei, quati, verts_i.data());
+            const unsigned int firstVerti(m_geometry.getFirstVertex(typei));
 
-            // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
-            if (m_evaluator.withinCutoff(rsq,r_cut_sq))
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // local forces and torques for particles i and j
-                vec3<Real> forceij, forceji;
-                vec3<Real> torqueij, torqueji;
-                Real potentialij(0);
+                // increment our calculation counter
+                n_calc_range++;
+
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int k = h_nlist.data[myHead + j];
+                // sanity check
+                assert(k < m_pdata->getN() + m_pdata->getNGhosts());
+
+                // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                vec3<Scalar> pj(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                quat<Scalar> quatj(h_orientation.data[k]);
+                vec3<Scalar> dxScalar(pj - pi);
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions (FLOPS: 9 (worst case: first branch is missed, the 2nd is taken and the add is done)
+                dxScalar = vec3<Scalar>(box.minImage(vec_to_scalar3(dxScalar)));
+                const vec3<Real> dx(dxScalar);
+
+                // If the evaluator needs the diameters of the particles to evaluate, grab particle_j's and
+                // pass in the diameters of the particles here
+                // MEM TRANSFER (1 scalar)
+                Scalar dj;
+                if (Potential::needsDiameter())
+                    {
+                    dj = h_diameter.data[k];
+                    evaluator.setDiameter(di,dj);
+                    }
+
+                if(Potential::needsVelocity())
+                    evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+
+                // start computing the force
+                // calculate r squared (FLOPS: 5)
+                Real rsq = dot(dx, dx);
 
-                // iterate over each vertex in particle i
-                for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
+                // only compute the force if the particles are closer than the cutoff (FLOPS: 1) and the bounding
+                // spheres of the shapes are within the range of the features
+                if (evaluator.withinCutoff(rsq,r_cut_sq) &&
+                    evaluator.boundingSpheresOverlap(rsq, m_geometry.getRadius(typei), m_geometry.getRadius(typej)))
                     {
-                    const vec3<Real> vertex0(
-                        rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
+                    // local forces and torques for particles i and j
+                    vec3<Real> forceij, forceji;
+                    vec3<Real> torqueij, torqueji;
+                    Real potentialij(0);
 
-                    // iterate over each face in particle j
-                    size_t faceIndex(typej);
-                    if(h_numTypeFaces.data[typej] > 0)
+                    // rotate the vertices of particle j once for all features of particle i
+                    m_geometry.rotate(typej, quatj, verts_j.data());
+                    const unsigned int firstVertj(m_geometry.getFirstVertex(typej));
+
+                    // iterate over each vertex in particle i
+                    for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                         {
-                        do
+                        const vec3<Real> vertex0(verts_i[firstVerti + vertIndex]);
+
+                        // iterate over each face in particle j
+                        size_t faceIndex(typej);
+                        if(h_numTypeFaces.data[typej] > 0)
                             {
-                            m_evaluator.vertexFace(dx, vertex0, quatj,
-                                h_verts.data,
-                                h_realVertIndex.data,
-                                h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
-                                potentialij,
-                                forceij, torqueij,
-                                forceji, torqueji);
-                            faceIndex = h_nextFace.data[faceIndex];
+                            do
+                                {
+                                evaluator.vertexFace(dx, vertex0, verts_j.data(),
+                                    h_realVertIndex.data,
+                                    h_nextFaceVert.data,
+                                    h_firstFaceVert.data[faceIndex],
+                                    potentialij,
+                                    forceij, torqueij,
+                                    forceji, torqueji);
+                                faceIndex = h_nextFace.data[faceIndex];
+                                }
+                            while(faceIndex != typej);
                             }
-                        while(faceIndex != typej);
-                        }
-                    // no faces; is it a spherocylinder?
-                    else if(h_numTypeEdges.data[typej] > 0)
-                        {
-                        // iterate over all edges of j
-                        for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
+                        // no faces; is it a spherocylinder?
+                        else if(h_numTypeEdges.data[typej] > 0)
                             {
-                            vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
-                            vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
-                            p10 = rotate(quatj, p10);
-                            p11 = rotate(quatj, p11);
-
-                            m_evaluator.vertexEdge(dx, vertex0, p10, p11,
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
+                            // iterate over all edges of j
+                            for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
+                                {
+                                const vec3<Real> p10(verts_j[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
+                                const vec3<Real> p11(verts_j[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
+
+                                evaluator.vertexEdge(dx, vertex0, p10, p11,
+                                    potentialij, forceij, torqueij,
+                                    forceji, torqueji);
+                                }
                             }
-                        }
-                    // no edges either; must be a sphere
-                    else
-                        {
-                        // all pairs of vertices
-                        for(size_t vertj(0); vertj < h_numTypeVerts.data[typej]; ++vertj)
+                        // no edges either; must be a sphere
+                        else
                             {
-                            vec3<Real> vertex1(h_verts.data[h_firstTypeVert.data[typej] + vertj]);
-                            vertex1 = rotate(quatj, vertex1);
-
-                            m_evaluator.vertexVertex(dx, vertex0, dx + vertex1,
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
+                            // all pairs of vertices
+                            for(size_t vertj(0); vertj < h_numTypeVerts.data[typej]; ++vertj)
+                                {
+                                const vec3<Real> vertex1(verts_j[firstVertj + vertj]);
+
+                                evaluator.vertexVertex(dx, vertex0, dx + vertex1,
+                                    potentialij, forceij, torqueij,
+                                    forceji, torqueji);
+                                }
                             }
                         }
-                    }
-
-                // iterate over each vertex in particle j
-                for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typej]; ++vertIndex)
-                    {
-                    const vec3<Real> vertex0(
-                        rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
 
-                    // iterate over each face in particle i
-                    size_t faceIndex(typei);
-                    if(h_numTypeFaces.data[typei] > 0)
+                    // iterate over each vertex in particle j
+                    for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typej]; ++vertIndex)
                         {
-                        do
+                        const vec3<Real> vertex0(verts_j[firstVertj + vertIndex]);
+
+                        // iterate over each face in particle i
+                        size_t faceIndex(typei);
+                        if(h_numTypeFaces.data[typei] > 0)
+                            {
+                            do
+                                {
+                                evaluator.vertexFace(-dx, vertex0, verts_i.data(),
+                                    h_realVertIndex.data,
+                                    h_nextFaceVert.data,
+                                    h_firstFaceVert.data[faceIndex],
+                                    potentialij,
+                                    forceji, torqueji,
+                                    forceij, torqueij);
+                                faceIndex = h_nextFace.data[faceIndex];
+                                }
+                            while(faceIndex != typei);
+                            }
+                        // no faces; is it a spherocylinder?
+                        else if(h_numTypeEdges.data[typei] > 0)
                             {
-                            m_evaluator.vertexFace(-dx, vertex0, quati,
-                                h_verts.data,
-                                h_realVertIndex.data,
-                                h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
-                                potentialij,
-                                forceji, torqueji,
-                                forceij, torqueij);
-                            faceIndex = h_nextFace.data[faceIndex];
+                            // iterate over all edges of i
+                            for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
+                                {
+                                const vec3<Real> p10(verts_i[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
+                                const vec3<Real> p11(verts_i[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
+
+                                evaluator.vertexEdge(-dx, vertex0, p10, p11,
+                                    potentialij, forceji, torqueji,
+                                    forceij, torqueij);
+                                }
                             }
-                        while(faceIndex != typei);
+                        // if it is a sphere, the vertex/vertex check was
+                        // done above while iterating over vertices in
+                        // particle i so we don't need another one here
                         }
-                    // no faces; is it a spherocylinder?
-                    else if(h_numTypeEdges.data[typei] > 0)
+
+                    // iterate over all pairs of edges
+                    for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                         {
-                        // iterate over all edges of i
-                        for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
+                        const vec3<Real> p00(verts_i[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
+                        const vec3<Real> p01(verts_i[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
+
+                        // iterate over all edges of j
+                        for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                             {
-                            vec3<Real> p10(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
-                            vec3<Real> p11(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
-                            p10 = rotate(quati, p10);
-                            p11 = rotate(quati, p11);
-
-                            m_evaluator.vertexEdge(-dx, vertex0, p10, p11,
-                                potentialij, forceji, torqueji,
-                                forceij, torqueij);
+                            const vec3<Real> p10(verts_j[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
+                            const vec3<Real> p11(verts_j[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
+
+                            evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
                             }
                         }
-                    // if it is a sphere, the vertex/vertex check was
-                    // done above while iterating over vertices in
-                    // particle i so we don't need another one here
-                    }
-
-                // iterate over all pairs of edges
-                for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
-                    {
-                    vec3<Real> p00(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
-                    vec3<Real> p01(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
-                    p00 = rotate(quati, p00);
-                    p01 = rotate(quati, p01);
 
-                    // iterate over all edges of j
-                    for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
+                    // compute the pair energy and virial (FLOPS: 6)
+                    Real pair_virial[6];
+                    pair_virial[0] = -Real(0.5) * dx.x * forceij.x;
+                    pair_virial[1] = -Real(0.5) * dx.y * forceij.x;
+                    pair_virial[2] = -Real(0.5) * dx.z * forceij.x;
+                    pair_virial[3] = -Real(0.5) * dx.y * forceij.y;
+                    pair_virial[4] = -Real(0.5) * dx.z * forceij.y;
+                    pair_virial[5] = -Real(0.5) * dx.z * forceij.z;
+
+                    // Scale potential energy by half for pairwise contribution
+                    potentialij *= Real(0.5);
+
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fi += forceij;
+                    ti += torqueij;
+                    pei += potentialij;
+                    viriali[0] += pair_virial[0];
+                    viriali[1] += pair_virial[1];
+                    viriali[2] += pair_virial[2];
+                    viriali[3] += pair_virial[3];
+                    viriali[4] += pair_virial[4];
+                    viriali[5] += pair_virial[5];
+
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                    if (third_law && k < N)
                         {
-                        vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
-                        vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
-                        p10 = rotate(quatj, p10);
-                        p11 = rotate(quatj, p11);
-
-                        m_evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
+                        force_j[k].x  += forceji.x;
+                        force_j[k].y  += forceji.y;
+                        force_j[k].z  += forceji.z;
+                        force_j[k].w  += potentialij;
+                        torque_j[k].x += torqueji.x;
+                        torque_j[k].y += torqueji.y;
+                        torque_j[k].z += torqueji.z;
+                        virial_j[0*virial_pitch_j + k] += pair_virial[0];
+                        virial_j[1*virial_pitch_j + k] += pair_virial[1];
+                        virial_j[2*virial_pitch_j + k] += pair_virial[2];
+                        virial_j[3*virial_pitch_j + k] += pair_virial[3];
+                        virial_j[4*virial_pitch_j + k] += pair_virial[4];
+                        virial_j[5*virial_pitch_j + k] += pair_virial[5];
                         }
                     }
 
-                // compute the pair energy and virial (FLOPS: 6)
-                Real pair_virial[6];
-                pair_virial[0] = -Real(0.5) * dx.x * forceij.x;
-                pair_virial[1] = -Real(0.5) * dx.y * forceij.x;
-                pair_virial[2] = -Real(0.5) * dx.z * forceij.x;
-                pair_virial[3] = -Real(0.5) * dx.y * forceij.y;
-                pair_virial[4] = -Real(0.5) * dx.z * forceij.y;
-                pair_virial[5] = -Real(0.5) * dx.z * forceij.z;
-
-                // Scale potential energy by half for pairwise contribution
-                potentialij *= Real(0.5);
-
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += forceij;
-                ti += torqueij;
-                pei += potentialij;
-                viriali[0] += pair_virial[0];
-                viriali[1] += pair_virial[1];
-                viriali[2] += pair_virial[2];
-                viriali[3] += pair_virial[3];
-                viriali[4] += pair_virial[4];
-                viriali[5] += pair_virial[5];
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law && k < m_pdata->getN())
-                    {
-                    h_force.data[k].x  += forceji.x;
-                    h_force.data[k].y  += forceji.y;
-                    h_force.data[k].z  += forceji.z;
-                    h_force.data[k].w  += potentialij;
-                    h_torque.data[k].x += torqueji.x;
-                    h_torque.data[k].y += torqueji.y;
-                    h_torque.data[k].z += torqueji.z;
-                    h_virial.data[0*virial_pitch + k] += pair_virial[0];
-                    h_virial.data[1*virial_pitch + k] += pair_virial[1];
-                    h_virial.data[2*virial_pitch + k] += pair_virial[2];
-                    h_virial.data[3*virial_pitch + k] += pair_virial[3];
-                    h_virial.data[4*virial_pitch + k] += pair_virial[4];
-                    h_virial.data[5*virial_pitch + k] += pair_virial[5];
-                    }
                 }
 
+            // finally, increment the force, potential energy and virial for particle i
+            // (MEM TRANSFER: 10 scalars / FLOPS: 5)
+            h_force.data[i].x  += fi.x;
+            h_force.data[i].y  += fi.y;
+            h_force.data[i].z  += fi.z;
+            h_force.data[i].w  += pei;
+            h_torque.data[i].x += ti.x;
+            h_torque.data[i].y += ti.y;
+            h_torque.data[i].z += ti.z;
+            h_virial.data[0*virial_pitch + i] += viriali[0];
+            h_virial.data[1*virial_pitch + i] += viriali[1];
+            h_virial.data[2*virial_pitch + i] += viriali[2];
+            h_virial.data[3*virial_pitch + i] += viriali[3];
+            h_virial.data[4*virial_pitch + i] += viriali[4];
+            h_virial.data[5*virial_pitch + i] += viriali[5];
             }
 
-        // finally, increment the force, potential energy and virial for particle i
-        // (MEM TRANSFER: 10 scalars / FLOPS: 5)
-        h_force.data[i].x  += fi.x;
-        h_force.data[i].y  += fi.y;
-        h_force.data[i].z  += fi.z;
-        h_force.data[i].w  += pei;
-        h_torque.data[i].x += ti.x;
-        h_torque.data[i].y += ti.y;
-        h_torque.data[i].z += ti.z;
-        h_virial.data[0*virial_pitch + i] += viriali[0];
-        h_virial.data[1*virial_pitch + i] += viriali[1];
-        h_virial.data[2*virial_pitch + i] += viriali[2];
-        h_virial.data[3*virial_pitch + i] += viriali[3];
-        h_virial.data[4*virial_pitch + i] += viriali[4];
-        h_virial.data[5*virial_pitch + i] += viriali[5];
+        n_calc += n_calc_range;
+        };
+
+    #ifdef ENABLE_TBB
+    if (third_law)
+        {
+        // forces on j are scattered, so every thread accumulates them into its own buffer
+        for (auto& buf : m_thread_force)
+            buf.assign(N, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_torque)
+            buf.assign(N, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_virial)
+            buf.assign(6*N, Scalar(0.0));
         }
 
-    int64_t flops = m_pdata->getN() * 5 + n_calc * (3+5+9+1+14+6+8);
-    if (third_law) flops += n_calc * 8;
-    int64_t mem_transfer = m_pdata->getN() * (5+4+10)*sizeof(Real) + n_calc * (1+3+1)*sizeof(Real);
-    if (third_law) mem_transfer += n_calc*10*sizeof(Real);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        if (!third_law)
+            {
+            // only the particles in the range are written
+            compute_range(r.begin(), r.end(), h_force.data, h_torque.data, h_virial.data, virial_pitch);
+            return;
+            }
+
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar4>& thread_torque = m_thread_torque.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != N)
+            thread_force.assign(N, make_scalar4(0,0,0,0));
+        if (thread_torque.size() != N)
+            thread_torque.assign(N, make_scalar4(0,0,0,0));
+        if (thread_virial.size() != 6*N)
+            thread_virial.assign(6*N, Scalar(0.0));
+
+        compute_range(r.begin(), r.end(), thread_force.data(), thread_torque.data(), thread_virial.data(), N);
+        });
+
+    // reduce the per-thread buffers
+    if (third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto& buf : m_thread_force)
+                {
+                if (buf.size() != N)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_force.data[i].x += buf[i].x;
+                    h_force.data[i].y += buf[i].y;
+                    h_force.data[i].z += buf[i].z;
+                    h_force.data[i].w += buf[i].w;
+                    }
+                }
+            for (auto& buf : m_thread_torque)
+                {
+                if (buf.size() != N)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_torque.data[i].x += buf[i].x;
+                    h_torque.data[i].y += buf[i].y;
+                    h_torque.data[i].z += buf[i].z;
+                    }
+                }
+            for (auto& buf : m_thread_virial)
+                {
+                if (buf.size() != 6*N)
+                    continue;
+                for (unsigned int k = 0; k < 6; ++k)
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        h_virial.data[k*virial_pitch+i] += buf[k*N+i];
+                }
+            });
+        }
+    #else
+    compute_range(0, N, h_force.data, h_torque.data, h_virial.data, virial_pitch);
+    #endif
+
+    int64_t flops = m_pdata->getN() * 5 + n_calc.load() * (3+5+9+1+14+6+8);
+    if (third_law) flops += n_calc.load() * 8;
+    int64_t mem_transfer = m_pdata->getN() * (5+4+10)*sizeof(Real) + n_calc.load() * (1+3+1)*sizeof(Real);
+    if (third_law) mem_transfer += n_calc.load()*10*sizeof(Real);
     if (m_prof) m_prof->pop(flops, mem_transfer);
     }
 
@@ -10,8 +10,13 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "DEMTypeGeometry.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file DEM3DForceCompute.h
   \brief Declares the DEM3DForceCompute class
 */
@@ -57,6 +62,10 @@
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
 
+  On the CPU, the vertices of each particle are rotated into the lab frame once (see DEMTypeGeometry) and pairs whose
+  bounding spheres are out of range of each other are skipped. With TBB, the loop over particles is parallelized and
+  the third law forces on neighbors are accumulated in per-thread buffers that are summed at the end.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -151,6 +160,13 @@ class DEM3DForceCompute : public ForceCompute
         GPUArray<Real4> m_verts; //! Vertices for each real index
         std::vector<std::vector<vec3<Real> > > m_shapes; //!< Vertices for each type
         std::vector<std::vector<std::vector<unsigned int> > > m_facesVec; //!< Faces for each type
+        DEMTypeGeometry<Real> m_geometry; //!< Host side vertices and bounding radii for each type
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_torque; //!< Per-thread torque buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
 
         //! Re-send the list of vertices and links to the GPU
         void createGeometry();
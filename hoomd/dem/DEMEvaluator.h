@@ -21,6 +21,35 @@
 #define DEVICE
 #endif
 
+/*! Vertices of a shape given in the body frame, rotated on access */
+template<typename Real, typename Real4>
+struct DEMBodyFrameVertices
+    {
+    DEVICE DEMBodyFrameVertices(const quat<Real> &q, const Real4 *verts): m_q(q), m_verts(verts) {}
+
+    DEVICE inline vec3<Real> operator()(unsigned int i) const
+        {
+        return rotate(m_q, vec3<Real>(m_verts[i]));
+        }
+
+    const quat<Real> m_q;
+    const Real4 *m_verts;
+    };
+
+/*! Vertices of a shape already rotated into the lab frame */
+template<typename Real>
+struct DEMLabFrameVertices
+    {
+    DEVICE DEMLabFrameVertices(const vec3<Real> *verts): m_verts(verts) {}
+
+    DEVICE inline vec3<Real> operator()(unsigned int i) const
+        {
+        return m_verts[i];
+        }
+
+    const vec3<Real> *m_verts;
+    };
+
 /*! Wrapper class to evaluate potentials between features of shapes */
 template<typename Real, typename Real4, typename Potential>
 class DEMEvaluator
@@ -91,6 +120,15 @@ class DEMEvaluator
             const unsigned int *realIndicesj, const unsigned int *facesj, const unsigned int vertex0, Real &potential,
             vec3<Real> &force_i, vec3<Real> &torque_i, vec3<Real> &force_j, vec3<Real> &torque_j) const;
 
+        /*! Same as above, but verticesj holds the vertices of particle j
+          already rotated into the lab frame, so that they are rotated
+          once per pair instead of once per vertex of particle i.
+        */
+        DEVICE inline void vertexFace(
+            const vec3<Real> &rij, const vec3<Real> &r0, const vec3<Real> *verticesj,
+            const unsigned int *realIndicesj, const unsigned int *facesj, const unsigned int vertex0, Real &potential,
+            vec3<Real> &force_i, vec3<Real> &torque_i, vec3<Real> &force_j, vec3<Real> &torque_j) const;
+
         /*! Evaluate the force and torque contributions for particles i
           and j between two edges, specified by points r00 (first vertex
           of the edge in particle i), r01 (second vertex in the edge in
@@ -108,6 +146,15 @@ class DEMEvaluator
         DEVICE inline bool withinCutoff(const Real rsq, const Real r_cut_sq)
             {return m_potential.withinCutoff(rsq,r_cut_sq);}
 
+        /*! Test if any features of two shapes with the given bounding
+          radii and centers of mass separated by sqrt(rsq) can interact
+         */
+        DEVICE inline bool boundingSpheresOverlap(const Real rsq, const Real radius_i, const Real radius_j) const
+            {
+            const Real range(radius_i + radius_j + m_potential.getMaxFeatureDistance());
+            return rsq <= range*range;
+            }
+
         DEVICE static bool needsDiameter() {return Potential::needsDiameter();}
 
         DEVICE inline void setDiameter(const Real di,const Real dj)
@@ -124,6 +171,13 @@ class DEMEvaluator
     private:
         //! Vertex/face potential parameters
         Potential m_potential;
+
+        //! Vertex/face evaluation for any way of accessing the vertices of particle j
+        template<typename Vertices>
+        DEVICE inline void vertexFaceImpl(
+            const vec3<Real> &rij, const vec3<Real> &r0, const Vertices &verticesj,
+            const unsigned int *realIndicesj, const unsigned int *facesj, const unsigned int vertex0, Real &potential,
+            vec3<Real> &force_i, vec3<Real> &torque_i, vec3<Real> &force_j, vec3<Real> &torque_j) const;
     };
 
 #include "DEMEvaluator.cc"
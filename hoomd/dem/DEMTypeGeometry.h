@@ -0,0 +1,138 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mspells
+
+/*! \file DEMTypeGeometry.h
+  \brief Declares the DEMTypeGeometry class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __DEMTYPEGEOMETRY_H__
+#define __DEMTYPEGEOMETRY_H__
+
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <vector>
+
+//! Host side copy of the vertices of all types for the CPU force loops
+/*! The vertices are stored as a structure of arrays, and the vertices of one type are contiguous in each array.
+  rotate() turns all vertices of a type into the lab frame in one loop, so the force loops rotate each shape once per
+  particle or pair instead of once per vertex/feature combination.
+
+  The bounding radius of each type is the largest distance of a vertex from the center of mass. Two shapes whose
+  bounding spheres (extended by the interaction range of the features) do not overlap cannot interact.
+*/
+template<typename Real>
+class DEMTypeGeometry
+    {
+    public:
+        //! Copy the vertices of all types
+        /*! \param shapes Vertices of each type (vec2 or vec3)
+        */
+        template<typename Vec>
+        void setShapes(const std::vector< std::vector<Vec> > &shapes)
+            {
+            m_first.resize(shapes.size());
+            m_num.resize(shapes.size());
+            m_radius.resize(shapes.size());
+            m_x.clear();
+            m_y.clear();
+            m_z.clear();
+
+            for(size_t type(0); type < shapes.size(); ++type)
+                {
+                m_first[type] = m_x.size();
+                m_num[type] = shapes[type].size();
+
+                Real rsq(0);
+                for(size_t k(0); k < shapes[type].size(); ++k)
+                    {
+                    const vec3<Real> v(toVec3(shapes[type][k]));
+                    m_x.push_back(v.x);
+                    m_y.push_back(v.y);
+                    m_z.push_back(v.z);
+                    rsq = std::max(rsq, dot(v, v));
+                    }
+                m_radius[type] = sqrt(rsq);
+                }
+            }
+
+        //! Get the total number of vertices
+        unsigned int getNumVertices() const
+            {
+            return m_x.size();
+            }
+
+        //! Get the index of the first vertex of a type
+        unsigned int getFirstVertex(unsigned int type) const
+            {
+            return m_first[type];
+            }
+
+        //! Get the number of vertices of a type
+        unsigned int getNumVertices(unsigned int type) const
+            {
+            return m_num[type];
+            }
+
+        //! Get the bounding radius of a type
+        Real getRadius(unsigned int type) const
+            {
+            return m_radius[type];
+            }
+
+        //! Rotate the vertices of a type
+        /*! \param type Type of the shape
+          \param q Orientation of the particle
+          \param out Rotated vertices, written to out[getFirstVertex(type)...]
+        */
+        void rotate(unsigned int type, const quat<Real> &q, vec3<Real> *out) const
+            {
+            const unsigned int first(m_first[type]);
+            const unsigned int n(m_num[type]);
+            const Real *x(m_x.data() + first), *y(m_y.data() + first), *z(m_z.data() + first);
+            vec3<Real> *o(out + first);
+            for(unsigned int k(0); k < n; ++k)
+                o[k] = ::rotate(q, vec3<Real>(x[k], y[k], z[k]));
+            }
+
+        //! Rotate the vertices of a 2D type
+        /*! \param type Type of the shape
+          \param q Orientation of the particle
+          \param out Rotated vertices, written to out[getFirstVertex(type)...]
+        */
+        void rotate(unsigned int type, const quat<Real> &q, vec2<Real> *out) const
+            {
+            const unsigned int first(m_first[type]);
+            const unsigned int n(m_num[type]);
+            const Real *x(m_x.data() + first), *y(m_y.data() + first);
+            vec2<Real> *o(out + first);
+            for(unsigned int k(0); k < n; ++k)
+                o[k] = ::rotate(q, vec2<Real>(x[k], y[k]));
+            }
+
+    private:
+        std::vector<Real> m_x;               //!< x coordinates of all vertices
+        std::vector<Real> m_y;               //!< y coordinates of all vertices
+        std::vector<Real> m_z;               //!< z coordinates of all vertices
+        std::vector<unsigned int> m_first;   //!< type->first vertex
+        std::vector<unsigned int> m_num;     //!< type->number of vertices
+        std::vector<Real> m_radius;          //!< type->bounding radius
+
+        static vec3<Real> toVec3(const vec3<Real> &v)
+            {
+            return v;
+            }
+
+        static vec3<Real> toVec3(const vec2<Real> &v)
+            {
+            return vec3<Real>(v.x, v.y, 0);
+            }
+    };
+
+#endif
@@ -62,6 +62,10 @@ class SWCAPotential
             Real &potential, Vec &force_i, Torque &torque_i,
             Vec &force_j, Torque &torque_j, float modFactor=1) const;
 
+        /*! Largest distance between two features that interact (requires setDiameter())
+         */
+        DEVICE inline Real getMaxFeatureDistance() const {return m_delta + sqrt(m_rcutsq);}
+
         /*! Test to see if we need to evaluate this potential
          */
         DEVICE inline bool withinCutoff(Real rsq, Real r_cut_sq)
@@ -73,6 +73,9 @@ class WCAPotential
             Real &potential, Vec &force_i, Torque &torque_i,
             Vec &force_j, Torque &torque_j, float modFactor=1) const;
 
+        /*! Largest distance between two features that interact */
+        DEVICE inline Real getMaxFeatureDistance() const {return sqrt(m_rcutsq);}
+
         /*! test if particles are within cutoff of this potential*/
         DEVICE inline bool withinCutoff(const Real rsq, const Real r_cutsq) {return rsq<r_cutsq;}
 
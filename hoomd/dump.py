@@ -496,6 +496,8 @@ class gsd(hoomd.analyze._analyzer):
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
+        distributed (bool): When True, every MPI rank writes the per-particle data of its own particles to the file
+                            instead of gathering all particles on rank 0.
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -552,6 +554,12 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    In MPI simulations of very large systems, set `distributed=True`. Per-particle chunks too large for the GSD write
+    buffer are then written by all ranks in parallel, each into its own rows, so rank 0 does not gather them. The file
+    has content equivalent to the one written with `distributed=False`. Smaller chunks, topology and user-defined log
+    quantities are still written by rank 0.
+    `distributed` has no effect in simulations on a single rank.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -586,7 +594,8 @@ class gsd(hoomd.analyze._analyzer):
                  truncate=False,
                  phase=0,
                  time_step=None,
-                 dynamic=None):
+                 dynamic=None,
+                 distributed=False):
 
         categories = ['attribute', 'property', 'momentum', 'topology'];
         dynamic_quantities = ['property']
@@ -607,6 +616,7 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setDistributed(distributed);
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -700,3 +710,59 @@ class gsd(hoomd.analyze._analyzer):
         .. versionadded:: 2.7
         """
         return self.cpp_analyzer.user_log;
+
+class checkpoint(hoomd.analyze._analyzer):
+    R""" Writes restartable checkpoints
+
+    Args:
+        filename (str): Directory to write the checkpoint to
+        period (int): Number of time steps between checkpoints, or None to write a single checkpoint immediately.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    :py:class:`checkpoint` saves the complete simulation state in double precision: all particle properties, bonds and
+    other topology, the box, the current time step, the state variables of the integrators, the domain decomposition
+    including the cut planes chosen by :py:class:`hoomd.update.balance`, and the parameters chosen by the autotuners.
+    Read the checkpoint with :py:func:`hoomd.init.read_checkpoint`.
+
+    *filename* is a directory. In MPI simulations, every rank writes the particles it owns into its own file, so
+    writing a checkpoint takes about the same time on any number of ranks. When the job restarts on the same number of
+    ranks, every rank also reads its own file back. A new checkpoint replaces the previous one only after it has been
+    written completely, so a job that is killed while writing always leaves a valid checkpoint behind.
+
+    Random numbers in hoomd are computed from the seed, the time step, and the particle tags. A restarted simulation
+    that sets the same seeds continues the same trajectory.
+
+    Checkpoints cannot be written after particles have been removed from the system.
+
+    Examples::
+
+        dump.checkpoint(filename="checkpoint", period=10000, phase=0)
+
+    """
+    def __init__(self, filename, period, phase=0):
+
+        # initialize base class
+        hoomd.analyze._analyzer.__init__(self);
+
+        filename = _hoomd.mpi_bcast_str(filename, hoomd.context.current.device.cpp_exec_conf);
+        self.cpp_analyzer = _hoomd.CheckpointWriter(hoomd.context.current.system_definition, filename);
+
+        if period is not None:
+            self.setupAnalyzer(period, phase);
+        else:
+            self.write();
+
+        # store metadata
+        self.filename = filename
+        self.period = period
+        self.phase = phase
+        self.metadata_fields = ['filename','period','phase']
+
+    def write(self):
+        """ Write a checkpoint at the current time step.
+
+        Call :py:meth:`write` at the end of a simulation to save the final state.
+        """
+
+        time_step = hoomd.context.current.system.getCurrentTimeStep()
+        self.cpp_analyzer.analyze(time_step);
@@ -205,6 +205,11 @@ class log(hoomd.analyze._analyzer):
         # re-register all computes and updater
         hoomd.context.current.system.registerLogger(self.cpp_analyzer)
 
+    # \internal
+    # \brief Writes out buffered log data (nothing is buffered, data is written every step)
+    def flush(self):
+        self.cpp_analyzer.flush()
+
     def disable(self):
         R""" Disable the logger.
 
@@ -438,6 +438,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        PatchEnergyBatch m_patch_batch;             //!< Neighbors of the trial move for the patch energy
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -957,8 +958,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
-            // check for overlaps with neighboring particle's positions (also calculate the new energy)
+            // check for overlaps with neighboring particle's positions (also collect the neighbors for the new energy)
             // All image boxes (including the primary)
+            m_patch_batch.clear();
             const unsigned int n_images = m_image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                 {
@@ -1021,18 +1023,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                     overlap = true;
                                     break;
                                     }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, collect the pair
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
+                                    m_patch_batch.push_back(r_ij,
+                                                            typ_j,
+                                                            quat<float>(orientation_j),
+                                                            h_diameter.data[j],
+                                                            h_charge.data[j]);
                                     }
                                 }
                             }
@@ -1051,9 +1048,16 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     break;
                 } // end loop over images
 
-            // calculate old patch energy only if m_patch not NULL and no overlaps
+            // calculate new and old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                m_patch_batch.evaluate(*m_patch, typ_i, quat<float>(shape_i.orientation), h_diameter.data[i],
+                                       h_charge.data[i]);
+                for (unsigned int k = 0; k < m_patch_batch.size(); k++)
+                    patch_field_energy_diff -= m_patch_batch.getEnergy(k);
+
+                m_patch_batch.clear();
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
@@ -1104,17 +1108,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
                                     Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                    // deltaU = U_old - U_new: add energy of old configuration
                                     if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
+                                        m_patch_batch.push_back(r_ij,
+                                                                typ_j,
+                                                                quat<float>(orientation_j),
+                                                                h_diameter.data[j],
+                                                                h_charge.data[j]);
                                     }
                                 }
                             }
@@ -1125,6 +1124,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                m_patch_batch.evaluate(*m_patch, typ_i, quat<float>(orientation_i), h_diameter.data[i],
+                                       h_charge.data[i]);
+                for (unsigned int k = 0; k < m_patch_batch.size(); k++)
+                    patch_field_energy_diff += m_patch_batch.getEnergy(k);
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -178,7 +178,7 @@ def read_getar(filename, modes={'any': 'any'}):
     except AttributeError:
         box = snapshot.box;
 
-    my_domain_decomposition = _create_domain_decomposition(box);
+    my_domain_decomposition = _create_domain_decomposition(box, snapshot);
     if my_domain_decomposition is not None:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(
             snapshot, hoomd.context.current.device.cpp_exec_conf, my_domain_decomposition);
@@ -226,7 +226,7 @@ def read_snapshot(snapshot):
 
     # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
     snapshot._broadcast_box(hoomd.context.current.device.cpp_exec_conf);
-    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
+    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box, snapshot);
 
     if my_domain_decomposition is not None:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.current.device.cpp_exec_conf, my_domain_decomposition);
@@ -239,7 +239,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, distributed = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -247,6 +247,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        distributed (bool): When True, every MPI rank reads the particles in its own domain directly from the file.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -259,6 +260,11 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     step of the simulation instead of the one read from the GSD file *filename*.
     *time_step* is not applied when the file *restart* is read.
 
+    By default, the root rank reads the whole frame and distributes the particles to the other ranks. With
+    *distributed=True*, all ranks open the file, and each rank memory maps the per-particle chunks and keeps only the
+    particles in its domain. Use this for very large systems, where the root rank would otherwise have to hold
+    all particles. Bonds and other topology are still read by the root rank.
+
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
@@ -275,10 +281,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.current.device.cpp_exec_conf);
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.current.device.cpp_exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.current.device.cpp_exec_conf, restart, abs(frame), frame < 0, distributed);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.current.device.cpp_exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.current.device.cpp_exec_conf, filename, abs(frame), frame < 0, distributed);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -286,7 +292,11 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
 
     # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
     snapshot._broadcast_box(hoomd.context.current.device.cpp_exec_conf);
-    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
+    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box, None if distributed else snapshot);
+
+    # with a distributed reader, every rank now reads the particles in its domain
+    if distributed:
+        reader.readLocalParticles(my_domain_decomposition);
 
     if my_domain_decomposition is not None:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.current.device.cpp_exec_conf, my_domain_decomposition);
@@ -301,6 +311,69 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     hoomd.context.current.state_reader.clearSnapshot();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
+def read_checkpoint(filename):
+    R""" Restart a simulation from a checkpoint.
+
+    Args:
+        filename (str): Checkpoint directory to read.
+
+    Reads a checkpoint written by :py:class:`hoomd.dump.checkpoint` and restores the particles, topology, box, time
+    step, and integrator state variables. Integrators and other objects that the script creates after
+    :py:func:`read_checkpoint` continue from the saved state. Autotuners reuse the parameters they chose in the
+    previous run instead of scanning their parameter space again.
+
+    When the job restarts on the same number of MPI ranks and no :py:class:`hoomd.comm.decomposition` is set, the domain
+    decomposition of the checkpoint is restored, including any cut planes moved by :py:class:`hoomd.update.balance`, and
+    every rank reads its own particles in parallel. Otherwise, rank 0 reads all particles and distributes them.
+
+    The result of :py:func:`hoomd.init.read_checkpoint` can be saved in a variable and later used to read and/or
+    change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
+
+    Example::
+
+        if os.path.exists('checkpoint'):
+            system = init.read_checkpoint('checkpoint')
+        else:
+            system = init.read_gsd('init.gsd')
+
+    See Also:
+        :py:class:`hoomd.dump.checkpoint`
+    """
+    hoomd.context._verify_init();
+
+    # check if initialization has already occurred
+    if is_initialized():
+        raise RuntimeError("Cannot initialize more than once\n");
+
+    filename = _hoomd.mpi_bcast_str(filename, hoomd.context.current.device.cpp_exec_conf);
+    reader = _hoomd.CheckpointReader(hoomd.context.current.device.cpp_exec_conf, filename);
+
+    # restore the decomposition of the checkpoint unless the user chose one
+    my_domain_decomposition = None;
+    if _hoomd.is_MPI_available() and hoomd.context.current.device.cpp_exec_conf.getNRanks() > 1 \
+            and hoomd.context.current.decomposition is None:
+        my_domain_decomposition = reader.makeDomainDecomposition();
+        if my_domain_decomposition is not None:
+            # update.balance acts on the decomposition in the context
+            hoomd.context.current.decomposition = hoomd.comm.decomposition();
+            hoomd.context.current.decomposition.cpp_dd = my_domain_decomposition;
+
+    if my_domain_decomposition is None:
+        my_domain_decomposition = _create_domain_decomposition(reader.getGlobalBox());
+
+    snapshot = reader.readSnapshot(my_domain_decomposition);
+
+    if my_domain_decomposition is not None:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.current.device.cpp_exec_conf, my_domain_decomposition);
+    else:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.current.device.cpp_exec_conf);
+
+    # initialize the system
+    hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, reader.getTimeStep());
+
+    _perform_common_init_tasks();
+    return hoomd.data.system_data(hoomd.context.current.system_definition);
+
 def restore_getar(filename, modes={'any': 'any'}):
     """Restore a subset of the current system's parameters from a
     trajectory archive (.tar, .zip, .sqlite) file. For a detailed
@@ -349,7 +422,7 @@ def _perform_common_init_tasks():
 
 ## Create a DomainDecomposition object
 # \internal
-def _create_domain_decomposition(box):
+def _create_domain_decomposition(box, snapshot=None):
     if not _hoomd.is_MPI_available():
         return None
 
@@ -363,7 +436,7 @@ def _create_domain_decomposition(box):
         # this is happening transparently to the user, so hush this up
         hoomd.context.current.decomposition = hoomd.comm.decomposition()
 
-    return hoomd.context.current.decomposition._make_cpp_decomposition(box)
+    return hoomd.context.current.decomposition._make_cpp_decomposition(box, snapshot)
 
 def _parse_getar_modes(modes):
     newModes = {}
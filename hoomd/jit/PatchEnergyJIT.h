@@ -77,6 +77,27 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
             return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
             }
 
+        //! evaluate the energies of the patch interaction between one particle and a batch of neighbors
+        /*! Calls the vectorized eval_batch function of the JIT module when it provides one.
+        */
+        virtual void energyBatch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy)
+            {
+            if (m_eval_batch)
+                m_eval_batch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+            else
+                hpmc::PatchEnergy::energyBatch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+            }
+
         static pybind11::object getAlphaNP(pybind11::object self)
             {
             auto self_cpp = self.cast<PatchEnergyJIT *>();
@@ -90,6 +111,7 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         Scalar m_r_cut;                             //!< Cutoff radius
         std::shared_ptr<EvalFactory> m_factory;       //!< The factory for the evaluator function
         EvalFactory::EvalFnPtr m_eval;                //!< Pointer to evaluator function inside the JIT module
+        EvalFactory::EvalBatchFnPtr m_eval_batch;     //!< Pointer to batched evaluator function (may be NULL)
         unsigned int m_alpha_size;                  //!< Size of array
         std::vector<float, managed_allocator<float> > m_alpha; //!< Array containing adjustable parameters
     };
@@ -97,6 +97,9 @@ float PatchEnergyJITUnion::compute_leaf_leaf_energy(vec3<float> dr,
                              unsigned int cur_node_a,
                              unsigned int cur_node_b)
     {
+    // number of constituent pairs passed to the JIT code in one call
+    const unsigned int batch_size = 16;
+
     float energy = 0.0;
     vec3<float> r_ab = rotate(conj(quat<float>(orientation_b)),vec3<float>(dr));
 
@@ -112,30 +115,55 @@ float PatchEnergyJITUnion::compute_leaf_leaf_energy(vec3<float> dr,
         quat<float> orientation_i = conj(quat<float>(orientation_b))*quat<float>(orientation_a) * m_orientation[type_a][ileaf];
         vec3<float> pos_i(rotate(conj(quat<float>(orientation_b))*quat<float>(orientation_a),m_position[type_a][ileaf])-r_ab);
 
-        // loop through leaf particles of cur_node_b
-        for (unsigned int j= 0; j < nb; j++)
+        // loop through leaf particles of cur_node_b in batches
+        for (unsigned int j_begin = 0; j_begin < nb; j_begin += batch_size)
             {
-            unsigned int jleaf = m_tree[type_b].getParticleByNode(cur_node_b, j);
+            vec3<float> r_ij[batch_size];
+            unsigned int type_j[batch_size];
+            quat<float> orientation_j[batch_size];
+            float d_j[batch_size];
+            float charge_j[batch_size];
+            float energy_ij[batch_size];
+            unsigned int n = 0;
+
+            // collect the pairs within the cutoff
+            for (unsigned int j = j_begin; j < std::min(nb, j_begin + batch_size); j++)
+                {
+                unsigned int jleaf = m_tree[type_b].getParticleByNode(cur_node_b, j);
+                vec3<float> r = m_position[type_b][jleaf] - pos_i;
+
+                float rsq = dot(r,r);
+                float rcut = m_rcut_union+0.5f*(m_diameter[type_a][ileaf]+m_diameter[type_b][jleaf]);
+                if (rsq <= rcut*rcut)
+                    {
+                    r_ij[n] = r;
+                    type_j[n] = m_type[type_b][jleaf];
+                    orientation_j[n] = m_orientation[type_b][jleaf];
+                    d_j[n] = m_diameter[type_b][jleaf];
+                    charge_j[n] = m_charge[type_b][jleaf];
+                    n++;
+                    }
+                }
 
-            unsigned int type_j = m_type[type_b][jleaf];
-            quat<float> orientation_j = m_orientation[type_b][jleaf];
-            vec3<float> r_ij = m_position[type_b][jleaf] - pos_i;
+            if (n == 0)
+                continue;
 
-            float rsq = dot(r_ij,r_ij);
-            float rcut = m_rcut_union+0.5f*(m_diameter[type_a][ileaf]+m_diameter[type_b][jleaf]);
-            if (rsq <= rcut*rcut)
+            // evaluate energy via JIT function
+            if (m_eval_union_batch)
                 {
-                // evaluate energy via JIT function
-                energy += m_eval_union(r_ij,
-                    type_i,
-                    orientation_i,
-                    m_diameter[type_a][ileaf],
-                    m_charge[type_a][ileaf],
-                    type_j,
-                    orientation_j,
-                    m_diameter[type_b][jleaf],
-                    m_charge[type_b][jleaf]);
+                m_eval_union_batch(n, r_ij, type_i, orientation_i, m_diameter[type_a][ileaf], m_charge[type_a][ileaf],
+                                   type_j, orientation_j, d_j, charge_j, energy_ij);
                 }
+            else
+                {
+                for (unsigned int k = 0; k < n; k++)
+                    energy_ij[k] = m_eval_union(r_ij[k], type_i, orientation_i, m_diameter[type_a][ileaf],
+                                                m_charge[type_a][ileaf], type_j[k], orientation_j[k], d_j[k],
+                                                charge_j[k]);
+                }
+
+            for (unsigned int k = 0; k < n; k++)
+                energy += energy_ij[k];
             }
         }
     return energy;
@@ -28,6 +28,7 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
 
             // get the evaluator
             m_eval_union = m_factory_union->getEval();
+            m_eval_union_batch = m_factory_union->getEvalBatch();
 
             if (!m_eval_union)
                 {
@@ -114,6 +115,25 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             float d_j,
             float charge_j);
 
+        //! evaluate the energies of the patch interaction between one particle and a batch of neighbors
+        /*! The pair energy of unions is not a single JIT function, so evaluate each pair with energy(). The
+            constituent pairs inside energy() are evaluated in batches.
+        */
+        virtual void energyBatch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy)
+            {
+            hpmc::PatchEnergy::energyBatch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -154,6 +174,7 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
 
         std::shared_ptr<EvalFactory> m_factory_union;            //!< The factory for the evaluator function, for constituent ptls
         EvalFactory::EvalFnPtr m_eval_union;                     //!< Pointer to evaluator function inside the JIT module
+        EvalFactory::EvalBatchFnPtr m_eval_union_batch;          //!< Pointer to batched evaluator function (may be NULL)
         Scalar m_rcut_union;                                     //!< Cutoff on constituent particles
         std::vector<float, managed_allocator<float> > m_alpha_union; //!< Data array for union
         unsigned int m_alpha_size_union;
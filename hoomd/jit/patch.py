@@ -122,6 +122,23 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also contain an extern "C" function that evaluates the energies of particle *i* with *n* neighbors
+    at once. HPMC calls it once per trial move when it is present:
+
+    .. code::
+
+        void eval_batch(unsigned int n,
+                        const vec3<float> *r_ij,
+                        unsigned int type_i,
+                        const quat<float>& q_i,
+                        float d_i,
+                        float charge_i,
+                        const unsigned int *type_j,
+                        const quat<float> *q_j,
+                        const float *d_j,
+                        const float *charge_j,
+                        float *energy)
+
     Compile the file with clang: ``clang -O3 --std=c++11 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -215,6 +232,24 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+// evaluate one particle against a batch of neighbors, HPMC calls this once per trial move
+void eval_batch(unsigned int n,
+    const vec3<float> *r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int *type_j,
+    const quat<float> *q_j,
+    const float *d_j,
+    const float *charge_j,
+    float *energy)
+    {
+    #pragma clang loop vectorize(enable)
+    for (unsigned int k = 0; k < n; k++)
+        energy[k] = eval(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+    }
 }
 """
 
@@ -9,6 +9,7 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace std;
@@ -233,7 +234,14 @@ void ActiveForceCompute::rotationalDiffusion(unsigned int timestep)
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     assert(h_pos.data != NULL);
 
-    for (unsigned int i = 0; i < m_group->getNumMembers(); i++)
+    // in 2D, the rotational diffusion angles are drawn for n_lanes particles at once
+    const unsigned int group_size = m_group->getNumMembers();
+    const unsigned int n_lanes = RandomGeneratorBatch::n_lanes;
+    RandomGeneratorBatch rng_batch(RNGIdentifier::ActiveForceCompute, m_seed);
+    NormalDistribution<Scalar> normal(m_rotationConst);
+    Scalar delta_theta[n_lanes]; // rotational diffusion angles
+
+    for (unsigned int i = 0; i < group_size; i++)
         {
         unsigned int tag = m_group->getMemberTag(i);
         unsigned int idx = h_rtag.data[tag];
@@ -241,11 +249,16 @@ void ActiveForceCompute::rotationalDiffusion(unsigned int timestep)
 
         if (m_sysdef->getNDimensions() == 2) // 2D
             {
-            Scalar delta_theta; // rotational diffusion angle
-            delta_theta = hoomd::NormalDistribution<Scalar>(m_rotationConst)(rng);
+            if (i % n_lanes == 0)
+                {
+                const unsigned int n = std::min(n_lanes, group_size - i);
+                for (unsigned int l = 0; l < n; l++)
+                    rng_batch.setLane(l, m_group->getMemberTag(i + l), timestep);
+                normal.generateBatch(delta_theta, rng_batch);
+                }
             Scalar theta; // angle on plane defining orientation of active force vector
             theta = atan2(h_f_actVec.data[i].y, h_f_actVec.data[i].x);
-            theta += delta_theta;
+            theta += delta_theta[i % n_lanes];
             h_f_actVec.data[i].x = slow::cos(theta);
             h_f_actVec.data[i].y = slow::sin(theta);
             // In 2D, the only meaningful torque vector is out of plane and should not change
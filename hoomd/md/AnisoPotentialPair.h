@@ -23,6 +23,12 @@
 #include "hoomd/ManagedArray.h"
 #include "hoomd/VectorMath.h"
 
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file AnisoPotentialPair.h
     \brief Defines the template class for anisotropic pair potentials
     \details The heart of the code that computes anisotropic pair potentials is in this file.
@@ -52,6 +58,11 @@
 
     \note XPLOR switching is not supported
 
+    Evaluators that return true from needsRotations() receive the rotation matrices (space to body frame) of both
+    particles through setRotations(). computeForces() converts each orientation to a matrix once per step instead of
+    once per pair. With TBB, the loop over particles runs in parallel and the forces and torques on neighbors (third
+    law) are accumulated in per-thread buffers that are summed at the end.
+
     <b>Implementation details</b>
 
     rcutsq and the params are stored per particle type pair. It wastes a little bit of space, but benchmarks
@@ -165,8 +176,14 @@ class AnisoPotentialPair : public ForceCompute
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
         GlobalArray<param_type> m_params;   //!< Pair parameters per type pair
         GlobalArray<shape_param_type> m_shape_params;   //!< Pair parameters per type pair
-        std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        std::vector< rotmat3<Scalar> > m_rotations; //!< Rotation matrices of local and ghost particles
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_torque; //!< Per-thread torque buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -395,7 +412,7 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     m_nlist->compute(timestep);
 
     // start the profile for this compute
-    if (m_prof) m_prof->push(m_prof_name);
+    if (m_prof) m_prof->push(m_prof_region);
 
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
@@ -422,7 +439,6 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
     ArrayHandle<shape_param_type> h_shape_params(m_shape_params, access_location::host, access_mode::read);
 
-    {
     // need to start from a zero force, energy and virial
     memset(&h_force.data[0] , 0, sizeof(Scalar4)*m_pdata->getN());
     memset(&h_torque.data[0] , 0, sizeof(Scalar4)*m_pdata->getN());
@@ -431,166 +447,282 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    const unsigned int n_local = m_pdata->getN();
+    const unsigned int n_all = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // design specifies that energies are shifted if
+    // shift mode is set to shift
+    const bool energy_shift = (m_shift_mode == shift);
+
+    // convert the orientations of all particles to rotation matrices once
+    const rotmat3<Scalar> *rotations = NULL;
+    if (aniso_evaluator::needsRotations())
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        Scalar4 quat_i = h_orientation.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (aniso_evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (aniso_evaluator::needsCharge())
-            qi = h_charge.data[i];
-
-        // initialize current particle force, torque, potential energy, and virial to 0
-        Scalar fxi = Scalar(0.0);
-        Scalar fyi = Scalar(0.0);
-        Scalar fzi = Scalar(0.0);
-        Scalar txi = Scalar(0.0);
-        Scalar tyi = Scalar(0.0);
-        Scalar tzi = Scalar(0.0);
-        Scalar pei = Scalar(0.0);
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+        m_rotations.resize(n_all);
+
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+            [&](const tbb::blocked_range<unsigned int>& r)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+        #else
+        for (unsigned int i = 0; i < n_all; ++i)
+        #endif
+            {
+            m_rotations[i] = rotmat3<Scalar>(conj(quat<Scalar>(h_orientation.data[i])));
+            }
+        #ifdef ENABLE_TBB
+            });
+        #endif
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-            Scalar4 quat_j = h_orientation.data[j];
+        rotations = m_rotations.data();
+        }
+
+    /* compute the forces on particles in [begin, end)
+       Forces, torques and virials of the particles in the range go to h_force, h_torque and h_virial, those of
+       their neighbors (third law) to neigh_force, neigh_torque and neigh_virial.
+     */
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *neigh_force, Scalar4 *neigh_torque,
+        Scalar *neigh_virial, unsigned int neigh_virial_pitch)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            Scalar4 quat_i = h_orientation.data[i];
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
+            Scalar di = Scalar(0.0);
+            Scalar qi = Scalar(0.0);
             if (aniso_evaluator::needsDiameter())
-                dj = h_diameter.data[j];
+                di = h_diameter.data[i];
             if (aniso_evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                qi = h_charge.data[i];
+
+            // initialize current particle force, torque, potential energy, and virial to 0
+            Scalar fxi = Scalar(0.0);
+            Scalar fyi = Scalar(0.0);
+            Scalar fzi = Scalar(0.0);
+            Scalar txi = Scalar(0.0);
+            Scalar tyi = Scalar(0.0);
+            Scalar tzi = Scalar(0.0);
+            Scalar pei = Scalar(0.0);
+            Scalar virialxxi = 0.0;
+            Scalar virialxyi = 0.0;
+            Scalar virialxzi = 0.0;
+            Scalar virialyyi = 0.0;
+            Scalar virialyzi = 0.0;
+            Scalar virialzzi = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int k = 0; k < size; k++)
+                {
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int j = h_nlist.data[myHead + k];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = pi - pj;
+                Scalar4 quat_j = h_orientation.data[j];
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // access diameter and charge (if needed)
+                Scalar dj = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (aniso_evaluator::needsDiameter())
+                    dj = h_diameter.data[j];
+                if (aniso_evaluator::needsCharge())
+                    qj = h_charge.data[j];
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                const param_type& param = h_params.data[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                // compute the force and potential energy
+                Scalar3 force = make_scalar3(0.0,0.0,0.0);
+                Scalar3 torque_i = make_scalar3(0.0,0.0,0.0);
+                Scalar3 torque_j = make_scalar3(0.0,0.0,0.0);
+
+                Scalar pair_eng = Scalar(0.0);
+
+                aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
+
+                if (aniso_evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (aniso_evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
+                if (aniso_evaluator::needsShape())
+                    eval.setShape(&h_shape_params.data[typei], &h_shape_params.data[typej]);
+                if (aniso_evaluator::needsTags())
+                    eval.setTags(h_tag.data[i], h_tag.data[j]);
+                if (aniso_evaluator::needsRotations())
+                    eval.setRotations(&rotations[i], &rotations[j]);
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                bool evaluated = eval.evaluate(force, pair_eng, energy_shift,torque_i,torque_j);
 
-            // design specifies that energies are shifted if
-            // shift mode is set to shift
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
+                if (evaluated)
+                    {
+                    Scalar3 force2 = Scalar(0.5)*force;
+
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fxi += force.x;
+                    fyi += force.y;
+                    fzi += force.z;
+                    txi += torque_i.x;
+                    tyi += torque_i.y;
+                    tzi += torque_i.z;
+                    pei += pair_eng * Scalar(0.5);
 
-            // compute the force and potential energy
-            Scalar3 force = make_scalar3(0.0,0.0,0.0);
-            Scalar3 torque_i = make_scalar3(0.0,0.0,0.0);
-            Scalar3 torque_j = make_scalar3(0.0,0.0,0.0);
+                    if (compute_virial)
+                        {
+                        virialxxi += dx.x*force2.x;
+                        virialxyi += dx.y*force2.x;
+                        virialxzi += dx.z*force2.x;
+                        virialyyi += dx.y*force2.y;
+                        virialyzi += dx.z*force2.y;
+                        virialzzi += dx.z*force2.z;
+                        }
 
-            Scalar pair_eng = Scalar(0.0);
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                    if (third_law)
+                        {
+                        neigh_force[j].x -= force.x;
+                        neigh_force[j].y -= force.y;
+                        neigh_force[j].z -= force.z;
+                        neigh_torque[j].x += torque_j.x;
+                        neigh_torque[j].y += torque_j.y;
+                        neigh_torque[j].z += torque_j.z;
+                        neigh_force[j].w += pair_eng * Scalar(0.5);
+                        if (compute_virial)
+                            {
+                            neigh_virial[0*neigh_virial_pitch+j] += dx.x*force2.x;
+                            neigh_virial[1*neigh_virial_pitch+j] += dx.y*force2.x;
+                            neigh_virial[2*neigh_virial_pitch+j] += dx.z*force2.x;
+                            neigh_virial[3*neigh_virial_pitch+j] += dx.y*force2.y;
+                            neigh_virial[4*neigh_virial_pitch+j] += dx.z*force2.y;
+                            neigh_virial[5*neigh_virial_pitch+j] += dx.z*force2.z;
+                            }
+                        }
+                    }
+                }
 
-            aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
+            // finally, increment the force, potential energy and virial for particle i
+            h_force.data[i].x += fxi;
+            h_force.data[i].y += fyi;
+            h_force.data[i].z += fzi;
+            h_torque.data[i].x += txi;
+            h_torque.data[i].y += tyi;
+            h_torque.data[i].z += tzi;
+            h_force.data[i].w += pei;
+            if (compute_virial)
+                {
+                h_virial.data[0*m_virial_pitch+i] += virialxxi;
+                h_virial.data[1*m_virial_pitch+i] += virialxyi;
+                h_virial.data[2*m_virial_pitch+i] += virialxzi;
+                h_virial.data[3*m_virial_pitch+i] += virialyyi;
+                h_virial.data[4*m_virial_pitch+i] += virialyzi;
+                h_virial.data[5*m_virial_pitch+i] += virialzzi;
+                }
+            }
+        };
 
-            if (aniso_evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (aniso_evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-            if (aniso_evaluator::needsShape())
-                eval.setShape(&h_shape_params.data[typei], &h_shape_params.data[typej]);
-            if (aniso_evaluator::needsTags())
-                eval.setTags(h_tag.data[i], h_tag.data[j]);
+    #ifdef ENABLE_TBB
+    if (third_law)
+        {
+        // forces on j are scattered, so every thread accumulates them into its own buffer
+        for (auto& buf : m_thread_force)
+            buf.assign(n_all, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_torque)
+            buf.assign(n_all, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_virial)
+            buf.assign(compute_virial ? 6*n_all : 0, Scalar(0.0));
+        }
 
-            bool evaluated = eval.evaluate(force, pair_eng, energy_shift,torque_i,torque_j);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        if (!third_law)
+            {
+            // only the particles in the range are written
+            compute_range(r.begin(), r.end(), h_force.data, h_torque.data, h_virial.data, m_virial_pitch);
+            return;
+            }
 
-            if (evaluated)
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar4>& thread_torque = m_thread_torque.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != n_all)
+            thread_force.assign(n_all, make_scalar4(0,0,0,0));
+        if (thread_torque.size() != n_all)
+            thread_torque.assign(n_all, make_scalar4(0,0,0,0));
+        if (compute_virial && thread_virial.size() != 6*n_all)
+            thread_virial.assign(6*n_all, Scalar(0.0));
+
+        compute_range(r.begin(), r.end(), thread_force.data(), thread_torque.data(),
+            compute_virial ? thread_virial.data() : NULL, n_all);
+        });
+
+    // reduce the per-thread buffers
+    if (third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto& buf : m_thread_force)
                 {
-                Scalar3 force2 = Scalar(0.5)*force;
-
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fxi += force.x;
-                fyi += force.y;
-                fzi += force.z;
-                txi += torque_i.x;
-                tyi += torque_i.y;
-                tzi += torque_i.z;
-                pei += pair_eng * Scalar(0.5);
-
-                if (compute_virial)
+                if (buf.size() != n_all)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
                     {
-                    virialxxi += dx.x*force2.x;
-                    virialxyi += dx.y*force2.x;
-                    virialxzi += dx.z*force2.x;
-                    virialyyi += dx.y*force2.y;
-                    virialyzi += dx.z*force2.y;
-                    virialzzi += dx.z*force2.z;
+                    h_force.data[i].x += buf[i].x;
+                    h_force.data[i].y += buf[i].y;
+                    h_force.data[i].z += buf[i].z;
+                    h_force.data[i].w += buf[i].w;
                     }
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law)
+                }
+            for (auto& buf : m_thread_torque)
+                {
+                if (buf.size() != n_all)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
                     {
-                    h_force.data[j].x -= force.x;
-                    h_force.data[j].y -= force.y;
-                    h_force.data[j].z -= force.z;
-                    h_torque.data[j].x += torque_j.x;
-                    h_torque.data[j].y += torque_j.y;
-                    h_torque.data[j].z += torque_j.z;
-                    h_force.data[j].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
-                        {
-                        h_virial.data[0*m_virial_pitch+j] += dx.x*force2.x;
-                        h_virial.data[1*m_virial_pitch+j] += dx.y*force2.x;
-                        h_virial.data[2*m_virial_pitch+j] += dx.z*force2.x;
-                        h_virial.data[3*m_virial_pitch+j] += dx.y*force2.y;
-                        h_virial.data[4*m_virial_pitch+j] += dx.z*force2.y;
-                        h_virial.data[5*m_virial_pitch+j] += dx.z*force2.z;
-                        }
+                    h_torque.data[i].x += buf[i].x;
+                    h_torque.data[i].y += buf[i].y;
+                    h_torque.data[i].z += buf[i].z;
                     }
                 }
-            }
 
-        // finally, increment the force, potential energy and virial for particle i
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_torque.data[i].x += txi;
-        h_torque.data[i].y += tyi;
-        h_torque.data[i].z += tzi;
-        h_force.data[i].w += pei;
-        if (compute_virial)
-            {
-            h_virial.data[0*m_virial_pitch+i] += virialxxi;
-            h_virial.data[1*m_virial_pitch+i] += virialxyi;
-            h_virial.data[2*m_virial_pitch+i] += virialxzi;
-            h_virial.data[3*m_virial_pitch+i] += virialyyi;
-            h_virial.data[4*m_virial_pitch+i] += virialyzi;
-            h_virial.data[5*m_virial_pitch+i] += virialzzi;
-            }
+            if (compute_virial)
+                {
+                for (auto& buf : m_thread_virial)
+                    {
+                    if (buf.size() != 6*n_all)
+                        continue;
+                    for (unsigned int k = 0; k < 6; ++k)
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            h_virial.data[k*m_virial_pitch+i] += buf[k*n_all+i];
+                    }
+                }
+            });
         }
-    }
+    #else
+    compute_range(0, n_local, h_force.data, h_torque.data, h_virial.data, m_virial_pitch);
+    #endif
 
     if (m_prof) m_prof->pop();
     }
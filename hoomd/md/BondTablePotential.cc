@@ -24,7 +24,8 @@ using namespace std;
 BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width),
+          m_interp(m_exec_conf, table_width, sysdef->getBondData()->getNTypes())
     {
     m_exec_conf->msg->notice(5) << "Constructing BondTablePotential" << endl;
 
@@ -117,6 +118,8 @@ void BondTablePotential::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = F[i];
         }
+
+    m_interp.tableChanged(type, h_params.data[type].z);
     }
 
 /*! BondTablePotential provides
@@ -176,6 +179,12 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
+    // refresh the spline coefficients of any modified tables
+    const bool cubic = m_interp.isCubic();
+    m_interp.update(h_tables.data, m_table_value);
+    ArrayHandle<Scalar4> h_coeff(m_interp.getCoefficients(), access_location::host, access_mode::read);
+    const Index2D& coeff_value = m_interp.getIndexer();
+
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -228,24 +237,25 @@ void BondTablePotential::computeForces(unsigned int timestep)
             // precomputed term
             Scalar value_f = (r - rmin) / delta_r;
 
-            // compute index into the table and read in values
-
-            /// Here we use the table!!
+            // compute index into the table and the interpolation coefficient
             unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            if (cubic)
+                {
+                Scalar4 c = h_coeff.data[coeff_value(value_i, type)];
+                TableInterpolation::evaluate(c, f, Scalar(1.0) / delta_r, V, F);
+                }
+            else
+                {
+                Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
+                Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
+
+                // interpolate linearly to get V and F
+                V = VF0.x + f * (VF1.x - VF0.x);
+                F = VF0.y + f * (VF1.y - VF0.y);
+                }
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar force_divr = Scalar(0.0);
@@ -296,5 +306,6 @@ void export_BondTablePotential(py::module& m)
     py::class_<BondTablePotential, ForceCompute, std::shared_ptr<BondTablePotential> >(m, "BondTablePotential")
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &BondTablePotential::setTable)
+    .def("setCubicInterpolation", &BondTablePotential::setCubicInterpolation)
     ;
     }
@@ -7,6 +7,7 @@
 #include "hoomd/ForceCompute.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GPUArray.h"
+#include "TableInterpolation.h"
 
 #include <memory>
 
@@ -48,6 +49,10 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - float(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When cubic interpolation is enabled with setCubicInterpolation(), the CPU code path evaluates a cubic Hermite spline
+    through the tabulated values and derivatives instead. See TableInterpolation for details. The GPU code path always
+    interpolates linearly.
     \ingroup computes
 */
 class PYBIND11_EXPORT BondTablePotential : public ForceCompute
@@ -68,6 +73,12 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Enable or disable cubic Hermite interpolation
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            m_interp.setCubic(cubic);
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -93,6 +104,7 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GPUArray<Scalar4> m_params;                 //!< Parameters stored for each table
         Index2D m_table_value;                      //!< Index table helper
+        TableInterpolation m_interp;                //!< Higher order interpolation of the tables
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
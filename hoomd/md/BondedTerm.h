@@ -0,0 +1,124 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/*! \file BondedTerm.h
+    \brief Declares the BondedTerm interface
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BONDEDTERM_H__
+#define __BONDEDTERM_H__
+
+//! Particle data and output arrays of a pass over bonded groups
+struct BondedPass
+    {
+    const Scalar4 *pos;         //!< Particle positions
+    const Scalar *diameter;     //!< Particle diameters
+    const Scalar *charge;       //!< Particle charges
+    unsigned int n_local;       //!< Number of local particles, forces on ghosts are not accumulated
+    bool compute_virial;        //!< True if the virial is accumulated
+    Scalar4 *force;             //!< Force and energy to accumulate into
+    Scalar *virial;             //!< Virial to accumulate into
+    unsigned int virial_pitch;  //!< Pitch of the virial array
+    };
+
+//! Bonded force computes that can be evaluated in a fused pass
+/*! A bonded term evaluates consecutive ranges of the local group table of its BondedGroupData (see
+    BondedGroupData::getLocalTable()) and adds the forces, energies and virials to the arrays of a BondedPass. The
+    table is ordered by the smallest local member index, so findFirstGroup() locates the groups of a window of
+    particles with a binary search. FusedBondedForceCompute walks all terms window by window, and the standalone
+    computeForces() of the terms evaluates the whole table into m_force.
+
+    Parameters held in GPUArrays are acquired by beginPass() and released by endPass(). evaluateGroups() may be
+    called from several threads at once between the two, as long as every thread writes to its own arrays. It does
+    not raise errors itself: groups with members missing on this rank are recorded with flagIncompleteGroup(), groups
+    the potential cannot evaluate with flagFailedGroup(), and both are reported by endPass() on the calling thread.
+
+    \ingroup computes
+*/
+class BondedTerm
+    {
+    public:
+        //! Constructor
+        BondedTerm() : m_incomplete_group(no_group), m_failed_group(no_group) {}
+
+        //! Destructor
+        virtual ~BondedTerm() {}
+
+        //! Prepare a pass over the local groups
+        /*! \returns The number of groups in the local table
+        */
+        virtual unsigned int beginPass() = 0;
+
+        //! Finish a pass over the local groups
+        virtual void endPass() = 0;
+
+        //! Find the first group whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx) = 0;
+
+        //! Evaluate the groups in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end) = 0;
+
+    protected:
+        static const unsigned int no_group = 0xffffffff;    //!< Marks that no group was recorded
+
+        //! Record a group of the local table with a member that is not available on this rank
+        void flagIncompleteGroup(unsigned int group)
+            {
+            flagGroup(m_incomplete_group, group);
+            }
+
+        //! Return the incomplete group recorded in the current pass (or no_group) and reset it
+        unsigned int takeIncompleteGroup()
+            {
+            return m_incomplete_group.exchange(no_group);
+            }
+
+        //! Record a group of the local table that the potential cannot evaluate
+        void flagFailedGroup(unsigned int group)
+            {
+            flagGroup(m_failed_group, group);
+            }
+
+        //! Return the failed group recorded in the current pass (or no_group) and reset it
+        unsigned int takeFailedGroup()
+            {
+            return m_failed_group.exchange(no_group);
+            }
+
+        //! Binary search on a local group table ordered by the smallest member index
+        template<class local_t>
+        static unsigned int lowerBound(const std::vector<local_t>& table, unsigned int idx)
+            {
+            auto it = std::lower_bound(table.begin(), table.end(), idx,
+                [](const local_t& g, unsigned int i)
+                    {
+                    return *std::min_element(g.idx, g.idx + sizeof(g.idx)/sizeof(g.idx[0])) < i;
+                    });
+            return (unsigned int)(it - table.begin());
+            }
+
+    private:
+        std::atomic<unsigned int> m_incomplete_group;   //!< Smallest incomplete group of the current pass
+        std::atomic<unsigned int> m_failed_group;       //!< Smallest group the potential failed on in the current pass
+
+        //! Keep the smallest group index, so the reported group does not depend on the thread schedule
+        static void flagGroup(std::atomic<unsigned int>& slot, unsigned int group)
+            {
+            unsigned int cur = slot.load();
+            while (group < cur && !slot.compare_exchange_weak(cur, group))
+                {
+                }
+            }
+    };
+
+#endif
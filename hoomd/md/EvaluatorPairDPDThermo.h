@@ -81,7 +81,8 @@ class EvaluatorPairDPDThermo
             \param _params Per type pair parameters of this potential
         */
         DEVICE EvaluatorPairDPDThermo(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
-            : rsq(_rsq), rcutsq(_rcutsq), a(_params.x), gamma(_params.y)
+            : rsq(_rsq), rcutsq(_rcutsq), a(_params.x), gamma(_params.y),
+              m_alpha(0), m_has_alpha(false)
             {
             }
 
@@ -112,6 +113,16 @@ class EvaluatorPairDPDThermo
             m_T = Temp;
             }
 
+        //! Set the random number of the pair
+        /*! \param alpha Uniform random number in [-1,1] drawn from the stream of the pair, with the same seeds
+                  and tags that evalForceEnergyThermo() would use to draw it
+        */
+        DEVICE void setAlpha(Scalar alpha)
+            {
+            m_alpha = alpha;
+            m_has_alpha = true;
+            }
+
         //! Does not use diameter
         DEVICE static bool needsDiameter() { return false; }
         //! Accept the optional diameter values
@@ -183,23 +194,27 @@ class EvaluatorPairDPDThermo
 
                 // force calculation
 
-                unsigned int m_oi, m_oj;
-                // initialize the RNG
-                if (m_i > m_j)
-                   {
-                   m_oi = m_j;
-                   m_oj = m_i;
-                   }
-                else
-                   {
-                   m_oi = m_i;
-                   m_oj = m_j;
-                   }
-
-                hoomd::RandomGenerator rng(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_seed, m_oi, m_oj, m_timestep);
-
-                // Generate a single random number
-                Scalar alpha = hoomd::UniformDistribution<Scalar>(-1,1)(rng);
+                // Generate a single random number, unless it was drawn in advance
+                Scalar alpha = m_alpha;
+                if (!m_has_alpha)
+                    {
+                    // initialize the RNG
+                    unsigned int m_oi, m_oj;
+                    if (m_i > m_j)
+                        {
+                        m_oi = m_j;
+                        m_oj = m_i;
+                        }
+                    else
+                        {
+                        m_oi = m_i;
+                        m_oj = m_j;
+                        }
+
+                    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_seed, m_oi, m_oj,
+                                               m_timestep);
+                    alpha = hoomd::UniformDistribution<Scalar>(-1,1)(rng);
+                    }
 
                 // conservative dpd
                 //force_divr = FDIV(a,r)*(Scalar(1.0) - r*rcutinv);
@@ -252,6 +267,8 @@ class EvaluatorPairDPDThermo
         Scalar m_T;         //!< Temperature for Themostat
         Scalar m_dot;       //!< Velocity difference dotted with displacement vector
         Scalar m_deltaT;   //!<  timestep size stored from constructor
+        Scalar m_alpha;     //!< Random number of the pair set by setAlpha()
+        bool m_has_alpha;   //!< True if the random number was set by setAlpha()
     };
 
 #undef DEVICE
@@ -108,7 +108,7 @@ class EvaluatorPairDipole
             \param _params Per type pair parameters of this potential
         */
         HOSTDEVICE EvaluatorPairDipole(Scalar3& _dr, Scalar4& _quat_i, Scalar4& _quat_j, Scalar _rcutsq, const param_type& _params)
-            :dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j), params(_params)
+            :dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j), rot_i(NULL), rot_j(NULL), params(_params)
             {
             }
 
@@ -136,6 +136,12 @@ class EvaluatorPairDipole
             return true;
             }
 
+        //! Whether the pair potential uses precomputed rotation matrices
+        HOSTDEVICE static bool needsRotations()
+            {
+            return true;
+            }
+
         //! Accept the optional diameter values
         /*! \param di Diameter of particle i
             \param dj Diameter of particle j
@@ -164,6 +170,16 @@ class EvaluatorPairDipole
             q_j = qj;
             }
 
+        //! Accept the optional rotation matrices
+        /*! \param _rot_i Rotation matrix (space->body) of particle i
+            \param _rot_j Rotation matrix (space->body) of particle j
+        */
+        HOSTDEVICE void setRotations(const rotmat3<Scalar> *_rot_i, const rotmat3<Scalar> *_rot_j)
+            {
+            rot_i = _rot_i;
+            rot_j = _rot_j;
+            }
+
         //! Evaluate the force and energy
         /*! \param force Output parameter to write the computed force.
             \param pair_eng Output parameter to write the computed pair energy.
@@ -187,8 +203,9 @@ class EvaluatorPairDipole
             Scalar r5inv = r3inv*r2inv;
 
             // convert dipole vector in the body frame of each particle to space frame
-            vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), vec3<Scalar>(params.mu, 0, 0));
-            vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), vec3<Scalar>(params.mu, 0, 0));
+            // (the body x axis is the first row of the space->body rotation matrix)
+            vec3<Scalar> p_i = rot_i ? params.mu*rot_i->row0 : rotate(quat<Scalar>(quat_i), vec3<Scalar>(params.mu, 0, 0));
+            vec3<Scalar> p_j = rot_j ? params.mu*rot_j->row0 : rotate(quat<Scalar>(quat_j), vec3<Scalar>(params.mu, 0, 0));
 
             vec3<Scalar> f;
             vec3<Scalar> t_i;
@@ -288,6 +305,8 @@ class EvaluatorPairDipole
         Scalar rcutsq;              //!< Stored rcutsq from the constructor
         Scalar q_i, q_j;            //!< Stored particle charges
         Scalar4 quat_i,quat_j;      //!< Stored quaternion of ith and jth particle from constructor
+        const rotmat3<Scalar> *rot_i; //!< Precomputed rotation matrix of particle i (or NULL)
+        const rotmat3<Scalar> *rot_j; //!< Precomputed rotation matrix of particle j (or NULL)
         const param_type &params;   //!< The pair potential parameters
     };
 
@@ -90,7 +90,7 @@ class EvaluatorPairGB
                                const Scalar _rcutsq,
                                const param_type& _params)
             : dr(_dr),rcutsq(_rcutsq),qi(_qi),qj(_qj),
-              params(_params)
+              rot_i(NULL), rot_j(NULL), params(_params)
             {
             }
 
@@ -118,6 +118,12 @@ class EvaluatorPairGB
             return false;
             }
 
+        //! Whether the pair potential uses precomputed rotation matrices
+        HOSTDEVICE static bool needsRotations()
+            {
+            return true;
+            }
+
         //! Accept the optional diameter values
         /*! \param di Diameter of particle i
             \param dj Diameter of particle j
@@ -142,6 +148,16 @@ class EvaluatorPairGB
         */
         HOSTDEVICE void setCharge(Scalar qi, Scalar qj){}
 
+        //! Accept the optional rotation matrices
+        /*! \param _rot_i Rotation matrix (space->body) of particle i
+            \param _rot_j Rotation matrix (space->body) of particle j
+        */
+        HOSTDEVICE void setRotations(const rotmat3<Scalar> *_rot_i, const rotmat3<Scalar> *_rot_j)
+            {
+            rot_i = _rot_i;
+            rot_j = _rot_j;
+            }
+
         //! Evaluate the force and energy
         /*! \param force Output parameter to write the computed force.
             \param pair_eng Output parameter to write the computed pair energy.
@@ -157,13 +173,9 @@ class EvaluatorPairGB
             Scalar r = fast::sqrt(rsq);
             vec3<Scalar> unitr = fast::rsqrt(dot(dr,dr))*dr;
 
-            // obtain rotation matrices (space->body)
-            rotmat3<Scalar> rotA(conj(qi));
-            rotmat3<Scalar> rotB(conj(qj));
-
-            // last row of rotation matrix
-            vec3<Scalar> a3 = rotA.row2;
-            vec3<Scalar> b3 = rotB.row2;
+            // last row of rotation matrix (space->body)
+            vec3<Scalar> a3 = rot_i ? rot_i->row2 : rotmat3<Scalar>(conj(qi)).row2;
+            vec3<Scalar> b3 = rot_j ? rot_j->row2 : rotmat3<Scalar>(conj(qj)).row2;
 
             Scalar ca = dot(a3,unitr);
             Scalar cb = dot(b3,unitr);
@@ -254,6 +266,8 @@ class EvaluatorPairGB
         Scalar rcutsq;     //!< Stored rcutsq from the constructor
         quat<Scalar> qi;   //!< Orientation quaternion for particle i
         quat<Scalar> qj;   //!< Orientation quaternion for particle j
+        const rotmat3<Scalar> *rot_i; //!< Precomputed rotation matrix of particle i (or NULL)
+        const rotmat3<Scalar> *rot_j; //!< Precomputed rotation matrix of particle j (or NULL)
         const param_type &params;  //!< The pair potential parameters
     };
 
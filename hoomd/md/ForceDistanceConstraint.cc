@@ -7,6 +7,11 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -21,7 +26,7 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
           m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
-          m_d_max(0.0)
+          m_d_max(0.0), m_use_lincs(false), m_expansion_order(4)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -61,19 +66,33 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         throw std::runtime_error("Error computing constraints.\n");
         }
 
-    // reallocate through amortized resizin
-    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
-    m_cvec.resize(n_constraint);
+    if (m_use_lincs)
+        {
+        // populate the sparse coupling matrix, the dense matrix is never formed
+        fillCouplingMatrix(timestep);
 
-    // populate the terms in the matrix vector equation
-    fillMatrixVector(timestep);
+        // check violations
+        checkConstraints(timestep);
 
-    // check violations
-    checkConstraints(timestep);
+        // solve the matrix vector equation by a truncated series expansion
+        solveConstraintsLINCS(timestep);
+        }
+    else
+        {
+        // reallocate through amortized resizin
+        unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+        m_cmatrix.resize(n_constraint*n_constraint);
+        m_cvec.resize(n_constraint);
 
-    // solve the matrix vector equation
-    solveConstraints(timestep);
+        // populate the terms in the matrix vector equation
+        fillMatrixVector(timestep);
+
+        // check violations
+        checkConstraints(timestep);
+
+        // solve the matrix vector equation
+        solveConstraints(timestep);
+        }
 
     // compute forces
     computeConstraintForces(timestep);
@@ -372,6 +391,301 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! The constraint matrix is assembled in a compressed row format from the particle-constraint incidence list,
+    so that the cost scales with the number of constraints and their connectivity, not with its square.
+
+    \param timestep Current timestep
+*/
+void ForceDistanceConstraint::fillCouplingMatrix(unsigned int timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    m_cvec.resize(n_constraint);
+    m_inv_diag.resize(n_constraint);
+    m_n_coupling.resize(n_constraint);
+    m_constraint_ptl.resize(2*n_constraint);
+    m_constraint_r.resize(n_constraint);
+    m_constraint_q.resize(n_constraint);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    // count the number of constraints per particle
+    m_ptl_constraint_offset.assign(max_local+1, 0);
+
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        assert(constraint.tag[0] <= m_pdata->getMaximumTag());
+        assert(constraint.tag[1] <= m_pdata->getMaximumTag());
+
+        unsigned int idx_a = h_rtag.data[constraint.tag[0]];
+        unsigned int idx_b = h_rtag.data[constraint.tag[1]];
+
+        if (idx_a >= max_local || idx_b >= max_local)
+            {
+            this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
+                constraint.tag[0] << " " << constraint.tag[1] << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in constraint calculation");
+            }
+
+        m_constraint_ptl[2*n] = idx_a;
+        m_constraint_ptl[2*n+1] = idx_b;
+        m_ptl_constraint_offset[idx_a+1]++;
+        m_ptl_constraint_offset[idx_b+1]++;
+
+        vec3<Scalar> rn(box.minImage(vec3<Scalar>(h_pos.data[idx_a])-vec3<Scalar>(h_pos.data[idx_b])));
+        vec3<Scalar> rndot(vec3<Scalar>(h_vel.data[idx_a])-vec3<Scalar>(h_vel.data[idx_b]));
+        vec3<Scalar> qn(rn+rndot*m_deltaT);
+        m_constraint_r[n] = rn;
+        m_constraint_q[n] = qn;
+
+        Scalar ma(h_vel.data[idx_a].w);
+        Scalar mb(h_vel.data[idx_b].w);
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
+            {
+            m_constraint_violated.resetFlags(n+1);
+            }
+
+        // fill vector component
+        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
+        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
+              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+        }
+
+    // build the incidence list particle -> constraints
+    for (unsigned int i = 0; i < max_local; ++i)
+        m_ptl_constraint_offset[i+1] += m_ptl_constraint_offset[i];
+
+    m_ptl_constraint.resize(2*n_constraint);
+    m_coupling_offset.resize(n_constraint+1);
+
+        {
+        std::vector<unsigned int> ptl_fill(m_ptl_constraint_offset.begin(), m_ptl_constraint_offset.end()-1);
+
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            m_ptl_constraint[ptl_fill[m_constraint_ptl[2*n]]++] = n;
+            m_ptl_constraint[ptl_fill[m_constraint_ptl[2*n+1]]++] = n;
+            }
+        }
+
+    // every row couples at most to the other constraints on its two particles
+    m_coupling_offset[0] = 0;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        unsigned int idx_a = m_constraint_ptl[2*n];
+        unsigned int idx_b = m_constraint_ptl[2*n+1];
+        unsigned int n_max = m_ptl_constraint_offset[idx_a+1] - m_ptl_constraint_offset[idx_a]
+            + m_ptl_constraint_offset[idx_b+1] - m_ptl_constraint_offset[idx_b] - 2;
+        m_coupling_offset[n+1] = m_coupling_offset[n] + n_max;
+        }
+
+    m_coupling_idx.resize(m_coupling_offset[n_constraint]);
+    m_coupling_coeff.resize(m_coupling_offset[n_constraint]);
+
+    bool singular = false;
+
+    // fill the rows of the normalized coupling matrix
+    #ifdef ENABLE_TBB
+    singular = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_constraint),
+        false,
+        [&](const tbb::blocked_range<unsigned int>& r, bool singular)->bool {
+        for (unsigned int n = r.begin(); n != r.end(); ++n)
+    #else
+    for (unsigned int n = 0; n < n_constraint; ++n)
+    #endif
+        {
+        unsigned int idx_a = m_constraint_ptl[2*n];
+        unsigned int idx_b = m_constraint_ptl[2*n+1];
+
+        double inv_ma = double(1.0)/h_vel.data[idx_a].w;
+        double inv_mb = double(1.0)/h_vel.data[idx_b].w;
+
+        vec3<Scalar> qn = m_constraint_q[n];
+
+        double diag = double(4.0)*dot(qn,m_constraint_r[n])*(inv_ma+inv_mb);
+        if (diag == double(0.0))
+            {
+            singular = true;
+            continue;
+            }
+
+        unsigned int offset = m_coupling_offset[n];
+        unsigned int n_coupling = 0;
+
+        for (unsigned int i = 0; i < 2; ++i)
+            {
+            unsigned int idx = m_constraint_ptl[2*n+i];
+
+            for (unsigned int k = m_ptl_constraint_offset[idx]; k < m_ptl_constraint_offset[idx+1]; ++k)
+                {
+                unsigned int m = m_ptl_constraint[k];
+                if (m == n)
+                    continue;
+
+                unsigned int idx_m_a = m_constraint_ptl[2*m];
+                unsigned int idx_m_b = m_constraint_ptl[2*m+1];
+
+                // constraints sharing both particles have already been counted with the first particle
+                if (i == 1 && (idx_m_a == idx_a || idx_m_b == idx_a))
+                    continue;
+
+                double qr = dot(qn,m_constraint_r[m]);
+
+                double delta(0.0);
+                if (idx_m_a == idx_a)
+                    delta += double(4.0)*qr*inv_ma;
+                if (idx_m_b == idx_a)
+                    delta -= double(4.0)*qr*inv_ma;
+                if (idx_m_a == idx_b)
+                    delta -= double(4.0)*qr*inv_mb;
+                if (idx_m_b == idx_b)
+                    delta += double(4.0)*qr*inv_mb;
+
+                if (delta != double(0.0))
+                    {
+                    m_coupling_idx[offset+n_coupling] = m;
+                    m_coupling_coeff[offset+n_coupling] = -delta/diag;
+                    n_coupling++;
+                    }
+                }
+            }
+
+        m_n_coupling[n] = n_coupling;
+        m_inv_diag[n] = double(1.0)/diag;
+        }
+    #ifdef ENABLE_TBB
+    return singular;
+    }, [](bool x, bool y)->bool { return x || y; } );
+    #endif
+
+    if (singular)
+        {
+        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+        throw std::runtime_error("Error evaluating constraint forces.\n");
+        }
+    }
+
+/*! The Lagrange multipliers are computed as (1 + B + B^2 + ... + B^order) D^-1 c. The expansion is truncated early
+    once the magnitude of the latest term falls below the relative tolerance.
+
+    \param timestep Current timestep
+*/
+void ForceDistanceConstraint::solveConstraintsLINCS(unsigned int timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    // skip if zero constraints
+    if (n_constraint == 0) return;
+
+    if (m_prof)
+        m_prof->push("LINCS");
+
+    bool diverged = false;
+
+        {
+        ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+        ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+
+        m_expansion_term[0].resize(n_constraint);
+        m_expansion_term[1].resize(n_constraint);
+
+        // zeroth order term
+        double *cur = &m_expansion_term[0].front();
+        double max_lagrange(0.0);
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            cur[n] = m_inv_diag[n]*h_cvec.data[n];
+            h_lagrange.data[n] = cur[n];
+            max_lagrange = std::max(max_lagrange, std::abs(cur[n]));
+            }
+
+        double max_term_old = max_lagrange;
+        for (unsigned int order = 1; order <= m_expansion_order; ++order)
+            {
+            const double *prev = &m_expansion_term[(order-1) % 2].front();
+            double *next = &m_expansion_term[order % 2].front();
+
+            // sparse matrix-vector multiplication, parallel over rows
+            typedef std::pair<double, double> max_t;
+            max_t max_val(0.0,0.0);
+
+            #ifdef ENABLE_TBB
+            max_val = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_constraint),
+                max_t(0.0,0.0),
+                [&](const tbb::blocked_range<unsigned int>& r, max_t max_val)->max_t {
+                for (unsigned int n = r.begin(); n != r.end(); ++n)
+            #else
+            for (unsigned int n = 0; n < n_constraint; ++n)
+            #endif
+                {
+                double sum(0.0);
+                unsigned int offset = m_coupling_offset[n];
+                for (unsigned int k = 0; k < m_n_coupling[n]; ++k)
+                    sum += m_coupling_coeff[offset+k]*prev[m_coupling_idx[offset+k]];
+
+                next[n] = sum;
+                h_lagrange.data[n] += sum;
+
+                max_val.first = std::max(max_val.first, std::abs(sum));
+                max_val.second = std::max(max_val.second, std::abs(h_lagrange.data[n]));
+                }
+            #ifdef ENABLE_TBB
+            return max_val;
+            }, [](max_t x, max_t y)->max_t
+                { return max_t(std::max(x.first, y.first), std::max(x.second, y.second)); } );
+            #endif
+
+            if (max_val.first > max_term_old)
+                {
+                diverged = true;
+                break;
+                }
+
+            if (max_val.first <= m_rel_tol*max_val.second)
+                {
+                m_exec_conf->msg->notice(10) << "ForceDistanceConstraint: LINCS converged after "
+                    << order << " terms" << std::endl;
+                break;
+                }
+
+            max_term_old = max_val.first;
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    if (diverged)
+        {
+        m_exec_conf->msg->warning() << "constrain.distance(): LINCS expansion does not converge, "
+            << "falling back to solver='lu'" << std::endl;
+
+        // switch to the direct solver for the remainder of the simulation
+        setUseLINCS(false);
+        m_cmatrix.resize(n_constraint*n_constraint);
+        fillMatrixVector(timestep);
+        solveConstraints(timestep);
+        }
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(unsigned int timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -596,5 +910,7 @@ void export_ForceDistanceConstraint(py::module& m)
     py::class_< ForceDistanceConstraint, MolecularForceCompute, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint")
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def("setUseLINCS", &ForceDistanceConstraint::setUseLINCS)
+        .def("setExpansionOrder", &ForceDistanceConstraint::setExpansionOrder)
     ;
     }
@@ -25,11 +25,25 @@
 #include <Eigen/Dense>
 #include <Eigen/SparseLU>
 
+#include <vector>
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    By default, the constraint matrix equation is solved with a sparse LU decomposition. Optionally, the inverse
+    of the matrix can be approximated by a truncated series expansion, as in the LINCS algorithm
+
+    [3] B. Hess, H. Bekker, H. J. C. Berendsen, and J. G. E. M. Fraaije, “LINCS: A linear constraint solver for molecular simulations,” J. Comput. Chem., vol. 18, no. 12, pp. 1463–1472, 1997.
+
+    Writing A = D (1 - B), with D the diagonal of A, the Lagrange multipliers are obtained as
+    (1 + B + B^2 + ...) D^-1 c. The matrix B only couples constraints sharing a particle, so it is assembled
+    directly in a compressed row format and each term of the expansion is a sparse matrix-vector product that
+    is evaluated in parallel over constraints. The expansion converges for molecules without strongly
+    coupled rings, e.g. chains and trees. There is no GPU implementation of the expansion: ForceDistanceConstraintGPU
+    runs the same host code, which copies the particle data to the host and the forces back on every step.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -54,6 +68,28 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
             m_rel_tol = rel_tol;
             }
 
+        //! Select the algorithm used to solve for the Lagrange multipliers
+        /*! \param use_lincs If true, use the LINCS matrix expansion, otherwise use the sparse LU decomposition
+         */
+        void setUseLINCS(bool use_lincs)
+            {
+            if (m_use_lincs && !use_lincs)
+                {
+                // the sparse solver state needs to be reinitialized
+                m_constraint_reorder = true;
+                m_condition.resetFlags(1);
+                }
+            m_use_lincs = use_lincs;
+            }
+
+        //! Set the maximum order of the LINCS matrix expansion
+        /*! \param order Number of terms to keep in the expansion (beyond the zeroth order term)
+         */
+        void setExpansionOrder(unsigned int order)
+            {
+            m_expansion_order = order;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -83,6 +119,21 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
 
         Scalar m_d_max;                    //!< Maximum constraint extension
 
+        bool m_use_lincs;                  //!< True if the LINCS matrix expansion is used instead of the sparse LU
+        unsigned int m_expansion_order;    //!< Maximum order of the LINCS matrix expansion
+
+        std::vector<unsigned int> m_constraint_ptl;        //!< Local indices of the two particles in every constraint
+        std::vector<vec3<Scalar> > m_constraint_r;         //!< Minimum image bond vector of every constraint
+        std::vector<vec3<Scalar> > m_constraint_q;         //!< Predicted bond vector of every constraint
+        std::vector<unsigned int> m_ptl_constraint_offset; //!< Offsets into the particle-constraint incidence list
+        std::vector<unsigned int> m_ptl_constraint;        //!< Constraints every particle participates in
+        std::vector<unsigned int> m_coupling_offset;       //!< Start of every row in the coupling matrix
+        std::vector<unsigned int> m_n_coupling;            //!< Number of non-zero off-diagonal elements per row
+        std::vector<unsigned int> m_coupling_idx;          //!< Column index of every off-diagonal element
+        std::vector<double> m_coupling_coeff;              //!< Off-diagonal elements, normalized by the diagonal
+        std::vector<double> m_inv_diag;                    //!< Inverse of the diagonal of the constraint matrix
+        std::vector<double> m_expansion_term[2];           //!< Current and previous term of the matrix expansion
+
         //! Compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -98,6 +149,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         //! Solve the linear matrix-vector equation
         virtual void computeConstraintForces(unsigned int timestep);
 
+        //! Populate the sparse coupling matrix and the RHS vector for the LINCS solver
+        virtual void fillCouplingMatrix(unsigned int timestep);
+
+        //! Solve the constraint matrix equation using the LINCS matrix expansion
+        virtual void solveConstraintsLINCS(unsigned int timestep);
+
         //! Method called when constraint order changes
         virtual void slotConstraintReorder()
             {
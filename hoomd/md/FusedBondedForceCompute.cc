@@ -0,0 +1,222 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file FusedBondedForceCompute.cc
+    \brief Contains code for the FusedBondedForceCompute class
+*/
+
+#include "FusedBondedForceCompute.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace std;
+
+/*! \param sysdef System to compute forces on
+*/
+FusedBondedForceCompute::FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef)
+    : ForceCompute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FusedBondedForceCompute" << endl;
+    m_prof_name = "Fused bonded";
+    }
+
+FusedBondedForceCompute::~FusedBondedForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FusedBondedForceCompute" << endl;
+    }
+
+/*! \param force Bonded force compute to evaluate in the fused pass
+*/
+void FusedBondedForceCompute::addForceCompute(std::shared_ptr<ForceCompute> force)
+    {
+    BondedTerm *term = dynamic_cast<BondedTerm *>(force.get());
+    if (!term)
+        {
+        m_exec_conf->msg->error() << "force.fused_bonded: Only bond, angle, dihedral and improper forces "
+                                  << "with a fused implementation can be fused" << endl;
+        throw runtime_error("Error adding force to FusedBondedForceCompute");
+        }
+
+    m_forces.push_back(force);
+    m_terms.push_back(term);
+    }
+
+/*! Actually perform the force computation
+    \param timestep Current time step
+ */
+void FusedBondedForceCompute::computeForces(unsigned int timestep)
+    {
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // Zero data for force calculation, once for all terms
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    ForceTarget target;
+    target.force = h_force.data;
+    target.virial = h_virial.data;
+    target.virial_pitch = m_virial_pitch;
+    target.torque = NULL;
+    accumulateForces(timestep, target);
+    }
+
+/*! \param timestep Current time step
+    \param target Arrays to add the forces, energies and virials of all terms to
+ */
+void FusedBondedForceCompute::accumulateForces(unsigned int timestep, const ForceTarget& target)
+    {
+    if (m_prof) m_prof->push(m_prof_region);
+
+    assert(m_pdata);
+
+    // access the particle data arrays
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    PDataFlags flags = m_pdata->getFlags();
+
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = h_diameter.data;
+    pass.charge = h_charge.data;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    pass.force = target.force;
+    pass.virial = target.virial;
+    pass.virial_pitch = target.virial_pitch;
+
+    // the local tables are rebuilt here, before the threads search them
+    const unsigned int n_terms = (unsigned int)m_terms.size();
+    std::vector<unsigned int> n_groups(n_terms);
+    for (unsigned int t = 0; t < n_terms; t++)
+        n_groups[t] = m_terms[t]->beginPass();
+
+    // the last window also holds the groups without a local member, which sort last
+    const unsigned int window = getWindowSize();
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_windows = max_local / window + 1;
+
+    /* evaluate all terms in the windows [first, last), accumulating into the arrays of the given pass
+     */
+    auto compute_windows = [&](unsigned int first, unsigned int last, const BondedPass& p)
+        {
+        std::vector<unsigned int> begin(n_terms);
+        for (unsigned int t = 0; t < n_terms; t++)
+            begin[t] = m_terms[t]->findFirstGroup(first*window);
+
+        for (unsigned int w = first; w < last; w++)
+            {
+            for (unsigned int t = 0; t < n_terms; t++)
+                {
+                unsigned int end = (w+1 == n_windows) ? n_groups[t] : m_terms[t]->findFirstGroup((w+1)*window);
+                if (end > begin[t])
+                    m_terms[t]->evaluateGroups(p, begin[t], end);
+                begin[t] = end;
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    const unsigned int n_local = pass.n_local;
+
+    // groups at the window boundaries scatter into neighboring windows, so every thread uses its own buffer
+    for (auto& buf : m_thread_force)
+        buf.assign(n_local, make_scalar4(0,0,0,0));
+    for (auto& buf : m_thread_virial)
+        buf.assign(pass.compute_virial ? 6*n_local : 0, Scalar(0.0));
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_windows),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != n_local)
+            thread_force.assign(n_local, make_scalar4(0,0,0,0));
+        if (pass.compute_virial && thread_virial.size() != 6*n_local)
+            thread_virial.assign(6*n_local, Scalar(0.0));
+
+        BondedPass thread_pass = pass;
+        thread_pass.force = thread_force.data();
+        thread_pass.virial = pass.compute_virial ? thread_virial.data() : NULL;
+        thread_pass.virial_pitch = n_local;
+        compute_windows(r.begin(), r.end(), thread_pass);
+        });
+
+    // reduce the per-thread buffers
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (auto& buf : m_thread_force)
+            {
+            if (buf.size() != n_local)
+                continue;
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                pass.force[i].x += buf[i].x;
+                pass.force[i].y += buf[i].y;
+                pass.force[i].z += buf[i].z;
+                pass.force[i].w += buf[i].w;
+                }
+            }
+
+        if (pass.compute_virial)
+            {
+            for (auto& buf : m_thread_virial)
+                {
+                if (buf.size() != 6*n_local)
+                    continue;
+                for (unsigned int k = 0; k < 6; ++k)
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        pass.virial[k*pass.virial_pitch+i] += buf[k*n_local+i];
+                }
+            }
+        });
+    #else
+    compute_windows(0, n_windows, pass);
+    #endif
+
+    // every term releases its parameters before the first error is raised
+    std::exception_ptr error;
+    for (unsigned int t = 0; t < n_terms; t++)
+        {
+        try
+            {
+            m_terms[t]->endPass();
+            }
+        catch (...)
+            {
+            if (!error)
+                error = std::current_exception();
+            }
+        }
+    if (error)
+        std::rethrow_exception(error);
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags FusedBondedForceCompute::getRequestedCommFlags(unsigned int timestep)
+    {
+    CommFlags flags = ForceCompute::getRequestedCommFlags(timestep);
+
+    for (auto& force : m_forces)
+        flags |= force->getRequestedCommFlags(timestep);
+
+    return flags;
+    }
+#endif
+
+void export_FusedBondedForceCompute(py::module& m)
+    {
+    py::class_<FusedBondedForceCompute, ForceCompute, std::shared_ptr<FusedBondedForceCompute> >(m, "FusedBondedForceCompute")
+    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    .def("addForceCompute", &FusedBondedForceCompute::addForceCompute)
+    ;
+    }
@@ -0,0 +1,91 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ForceCompute.h"
+#include "BondedTerm.h"
+
+#include <memory>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file FusedBondedForceCompute.h
+    \brief Declares the FusedBondedForceCompute class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTE_H__
+#define __FUSEDBONDEDFORCECOMPUTE_H__
+
+//! Evaluates several bonded force computes in one pass into a single force array
+/*! Every bonded force compute added with addForceCompute() must implement BondedTerm. The local particles are
+    split into windows of getWindowSize() consecutive indices. For every window, the groups of all terms whose
+    smallest member lies in the window are evaluated before moving on to the next window. With the particles sorted
+    along a space filling curve, a window covers a few molecules, so their positions and forces stay in cache while
+    all bonds, angles, dihedrals and impropers that act on them are evaluated.
+
+    All terms accumulate into m_force and m_virial of this compute, which are zeroed once per step, and the
+    integrator sums one array instead of one per term. With direct accumulation, the terms add their forces straight
+    to the net force. The terms themselves must not be added to the integrator,
+    their own arrays are only filled when their energy is logged.
+
+    With TBB, the windows are distributed between threads that accumulate into per-thread buffers.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceCompute : public ForceCompute
+    {
+    public:
+        //! Constructs the compute
+        FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Destructor
+        virtual ~FusedBondedForceCompute();
+
+        //! Add a bonded force compute to the fused pass
+        void addForceCompute(std::shared_ptr<ForceCompute> force);
+
+        //! Get the number of particles in a window
+        static unsigned int getWindowSize()
+            {
+            return 512;
+            }
+
+        //! Returns true, the fused forces can be added directly to the net force
+        virtual bool supportsDirectAccumulation()
+            {
+            return true;
+            }
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by the fused force computes
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+        #endif
+
+    protected:
+        std::vector< std::shared_ptr<ForceCompute> > m_forces; //!< Fused force computes
+        std::vector< BondedTerm* > m_terms;                     //!< Bonded term interface of each force compute
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        //! Add the forces of all terms to the given arrays
+        virtual void accumulateForces(unsigned int timestep, const ForceTarget& target);
+    };
+
+//! Exports the FusedBondedForceCompute class to python
+void export_FusedBondedForceCompute(pybind11::module& m);
+
+#endif
@@ -119,68 +119,108 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    unsigned int virial_pitch = m_virial.getPitch();
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = NULL;
+    pass.charge = NULL;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = true;
+    pass.force = h_force.data;
+    pass.virial = h_virial.data;
+    pass.virial_pitch = m_virial.getPitch();
+
+    // for each of the angles
+    const unsigned int n_groups = beginPass();
+    evaluateGroups(pass, 0, n_groups);
+    endPass();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns The number of angles in the local table
+*/
+unsigned int HarmonicAngleForceCompute::beginPass()
+    {
+    return (unsigned int)m_angle_data->getLocalTable().size();
+    }
+
+/*! Raises the error for an incomplete angle found in the pass, after all threads have finished.
+*/
+void HarmonicAngleForceCompute::endPass()
+    {
+    const unsigned int group = takeIncompleteGroup();
+    if (group != no_group)
+        {
+        ArrayHandle<AngleData::members_t> h_groups(m_angle_data->getMembersArray(),
+            access_location::host, access_mode::read);
+        const AngleData::members_t& tags = h_groups.data[group];
+        m_exec_conf->msg->error() << "angle.harmonic: angle " <<
+            tags.tag[0] << " " << tags.tag[1] << " " << tags.tag[2] << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in angle calculation");
+        }
+    }
+
+/*! \param pass Particle data and output arrays
+    \param begin First angle in the local table
+    \param end One past the last angle in the local table
+*/
+void HarmonicAngleForceCompute::evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end)
+    {
+    const std::vector<AngleData::local_t>& table = m_angle_data->getLocalTable();
+
+    const unsigned int n_local = pass.n_local;
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int virial_pitch = pass.virial_pitch;
+
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    for (unsigned int i = begin; i < end; i++)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+        const AngleData::local_t& angle = table[i];
+        unsigned int idx_a = angle.idx[0];
+        unsigned int idx_b = angle.idx[1];
+        unsigned int idx_c = angle.idx[2];
+
+        // incomplete angles are reported by endPass()
+        if (idx_a >= max_local || idx_b >= max_local || idx_c >= max_local)
             {
-            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
+            flagIncompleteGroup(angle.group);
+            continue;
             }
 
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx_a < max_local);
+        assert(idx_b < max_local);
+        assert(idx_c < max_local);
 
         // calculate d\vec{r}
         Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+        dab.x = pass.pos[idx_a].x - pass.pos[idx_b].x;
+        dab.y = pass.pos[idx_a].y - pass.pos[idx_b].y;
+        dab.z = pass.pos[idx_a].z - pass.pos[idx_b].z;
 
         Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+        dcb.x = pass.pos[idx_c].x - pass.pos[idx_b].x;
+        dcb.y = pass.pos[idx_c].y - pass.pos[idx_b].y;
+        dcb.z = pass.pos[idx_c].z - pass.pos[idx_b].z;
 
         Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
+        dac.x = pass.pos[idx_a].x - pass.pos[idx_c].x; // used for the 1-3 JL interaction
+        dac.y = pass.pos[idx_a].y - pass.pos[idx_c].y;
+        dac.z = pass.pos[idx_a].z - pass.pos[idx_c].z;
 
         // apply minimum image conventions to all 3 vectors
         dab = box.minImage(dab);
@@ -208,7 +248,7 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         s_abbc = 1.0/s_abbc;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = angle.typeval.type;
         Scalar dth = acos(c_abbc) - m_t_0[angle_type];
         Scalar tk = m_K[angle_type]*dth;
 
@@ -242,38 +282,39 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
 
         // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
         // do not update ghost particles
-        if (idx_a < m_pdata->getN())
+        if (idx_a < n_local)
             {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
+            pass.force[idx_a].x += fab[0];
+            pass.force[idx_a].y += fab[1];
+            pass.force[idx_a].z += fab[2];
+            pass.force[idx_a].w += angle_eng;
+            if (pass.compute_virial)
+                for (int j = 0; j < 6; j++)
+                    pass.virial[j*virial_pitch+idx_a]  += angle_virial[j];
             }
 
-        if (idx_b < m_pdata->getN())
+        if (idx_b < n_local)
             {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
+            pass.force[idx_b].x -= fab[0] + fcb[0];
+            pass.force[idx_b].y -= fab[1] + fcb[1];
+            pass.force[idx_b].z -= fab[2] + fcb[2];
+            pass.force[idx_b].w += angle_eng;
+            if (pass.compute_virial)
+                for (int j = 0; j < 6; j++)
+                    pass.virial[j*virial_pitch+idx_b]  += angle_virial[j];
             }
 
-        if (idx_c < m_pdata->getN())
+        if (idx_c < n_local)
             {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
+            pass.force[idx_c].x += fcb[0];
+            pass.force[idx_c].y += fcb[1];
+            pass.force[idx_c].z += fcb[2];
+            pass.force[idx_c].w += angle_eng;
+            if (pass.compute_virial)
+                for (int j = 0; j < 6; j++)
+                    pass.virial[j*virial_pitch+idx_c]  += angle_virial[j];
             }
         }
-
-    if (m_prof) m_prof->pop();
     }
 
 void export_HarmonicAngleForceCompute(py::module& m)
@@ -5,6 +5,7 @@
 // Maintainer: dnlebard
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedTerm.h"
 
 #include <memory>
 
@@ -29,7 +30,7 @@
     The angles which forces are computed on are accessed from ParticleData::getAngleData
     \ingroup computes
 */
-class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
+class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute, public BondedTerm
     {
     public:
         //! Constructs the compute
@@ -60,6 +61,21 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
             }
         #endif
 
+        //! Prepare a pass over the local angles
+        virtual unsigned int beginPass();
+
+        //! Finish a pass over the local angles
+        virtual void endPass();
+
+        //! Find the first angle whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx)
+            {
+            return lowerBound(m_angle_data->getLocalTable(), idx);
+            }
+
+        //! Evaluate the angles in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end);
+
     protected:
         Scalar* m_K;    //!< K parameter for multiple angle tyes
         Scalar* m_t_0;  //!< r_0 parameter for multiple angle types
@@ -131,73 +131,111 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
 
-    // Zero data for force calculation.
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
-    unsigned int virial_pitch = m_virial.getPitch();
+    // Zero data for force calculation.
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = NULL;
+    pass.charge = NULL;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = true;
+    pass.force = h_force.data;
+    pass.virial = h_virial.data;
+    pass.virial_pitch = m_virial.getPitch();
+
+    // for each of the dihedrals
+    const unsigned int n_groups = beginPass();
+    evaluateGroups(pass, 0, n_groups);
+    endPass();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns The number of dihedrals in the local table
+*/
+unsigned int HarmonicDihedralForceCompute::beginPass()
+    {
+    return (unsigned int)m_dihedral_data->getLocalTable().size();
+    }
+
+/*! Raises the error for an incomplete dihedral found in the pass, after all threads have finished.
+*/
+void HarmonicDihedralForceCompute::endPass()
+    {
+    const unsigned int group = takeIncompleteGroup();
+    if (group != no_group)
+        {
+        ArrayHandle<DihedralData::members_t> h_groups(m_dihedral_data->getMembersArray(),
+            access_location::host, access_mode::read);
+        const DihedralData::members_t& tags = h_groups.data[group];
+        m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+            tags.tag[0] << " " << tags.tag[1] << " " << tags.tag[2] << " " << tags.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in dihedral calculation");
+        }
+    }
+
+/*! \param pass Particle data and output arrays
+    \param begin First dihedral in the local table
+    \param end One past the last dihedral in the local table
+*/
+void HarmonicDihedralForceCompute::evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end)
+    {
+    const std::vector<DihedralData::local_t>& table = m_dihedral_data->getLocalTable();
+
+    const unsigned int n_local = pass.n_local;
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int virial_pitch = pass.virial_pitch;
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    for (unsigned int i = begin; i < end; i++)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
-        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
+        const DihedralData::local_t& dihedral = table[i];
+        unsigned int idx_a = dihedral.idx[0];
+        unsigned int idx_b = dihedral.idx[1];
+        unsigned int idx_c = dihedral.idx[2];
+        unsigned int idx_d = dihedral.idx[3];
+
+        // incomplete dihedrals are reported by endPass()
+        if (idx_a >= max_local || idx_b >= max_local || idx_c >= max_local || idx_d >= max_local)
             {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
+            flagIncompleteGroup(dihedral.group);
+            continue;
             }
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx_a < max_local);
+        assert(idx_b < max_local);
+        assert(idx_c < max_local);
+        assert(idx_d < max_local);
 
         // calculate d\vec{r}
         Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+        dab.x = pass.pos[idx_a].x - pass.pos[idx_b].x;
+        dab.y = pass.pos[idx_a].y - pass.pos[idx_b].y;
+        dab.z = pass.pos[idx_a].z - pass.pos[idx_b].z;
 
         Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+        dcb.x = pass.pos[idx_c].x - pass.pos[idx_b].x;
+        dcb.y = pass.pos[idx_c].y - pass.pos[idx_b].y;
+        dcb.z = pass.pos[idx_c].z - pass.pos[idx_b].z;
 
         Scalar3 ddc;
-        ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
-        ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
-        ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
+        ddc.x = pass.pos[idx_d].x - pass.pos[idx_c].x;
+        ddc.y = pass.pos[idx_d].y - pass.pos[idx_c].y;
+        ddc.z = pass.pos[idx_d].z - pass.pos[idx_c].z;
 
         // apply periodic boundary conditions
         dab = box.minImage(dab);
@@ -237,7 +275,7 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         if (c_abcd > 1.0) c_abcd = 1.0;
         if (c_abcd < -1.0) c_abcd = -1.0;
 
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = dihedral.typeval.type;
         int multi = (int)m_multi[dihedral_type];
         Scalar p = Scalar(1.0);
         Scalar dfab = Scalar(0.0);
@@ -331,36 +369,51 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         dihedral_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        h_force.data[idx_a].x += ffax;
-        h_force.data[idx_a].y += ffay;
-        h_force.data[idx_a].z += ffaz;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
-
-        h_force.data[idx_b].x += ffbx;
-        h_force.data[idx_b].y += ffby;
-        h_force.data[idx_b].z += ffbz;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
-
-        h_force.data[idx_c].x += ffcx;
-        h_force.data[idx_c].y += ffcy;
-        h_force.data[idx_c].z += ffcz;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
-
-        h_force.data[idx_d].x += ffdx;
-        h_force.data[idx_d].y += ffdy;
-        h_force.data[idx_d].z += ffdz;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        // do not update ghost particles
+        if (idx_a < n_local)
+            {
+            pass.force[idx_a].x += ffax;
+            pass.force[idx_a].y += ffay;
+            pass.force[idx_a].z += ffaz;
+            pass.force[idx_a].w += dihedral_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[virial_pitch*k+idx_a]  += dihedral_virial[k];
+            }
+
+        if (idx_b < n_local)
+            {
+            pass.force[idx_b].x += ffbx;
+            pass.force[idx_b].y += ffby;
+            pass.force[idx_b].z += ffbz;
+            pass.force[idx_b].w += dihedral_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[virial_pitch*k+idx_b]  += dihedral_virial[k];
+            }
 
-    if (m_prof) m_prof->pop();
+        if (idx_c < n_local)
+            {
+            pass.force[idx_c].x += ffcx;
+            pass.force[idx_c].y += ffcy;
+            pass.force[idx_c].z += ffcz;
+            pass.force[idx_c].w += dihedral_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[virial_pitch*k+idx_c]  += dihedral_virial[k];
+            }
+
+        if (idx_d < n_local)
+            {
+            pass.force[idx_d].x += ffdx;
+            pass.force[idx_d].y += ffdy;
+            pass.force[idx_d].z += ffdz;
+            pass.force[idx_d].w += dihedral_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[virial_pitch*k+idx_d]  += dihedral_virial[k];
+            }
+        }
     }
 
 void export_HarmonicDihedralForceCompute(py::module& m)
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedTerm.h"
 
 #include <memory>
 
@@ -30,7 +31,7 @@
     The dihedrals which forces are computed on are accessed from ParticleData::getDihedralData
     \ingroup computes
 */
-class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
+class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute, public BondedTerm
     {
     public:
         //! Constructs the compute
@@ -61,6 +62,21 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
             }
         #endif
 
+        //! Prepare a pass over the local dihedrals
+        virtual unsigned int beginPass();
+
+        //! Finish a pass over the local dihedrals
+        virtual void endPass();
+
+        //! Find the first dihedral whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx)
+            {
+            return lowerBound(m_dihedral_data->getLocalTable(), idx);
+            }
+
+        //! Evaluate the dihedrals in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end);
+
     protected:
         Scalar *m_K;     //!< K parameter for multiple dihedral tyes
         Scalar *m_sign;  //!< sign parameter for multiple dihedral types
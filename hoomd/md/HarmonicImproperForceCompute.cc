@@ -118,72 +118,111 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    unsigned int virial_pitch = m_virial.getPitch();
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = NULL;
+    pass.charge = NULL;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = true;
+    pass.force = h_force.data;
+    pass.virial = h_virial.data;
+    pass.virial_pitch = m_virial.getPitch();
+
+    // for each of the impropers
+    const unsigned int n_groups = beginPass();
+    evaluateGroups(pass, 0, n_groups);
+    endPass();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns The number of impropers in the local table
+*/
+unsigned int HarmonicImproperForceCompute::beginPass()
+    {
+    return (unsigned int)m_improper_data->getLocalTable().size();
+    }
+
+/*! Raises the error for an incomplete improper found in the pass, after all threads have finished.
+*/
+void HarmonicImproperForceCompute::endPass()
+    {
+    const unsigned int group = takeIncompleteGroup();
+    if (group != no_group)
+        {
+        ArrayHandle<ImproperData::members_t> h_groups(m_improper_data->getMembersArray(),
+            access_location::host, access_mode::read);
+        const ImproperData::members_t& tags = h_groups.data[group];
+        m_exec_conf->msg->error() << "improper.harmonic: improper " <<
+            tags.tag[0] << " " << tags.tag[1] << " " << tags.tag[2] << " " << tags.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in improper calculation");
+        }
+    }
+
+/*! \param pass Particle data and output arrays
+    \param begin First improper in the local table
+    \param end One past the last improper in the local table
+*/
+void HarmonicImproperForceCompute::evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end)
+    {
+    const std::vector<ImproperData::local_t>& table = m_improper_data->getLocalTable();
+
+    const unsigned int n_local = pass.n_local;
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int virial_pitch = pass.virial_pitch;
+
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the impropers
-    const unsigned int size = (unsigned int)m_improper_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    for (unsigned int i = begin; i < end; i++)
         {
-        // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
-        assert(improper.tag[0] <= m_pdata->getMaximumTag());
-        assert(improper.tag[1] <= m_pdata->getMaximumTag());
-        assert(improper.tag[2] <= m_pdata->getMaximumTag());
-        assert(improper.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[improper.tag[0]];
-        unsigned int idx_b = h_rtag.data[improper.tag[1]];
-        unsigned int idx_c = h_rtag.data[improper.tag[2]];
-        unsigned int idx_d = h_rtag.data[improper.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
+        const ImproperData::local_t& improper = table[i];
+        unsigned int idx_a = improper.idx[0];
+        unsigned int idx_b = improper.idx[1];
+        unsigned int idx_c = improper.idx[2];
+        unsigned int idx_d = improper.idx[3];
+
+        // incomplete impropers are reported by endPass()
+        if (idx_a >= max_local || idx_b >= max_local || idx_c >= max_local || idx_d >= max_local)
             {
-            this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
-                improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in improper calculation");
+            flagIncompleteGroup(improper.group);
+            continue;
             }
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx_a < max_local);
+        assert(idx_b < max_local);
+        assert(idx_c < max_local);
+        assert(idx_d < max_local);
 
         // calculate d\vec{r}
         Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+        dab.x = pass.pos[idx_a].x - pass.pos[idx_b].x;
+        dab.y = pass.pos[idx_a].y - pass.pos[idx_b].y;
+        dab.z = pass.pos[idx_a].z - pass.pos[idx_b].z;
 
         Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+        dcb.x = pass.pos[idx_c].x - pass.pos[idx_b].x;
+        dcb.y = pass.pos[idx_c].y - pass.pos[idx_b].y;
+        dcb.z = pass.pos[idx_c].z - pass.pos[idx_b].z;
 
         Scalar3 ddc;
-        ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
-        ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
-        ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
+        ddc.x = pass.pos[idx_d].x - pass.pos[idx_c].x;
+        ddc.y = pass.pos[idx_d].y - pass.pos[idx_c].y;
+        ddc.z = pass.pos[idx_d].z - pass.pos[idx_c].z;
 
         // apply periodic boundary conditions
         dab = box.minImage(dab);
@@ -220,7 +259,7 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
+        unsigned int improper_type = improper.typeval.type;
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
@@ -271,49 +310,51 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         improper_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         improper_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        if (idx_a < m_pdata->getN())
+        if (idx_a < n_local)
             {
             // accumulate the forces
-            h_force.data[idx_a].x += ffax;
-            h_force.data[idx_a].y += ffay;
-            h_force.data[idx_a].z += ffaz;
-            h_force.data[idx_a].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_a]  += improper_virial[k];
+            pass.force[idx_a].x += ffax;
+            pass.force[idx_a].y += ffay;
+            pass.force[idx_a].z += ffaz;
+            pass.force[idx_a].w += improper_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[k*virial_pitch+idx_a]  += improper_virial[k];
             }
 
-        if (idx_b < m_pdata->getN())
+        if (idx_b < n_local)
             {
-            h_force.data[idx_b].x += ffbx;
-            h_force.data[idx_b].y += ffby;
-            h_force.data[idx_b].z += ffbz;
-            h_force.data[idx_b].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_b]  += improper_virial[k];
+            pass.force[idx_b].x += ffbx;
+            pass.force[idx_b].y += ffby;
+            pass.force[idx_b].z += ffbz;
+            pass.force[idx_b].w += improper_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[k*virial_pitch+idx_b]  += improper_virial[k];
             }
 
-        if (idx_c < m_pdata->getN())
+        if (idx_c < n_local)
             {
-            h_force.data[idx_c].x += ffcx;
-            h_force.data[idx_c].y += ffcy;
-            h_force.data[idx_c].z += ffcz;
-            h_force.data[idx_c].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_c]  += improper_virial[k];
+            pass.force[idx_c].x += ffcx;
+            pass.force[idx_c].y += ffcy;
+            pass.force[idx_c].z += ffcz;
+            pass.force[idx_c].w += improper_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[k*virial_pitch+idx_c]  += improper_virial[k];
             }
 
-        if (idx_d < m_pdata->getN())
+        if (idx_d < n_local)
             {
-            h_force.data[idx_d].x += ffdx;
-            h_force.data[idx_d].y += ffdy;
-            h_force.data[idx_d].z += ffdz;
-            h_force.data[idx_d].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
+            pass.force[idx_d].x += ffdx;
+            pass.force[idx_d].y += ffdy;
+            pass.force[idx_d].z += ffdz;
+            pass.force[idx_d].w += improper_eng;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[k*virial_pitch+idx_d]  += improper_virial[k];
             }
         }
-
-    if (m_prof) m_prof->pop();
     }
 
 void export_HarmonicImproperForceCompute(py::module& m)
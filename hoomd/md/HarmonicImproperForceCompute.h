@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedTerm.h"
 
 #include <memory>
 
@@ -30,7 +31,7 @@
     The impropers which forces are computed on are accessed from ParticleData::getImproperData
     \ingroup computes
 */
-class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute
+class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute, public BondedTerm
     {
     public:
         //! Constructs the compute
@@ -61,6 +62,21 @@ class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute
             }
         #endif
 
+        //! Prepare a pass over the local impropers
+        virtual unsigned int beginPass();
+
+        //! Finish a pass over the local impropers
+        virtual void endPass();
+
+        //! Find the first improper whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx)
+            {
+            return lowerBound(m_improper_data->getLocalTable(), idx);
+            }
+
+        //! Evaluate the impropers in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end);
+
     protected:
         Scalar *m_K;    //!< K parameter for multiple improper tyes
         Scalar *m_chi;  //!< Chi parameter for multiple impropers
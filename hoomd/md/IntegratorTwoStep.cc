@@ -106,7 +106,7 @@ void IntegratorTwoStep::update(unsigned int timestep)
     assert(m_prepared);
 
     if (m_prof)
-        m_prof->push("Integrate");
+        m_prof->push(m_prof_integrate);
 
     // perform the first step of the integration on all groups
     std::vector< std::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
@@ -147,7 +147,7 @@ void IntegratorTwoStep::update(unsigned int timestep)
         }
 
     if (m_prof)
-        m_prof->push("Integrate");
+        m_prof->push(m_prof_integrate);
 
     // perform the second step of the integration on all groups
     for (method = m_methods.begin(); method != m_methods.end(); ++method)
@@ -11,6 +11,7 @@
 #include "NeighborList.h"
 #include "hoomd/BondedGroupData.h"
 
+#include <pybind11/stl.h>
 namespace py = pybind11;
 
 #include <iostream>
@@ -33,8 +34,10 @@ using namespace std;
 NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_cut, Scalar r_buff)
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
-      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
-      m_dist_check(true), m_has_been_updated_once(false)
+      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_num_builds(0),
+      m_force_update(true), m_dist_check(true), m_has_been_updated_once(false), m_rbuff_window(1),
+      m_rbuff_window_steps(0), m_rbuff_window_open(false), m_rbuff_tuner_tstep(0), m_prof_neighbor(0),
+      m_prof_dist_check(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
 
@@ -312,11 +315,29 @@ NeighborList::~NeighborList()
     getRCutChangeSignal().disconnect<NeighborList, &NeighborList::slotRCutChange>(this);
     }
 
+/*! \param prof Profiler to use
+
+    The regions are looked up once here, so that they are pushed by id on every step.
+*/
+void NeighborList::setProfiler(std::shared_ptr<Profiler> prof)
+    {
+    Compute::setProfiler(prof);
+    if (m_prof)
+        {
+        m_prof_neighbor = m_prof->getRegion("Neighbor");
+        m_prof_dist_check = m_prof->getRegion("Dist check");
+        }
+    }
+
 /*! Updates the neighborlist if it has not yet been updated this times step
     \param timestep Current time step of the simulation
 */
 void NeighborList::compute(unsigned int timestep)
     {
+    // switch the buffer radius before anything reads it this step
+    if (m_rbuff_tuner)
+        updateRBuffTuner(timestep);
+
     // check if the rcut array has changed and update it
     if (m_rcut_changed)
         {
@@ -327,7 +348,7 @@ void NeighborList::compute(unsigned int timestep)
     if (!shouldCompute(timestep) && !m_force_update)
         return;
 
-    if (m_prof) m_prof->push("Neighbor");
+    if (m_prof) m_prof->push(m_prof_neighbor);
 
     // take care of some updates if things have changed since construction
     if (m_force_update)
@@ -368,6 +389,7 @@ void NeighborList::compute(unsigned int timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_num_builds++;
         }
     if (m_prof) m_prof->pop();
     }
@@ -397,6 +419,7 @@ double NeighborList::benchmark(unsigned int num_iters)
     uint64_t start_time = t.getTime();
     for (unsigned int i = 0; i < num_iters; i++)
         buildNlist(0);
+    m_num_builds += num_iters + 1;
 
 #ifdef ENABLE_HIP
     if(m_exec_conf->isCUDAEnabled())
@@ -471,6 +494,98 @@ void NeighborList::setRBuff(Scalar r_buff)
     forceUpdate();
     }
 
+/*! \param r_buff Candidate buffer radii
+    \param nsamples Number of samples (time windows) taken for each candidate
+    \param period Number of windows between rescans of all candidates
+    \param window Number of time steps timed for one sample
+
+    The wall clock time of whole time steps is measured, since r_buff trades the cost of neighbor list builds against
+    the cost of the pair forces. A window should span several neighbor list builds to be representative. When the
+    simulation is domain decomposed, the decision is made on the root rank from the samples of all ranks.
+*/
+void NeighborList::setRBuffTuner(const std::vector<Scalar>& r_buff,
+                                 unsigned int nsamples,
+                                 unsigned int period,
+                                 unsigned int window)
+    {
+    if (r_buff.size() == 0 || window == 0)
+        {
+        m_exec_conf->msg->error() << "nlist: r_buff tuning requires at least one candidate and a positive window"
+                                  << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    for (unsigned int i = 0; i < r_buff.size(); i++)
+        {
+        if (r_buff[i] < 0.0)
+            {
+            m_exec_conf->msg->error() << "nlist: Requested buffer radius is less than zero" << endl;
+            throw runtime_error("Error changing NeighborList parameters");
+            }
+        }
+
+    m_rbuff_candidates = r_buff;
+    m_rbuff_window = window;
+    m_rbuff_window_steps = 0;
+    m_rbuff_window_open = false;
+
+    // the tuner chooses an index into the list of candidates
+    m_rbuff_tuner.reset(new Autotuner(0, (unsigned int)r_buff.size()-1, 1, nsamples, period, "nlist_rbuff",
+                                      m_exec_conf));
+    #ifdef ENABLE_MPI
+    m_rbuff_tuner->setSync(bool(m_pdata->getDomainDecomposition()));
+    #endif
+    }
+
+void NeighborList::disableRBuffTuner()
+    {
+    if (!m_rbuff_tuner)
+        return;
+
+    m_rbuff_tuner->setEnabled(false);
+    if (m_rbuff_tuner->isComplete())
+        {
+        Scalar r_buff = m_rbuff_candidates[m_rbuff_tuner->getParam()];
+        if (r_buff != m_r_buff)
+            setRBuff(r_buff);
+        }
+    m_rbuff_tuner.reset();
+    }
+
+/*! \param timestep Current time step
+
+    The tuner is advanced from compute() and, in MPI simulations, from peekUpdate(), which the Communicator calls
+    before ghost particles are exchanged. A new buffer radius therefore forces a migration and a ghost exchange with
+    the matching ghost layer width before the neighbor list is built.
+*/
+void NeighborList::updateRBuffTuner(unsigned int timestep)
+    {
+    if (m_rbuff_window_open && m_rbuff_tuner_tstep == timestep)
+        return;
+    m_rbuff_tuner_tstep = timestep;
+
+    if (m_rbuff_window_open)
+        {
+        m_rbuff_window_steps++;
+        if (m_rbuff_window_steps < m_rbuff_window)
+            return;
+
+        m_rbuff_tuner->end();
+        }
+
+    // apply the candidate for the next window (the optimal one once the scan is complete)
+    Scalar r_buff = m_rbuff_candidates[m_rbuff_tuner->getParam()];
+    if (r_buff != m_r_buff)
+        {
+        m_exec_conf->msg->notice(6) << "nlist: tuner sets r_buff = " << r_buff << endl;
+        setRBuff(r_buff);
+        }
+
+    m_rbuff_tuner->begin();
+    m_rbuff_window_steps = 0;
+    m_rbuff_window_open = true;
+    }
+
 void NeighborList::updateRList()
     {
     // only need a read on the real cutoff
@@ -1120,7 +1235,7 @@ bool NeighborList::distanceCheck(unsigned int timestep)
     assert(h_pos.data);
 
     // profile
-    if (m_prof) m_prof->push("Dist check");
+    if (m_prof) m_prof->push(m_prof_dist_check);
 
     // temporary storage for the result
     bool result = false;
@@ -1200,7 +1315,7 @@ void NeighborList::setLastUpdatedPos()
     assert(h_pos.data);
 
     // profile
-    if (m_prof) m_prof->push("Dist check");
+    if (m_prof) m_prof->push(m_prof_dist_check);
 
     // update the last position arrays
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::overwrite);
@@ -1603,7 +1718,10 @@ void NeighborList::setCommunicator(std::shared_ptr<Communicator> comm)
  */
 bool NeighborList::peekUpdate(unsigned int timestep)
     {
-    if (m_prof) m_prof->push("Neighbor");
+    if (m_rbuff_tuner)
+        updateRBuffTuner(timestep);
+
+    if (m_prof) m_prof->push(m_prof_neighbor);
 
     bool result = needsUpdating(timestep);
 
@@ -1678,6 +1796,10 @@ void export_NeighborList(py::module& m)
         .def("setRCut", &NeighborList::setRCut)
         .def("setRCutPair", &NeighborList::setRCutPair)
         .def("setRBuff", &NeighborList::setRBuff)
+        .def("setRBuffTuner", &NeighborList::setRBuffTuner)
+        .def("disableRBuffTuner", &NeighborList::disableRBuffTuner)
+        .def("isRBuffTunerComplete", &NeighborList::isRBuffTunerComplete)
+        .def("getRBuff", &NeighborList::getRBuff)
         .def("setEvery", &NeighborList::setEvery)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def("addExclusion", &NeighborList::addExclusion)
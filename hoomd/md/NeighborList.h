@@ -5,6 +5,7 @@
 // Maintainer: joaander
 
 #include "hoomd/Compute.h"
+#include "hoomd/Autotuner.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
@@ -128,6 +129,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Destructor
         virtual ~NeighborList();
 
+        //! Sets the profiler for the compute to use
+        virtual void setProfiler(std::shared_ptr<Profiler> prof);
+
         //! \name Set parameters
         // @{
 
@@ -140,6 +144,21 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Change the global buffer radius
         virtual void setRBuff(Scalar r_buff);
 
+        //! Choose the global buffer radius at run time from a list of candidates
+        void setRBuffTuner(const std::vector<Scalar>& r_buff,
+                           unsigned int nsamples,
+                           unsigned int period,
+                           unsigned int window);
+
+        //! Stop tuning the buffer radius and keep the best value found so far
+        void disableRBuffTuner();
+
+        //! Test if the buffer radius tuner has completed its initial scan
+        bool isRBuffTunerComplete()
+            {
+            return m_rbuff_tuner && m_rbuff_tuner->isComplete();
+            }
+
         //! Change how many timesteps before checking to see if the list should be rebuilt
         /*! \param every Number of time steps to wait before beginning to check if particles have moved a sufficient distance
                    to require a neighbor list update.
@@ -430,6 +449,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_updates + m_forced_updates;
             }
 
+        //! Get the number of times the list has been built
+        /*! Unlike getNumUpdates(), this count is never reset by resetStats(). Computes that cache data derived from
+            the list compare it to the value at the time of caching.
+        */
+        uint64_t getNumBuilds() const
+            {
+            return m_num_builds;
+            }
+
 
 #ifdef ENABLE_MPI
         //! Set the communicator to use
@@ -555,6 +583,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         int64_t m_updates;              //!< Number of times the neighbor list has been updated
         int64_t m_forced_updates;       //!< Number of times the neighbor list has been forcibly updated
         int64_t m_dangerous_updates;    //!< Number of dangerous builds counted
+        uint64_t m_num_builds;          //!< Number of list builds, never reset
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_every steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
@@ -589,6 +618,19 @@ class PYBIND11_EXPORT NeighborList : public Compute
             m_need_reallocate_exlist = true;
             }
 
+        std::unique_ptr<Autotuner> m_rbuff_tuner;   //!< Wall clock tuner for the buffer radius
+        std::vector<Scalar> m_rbuff_candidates;     //!< Buffer radii the tuner chooses from
+        unsigned int m_rbuff_window;                //!< Number of time steps timed per sample
+        unsigned int m_rbuff_window_steps;          //!< Time steps elapsed in the current sample
+        bool m_rbuff_window_open;                   //!< True if the tuner is timing a sample
+        unsigned int m_rbuff_tuner_tstep;           //!< Last time step the tuner was advanced
+
+        unsigned int m_prof_neighbor;               //!< Profiler region "Neighbor"
+        unsigned int m_prof_dist_check;             //!< Profiler region "Dist check"
+
+        //! Advance the buffer radius tuner once per time step
+        void updateRBuffTuner(unsigned int timestep);
+
         #ifdef ENABLE_HIP
         GPUPartition m_last_gpu_partition; //!< The partition at the time of the last memory hints
         #endif
@@ -109,29 +109,79 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-    // access the force and virial tensor arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
 
-    // access parameter data
-    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+    // there are enough other checks on the input data: but it doesn't hurt to be safe
+    assert(h_force.data);
+    assert(h_virial.data);
+    assert(h_pos.data);
 
-    // Zero data for force calculation before computation
+    // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
-    // there are enough other checks on the input data, but it doesn't hurt to be safe
-    assert(h_force.data);
-    assert(h_virial.data);
-    assert(h_pos.data);
-    assert(h_rtag.data);
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = NULL;
+    pass.charge = NULL;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = true;
+    pass.force = h_force.data;
+    pass.virial = h_virial.data;
+    pass.virial_pitch = m_virial.getPitch();
+
+    // for each of the dihedrals
+    const unsigned int n_groups = beginPass();
+    evaluateGroups(pass, 0, n_groups);
+    endPass();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns The number of dihedrals in the local table
+*/
+unsigned int OPLSDihedralForceCompute::beginPass()
+    {
+    m_pass_params.reset(new ArrayHandle<Scalar4>(m_params, access_location::host, access_mode::read));
+    return (unsigned int)m_dihedral_data->getLocalTable().size();
+    }
 
-    unsigned int virial_pitch = m_virial.getPitch();
+/*! Raises the error for an incomplete dihedral found in the pass, after all threads have finished.
+*/
+void OPLSDihedralForceCompute::endPass()
+    {
+    m_pass_params.reset();
+
+    const unsigned int group = takeIncompleteGroup();
+    if (group != no_group)
+        {
+        ArrayHandle<DihedralData::members_t> h_groups(m_dihedral_data->getMembersArray(),
+            access_location::host, access_mode::read);
+        const DihedralData::members_t& tags = h_groups.data[group];
+        m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
+            tags.tag[0] << " " << tags.tag[1] << " " << tags.tag[2] << " " << tags.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in dihedral calculation");
+        }
+    }
+
+/*! \param pass Particle data and output arrays
+    \param begin First dihedral in the local table
+    \param end One past the last dihedral in the local table
+*/
+void OPLSDihedralForceCompute::evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end)
+    {
+    const std::vector<DihedralData::local_t>& table = m_dihedral_data->getLocalTable();
+    const Scalar4 *params = m_pass_params->data;
+
+    const unsigned int n_local = pass.n_local;
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int virial_pitch = pass.virial_pitch;
 
     // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
+    unsigned int dihedral_type;
     Scalar3 vb1,vb2,vb3,vb2m;
     Scalar4 f1,f2,f3,f4;
     Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
@@ -141,57 +191,46 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     Scalar k1,k2,k3,k4;
     Scalar dihedral_virial[6];
 
-    // get a local copy of the simulation box
+    // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // iterate through each dihedral
-    const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
+    for (unsigned int i = begin; i < end; i++)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
-        assert(dihedral.tag[0] < m_pdata->getNGlobal());
-        assert(dihedral.tag[1] < m_pdata->getNGlobal());
-        assert(dihedral.tag[2] < m_pdata->getNGlobal());
-        assert(dihedral.tag[3] < m_pdata->getNGlobal());
-
-        // i1 to i4 are the tags
-        i1 = h_rtag.data[dihedral.tag[0]];
-        i2 = h_rtag.data[dihedral.tag[1]];
-        i3 = h_rtag.data[dihedral.tag[2]];
-        i4 = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (i1 == NOT_LOCAL|| i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
+        const DihedralData::local_t& dihedral = table[i];
+        unsigned int i1 = dihedral.idx[0];
+        unsigned int i2 = dihedral.idx[1];
+        unsigned int i3 = dihedral.idx[2];
+        unsigned int i4 = dihedral.idx[3];
+
+        // incomplete dihedrals are reported by endPass()
+        if (i1 >= max_local || i2 >= max_local || i3 >= max_local || i4 >= max_local)
             {
-            this->m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
+            flagIncompleteGroup(dihedral.group);
+            continue;
             }
 
-        assert(i1 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i2 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i3 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i4 < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(i1 < max_local);
+        assert(i2 < max_local);
+        assert(i3 < max_local);
+        assert(i4 < max_local);
 
         // 1st bond
 
-        vb1.x = h_pos.data[i1].x - h_pos.data[i2].x;
-        vb1.y = h_pos.data[i1].y - h_pos.data[i2].y;
-        vb1.z = h_pos.data[i1].z - h_pos.data[i2].z;
+        vb1.x = pass.pos[i1].x - pass.pos[i2].x;
+        vb1.y = pass.pos[i1].y - pass.pos[i2].y;
+        vb1.z = pass.pos[i1].z - pass.pos[i2].z;
 
         // 2nd bond
 
-        vb2.x = h_pos.data[i3].x - h_pos.data[i2].x;
-        vb2.y = h_pos.data[i3].y - h_pos.data[i2].y;
-        vb2.z = h_pos.data[i3].z - h_pos.data[i2].z;
+        vb2.x = pass.pos[i3].x - pass.pos[i2].x;
+        vb2.y = pass.pos[i3].y - pass.pos[i2].y;
+        vb2.z = pass.pos[i3].z - pass.pos[i2].z;
 
         // 3rd bond
 
-        vb3.x = h_pos.data[i4].x - h_pos.data[i3].x;
-        vb3.y = h_pos.data[i4].y - h_pos.data[i3].y;
-        vb3.z = h_pos.data[i4].z - h_pos.data[i3].z;
+        vb3.x = pass.pos[i4].x - pass.pos[i3].x;
+        vb3.y = pass.pos[i4].y - pass.pos[i3].y;
+        vb3.z = pass.pos[i4].z - pass.pos[i3].z;
 
         // apply periodic boundary conditions
         vb1 = box.minImage(vb1);
@@ -231,11 +270,11 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
-        k1 = h_params.data[dihedral_type].x;
-        k2 = h_params.data[dihedral_type].y;
-        k3 = h_params.data[dihedral_type].z;
-        k4 = h_params.data[dihedral_type].w;
+        dihedral_type = dihedral.typeval.type;
+        k1 = params[dihedral_type].x;
+        k2 = params[dihedral_type].y;
+        k3 = params[dihedral_type].z;
+        k4 = params[dihedral_type].w;
 
         // calculate the potential p = sum (i=1,4) k_i * (1 + (-1)**(i+1)*cos(i*phi) )
         // and df = dp/dc
@@ -316,24 +355,6 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
         f3.z = -sz2 - f4.z;
         f3.w = e_dihedral;
 
-        // Apply force to each of the 4 atoms
-        h_force.data[i1].x += f1.x;
-        h_force.data[i1].y += f1.y;
-        h_force.data[i1].z += f1.z;
-        h_force.data[i1].w += f1.w;
-        h_force.data[i2].x += f2.x;
-        h_force.data[i2].y += f2.y;
-        h_force.data[i2].z += f2.z;
-        h_force.data[i2].w += f2.w;
-        h_force.data[i3].x += f3.x;
-        h_force.data[i3].y += f3.y;
-        h_force.data[i3].z += f3.z;
-        h_force.data[i3].w += f3.w;
-        h_force.data[i4].x += f4.x;
-        h_force.data[i4].y += f4.y;
-        h_force.data[i4].z += f4.z;
-        h_force.data[i4].w += f4.w;
-
         // Compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
         dihedral_virial[0] = 0.25*(vb1.x*f1.x + vb2.x*f3.x + (vb3.x+vb2.x)*f4.x);
@@ -343,16 +364,23 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = 0.25*(vb1.z*f1.y + vb2.z*f3.y + (vb3.z+vb2.z)*f4.y);
         dihedral_virial[5] = 0.25*(vb1.z*f1.z + vb2.z*f3.z + (vb3.z+vb2.z)*f4.z);
 
-        for (int k = 0; k < 6; k++)
+        // Apply force to each of the 4 atoms, do not update ghost particles
+        const unsigned int idx[4] = {i1, i2, i3, i4};
+        const Scalar4 f[4] = {f1, f2, f3, f4};
+        for (unsigned int j = 0; j < 4; j++)
             {
-            h_virial.data[virial_pitch*k+i1]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i2]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i3]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i4]  += dihedral_virial[k];
+            if (idx[j] >= n_local)
+                continue;
+
+            pass.force[idx[j]].x += f[j].x;
+            pass.force[idx[j]].y += f[j].y;
+            pass.force[idx[j]].z += f[j].z;
+            pass.force[idx[j]].w += f[j].w;
+            if (pass.compute_virial)
+                for (int k = 0; k < 6; k++)
+                    pass.virial[virial_pitch*k+idx[j]]  += dihedral_virial[k];
             }
         }
-
-    if (m_prof) m_prof->pop();
     }
 
 void export_OPLSDihedralForceCompute(py::module& m)
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedTerm.h"
 
 #include <memory>
 #include <vector>
@@ -29,7 +30,7 @@
     The dihedrals which forces are computed on are accessed from ParticleData::getDihedralData
     \ingroup computes
 */
-class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
+class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute, public BondedTerm
     {
     public:
         //! Constructs the compute
@@ -60,8 +61,24 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
             }
         #endif
 
+        //! Prepare a pass over the local dihedrals
+        virtual unsigned int beginPass();
+
+        //! Finish a pass over the local dihedrals
+        virtual void endPass();
+
+        //! Find the first dihedral whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx)
+            {
+            return lowerBound(m_dihedral_data->getLocalTable(), idx);
+            }
+
+        //! Evaluate the dihedrals in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end);
+
     protected:
         GPUArray<Scalar4> m_params;
+        std::unique_ptr< ArrayHandle<Scalar4> > m_pass_params; //!< Parameters acquired for a pass
 
         //!< Dihedral data to use in computing dihedrals
         std::shared_ptr<DihedralData> m_dihedral_data;
@@ -4,9 +4,14 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "BondedTerm.h"
 
 #include <vector>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file PotentialBond.h
     \brief Declares PotentialBond
 */
@@ -22,10 +27,16 @@
 
 /*! Bond potential with evaluator support
 
+    The CPU loop runs over BondData::getLocalTable(), which holds the local particle indices of the bond members in the
+    order of the particle sort. Tags are only translated to indices when the table is rebuilt after a sort, migration
+    or ghost exchange. With TBB, the bonds are split between threads that accumulate into per-thread buffers.
+
+    As a BondedTerm, the bonds can also be evaluated together with other bonded terms by FusedBondedForceCompute.
+
     \ingroup computes
 */
 template < class evaluator >
-class PotentialBond : public ForceCompute
+class PotentialBond : public ForceCompute, public BondedTerm
     {
     public:
         //! Param type from evaluator
@@ -52,14 +63,43 @@ class PotentialBond : public ForceCompute
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
         #endif
 
+        //! Returns true, the bond forces can be added directly to the net force
+        virtual bool supportsDirectAccumulation()
+            {
+            return true;
+            }
+
+        //! Prepare a pass over the local bonds
+        virtual unsigned int beginPass();
+
+        //! Finish a pass over the local bonds
+        virtual void endPass();
+
+        //! Find the first bond whose smallest member index is not below \a idx
+        virtual unsigned int findFirstGroup(unsigned int idx)
+            {
+            return lowerBound(m_bond_data->getLocalTable(), idx);
+            }
+
+        //! Evaluate the bonds in [begin, end) of the local table
+        virtual void evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end);
+
     protected:
         GPUArray<param_type> m_params;              //!< Bond parameters per type
         std::shared_ptr<BondData> m_bond_data;    //!< Bond data to use in computing bonds
         std::string m_log_name;                     //!< Cached log name
-        std::string m_prof_name;                    //!< Cached profiler name
+        std::unique_ptr< ArrayHandle<param_type> > m_pass_params; //!< Parameters acquired for a pass
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
+
+        //! Add the forces to the given arrays
+        virtual void accumulateForces(unsigned int timestep, const ForceTarget& target);
     };
 
 /*! \param sysdef System to compute forces on
@@ -143,76 +183,201 @@ Scalar PotentialBond< evaluator >::getLogValue(const std::string& quantity, unsi
 template< class evaluator >
 void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     {
-    if (m_prof) m_prof->push(m_prof_name);
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // Zero data for force calculation
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    ForceTarget target;
+    target.force = h_force.data;
+    target.virial = h_virial.data;
+    target.virial_pitch = m_virial_pitch;
+    target.torque = NULL;
+    accumulateForces(timestep, target);
+    }
+
+/*! \param timestep Current time step
+    \param target Arrays to add the forces, energies and virials to
+ */
+template< class evaluator >
+void PotentialBond< evaluator >::accumulateForces(unsigned int timestep, const ForceTarget& target)
+    {
+    if (m_prof) m_prof->push(m_prof_region);
 
     assert(m_pdata);
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::readwrite);
-
-    // access the parameters
-    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
-
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
-    assert(h_force.data);
-    assert(h_virial.data);
     assert(h_pos.data);
     assert(h_diameter.data);
     assert(h_charge.data);
 
-    // Zero data for force calculation
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    PDataFlags flags = this->m_pdata->getFlags();
+
+    BondedPass pass;
+    pass.pos = h_pos.data;
+    pass.diameter = h_diameter.data;
+    pass.charge = h_charge.data;
+    pass.n_local = m_pdata->getN();
+    pass.compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    pass.force = target.force;
+    pass.virial = target.virial;
+    pass.virial_pitch = target.virial_pitch;
+
+    // the local table translates tags to indices once per sort, migration or ghost exchange
+    const unsigned int n_bonds = beginPass();
+
+    #ifdef ENABLE_TBB
+    const unsigned int n_local = pass.n_local;
+
+    // both members of a bond are scattered, so every thread accumulates into its own buffer
+    for (auto& buf : m_thread_force)
+        buf.assign(n_local, make_scalar4(0,0,0,0));
+    for (auto& buf : m_thread_virial)
+        buf.assign(pass.compute_virial ? 6*n_local : 0, Scalar(0.0));
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_bonds),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != n_local)
+            thread_force.assign(n_local, make_scalar4(0,0,0,0));
+        if (pass.compute_virial && thread_virial.size() != 6*n_local)
+            thread_virial.assign(6*n_local, Scalar(0.0));
+
+        BondedPass thread_pass = pass;
+        thread_pass.force = thread_force.data();
+        thread_pass.virial = pass.compute_virial ? thread_virial.data() : NULL;
+        thread_pass.virial_pitch = n_local;
+        evaluateGroups(thread_pass, r.begin(), r.end());
+        });
+
+    // reduce the per-thread buffers
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (auto& buf : m_thread_force)
+            {
+            if (buf.size() != n_local)
+                continue;
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                pass.force[i].x += buf[i].x;
+                pass.force[i].y += buf[i].y;
+                pass.force[i].z += buf[i].z;
+                pass.force[i].w += buf[i].w;
+                }
+            }
+
+        if (pass.compute_virial)
+            {
+            for (auto& buf : m_thread_virial)
+                {
+                if (buf.size() != 6*n_local)
+                    continue;
+                for (unsigned int k = 0; k < 6; ++k)
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        pass.virial[k*pass.virial_pitch+i] += buf[k*n_local+i];
+                }
+            }
+        });
+    #else
+    evaluateGroups(pass, 0, n_bonds);
+    #endif
+
+    endPass();
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \returns The number of bonds in the local table
+
+    The local table is rebuilt here if needed, so that evaluateGroups() can be called from several threads.
+*/
+template< class evaluator >
+unsigned int PotentialBond< evaluator >::beginPass()
+    {
+    m_pass_params.reset(new ArrayHandle<param_type>(m_params, access_location::host, access_mode::read));
+    return (unsigned int)m_bond_data->getLocalTable().size();
+    }
+
+/*! Raises the error for an incomplete or out of bounds bond found in the pass, after all threads have finished.
+*/
+template< class evaluator >
+void PotentialBond< evaluator >::endPass()
+    {
+    m_pass_params.reset();
+
+    const unsigned int group = takeIncompleteGroup();
+    const unsigned int failed_group = takeFailedGroup();
+    if (group != no_group)
+        {
+        ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(),
+            access_location::host, access_mode::read);
+        this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
+            h_bonds.data[group].tag[0] << " " << h_bonds.data[group].tag[1] << " incomplete."
+            << std::endl << std::endl;
+        throw std::runtime_error("Error in bond calculation");
+        }
+
+    if (failed_group != no_group)
+        {
+        this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
+        throw std::runtime_error("Error in bond calculation");
+        }
+    }
+
+/*! \param pass Particle data and output arrays
+    \param begin First bond in the local table
+    \param end One past the last bond in the local table
+*/
+template< class evaluator >
+void PotentialBond< evaluator >::evaluateGroups(const BondedPass& pass, unsigned int begin, unsigned int end)
+    {
+    assert(m_pass_params);
+
+    const std::vector<typename BondData::local_t>& table = m_bond_data->getLocalTable();
+    const param_type *params = m_pass_params->data;
 
     // we are using the minimum image of the global box here
     // to ensure that ghosts are always correctly wrapped (even if a bond exceeds half the domain length)
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    const unsigned int n_local = pass.n_local;
+    const unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const bool compute_virial = pass.compute_virial;
+    Scalar4 *force = pass.force;
+    Scalar *virial = pass.virial;
+    const unsigned int virial_pitch = pass.virial_pitch;
 
     Scalar bond_virial[6];
     for (unsigned int i = 0; i< 6; i++)
         bond_virial[i]=Scalar(0.0);
 
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
-    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
-
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
-
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    for (unsigned int i = begin; i < end; i++)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
+        const typename BondData::local_t& bond = table[i];
+        unsigned int idx_a = bond.idx[0];
+        unsigned int idx_b = bond.idx[1];
 
-        // throw an error if this bond is incomplete
+        // incomplete bonds are reported by endPass()
         if (idx_a >= max_local || idx_b >= max_local)
             {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
+            flagIncompleteGroup(bond.group);
+            continue;
             }
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+        Scalar3 posa = make_scalar3(pass.pos[idx_a].x, pass.pos[idx_a].y, pass.pos[idx_a].z);
+        Scalar3 posb = make_scalar3(pass.pos[idx_b].x, pass.pos[idx_b].y, pass.pos[idx_b].z);
 
         Scalar3 dx = posb - posa;
 
@@ -221,8 +386,8 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar diameter_b = Scalar(0.0);
         if (evaluator::needsDiameter())
             {
-            diameter_a = h_diameter.data[idx_a];
-            diameter_b = h_diameter.data[idx_b];
+            diameter_a = pass.diameter[idx_a];
+            diameter_b = pass.diameter[idx_b];
             }
 
         // access charge (if needed)
@@ -230,8 +395,8 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar charge_b = Scalar(0.0);
         if (evaluator::needsCharge())
             {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
+            charge_a = pass.charge[idx_a];
+            charge_b = pass.charge[idx_b];
             }
 
         // if the vector crosses the box, pull it back
@@ -241,7 +406,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar rsq = dot(dx,dx);
 
         // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
+        param_type param = params[bond.typeval.type];
 
         // compute the force and potential energy
         Scalar force_divr = Scalar(0.0);
@@ -272,36 +437,34 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 }
 
             // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
+            if (idx_b < n_local)
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                force[idx_b].x += force_divr * dx.x;
+                force[idx_b].y += force_divr * dx.y;
+                force[idx_b].z += force_divr * dx.z;
+                force[idx_b].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        virial[k*virial_pitch+idx_b]  += bond_virial[k];
                 }
 
-            if (idx_a < m_pdata->getN())
+            if (idx_a < n_local)
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                force[idx_a].x -= force_divr * dx.x;
+                force[idx_a].y -= force_divr * dx.y;
+                force[idx_a].z -= force_divr * dx.z;
+                force[idx_a].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        virial[k*virial_pitch+idx_a]  += bond_virial[k];
                 }
             }
         else
             {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
+            // reported by endPass()
+            flagFailedGroup(bond.group);
             }
         }
-
-    if (m_prof) m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
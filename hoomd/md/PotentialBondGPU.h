@@ -53,6 +53,12 @@ class PotentialBondGPU : public PotentialBond<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! Returns false, the forces are only computed on the GPU
+        virtual bool supportsDirectAccumulation()
+            {
+            return false;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
         GPUArray<unsigned int> m_flags;       //!< Flags set during the kernel execution
@@ -97,7 +103,7 @@ template< class evaluator, hipError_t gpu_cgbf(const bond_args_t& bond_args,
 void PotentialBondGPU< evaluator, gpu_cgbf >::computeForces(unsigned int timestep)
     {
     // start the profile
-    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_name);
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_region);
 
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
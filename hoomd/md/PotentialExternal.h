@@ -9,6 +9,10 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/GlobalArray.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file PotentialExternal.h
     \brief Declares a class for computing an external force field
 */
@@ -23,7 +27,9 @@
 #define __POTENTIAL_EXTERNAL_H__
 
 //! Applys an external force to particles based on position
-/*! \ingroup computes
+/*! With TBB, the particles are evaluated in parallel.
+
+    \ingroup computes
 */
 template<class evaluator>
 class PotentialExternal: public ForceCompute
@@ -175,40 +181,54 @@ void PotentialExternal<evaluator>::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
 
-    // for each of the particles
-    for (unsigned int idx = 0; idx < nparticles; idx++)
+    /* evaluate the particles in [begin, end)
+     */
+    auto compute_particles = [&](unsigned int begin, unsigned int end)
         {
-        // get the current particle properties
-        Scalar3 X = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
-        unsigned int type = __scalar_as_int(h_pos.data[idx].w);
-        Scalar3 F;
-        Scalar energy;
-        Scalar virial[6];
-
-        param_type params = h_params.data[type];
-        evaluator eval(X, box, params, field);
-
-        if (evaluator::needsDiameter())
+        for (unsigned int idx = begin; idx < end; idx++)
             {
-            Scalar di = h_diameter.data[idx];
-            eval.setDiameter(di);
+            // get the current particle properties
+            Scalar3 X = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+            unsigned int type = __scalar_as_int(h_pos.data[idx].w);
+            Scalar3 F;
+            Scalar energy;
+            Scalar virial[6];
+
+            param_type params = h_params.data[type];
+            evaluator eval(X, box, params, field);
+
+            if (evaluator::needsDiameter())
+                {
+                Scalar di = h_diameter.data[idx];
+                eval.setDiameter(di);
+                }
+            if (evaluator::needsCharge())
+                {
+                Scalar qi = h_charge.data[idx];
+                eval.setCharge(qi);
+                }
+            eval.evalForceEnergyAndVirial(F, energy, virial);
+
+            // apply the constraint force
+            h_force.data[idx].x = F.x;
+            h_force.data[idx].y = F.y;
+            h_force.data[idx].z = F.z;
+            h_force.data[idx].w = energy;
+            for (int k = 0; k < 6; k++)
+                h_virial.data[k*m_virial_pitch+idx]  = virial[k];
             }
-        if (evaluator::needsCharge())
-            {
-            Scalar qi = h_charge.data[idx];
-            eval.setCharge(qi);
-            }
-        eval.evalForceEnergyAndVirial(F, energy, virial);
-
-        // apply the constraint force
-        h_force.data[idx].x = F.x;
-        h_force.data[idx].y = F.y;
-        h_force.data[idx].z = F.z;
-        h_force.data[idx].w = energy;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k*m_virial_pitch+idx]  = virial[k];
-        }
+        };
 
+    // for each of the particles
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        compute_particles(r.begin(), r.end());
+        });
+    #else
+    compute_particles(0, nparticles);
+    #endif
 
     if (m_prof)
         m_prof->pop();
@@ -135,6 +135,12 @@ class PotentialPair : public ForceCompute
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
         #endif
 
+        //! Returns true, the pair forces can be added directly to the net force
+        virtual bool supportsDirectAccumulation()
+            {
+            return true;
+            }
+
         //! Calculates the energy between two lists of particles.
         template< class InputIterator >
         void computeEnergyBetweenSets(  InputIterator first1, InputIterator last1,
@@ -163,12 +169,14 @@ class PotentialPair : public ForceCompute
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
         GlobalArray<Scalar> m_ronsq;                   //!< ron squared per type pair
         GlobalArray<param_type> m_params;              //!< Pair parameters per type pair
-        std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Add the forces to the given arrays
+        virtual void accumulateForces(unsigned int timestep, const ForceTarget& target);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -389,12 +397,36 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
 */
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
+    {
+    //force arrays
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    ForceTarget target;
+    target.force = h_force.data;
+    target.virial = h_virial.data;
+    target.virial_pitch = m_virial_pitch;
+    target.torque = NULL;
+    accumulateForces(timestep, target);
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \param target Arrays to add the forces, energies and virials to
+
+    The neighborlist's compute method is called to ensure that it is up to date before proceeding.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::accumulateForces(unsigned int timestep, const ForceTarget& target)
     {
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
     // start the profile for this compute
-    if (m_prof) m_prof->push(m_prof_name);
+    if (m_prof) m_prof->push(m_prof_region);
 
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
@@ -410,11 +442,10 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
-
+    Scalar4 *force = target.force;
+    Scalar *virial = target.virial;
+    const unsigned int virial_pitch = target.virial_pitch;
 
     const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
@@ -424,10 +455,6 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
-
     // for each particle
     for (int i = 0; i < (int)m_pdata->getN(); i++)
         {
@@ -566,18 +593,18 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                 if (third_law && j < m_pdata->getN())
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
                         }
                     }
                 }
@@ -585,18 +612,18 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            virial[0*virial_pitch+mem_idx] += virialxxi;
+            virial[1*virial_pitch+mem_idx] += virialxyi;
+            virial[2*virial_pitch+mem_idx] += virialxzi;
+            virial[3*virial_pitch+mem_idx] += virialyyi;
+            virial[4*virial_pitch+mem_idx] += virialyzi;
+            virial[5*virial_pitch+mem_idx] += virialzzi;
             }
         }
 
@@ -634,7 +661,7 @@ inline void PotentialPair< evaluator >::computeEnergyBetweenSets(   InputIterato
                                                                     Scalar& energy )
     {
     // start the profile for this compute
-    if (m_prof) m_prof->push(m_prof_name);
+    if (m_prof) m_prof->push(m_prof_region);
 
     if( first1 == last1 || first2 == last2 )
         return;
@@ -9,6 +9,15 @@
 
 #include "PotentialPair.h"
 #include "hoomd/Variant.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 
 /*! \file PotentialPairDPDThermo.h
@@ -37,6 +46,16 @@
      - Logging methods are provided for the energy
      - And all the details about looping through the particles, computing dr, computing the virial, etc. are handled
 
+    The random number of a pair is drawn from a stream seeded with the ordered tags of both particles.
+    computeForces() draws the numbers of the pairs within the cutoff in batches with hoomd::RandomGeneratorBatch and
+    passes them to the evaluator with setAlpha(). With a half neighbor list, every pair is visited once. With a full
+    list, every local pair is drawn once, from the entry of the particle with the smaller tag, and stored per neighbor
+    list entry; the entry of the other particle reads it through a table of reverse entries that is rebuilt with the
+    list. Pairs with a ghost particle draw on each rank, as their forces are computed on both.
+
+    With TBB, the loop over particles runs in parallel and the forces on neighbors (third law) are accumulated in
+    per-thread buffers that are summed at the end.
+
     \sa export_PotentialPairDPDThermo()
 */
 template < class evaluator >
@@ -65,15 +84,37 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
         #endif
 
+        //! Returns false, the random forces must not be evaluated again for per particle data
+        virtual bool supportsDirectAccumulation()
+            {
+            return false;
+            }
+
     protected:
 
         unsigned int m_seed;  //!< seed for PRNG for DPD thermostat
         std::shared_ptr<Variant> m_T;     //!< Temperature for the DPD thermostat
 
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
+
+        static const unsigned int no_slot = 0xffffffff;   //!< Marks a neighbor list entry without a reverse entry
+        std::vector<Scalar> m_pair_alpha;         //!< Random number of every full neighbor list entry
+        std::vector<unsigned int> m_reverse_slot; //!< Entry of i in the list of j, for every entry j of i (full list)
+        uint64_t m_reverse_slot_builds;           //!< Neighbor list build that m_reverse_slot was computed for
+
         //! Actually compute the forces (overwrites PotentialPair::computeForces())
         virtual void computeForces(unsigned int timestep);
+
+        //! Update the reverse entries of a full neighbor list
+        void updateReverseSlots();
     };
 
+template < class evaluator >
+const unsigned int PotentialPairDPDThermo< evaluator >::no_slot;
+
 /*! \param sysdef System to compute forces on
     \param nlist Neighborlist to use for computing the forces
     \param log_suffix Name given to this instance of the force
@@ -82,7 +123,7 @@ template < class evaluator >
 PotentialPairDPDThermo< evaluator >::PotentialPairDPDThermo(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : PotentialPair<evaluator>(sysdef,nlist, log_suffix)
+    : PotentialPair<evaluator>(sysdef,nlist, log_suffix), m_reverse_slot_builds(0)
     {
     }
 
@@ -112,6 +153,72 @@ void PotentialPairDPDThermo< evaluator >::setT(std::shared_ptr<Variant> T)
     m_T = T;
     }
 
+/*! For every entry j in the full neighbor list of a local particle i, finds the entry of i in the list of j. Entries
+    with a ghost neighbor, or without a reverse entry, are set to no_slot. The table only changes when the list is
+    built.
+*/
+template< class evaluator >
+void PotentialPairDPDThermo< evaluator >::updateReverseSlots()
+    {
+    const uint64_t n_builds = this->m_nlist->getNumBuilds();
+    const unsigned int n_slots = (unsigned int)this->m_nlist->getNListArray().getNumElements();
+    if (n_builds == m_reverse_slot_builds && m_reverse_slot.size() == n_slots)
+        return;
+    m_reverse_slot_builds = n_builds;
+
+    ArrayHandle<unsigned int> h_n_neigh(this->m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(this->m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(this->m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    const unsigned int n_local = this->m_pdata->getN();
+    m_reverse_slot.assign(n_slots, no_slot);
+
+    // the neighbors of every particle sorted by index, to find the reverse entries by bisection
+    std::vector< std::pair<unsigned int, unsigned int> > sorted(n_slots);
+    auto sort_range = [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            const unsigned int head_i = h_head_list.data[i];
+            const unsigned int size = h_n_neigh.data[i];
+            for (unsigned int k = 0; k < size; k++)
+                sorted[head_i + k] = std::make_pair(h_nlist.data[head_i + k], head_i + k);
+            std::sort(sorted.begin() + head_i, sorted.begin() + head_i + size);
+            }
+        };
+
+    auto find_range = [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            const unsigned int head_i = h_head_list.data[i];
+            const unsigned int size = h_n_neigh.data[i];
+            for (unsigned int k = 0; k < size; k++)
+                {
+                const unsigned int j = h_nlist.data[head_i + k];
+                if (j >= n_local)
+                    continue;
+
+                auto first = sorted.begin() + h_head_list.data[j];
+                auto last = first + h_n_neigh.data[j];
+                auto it = std::lower_bound(first, last, std::make_pair(i, 0u));
+                if (it != last && it->first == i)
+                    m_reverse_slot[head_i + k] = it->second;
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r) { sort_range(r.begin(), r.end()); });
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r) { find_range(r.begin(), r.end()); });
+    #else
+    sort_range(0, n_local);
+    find_range(0, n_local);
+    #endif
+    }
+
 /*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is called to ensure
     that it is up to date before proceeding.
 
@@ -124,12 +231,21 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     this->m_nlist->compute(timestep);
 
     // start the profile for this compute
-    if (this->m_prof) this->m_prof->push(this->m_prof_name);
+    if (this->m_prof) this->m_prof->push(this->m_prof_region);
 
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
 
+    // a full list draws the number of a pair once, from one of its two entries
+    if (!third_law)
+        {
+        updateReverseSlots();
+        m_pair_alpha.resize(m_reverse_slot.size());
+        }
+    const unsigned int *reverse_slot = m_reverse_slot.data();
+    Scalar *pair_alpha = m_pair_alpha.data();
+
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(this->m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(this->m_nlist->getNListArray(), access_location::host, access_mode::read);
@@ -152,127 +268,344 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*this->m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*this->m_virial.getNumElements());
 
-    // for each particle
-    for (int i = 0; i < (int)this->m_pdata->getN(); i++)
-        {
-        // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
-
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < this->m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0,0,0);
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (unsigned int l = 0; l < 6; l++)
-            viriali[l] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
-            {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[head_i + k];
-            assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts() );
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+    const unsigned int n_local = this->m_pdata->getN();
 
-            // calculate dv_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 vj = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-            Scalar3 dv = vi - vj;
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    const bool energy_shift = (this->m_shift_mode == this->shift);
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < this->m_pdata->getNTypes());
+    // Special Potential Pair DPD Requirements
+    const Scalar currentTemp = m_T->getValue(timestep);
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+    /* draw the random numbers of the full list entries of the particles in [begin, end)
+       The entry of the particle with the smaller tag draws and stores the number of a pair, the entry of its partner
+       is skipped. Entries without a reverse entry draw their own number.
+     */
+    auto draw_range = [&](unsigned int begin, unsigned int end)
+        {
+        const unsigned int n_lanes = hoomd::RandomGeneratorBatch::n_lanes;
+        hoomd::RandomGeneratorBatch rng_batch(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_seed);
+        hoomd::UniformDistribution<Scalar> uniform(-1,1);
+        Scalar alpha[n_lanes];
+        unsigned int lane_slot[n_lanes];
+        unsigned int n = 0;
+
+        for (unsigned int i = begin; i < end; i++)
+            {
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            unsigned int tagi = h_tag.data[i];
+            const unsigned int head_i = h_head_list.data[i];
 
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int k = 0; k < size; k++)
+                {
+                const unsigned int slot = head_i + k;
+                unsigned int j = h_nlist.data[slot];
+                unsigned int tagj = h_tag.data[j];
 
-            //calculate the drag term r \dot v
-            Scalar rdotv = dot(dx, dv);
+                // drawn by the entry of j
+                if (tagj < tagi && reverse_slot[slot] != no_slot)
+                    continue;
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = this->m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = box.minImage(pi - pj);
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            bool energy_shift = false;
-            if (this->m_shift_mode == this->shift)
-                energy_shift = true;
+                // pairs beyond the cutoff are not evaluated and draw no random number
+                if (!(dot(dx, dx) < h_rcutsq.data[this->m_typpair_idx(typei, typej)]))
+                    {
+                    pair_alpha[slot] = Scalar(0.0);
+                    continue;
+                    }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar force_divr_cons = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
+                rng_batch.setLane(n, std::min(tagi, tagj), std::max(tagi, tagj), timestep);
+                lane_slot[n] = slot;
+                n++;
 
-            // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->getValue(timestep);
+                if (n == n_lanes)
+                    {
+                    uniform.generateBatch(alpha, rng_batch);
+                    for (unsigned int l = 0; l < n; l++)
+                        pair_alpha[lane_slot[l]] = alpha[l];
+                    n = 0;
+                    }
+                }
+            }
 
-            // set seed using global tags
+        if (n > 0)
+            {
+            uniform.generateBatch(alpha, rng_batch);
+            for (unsigned int l = 0; l < n; l++)
+                pair_alpha[lane_slot[l]] = alpha[l];
+            }
+        };
+
+    /* compute the forces on particles in [begin, end)
+       Forces and virials of the particles in the range go to h_force and h_virial, those of their neighbors (third
+       law) to neigh_force and neigh_virial.
+     */
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *neigh_force, Scalar *neigh_virial,
+        unsigned int neigh_virial_pitch)
+        {
+        // the random numbers of the pairs of a particle are drawn in batches, with the streams of the evaluator
+        const unsigned int n_lanes = hoomd::RandomGeneratorBatch::n_lanes;
+        hoomd::RandomGeneratorBatch rng_batch(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_seed);
+        hoomd::UniformDistribution<Scalar> uniform(-1,1);
+        Scalar alpha[n_lanes];
+
+        // pairs within the cutoff, one per lane
+        unsigned int lane_j[n_lanes];
+        unsigned int lane_slot[n_lanes];
+        unsigned int lane_typpair[n_lanes];
+        Scalar3 lane_dx[n_lanes];
+        Scalar lane_rsq[n_lanes];
+        Scalar lane_rdotv[n_lanes];
+
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
+
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
             unsigned int tagi = h_tag.data[i];
-            unsigned int tagj = h_tag.data[j];
-            eval.set_seed_ij_timestep(m_seed,tagi,tagj,timestep);
-            eval.setDeltaT(this->m_deltaT);
-            eval.setRDotV(rdotv);
-            eval.setT(currentTemp);
+            const unsigned int head_i = h_head_list.data[i];
+
+            // sanity check
+            assert(typei < this->m_pdata->getNTypes());
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0,0,0);
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (unsigned int l = 0; l < 6; l++)
+                viriali[l] = 0.0;
+
+            // loop over all of the neighbors of this particle, n_lanes pairs within the cutoff at a time
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            unsigned int k = 0;
+            while (k < size)
+                {
+                unsigned int n = 0;
+                for (; k < size && n < n_lanes; k++)
+                    {
+                    // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                    unsigned int j = h_nlist.data[head_i + k];
+                    assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts() );
+
+                    // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                    Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                    Scalar3 dx = pi - pj;
+
+                    // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                    unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                    assert(typej < this->m_pdata->getNTypes());
+
+                    // apply periodic boundary conditions
+                    dx = box.minImage(dx);
+
+                    // calculate r_ij squared (FLOPS: 5)
+                    Scalar rsq = dot(dx, dx);
+
+                    // pairs beyond the cutoff are not evaluated and draw no random number
+                    unsigned int typpair_idx = this->m_typpair_idx(typei, typej);
+                    if (!(rsq < h_rcutsq.data[typpair_idx]))
+                        continue;
+
+                    // calculate dv_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                    Scalar3 vj = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                    Scalar3 dv = vi - vj;
+
+                    //calculate the drag term r \dot v
+                    lane_rdotv[n] = dot(dx, dv);
+                    lane_j[n] = j;
+                    lane_slot[n] = head_i + k;
+                    lane_typpair[n] = typpair_idx;
+                    lane_dx[n] = dx;
+                    lane_rsq[n] = rsq;
+
+                    // the stream of a pair is seeded with the ordered global tags, the same from either particle
+                    if (third_law)
+                        {
+                        unsigned int tagj = h_tag.data[j];
+                        rng_batch.setLane(n, std::min(tagi, tagj), std::max(tagi, tagj), timestep);
+                        }
+                    n++;
+                    }
 
-            bool evaluated = eval.evalForceEnergyThermo(force_divr, force_divr_cons, pair_eng, energy_shift);
+                if (n == 0)
+                    break;
 
-            if (evaluated)
-                {
-                // compute the virial (FLOPS: 2)
-                Scalar pair_virial[6];
-                pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
-                pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
-                pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
-                pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
-                pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
-                pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
-
-
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                for (unsigned int l = 0; l < 6; l++)
-                    viriali[l] += pair_virial[l];
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
                 if (third_law)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                    uniform.generateBatch(alpha, rng_batch);
+                    }
+                else
+                    {
+                    // read the numbers drawn by draw_range(), from the entry that drew them
+                    for (unsigned int l = 0; l < n; l++)
+                        {
+                        const unsigned int slot = lane_slot[l];
+                        const bool drawn_by_j = h_tag.data[lane_j[l]] < tagi && reverse_slot[slot] != no_slot;
+                        alpha[l] = pair_alpha[drawn_by_j ? reverse_slot[slot] : slot];
+                        }
+                    }
+
+                for (unsigned int l = 0; l < n; l++)
+                    {
+                    unsigned int j = lane_j[l];
+                    Scalar3 dx = lane_dx[l];
+
+                    // get parameters for this type pair
+                    param_type param = h_params.data[lane_typpair[l]];
+                    Scalar rcutsq = h_rcutsq.data[lane_typpair[l]];
+
+                    // compute the force and potential energy
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar force_divr_cons = Scalar(0.0);
+                    Scalar pair_eng = Scalar(0.0);
+                    evaluator eval(lane_rsq[l], rcutsq, param);
+
+                    // set seed using global tags
+                    eval.set_seed_ij_timestep(m_seed,tagi,h_tag.data[j],timestep);
+                    eval.setAlpha(alpha[l]);
+                    eval.setDeltaT(this->m_deltaT);
+                    eval.setRDotV(lane_rdotv[l]);
+                    eval.setT(currentTemp);
+
+                    bool evaluated = eval.evalForceEnergyThermo(force_divr, force_divr_cons, pair_eng, energy_shift);
+
+                    if (evaluated)
+                        {
+                        // compute the virial (FLOPS: 2)
+                        Scalar pair_virial[6];
+                        pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
+                        pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
+                        pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
+                        pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
+                        pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
+                        pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
+
+                        // add the force, potential energy and virial to the particle i
+                        // (FLOPS: 8)
+                        fi += dx*force_divr;
+                        pei += pair_eng * Scalar(0.5);
+                        if (compute_virial)
+                            {
+                            for (unsigned int v = 0; v < 6; v++)
+                                viriali[v] += pair_virial[v];
+                            }
+
+                        // add the force to particle j if we are using the third law
+                        // (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                        if (third_law)
+                            {
+                            neigh_force[j].x -= dx.x*force_divr;
+                            neigh_force[j].y -= dx.y*force_divr;
+                            neigh_force[j].z -= dx.z*force_divr;
+                            neigh_force[j].w += pair_eng * Scalar(0.5);
+                            if (compute_virial)
+                                {
+                                for (unsigned int v = 0; v < 6; v++)
+                                    neigh_virial[v * neigh_virial_pitch + j] += pair_virial[v];
+                                }
+                            }
+                        }
                     }
                 }
+
+            // finally, increment the force, potential energy and virial for particle i
+            h_force.data[i].x += fi.x;
+            h_force.data[i].y += fi.y;
+            h_force.data[i].z += fi.z;
+            h_force.data[i].w += pei;
+            if (compute_virial)
+                {
+                for (unsigned int v = 0; v < 6; v++)
+                    h_virial.data[v * this->m_virial_pitch + i] += viriali[v];
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    const unsigned int n_all = this->m_pdata->getN() + this->m_pdata->getNGhosts();
+    if (third_law)
+        {
+        // forces on j are scattered, so every thread accumulates them into its own buffer
+        for (auto& buf : m_thread_force)
+            buf.assign(n_all, make_scalar4(0,0,0,0));
+        for (auto& buf : m_thread_virial)
+            buf.assign(compute_virial ? 6*n_all : 0, Scalar(0.0));
+        }
+
+    // all numbers of a full list are drawn before any entry reads the number of its partner
+    if (!third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+            [&](const tbb::blocked_range<unsigned int>& r) { draw_range(r.begin(), r.end()); });
+        }
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        if (!third_law)
+            {
+            // only the particles in the range are written
+            compute_range(r.begin(), r.end(), h_force.data, h_virial.data, this->m_virial_pitch);
+            return;
             }
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        for (unsigned int l = 0; l < 6; l++)
-            h_virial.data[l * this->m_virial_pitch + mem_idx] += viriali[l];
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != n_all)
+            thread_force.assign(n_all, make_scalar4(0,0,0,0));
+        if (compute_virial && thread_virial.size() != 6*n_all)
+            thread_virial.assign(6*n_all, Scalar(0.0));
+
+        compute_range(r.begin(), r.end(), thread_force.data(), compute_virial ? thread_virial.data() : NULL, n_all);
+        });
+
+    // reduce the per-thread buffers
+    if (third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto& buf : m_thread_force)
+                {
+                if (buf.size() != n_all)
+                    continue;
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    h_force.data[i].x += buf[i].x;
+                    h_force.data[i].y += buf[i].y;
+                    h_force.data[i].z += buf[i].z;
+                    h_force.data[i].w += buf[i].w;
+                    }
+                }
+
+            if (compute_virial)
+                {
+                for (auto& buf : m_thread_virial)
+                    {
+                    if (buf.size() != 6*n_all)
+                        continue;
+                    for (unsigned int k = 0; k < 6; ++k)
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            h_virial.data[k*this->m_virial_pitch+i] += buf[k*n_all+i];
+                    }
+                }
+            });
         }
+    #else
+    if (!third_law)
+        draw_range(0, n_local);
+    compute_range(0, n_local, h_force.data, h_virial.data, this->m_virial_pitch);
+    #endif
 
     if (this->m_prof) this->m_prof->pop();
     }
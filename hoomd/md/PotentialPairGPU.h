@@ -78,6 +78,12 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! Returns false, the forces are only computed on the GPU
+        virtual bool supportsDirectAccumulation()
+            {
+            return false;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for block size and threads per particle
         unsigned int m_param;                       //!< Kernel tuning parameter
@@ -128,7 +134,7 @@ void PotentialPairGPU< evaluator, gpu_cgpf >::computeForces(unsigned int timeste
     this->m_nlist->compute(timestep);
 
     // start the profile
-    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_name);
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_region);
 
     // The GPU implementation CANNOT handle a half neighborlist, error out now
     bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
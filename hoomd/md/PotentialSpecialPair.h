@@ -59,7 +59,6 @@ class PotentialSpecialPair : public ForceCompute
         GPUArray<param_type> m_params;              //!< SpecialPair parameters per type
         std::shared_ptr<PairData> m_pair_data;    //!< Data to use in computing particle pairs
         std::string m_log_name;                     //!< Cached log name
-        std::string m_prof_name;                    //!< Cached profiler name
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -146,7 +145,7 @@ Scalar PotentialSpecialPair< evaluator >::getLogValue(const std::string& quantit
 template< class evaluator >
 void PotentialSpecialPair< evaluator >::computeForces(unsigned int timestep)
     {
-    if (m_prof) m_prof->push(m_prof_name);
+    if (m_prof) m_prof->push(m_prof_region);
 
     assert(m_pdata);
 
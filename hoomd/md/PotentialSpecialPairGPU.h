@@ -98,7 +98,7 @@ template< class evaluator, hipError_t gpu_cgbf(const bond_args_t& bond_args,
 void PotentialSpecialPairGPU< evaluator, gpu_cgbf >::computeForces(unsigned int timestep)
     {
     // start the profile
-    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_name);
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, this->m_prof_region);
 
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(), access_location::device, access_mode::read);
@@ -16,6 +16,11 @@
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
 
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 /*! \file PotentialTersoff.h
     \brief Defines the template class for standard three-body potentials
@@ -62,6 +67,17 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    <b>Neighbor caching and parallelization</b>
+
+    The neighbor list provided by the user may contain many neighbors that are beyond the three-body cutoff (e.g.
+    when it is shared with longer ranged pair potentials). PotentialTersoff keeps its own sub-list of neighbors
+    within the largest cutoff of each type plus the neighbor list buffer, which remains valid until the parent
+    list is rebuilt. The sub-list uses the head list of the parent. For every particle i, the displacements to all
+    of its neighbors are computed once and reused in all ij and ijk loops.
+
+    With TBB, the loop over particles i is parallelized. The forces on neighbors j and k are accumulated into
+    per-thread buffers that are summed at the end of the computation.
+
     For profiling and logging, PotentialTersoff needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -105,12 +121,33 @@ class PotentialTersoff : public ForceCompute
         GPUArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
         GPUArray<Scalar> m_ronsq;                   //!< ron squared per type pair
         GPUArray<param_type> m_params;   //!< Pair parameters per type pair
-        std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        GPUArray<unsigned int> m_n_neigh_short;     //!< Number of neighbors in the short-ranged sub-list
+        GPUArray<unsigned int> m_nlist_short;       //!< Short-ranged sub-list, indexed by the parent head list
+        uint64_t m_nlist_builds;                    //!< Number of parent neighbor list builds at the last build
+        bool m_short_nlist_stale;                   //!< True if the sub-list must be rebuilt
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+        tbb::enumerable_thread_specific< std::vector<Scalar> > m_thread_virial; //!< Per-thread virial buffers
+        #endif
+
+        //! Cached displacement to a neighbor
+        struct TripletNeighbor
+            {
+            Scalar3 dx;         //!< Minimum image displacement r_i - r_j
+            Scalar rsq;         //!< Squared distance
+            unsigned int idx;   //!< Index of the neighbor
+            unsigned int type;  //!< Type of the neighbor
+            };
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Rebuild the short-ranged sub-list when the parent neighbor list has changed
+        void updateShortNlist();
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -129,6 +166,8 @@ class PotentialTersoff : public ForceCompute
             m_ronsq.swap(ronsq);
             GPUArray<param_type> params(m_typpair_idx.getNumElements(), m_exec_conf);
             m_params.swap(params);
+
+            m_short_nlist_stale = true;
             }
     };
 
@@ -140,7 +179,8 @@ template < class evaluator >
 PotentialTersoff< evaluator >::PotentialTersoff(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_typpair_idx(m_pdata->getNTypes()), m_nlist_builds(0),
+      m_short_nlist_stale(true)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing PotentialTersoff" << std::endl;
 
@@ -209,6 +249,8 @@ void PotentialTersoff< evaluator >::setRcut(unsigned int typ1, unsigned int typ2
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
     h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
     h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+
+    m_short_nlist_stale = true;
     }
 
 /*! \param typ1 First type index in the pair
@@ -263,6 +305,87 @@ Scalar PotentialTersoff< evaluator >::getLogValue(const std::string& quantity, u
         }
     }
 
+/*! The sub-list keeps those neighbors of the parent list that are within the largest cutoff of the type of particle
+    i plus the neighbor list buffer. Pairs further apart cannot come within the cutoff before the parent
+    list is rebuilt.
+*/
+template< class evaluator >
+void PotentialTersoff< evaluator >::updateShortNlist()
+    {
+    // the build count of the parent list is never reset, unlike its update statistics
+    uint64_t n_builds = m_nlist->getNumBuilds();
+    if (!m_short_nlist_stale && n_builds == m_nlist_builds
+        && m_nlist_short.getNumElements() == m_nlist->getNListArray().getNumElements()
+        && m_n_neigh_short.getNumElements() >= m_pdata->getN())
+        return;
+
+    m_nlist_builds = n_builds;
+    m_short_nlist_stale = false;
+
+    if (m_nlist_short.getNumElements() != m_nlist->getNListArray().getNumElements())
+        {
+        GPUArray<unsigned int> nlist_short(m_nlist->getNListArray().getNumElements(), m_exec_conf);
+        m_nlist_short.swap(nlist_short);
+        }
+    if (m_n_neigh_short.getNumElements() < m_pdata->getN())
+        {
+        GPUArray<unsigned int> n_neigh_short(m_pdata->getN(), m_exec_conf);
+        m_n_neigh_short.swap(n_neigh_short);
+        }
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+
+    ArrayHandle<unsigned int> h_n_neigh_short(m_n_neigh_short, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_nlist_short(m_nlist_short, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ntypes = m_pdata->getNTypes();
+    Scalar r_buff = m_nlist->getRBuff();
+
+    // largest cutoff plus buffer per type of particle i
+    std::vector<Scalar> rlistsq(ntypes, Scalar(0.0));
+    for (unsigned int typ_a = 0; typ_a < ntypes; ++typ_a)
+        {
+        Scalar rcut_max(0.0);
+        for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+            rcut_max = std::max(rcut_max, fast::sqrt(h_rcutsq.data[m_typpair_idx(typ_a, typ_b)]));
+        rlistsq[typ_a] = (rcut_max + r_buff)*(rcut_max + r_buff);
+        }
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+    #endif
+        {
+        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int head_i = h_head_list.data[i];
+
+        unsigned int n_short = 0;
+        for (unsigned int j = 0; j < h_n_neigh.data[i]; ++j)
+            {
+            unsigned int jj = h_nlist.data[head_i + j];
+            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+            Scalar3 dx = box.minImage(posi - posj);
+
+            if (dot(dx, dx) < rlistsq[typei])
+                h_nlist_short.data[head_i + n_short++] = jj;
+            }
+        h_n_neigh_short.data[i] = n_short;
+        }
+    #ifdef ENABLE_TBB
+        });
+    #endif
+    }
+
 /*! \post The forces are computed for the given timestep. The neighborlist's compute method is called to ensure
     that it is up to date before proceeding.
 
@@ -275,7 +398,7 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     m_nlist->compute(timestep);
 
     // start the profile for this compute
-    if (m_prof) m_prof->push(m_prof_name);
+    if (m_prof) m_prof->push(m_prof_region);
 
     // The three-body potentials can't handle a half neighbor list, so check now.
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -306,366 +429,394 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-    // need to start from a zero force, energy
-    memset(h_force.data, 0, sizeof(Scalar4)*(m_pdata->getN()+m_pdata->getNGhosts()));
-    memset(h_virial.data, 0, sizeof(Scalar)*6*m_virial_pitch);
+    // rebuild the short-ranged neighbor list if the parent list has changed
+    updateShortNlist();
+    ArrayHandle<unsigned int> h_n_neigh_short(m_n_neigh_short, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist_short(m_nlist_short, access_location::host, access_mode::read);
 
+    const unsigned int n_local = m_pdata->getN();
+    const unsigned int n_all = m_pdata->getN()+m_pdata->getNGhosts();
     unsigned int ntypes = m_pdata->getNTypes();
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current force and potential energy of particle i to 0
-        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-        Scalar pei = 0.0;
+    // need to start from a zero force, energy
+    memset(h_force.data, 0, sizeof(Scalar4)*n_all);
+    memset(h_virial.data, 0, sizeof(Scalar)*6*m_virial_pitch);
 
-        Scalar viriali_xx(0.0);
-        Scalar viriali_xy(0.0);
-        Scalar viriali_xz(0.0);
-        Scalar viriali_yy(0.0);
-        Scalar viriali_yz(0.0);
-        Scalar viriali_zz(0.0);
+    /* compute the forces on particles in [begin, end), accumulating into the given force and virial arrays
+       The displacements to all neighbors of i are computed once and reused for every ij pair and ijk triplet.
+     */
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *force, Scalar *virial,
+        unsigned int virial_pitch)
+        {
+        // cached neighbor data of particle i
+        std::vector<TripletNeighbor> neigh;
 
         Scalar phi_ab[ntypes];
 
-        // reset phi
-        for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+        for (unsigned int i = begin; i < end; i++)
             {
-            phi_ab[typ_b] = Scalar(0.0);
-            }
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
+
+            // initialize current force and potential energy of particle i to 0
+            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pei = 0.0;
+
+            Scalar viriali_xx(0.0);
+            Scalar viriali_xy(0.0);
+            Scalar viriali_xz(0.0);
+            Scalar viriali_yy(0.0);
+            Scalar viriali_yz(0.0);
+            Scalar viriali_zz(0.0);
+
+            // reset phi
+            for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                {
+                phi_ab[typ_b] = Scalar(0.0);
+                }
 
-        // all neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        if (evaluator::hasPerParticleEnergy())
-            {
+            // compute the displacements to all neighbors once
+            const unsigned int size = h_n_neigh_short.data[i];
+            neigh.resize(size);
             for (unsigned int j = 0; j < size; j++)
                 {
                 // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+                unsigned int jj = h_nlist_short.data[head_i + j];
+                assert(jj < n_all);
 
                 // access the position and type of particle j
                 Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
                 unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                 assert(typej < m_pdata->getNTypes());
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                // calculate dr_ij and apply periodic boundary conditions (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 dxij = box.minImage(posi - posj);
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // evaluate the scalar per-neighbor contribution
-                evaluator eval(rij_sq, rcutsq, param);
-                eval.evalPhi(phi_ab[typej]);
+                neigh[j].dx = dxij;
+                neigh[j].rsq = dot(dxij, dxij);
+                neigh[j].idx = jj;
+                neigh[j].type = typej;
                 }
 
-            // self-energy
-            for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+            if (evaluator::hasPerParticleEnergy())
                 {
-                unsigned int typpair_idx = m_typpair_idx(typei,typ_b);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-                evaluator eval(Scalar(0.0), rcutsq, param);
-                Scalar energy(0.0);
-                eval.evalSelfEnergy(energy, phi_ab[typ_b]);
-                pei += energy;
-                }
-            }
-
-        // loop over all of the neighbors of this particle
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-            unsigned int jj = h_nlist.data[head_i + j];
-            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // access the position and type of particle j
-            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-            unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // initialize the current force and potential energy of particle j to 0
-            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pej = 0.0;
+                for (unsigned int j = 0; j < size; j++)
+                    {
+                    // get parameters for this type pair
+                    unsigned int typpair_idx = m_typpair_idx(typei, neigh[j].type);
+                    param_type param = h_params.data[typpair_idx];
+                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                    // evaluate the scalar per-neighbor contribution
+                    evaluator eval(neigh[j].rsq, rcutsq, param);
+                    eval.evalPhi(phi_ab[neigh[j].type]);
+                    }
 
-            // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 dxij = posi - posj;
+                // self-energy
+                for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                    {
+                    unsigned int typpair_idx = m_typpair_idx(typei,typ_b);
+                    param_type param = h_params.data[typpair_idx];
+                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                    evaluator eval(Scalar(0.0), rcutsq, param);
+                    Scalar energy(0.0);
+                    eval.evalSelfEnergy(energy, phi_ab[typ_b]);
+                    pei += energy;
+                    }
+                }
 
-            // apply periodic boundary conditions
-            dxij = box.minImage(dxij);
+            // loop over all of the neighbors of this particle
+            for (unsigned int j = 0; j < size; j++)
+                {
+                unsigned int jj = neigh[j].idx;
+                unsigned int typej = neigh[j].type;
+                Scalar3 dxij = neigh[j].dx;
+                Scalar rij_sq = neigh[j].rsq;
 
-            // compute rij_sq (FLOPS: 5)
-            Scalar rij_sq = dot(dxij, dxij);
+                // initialize the current force and potential energy of particle j to 0
+                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+                Scalar pej = 0.0;
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = h_params.data[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
 
-            // evaluate the base repulsive and attractive terms
-            Scalar fR = 0.0;
-            Scalar fA = 0.0;
-            evaluator eval(rij_sq, rcutsq, param);
-            bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+                // evaluate the base repulsive and attractive terms
+                Scalar fR = 0.0;
+                Scalar fA = 0.0;
+                evaluator eval(rij_sq, rcutsq, param);
+                bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
 
-            Scalar virialj_xx(0.0);
-            Scalar virialj_xy(0.0);
-            Scalar virialj_xz(0.0);
-            Scalar virialj_yy(0.0);
-            Scalar virialj_yz(0.0);
-            Scalar virialj_zz(0.0);
+                Scalar virialj_xx(0.0);
+                Scalar virialj_xy(0.0);
+                Scalar virialj_xz(0.0);
+                Scalar virialj_yy(0.0);
+                Scalar virialj_yz(0.0);
+                Scalar virialj_zz(0.0);
 
-            if (evaluated)
-                {
-                // evaluate chi
-                Scalar chi = 0.0;
-                if (evaluator::needsChi())
+                if (evaluated)
                     {
-                    for (unsigned int k = 0; k < size; k++)
+                    // evaluate chi
+                    Scalar chi = 0.0;
+                    if (evaluator::needsChi())
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
-
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param = h_params.data[typpair_idx];
-
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        bool temp_evaluated = temp_eval.areInteractive();
-
-                        if (kk != jj && temp_evaluated)
+                        for (unsigned int k = 0; k < size; k++)
                             {
-                            // compute drik
-                            Scalar3 dxik = posi - posk;
+                            if (k == j)
+                                continue;
 
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            // access the type pair parameters for i and k
+                            param_type temp_param = h_params.data[m_typpair_idx(typei, neigh[k].type)];
 
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                            if (temp_eval.areInteractive())
+                                {
+                                Scalar rik_sq = neigh[k].rsq;
 
-                            // compute the bond angle (if needed)
-                            Scalar cos_th = Scalar(0.0);
-                            if (evaluator::needsAngle())
-                                cos_th = dot(dxij, dxik) / fast::sqrt(rij_sq * rik_sq);
+                                // compute the bond angle (if needed)
+                                Scalar cos_th = Scalar(0.0);
+                                if (evaluator::needsAngle())
+                                    cos_th = dot(dxij, neigh[k].dx) / fast::sqrt(rij_sq * rik_sq);
 
-                            // evaluate the partial chi term
-                            eval.setRik(rik_sq);
-                            if (evaluator::needsAngle())
-                                eval.setAngle(cos_th);
+                                // evaluate the partial chi term
+                                eval.setRik(rik_sq);
+                                if (evaluator::needsAngle())
+                                    eval.setAngle(cos_th);
 
-                            eval.evalChi(chi);
+                                eval.evalChi(chi);
+                                }
                             }
                         }
-                    }
 
-                // evaluate the force and energy from the ij interaction
-                Scalar force_divr = Scalar(0.0);
-                Scalar potential_eng = Scalar(0.0);
-                Scalar bij = Scalar(0.0);
-                eval.evalForceij(fR, fA, chi, phi_ab[typej], bij, force_divr, potential_eng);
+                    // evaluate the force and energy from the ij interaction
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar potential_eng = Scalar(0.0);
+                    Scalar bij = Scalar(0.0);
+                    eval.evalForceij(fR, fA, chi, phi_ab[typej], bij, force_divr, potential_eng);
 
-                // add this force to particle i
-                fi += force_divr * dxij;
-                pei += potential_eng * Scalar(0.5);
+                    // add this force to particle i
+                    fi += force_divr * dxij;
+                    pei += potential_eng * Scalar(0.5);
 
-                if (compute_virial)
-                    {
-                    Scalar force_div2r = Scalar(0.5)*force_divr;
-
-                    viriali_xx += force_div2r*dxij.x*dxij.x;
-                    viriali_xy += force_div2r*dxij.x*dxij.y;
-                    viriali_xz += force_div2r*dxij.x*dxij.z;
-                    viriali_yy += force_div2r*dxij.y*dxij.y;
-                    viriali_yz += force_div2r*dxij.y*dxij.z;
-                    viriali_zz += force_div2r*dxij.z*dxij.z;
-                    }
-
-                // add this force to particle j
-                fj += Scalar(-1.0) * force_divr * dxij;
-                pej += potential_eng * Scalar(0.5);
-
-                if (compute_virial)
-                    {
-                    Scalar force_div2r = Scalar(0.5)*force_divr;
-
-                    virialj_xx += force_div2r*dxij.x*dxij.x;
-                    virialj_xy += force_div2r*dxij.x*dxij.y;
-                    virialj_xz += force_div2r*dxij.x*dxij.z;
-                    virialj_yy += force_div2r*dxij.y*dxij.y;
-                    virialj_yz += force_div2r*dxij.y*dxij.z;
-                    virialj_zz += force_div2r*dxij.z*dxij.z;
-                    }
-
-                if (evaluator::hasIkForce())
-                    {
-                    // evaluate the force from the ik interactions
-                    for (unsigned int k = 0; k < size; k++)
+                    if (compute_virial)
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
+                        Scalar force_div2r = Scalar(0.5)*force_divr;
+
+                        viriali_xx += force_div2r*dxij.x*dxij.x;
+                        viriali_xy += force_div2r*dxij.x*dxij.y;
+                        viriali_xz += force_div2r*dxij.x*dxij.z;
+                        viriali_yy += force_div2r*dxij.y*dxij.y;
+                        viriali_yz += force_div2r*dxij.y*dxij.z;
+                        viriali_zz += force_div2r*dxij.z*dxij.z;
+                        }
 
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param = h_params.data[typpair_idx];
+                    // add this force to particle j
+                    fj += Scalar(-1.0) * force_divr * dxij;
+                    pej += potential_eng * Scalar(0.5);
 
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        bool temp_evaluated = temp_eval.areInteractive();
+                    if (compute_virial)
+                        {
+                        Scalar force_div2r = Scalar(0.5)*force_divr;
+
+                        virialj_xx += force_div2r*dxij.x*dxij.x;
+                        virialj_xy += force_div2r*dxij.x*dxij.y;
+                        virialj_xz += force_div2r*dxij.x*dxij.z;
+                        virialj_yy += force_div2r*dxij.y*dxij.y;
+                        virialj_yz += force_div2r*dxij.y*dxij.z;
+                        virialj_zz += force_div2r*dxij.z*dxij.z;
+                        }
 
-                        if (kk != jj && temp_evaluated)
+                    if (evaluator::hasIkForce())
+                        {
+                        // evaluate the force from the ik interactions
+                        for (unsigned int k = 0; k < size; k++)
                             {
-                            // create variable for the force on k
-                            Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-
-                            // compute dr_ik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
+                            if (k == j)
+                                continue;
 
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            unsigned int kk = neigh[k].idx;
 
-                            // compute the bond angle (if needed)
-                            Scalar cos_th = Scalar(0.0);
-                            if (evaluator::needsAngle())
-                                cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
+                            // access the type pair parameters for i and k
+                            param_type temp_param = h_params.data[m_typpair_idx(typei, neigh[k].type)];
 
-                            // set up the evaluator
-                            eval.setRik(rik_sq);
-                            if (evaluator::needsAngle())
-                                eval.setAngle(cos_th);
-
-                            // compute the total force and energy
-                            Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
-                            eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
-
-                            // add the force to particle i
-                            // (FLOPS: 17)
-                            fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
-                            fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
-                            fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
-
-                            // NOTE: virial for ik forces not tested
-                            if (compute_virial)
+                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                            if (temp_eval.areInteractive())
                                 {
-                                Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.x;
-                                Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.x;
-                                viriali_xx += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                viriali_xy += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                viriali_xz += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                viriali_yy += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                viriali_yz += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                viriali_zz += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
-                                }
-
-                            // add the force to particle j (FLOPS: 17)
-                            fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
-                            fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
-                            fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
-
-                            // NOTE: virial for ik forces not tested
-                            if (compute_virial)
-                                {
-                                Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.y;
-                                Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.y;
-                                virialj_xx += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                virialj_xy += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                virialj_xz += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                virialj_yy += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                virialj_yz += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                virialj_zz += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
-                                }
-
-                            // add the force to particle k
-                            fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
-                            fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
-                            fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
-
-                            // increment the force for particle k
-                            unsigned int mem_idx = kk;
-                            h_force.data[mem_idx].x += fk.x;
-                            h_force.data[mem_idx].y += fk.y;
-                            h_force.data[mem_idx].z += fk.z;
-
-                            if (compute_virial)
-                                {
-                                Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
-                                Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
-                                h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                // create variable for the force on k
+                                Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
+
+                                Scalar3 dxik = neigh[k].dx;
+                                Scalar rik_sq = neigh[k].rsq;
+
+                                // compute the bond angle (if needed)
+                                Scalar cos_th = Scalar(0.0);
+                                if (evaluator::needsAngle())
+                                    cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
+
+                                // set up the evaluator
+                                eval.setRik(rik_sq);
+                                if (evaluator::needsAngle())
+                                    eval.setAngle(cos_th);
+
+                                // compute the total force and energy
+                                Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
+                                Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
+                                eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
+
+                                // add the force to particle i
+                                // (FLOPS: 17)
+                                fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
+                                fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
+                                fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
+
+                                // NOTE: virial for ik forces not tested
+                                if (compute_virial)
+                                    {
+                                    Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.x;
+                                    Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.x;
+                                    viriali_xx += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                    viriali_xy += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                    viriali_xz += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                    viriali_yy += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                    viriali_yz += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                    viriali_zz += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                    }
+
+                                // add the force to particle j (FLOPS: 17)
+                                fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
+                                fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
+                                fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
+
+                                // NOTE: virial for ik forces not tested
+                                if (compute_virial)
+                                    {
+                                    Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.y;
+                                    Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.y;
+                                    virialj_xx += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                    virialj_xy += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                    virialj_xz += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                    virialj_yy += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                    virialj_yz += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                    virialj_zz += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                    }
+
+                                // add the force to particle k
+                                fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
+                                fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
+                                fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
+
+                                // increment the force for particle k
+                                force[kk].x += fk.x;
+                                force[kk].y += fk.y;
+                                force[kk].z += fk.z;
+
+                                if (compute_virial)
+                                    {
+                                    Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
+                                    Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
+                                    virial[0*virial_pitch+kk] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                    virial[1*virial_pitch+kk] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                    virial[2*virial_pitch+kk] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                    virial[3*virial_pitch+kk] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                    virial[4*virial_pitch+kk] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                    virial[5*virial_pitch+kk] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                    }
                                 }
                             }
                         }
                     }
+                // increment the force and potential energy for particle j
+                force[jj].x += fj.x;
+                force[jj].y += fj.y;
+                force[jj].z += fj.z;
+                force[jj].w += pej;
+
+                if (compute_virial)
+                    {
+                    virial[0*virial_pitch+jj] += virialj_xx;
+                    virial[1*virial_pitch+jj] += virialj_xy;
+                    virial[2*virial_pitch+jj] += virialj_xz;
+                    virial[3*virial_pitch+jj] += virialj_yy;
+                    virial[4*virial_pitch+jj] += virialj_yz;
+                    virial[5*virial_pitch+jj] += virialj_zz;
+                    }
                 }
-            // increment the force and potential energy for particle j
-            unsigned int mem_idx = jj;
-            h_force.data[mem_idx].x += fj.x;
-            h_force.data[mem_idx].y += fj.y;
-            h_force.data[mem_idx].z += fj.z;
-            h_force.data[mem_idx].w += pej;
+            // finally, increment the force and potential energy for particle i
+            force[i].x += fi.x;
+            force[i].y += fi.y;
+            force[i].z += fi.z;
+            force[i].w += pei;
 
             if (compute_virial)
                 {
-                h_virial.data[0*m_virial_pitch+mem_idx] += virialj_xx;
-                h_virial.data[1*m_virial_pitch+mem_idx] += virialj_xy;
-                h_virial.data[2*m_virial_pitch+mem_idx] += virialj_xz;
-                h_virial.data[3*m_virial_pitch+mem_idx] += virialj_yy;
-                h_virial.data[4*m_virial_pitch+mem_idx] += virialj_yz;
-                h_virial.data[5*m_virial_pitch+mem_idx] += virialj_zz;
+                virial[0*virial_pitch+i] += viriali_xx;
+                virial[1*virial_pitch+i] += viriali_xy;
+                virial[2*virial_pitch+i] += viriali_xz;
+                virial[3*virial_pitch+i] += viriali_yy;
+                virial[4*virial_pitch+i] += viriali_yz;
+                virial[5*virial_pitch+i] += viriali_zz;
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    // forces on j and k are scattered, so every thread accumulates into its own buffer
+    for (auto& buf : m_thread_force)
+        buf.assign(n_all, make_scalar4(0,0,0,0));
+    for (auto& buf : m_thread_virial)
+        buf.assign(compute_virial ? 6*n_all : 0, Scalar(0.0));
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        std::vector<Scalar4>& thread_force = m_thread_force.local();
+        std::vector<Scalar>& thread_virial = m_thread_virial.local();
+        if (thread_force.size() != n_all)
+            thread_force.assign(n_all, make_scalar4(0,0,0,0));
+        if (compute_virial && thread_virial.size() != 6*n_all)
+            thread_virial.assign(6*n_all, Scalar(0.0));
+
+        compute_range(r.begin(), r.end(), &thread_force.front(),
+            compute_virial ? &thread_virial.front() : NULL, n_all);
+        });
+
+    // reduce the per-thread buffers
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_all),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (auto& buf : m_thread_force)
+            {
+            if (buf.size() != n_all)
+                continue;
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                h_force.data[i].x += buf[i].x;
+                h_force.data[i].y += buf[i].y;
+                h_force.data[i].z += buf[i].z;
+                h_force.data[i].w += buf[i].w;
                 }
             }
-        // finally, increment the force and potential energy for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
 
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += viriali_xx;
-            h_virial.data[1*m_virial_pitch+mem_idx] += viriali_xy;
-            h_virial.data[2*m_virial_pitch+mem_idx] += viriali_xz;
-            h_virial.data[3*m_virial_pitch+mem_idx] += viriali_yy;
-            h_virial.data[4*m_virial_pitch+mem_idx] += viriali_yz;
-            h_virial.data[5*m_virial_pitch+mem_idx] += viriali_zz;
+            for (auto& buf : m_thread_virial)
+                {
+                if (buf.size() != 6*n_all)
+                    continue;
+                for (unsigned int k = 0; k < 6; ++k)
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        h_virial.data[k*m_virial_pitch+i] += buf[k*n_all+i];
+                }
             }
-        }
+        });
+    #else
+    compute_range(0, n_local, h_force.data, h_virial.data, m_virial_pitch);
+    #endif
 
     if (m_prof) m_prof->pop();
     }
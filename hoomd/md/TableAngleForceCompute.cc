@@ -29,7 +29,8 @@ using namespace std;
 TableAngleForceCompute::TableAngleForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width),
+          m_interp(m_exec_conf, table_width, sysdef->getAngleData()->getNTypes())
     {
     m_exec_conf->msg->notice(5) << "Constructing TableAngleForceCompute" << endl;
 
@@ -107,6 +108,8 @@ void TableAngleForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    m_interp.tableChanged(type, Scalar(M_PI)/Scalar(m_table_width - 1));
     }
 
 /*! TableAngleForceCompute provides
@@ -167,6 +170,12 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
+    // refresh the spline coefficients of any modified tables
+    const bool cubic = m_interp.isCubic();
+    m_interp.update(h_tables.data, m_table_value);
+    ArrayHandle<Scalar4> h_coeff(m_interp.getCoefficients(), access_location::host, access_mode::read);
+    const Index2D& coeff_value = m_interp.getIndexer();
+
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -248,20 +257,25 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
         /// Here we use the table!!
         unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         unsigned int value_i = floor(value_f);
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
+
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (cubic)
+            {
+            Scalar4 c = h_coeff.data[coeff_value(value_i, angle_type)];
+            TableInterpolation::evaluate(c, f, Scalar(1.0) / delta_th, V, T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
+
+            // interpolate linearly to get V and T
+            V = VT0.x + f * (VT1.x - VT0.x);
+            T = VT0.y + f * (VT1.y - VT0.y);
+            }
 
         Scalar a =  T*s_abbc;
         Scalar a11 = a*c_abbc/rsqab;
@@ -333,5 +347,6 @@ void export_TableAngleForceCompute(py::module& m)
     py::class_<TableAngleForceCompute, ForceCompute, std::shared_ptr<TableAngleForceCompute> >(m, "TableAngleForceCompute")
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableAngleForceCompute::setTable)
+    .def("setCubicInterpolation", &TableAngleForceCompute::setCubicInterpolation)
     ;
     }
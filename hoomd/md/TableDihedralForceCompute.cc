@@ -30,7 +30,8 @@ using namespace std;
 TableDihedralForceCompute::TableDihedralForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width),
+          m_interp(m_exec_conf, table_width, sysdef->getDihedralData()->getNTypes())
     {
     m_exec_conf->msg->notice(5) << "Constructing TableDihedralForceCompute" << endl;
 
@@ -96,6 +97,8 @@ void TableDihedralForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    m_interp.tableChanged(type, Scalar(2.0*M_PI)/Scalar(m_table_width - 1));
     }
 
 /*! TableDihedralForceCompute provides
@@ -156,6 +159,12 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
+    // refresh the spline coefficients of any modified tables
+    const bool cubic = m_interp.isCubic();
+    m_interp.update(h_tables.data, m_table_value);
+    ArrayHandle<Scalar4> h_coeff(m_interp.getCoefficients(), access_location::host, access_mode::read);
+    const Index2D& coeff_value = m_interp.getIndexer();
+
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -278,20 +287,25 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         /// Here we use the table!!
         unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         unsigned int value_i = value_f;
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
+
+        // compute the interpolation coefficient
         Scalar f = value_f - Scalar(value_i);
 
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (cubic)
+            {
+            Scalar4 c = h_coeff.data[coeff_value(value_i, dihedral_type)];
+            TableInterpolation::evaluate(c, f, Scalar(1.0) / delta_phi, V, T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
+
+            // interpolate linearly to get V and T
+            V = VT0.x + f * (VT1.x - VT0.x);
+            T = VT0.y + f * (VT1.y - VT0.y);
+            }
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab),vec3<Scalar>(dcbm));
@@ -358,6 +372,7 @@ void export_TableDihedralForceCompute(py::module& m)
     py::class_<TableDihedralForceCompute, ForceCompute, std::shared_ptr<TableDihedralForceCompute> >(m, "TableDihedralForceCompute")
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableDihedralForceCompute::setTable)
+    .def("setCubicInterpolation", &TableDihedralForceCompute::setCubicInterpolation)
     .def("getEntry", &TableDihedralForceCompute::getEntry)
     ;
     }
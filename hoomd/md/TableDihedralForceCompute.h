@@ -8,6 +8,7 @@
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GPUArray.h"
+#include "TableInterpolation.h"
 
 #include <memory>
 
@@ -49,6 +50,10 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When cubic interpolation is enabled with setCubicInterpolation(), the CPU code path evaluates a cubic Hermite spline
+    through the tabulated values and derivatives instead. See TableInterpolation for details. The GPU code path always
+    interpolates linearly.
     \ingroup computes
 */
 class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
@@ -67,6 +72,12 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
                               const std::vector<Scalar> &V,
                               const std::vector<Scalar> &T);
 
+        //! Enable or disable cubic Hermite interpolation
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            m_interp.setCubic(cubic);
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -104,6 +115,7 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
         unsigned int m_table_width;                 //!< Width of the tables in memory
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         Index2D m_table_value;                      //!< Index table helper
+        TableInterpolation m_interp;                //!< Higher order interpolation of the tables
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
@@ -0,0 +1,98 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#include "TableInterpolation.h"
+
+/*! \file TableInterpolation.cc
+    \brief Defines the TableInterpolation class
+*/
+
+using namespace std;
+
+/*! \param exec_conf Execution configuration used for allocations
+    \param table_width Number of grid points in each table
+    \param n_tables Number of tables
+*/
+TableInterpolation::TableInterpolation(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                       unsigned int table_width,
+                                       unsigned int n_tables)
+    : m_exec_conf(exec_conf), m_table_width(table_width), m_n_tables(0), m_cubic(false)
+    {
+    setNumTables(n_tables);
+    }
+
+/*! \param n_tables New number of tables
+    \post All coefficients are released and marked for a rebuild
+*/
+void TableInterpolation::setNumTables(unsigned int n_tables)
+    {
+    m_n_tables = n_tables;
+    m_dx.assign(n_tables, Scalar(0.0));
+    m_dirty.assign(n_tables, true);
+
+    // coefficients are reallocated on the next update()
+    GPUArray<Scalar4> coeff;
+    m_coeff.swap(coeff);
+    m_coeff_value = Index2D(m_table_width, m_n_tables);
+    }
+
+/*! \param table Index of the table that changed
+    \param dx Grid spacing of the table
+*/
+void TableInterpolation::tableChanged(unsigned int table, Scalar dx)
+    {
+    assert(table < m_n_tables);
+    m_dx[table] = dx;
+    m_dirty[table] = true;
+    }
+
+/*! \param tables Interleaved (V, -dV/dx) values of all tables
+    \param table_value Indexer into \a tables
+
+    Only tables flagged by tableChanged() are rebuilt. Nothing is done unless cubic interpolation is enabled.
+*/
+void TableInterpolation::update(const Scalar2 *tables, const Index2D& table_value)
+    {
+    if (!m_cubic)
+        return;
+
+    if (m_coeff.isNull())
+        {
+        GPUArray<Scalar4> coeff(m_coeff_value.getNumElements(), m_exec_conf);
+        m_coeff.swap(coeff);
+        m_dirty.assign(m_n_tables, true);
+        }
+
+    ArrayHandle<Scalar4> h_coeff(m_coeff, access_location::host, access_mode::readwrite);
+
+    for (unsigned int t = 0; t < m_n_tables; t++)
+        {
+        if (!m_dirty[t])
+            continue;
+
+        Scalar dx = m_dx[t];
+        for (unsigned int i = 0; i + 1 < m_table_width; i++)
+            {
+            Scalar2 VF0 = tables[table_value(i, t)];
+            Scalar2 VF1 = tables[table_value(i+1, t)];
+
+            // slopes in units of the interval (F stores -dV/dx)
+            Scalar m0 = -VF0.y * dx;
+            Scalar m1 = -VF1.y * dx;
+
+            Scalar4 c;
+            c.x = VF0.x;
+            c.y = m0;
+            c.z = Scalar(3.0)*(VF1.x - VF0.x) - Scalar(2.0)*m0 - m1;
+            c.w = Scalar(2.0)*(VF0.x - VF1.x) + m0 + m1;
+            h_coeff.data[m_coeff_value(i, t)] = c;
+            }
+
+        // extrapolate linearly from the last grid point
+        Scalar2 VF_last = tables[table_value(m_table_width-1, t)];
+        h_coeff.data[m_coeff_value(m_table_width-1, t)] = make_scalar4(VF_last.x, -VF_last.y * dx, 0, 0);
+
+        m_dirty[t] = false;
+        }
+    }
@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file TableInterpolation.h
+    \brief Declares the TableInterpolation class shared by the tabulated force computes
+*/
+
+#ifndef __TABLE_INTERPOLATION_H__
+#define __TABLE_INTERPOLATION_H__
+
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Interpolation engine shared by the tabulated force computes
+/*! TablePotential, BondTablePotential, TableAngleForceCompute and TableDihedralForceCompute all store V(x) and
+    F(x) = -dV/dx on an evenly spaced grid as interleaved Scalar2 values. By default they interpolate both linearly,
+    which is only first order accurate and requires very wide tables for smooth forces.
+
+    TableInterpolation optionally replaces the linear scheme with piecewise cubic Hermite interpolation. Since F is
+    tabulated alongside V, the Hermite spline through (V_i, -F_i) and (V_i+1, -F_i+1) is fully determined by the
+    table itself and reproduces both the value and the slope at every grid point. The error drops from O(dx^2) to
+    O(dx^4), so a table with a fraction of the points reaches the same accuracy.
+
+    \b Memory layout
+
+    The spline is stored as one packed Scalar4 (c0, c1, c2, c3) per interval, so each lookup is a single contiguous
+    load and the polynomial is evaluated with Horner's scheme:
+
+    V(f) = c0 + f*(c1 + f*(c2 + f*c3)) and F(f) = -(c1 + f*(2*c2 + 3*f*c3)) / dx
+
+    where f in [0,1) is the fractional position inside the interval. The coefficients of table \a t, interval \a i are
+    located at getIndexer()(i, t). The last entry of each row extrapolates linearly from the final grid point so that
+    lookups exactly at the upper table boundary remain valid.
+
+    The owning compute keeps its Scalar2 table as the source of truth (it is still used by the GPU kernels and the
+    linear scheme) and notifies the engine with tableChanged() whenever a row is modified. Coefficients are allocated
+    and rebuilt lazily in update(), so the linear default carries no memory overhead.
+*/
+class TableInterpolation
+    {
+    public:
+        //! Constructs the engine
+        TableInterpolation(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                           unsigned int table_width,
+                           unsigned int n_tables);
+
+        //! Change the number of tables
+        void setNumTables(unsigned int n_tables);
+
+        //! Enable or disable cubic Hermite interpolation
+        void setCubic(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
+        //! Test whether cubic Hermite interpolation is enabled
+        bool isCubic() const
+            {
+            return m_cubic;
+            }
+
+        //! Notify the engine that a table row has new values
+        void tableChanged(unsigned int table, Scalar dx);
+
+        //! Rebuild the coefficients of all changed tables
+        void update(const Scalar2 *tables, const Index2D& table_value);
+
+        //! Get the packed spline coefficients
+        const GPUArray<Scalar4>& getCoefficients() const
+            {
+            return m_coeff;
+            }
+
+        //! Get the indexer into the coefficient array
+        const Index2D& getIndexer() const
+            {
+            return m_coeff_value;
+            }
+
+        //! Evaluate the cubic Hermite spline inside one interval
+        /*! \param c Packed coefficients of the interval
+            \param f Fractional position inside the interval
+            \param inv_dx Inverse grid spacing
+            \param V Output interpolated value
+            \param F Output interpolated -dV/dx
+        */
+        DEVICE static inline void evaluate(const Scalar4& c, Scalar f, Scalar inv_dx, Scalar& V, Scalar& F)
+            {
+            V = c.x + f*(c.y + f*(c.z + f*c.w));
+            F = -(c.y + f*(Scalar(2.0)*c.z + Scalar(3.0)*f*c.w)) * inv_dx;
+            }
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration for allocations
+        unsigned int m_table_width;         //!< Number of grid points per table
+        unsigned int m_n_tables;            //!< Number of tables
+        bool m_cubic;                       //!< True if cubic Hermite interpolation is enabled
+        GPUArray<Scalar4> m_coeff;          //!< Packed spline coefficients, one Scalar4 per interval
+        Index2D m_coeff_value;              //!< Indexer into m_coeff
+        std::vector<Scalar> m_dx;           //!< Grid spacing of each table
+        std::vector<bool> m_dirty;          //!< Flags tables whose coefficients need a rebuild
+    };
+
+#undef DEVICE
+
+#endif
@@ -24,7 +24,8 @@ TablePotential::TablePotential(std::shared_ptr<SystemDefinition> sysdef,
                                std::shared_ptr<NeighborList> nlist,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_nlist(nlist), m_table_width(table_width)
+        : ForceCompute(sysdef), m_nlist(nlist), m_table_width(table_width),
+          m_interp(m_exec_conf, table_width, Index2DUpperTriangular(m_pdata->getNTypes()).getNumElements())
     {
     m_exec_conf->msg->notice(5) << "Constructing TablePotential" << endl;
 
@@ -109,6 +110,8 @@ void TablePotential::slotNumTypesChange()
     m_params.swap(params);
     TAG_ALLOCATION(m_params);
 
+    m_interp.setNumTables(table_index.getNumElements());
+
     #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
         {
@@ -182,6 +185,8 @@ void TablePotential::setTable(unsigned int typ1,
         h_tables.data[table_value(i, cur_table_index)].x = V[i];
         h_tables.data[table_value(i, cur_table_index)].y = F[i];
         }
+
+    m_interp.tableChanged(cur_table_index, h_params.data[cur_table_index].z);
     }
 
 /*! TablePotential provides
@@ -256,6 +261,12 @@ void TablePotential::computeForces(unsigned int timestep)
     Index2DUpperTriangular table_index(m_ntypes);
     Index2D table_value(m_table_width);
 
+    // refresh the spline coefficients of any modified tables
+    const bool cubic = m_interp.isCubic();
+    m_interp.update(h_tables.data, table_value);
+    ArrayHandle<Scalar4> h_coeff(m_interp.getCoefficients(), access_location::host, access_mode::read);
+    const Index2D& coeff_value = m_interp.getIndexer();
+
     // for each particle
     for (int i = 0; i < (int) m_pdata->getN(); i++)
         {
@@ -314,22 +325,25 @@ void TablePotential::computeForces(unsigned int timestep)
                 // precomputed term
                 Scalar value_f = (r - rmin) / delta_r;
 
-                // compute index into the table and read in values
+                // compute index into the table and the interpolation coefficient
                 unsigned int value_i = (unsigned int)floor(value_f);
-                Scalar2 VF0 = h_tables.data[table_value(value_i, cur_table_index)];
-                Scalar2 VF1 = h_tables.data[table_value(value_i+1, cur_table_index)];
-                // unpack the data
-                Scalar V0 = VF0.x;
-                Scalar V1 = VF1.x;
-                Scalar F0 = VF0.y;
-                Scalar F1 = VF1.y;
-
-                // compute the linear interpolation coefficient
                 Scalar f = value_f - Scalar(value_i);
 
-                // interpolate to get V and F;
-                Scalar V = V0 + f * (V1 - V0);
-                Scalar F = F0 + f * (F1 - F0);
+                Scalar V, F;
+                if (cubic)
+                    {
+                    Scalar4 c = h_coeff.data[coeff_value(value_i, cur_table_index)];
+                    TableInterpolation::evaluate(c, f, Scalar(1.0) / delta_r, V, F);
+                    }
+                else
+                    {
+                    Scalar2 VF0 = h_tables.data[table_value(value_i, cur_table_index)];
+                    Scalar2 VF1 = h_tables.data[table_value(value_i+1, cur_table_index)];
+
+                    // interpolate linearly to get V and F
+                    V = VF0.x + f * (VF1.x - VF0.x);
+                    F = VF0.y + f * (VF1.y - VF0.y);
+                    }
 
                 // convert to standard variables used by the other pair computes in HOOMD-blue
                 Scalar forcemag_divr = Scalar(0.0);
@@ -392,5 +406,6 @@ void export_TablePotential(py::module& m)
     py::class_<TablePotential, ForceCompute, std::shared_ptr<TablePotential> >(m, "TablePotential")
     .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, unsigned int, const std::string& >())
     .def("setTable", &TablePotential::setTable)
+    .def("setCubicInterpolation", &TablePotential::setCubicInterpolation)
     ;
     }
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "TableInterpolation.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GlobalArray.h"
 
@@ -56,6 +57,10 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When cubic interpolation is enabled with setCubicInterpolation(), the CPU code path evaluates a cubic Hermite spline
+    through Vi, Fi, Vi+1 and Fi+1 instead. See TableInterpolation for details. The GPU code path always interpolates
+    linearly.
     \ingroup computes
 */
 class PYBIND11_EXPORT TablePotential : public ForceCompute
@@ -78,6 +83,12 @@ class PYBIND11_EXPORT TablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Enable or disable cubic Hermite interpolation
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            m_interp.setCubic(cubic);
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -90,6 +101,7 @@ class PYBIND11_EXPORT TablePotential : public ForceCompute
         unsigned int m_ntypes;                      //!< Store the number of particle types
         GlobalArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GlobalArray<Scalar4> m_params;                 //!< Parameters stored for each table
+        TableInterpolation m_interp;                //!< Higher order interpolation of the tables
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
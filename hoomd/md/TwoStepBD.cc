@@ -11,6 +11,9 @@
 
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
+
+#include <algorithm>
+
 using namespace hoomd;
 
 
@@ -94,124 +97,143 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // the random numbers are drawn for n_lanes particles at once
+    const unsigned int n_lanes = RandomGeneratorBatch::n_lanes;
+    RandomGeneratorBatch rng_batch(RNGIdentifier::TwoStepBD, m_seed);
+    UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
+    NormalDistribution<Scalar> normal;
+    Scalar r[3][n_lanes];
+    Scalar v[3][n_lanes];
+    Scalar sigma[n_lanes] = {};
+
+    for (unsigned int first = 0; first < group_size; first += n_lanes)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
-
-        // Initialize the RNG
-        RandomGenerator rng(RNGIdentifier::TwoStepBD, m_seed, ptag, timestep);
-
-        // compute the random force
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
-
-        Scalar gamma;
-        if (m_use_lambda)
-            gamma = m_lambda*h_diameter.data[j];
-        else
+        const unsigned int n = std::min(n_lanes, group_size - first);
+        for (unsigned int l = 0; l < n; l++)
             {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
+            unsigned int j = m_group->getMemberIndex(first + l);
+            rng_batch.setLane(l, h_tag.data[j], timestep);
+            sigma[l] = fast::sqrt(currentTemp/h_vel.data[j].w);
             }
 
-        // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
-        // it is not the dimensionality of the system
-        Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*currentTemp/m_deltaT);
-        if (m_noiseless_t)
-            coeff = Scalar(0.0);
-        Scalar Fr_x = rx*coeff;
-        Scalar Fr_y = ry*coeff;
-        Scalar Fr_z = rz*coeff;
-
-        if (D < 3)
-            Fr_z = Scalar(0.0);
-
-        // update position
-        h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
-        h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
-        h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
-
-        // particles may have been moved slightly outside the box by the above steps, wrap them back into place
-        box.wrap(h_pos.data[j], h_image.data[j]);
-
-        // draw a new random velocity for particle j
-        Scalar mass =  h_vel.data[j].w;
-        Scalar sigma = fast::sqrt(currentTemp/mass);
-        NormalDistribution<Scalar> normal(sigma);
-        h_vel.data[j].x = normal(rng);
-        h_vel.data[j].y = normal(rng);
-        if (D > 2)
-            h_vel.data[j].z = normal(rng);
-        else
-            h_vel.data[j].z = 0;
-
-        // rotational random force and orientation quaternion updates
-        if (m_aniso)
+        // compute the random forces and velocities
+        for (unsigned int d = 0; d < 3; d++)
+            uniform.generateBatch(r[d], rng_batch);
+        for (unsigned int d = 0; d < D; d++)
+            normal.generateBatch(v[d], rng_batch, sigma);
+
+        for (unsigned int l = 0; l < n; l++)
             {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+            unsigned int j = m_group->getMemberIndex(first + l);
+            Scalar rx = r[0][l];
+            Scalar ry = r[1][l];
+            Scalar rz = r[2][l];
+
+            Scalar gamma;
+            if (m_use_lambda)
+                gamma = m_lambda*h_diameter.data[j];
+            else
                 {
-                vec3<Scalar> p_vec;
-                quat<Scalar> q(h_orientation.data[j]);
-                vec3<Scalar> t(h_torque.data[j]);
-                vec3<Scalar> I(h_inertia.data[j]);
-
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
-
-                Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
-                if (m_noiseless_r)
-                    sigma_r = make_scalar3(0,0,0);
-
-                // original Gaussian random torque
-                // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                if (x_zero) bf_torque.x = 0;
-                if (y_zero) bf_torque.y = 0;
-                if (z_zero) bf_torque.z = 0;
-
-                // use the damping by gamma_r and rotate back to lab frame
-                // Notes For the Future: take special care when have anisotropic gamma_r
-                // if aniso gamma_r, first rotate the torque into particle frame and divide the different gamma_r
-                // and then rotate the "angular velocity" back to lab frame and integrate
-                bf_torque = rotate(q, bf_torque);
-                if (D < 3)
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
+
+            // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
+            // it is not the dimensionality of the system
+            Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*currentTemp/m_deltaT);
+            if (m_noiseless_t)
+                coeff = Scalar(0.0);
+            Scalar Fr_x = rx*coeff;
+            Scalar Fr_y = ry*coeff;
+            Scalar Fr_z = rz*coeff;
+
+            if (D < 3)
+                Fr_z = Scalar(0.0);
+
+            // update position
+            h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
+            h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
+            h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
+
+            // particles may have been moved slightly outside the box by the above steps, wrap them back into place
+            box.wrap(h_pos.data[j], h_image.data[j]);
+
+            // draw a new random velocity for particle j
+            h_vel.data[j].x = v[0][l];
+            h_vel.data[j].y = v[1][l];
+            if (D > 2)
+                h_vel.data[j].z = v[2][l];
+            else
+                h_vel.data[j].z = 0;
+
+            // rotational random force and orientation quaternion updates
+            if (m_aniso)
+                {
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r.data[type_r];
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
                     {
-                    bf_torque.x = 0;
-                    bf_torque.y = 0;
-                    t.x = 0;
-                    t.y = 0;
+                    // continue the stream of particle j
+                    RandomGenerator rng = rng_batch.getGenerator(l);
+
+                    vec3<Scalar> p_vec;
+                    quat<Scalar> q(h_orientation.data[j]);
+                    vec3<Scalar> t(h_torque.data[j]);
+                    vec3<Scalar> I(h_inertia.data[j]);
+
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
+
+                    Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
+                    if (m_noiseless_r)
+                        sigma_r = make_scalar3(0,0,0);
+
+                    // original Gaussian random torque
+                    // Gaussian random distribution is preferred in terms of preserving the exact math
+                    vec3<Scalar> bf_torque;
+                    bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
+                    bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
+                    bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+
+                    if (x_zero) bf_torque.x = 0;
+                    if (y_zero) bf_torque.y = 0;
+                    if (z_zero) bf_torque.z = 0;
+
+                    // use the damping by gamma_r and rotate back to lab frame
+                    // Notes For the Future: take special care when have anisotropic gamma_r
+                    // if aniso gamma_r, first rotate the torque into particle frame and divide the different gamma_r
+                    // and then rotate the "angular velocity" back to lab frame and integrate
+                    bf_torque = rotate(q, bf_torque);
+                    if (D < 3)
+                        {
+                        bf_torque.x = 0;
+                        bf_torque.y = 0;
+                        t.x = 0;
+                        t.y = 0;
+                        }
+
+                    // do the integration for quaternion
+                    q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q ;
+                    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+                    h_orientation.data[j] = quat_to_scalar4(q);
+
+                    // draw a new random ang_mom for particle j in body frame
+                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
+                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
+                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                    if (x_zero) p_vec.x = 0;
+                    if (y_zero) p_vec.y = 0;
+                    if (z_zero) p_vec.z = 0;
+
+                    // !! Note this isn't well-behaving in 2D,
+                    // !! because may have effective non-zero ang_mom in x,y
+
+                    // store ang_mom quaternion
+                    quat<Scalar> p = Scalar(2.0) * q * p_vec;
+                    h_angmom.data[j] = quat_to_scalar4(p);
                     }
-
-                // do the integration for quaternion
-                q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q ;
-                q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-                h_orientation.data[j] = quat_to_scalar4(q);
-
-                // draw a new random ang_mom for particle j in body frame
-                p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
-                if (x_zero) p_vec.x = 0;
-                if (y_zero) p_vec.y = 0;
-                if (z_zero) p_vec.z = 0;
-
-                // !! Note this isn't well-behaving in 2D,
-                // !! because may have effective non-zero ang_mom in x,y
-
-                // store ang_mom quaternion
-                quat<Scalar> p = Scalar(2.0) * q * p_vec;
-                h_angmom.data[j] = quat_to_scalar4(p);
                 }
             }
         }
@@ -9,6 +9,8 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/VectorMath.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
 #endif
@@ -270,106 +272,123 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
 
     // a(t+deltaT) gets modified with the bd forces
     // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
-
-        // Initialize the RNG
-        RandomGenerator rng(RNGIdentifier::TwoStepLangevin, m_seed, ptag, timestep);
+    // the random numbers are drawn for n_lanes particles at once
+    const unsigned int n_lanes = RandomGeneratorBatch::n_lanes;
+    RandomGeneratorBatch rng_batch(RNGIdentifier::TwoStepLangevin, m_seed);
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
+    Scalar r[3][n_lanes];
 
-        // first, calculate the BD forces
-        // Generate three random numbers
-        hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
-
-        Scalar gamma;
-        if (m_use_lambda)
-            gamma = m_lambda*h_diameter.data[j];
-        else
+    for (unsigned int first = 0; first < group_size; first += n_lanes)
+        {
+        const unsigned int n = std::min(n_lanes, group_size - first);
+        for (unsigned int l = 0; l < n; l++)
             {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
+            unsigned int j = m_group->getMemberIndex(first + l);
+            rng_batch.setLane(l, h_tag.data[j], timestep);
             }
 
-        // compute the bd force
-        Scalar coeff = fast::sqrt(Scalar(6.0) *gamma*currentTemp/m_deltaT);
-        if (m_noiseless_t)
-            coeff = Scalar(0.0);
-        Scalar bd_fx = rx*coeff - gamma*h_vel.data[j].x;
-        Scalar bd_fy = ry*coeff - gamma*h_vel.data[j].y;
-        Scalar bd_fz = rz*coeff - gamma*h_vel.data[j].z;
-
-        if (D < 3)
-            bd_fz = Scalar(0.0);
-
-        // then, calculate acceleration from the net force
-        Scalar minv = Scalar(1.0) / h_vel.data[j].w;
-        h_accel.data[j].x = (h_net_force.data[j].x + bd_fx)*minv;
-        h_accel.data[j].y = (h_net_force.data[j].y + bd_fy)*minv;
-        h_accel.data[j].z = (h_net_force.data[j].z + bd_fz)*minv;
-
-        // then, update the velocity
-        h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
-        h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
-        h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
-
-        // tally the energy transfer from the bd thermal reservoir to the particles
-        if (m_tally) bd_energy_transfer += bd_fx * h_vel.data[j].x + bd_fy * h_vel.data[j].y + bd_fz * h_vel.data[j].z;
+        // first, calculate the BD forces
+        // Generate three random numbers per particle
+        for (unsigned int d = 0; d < 3; d++)
+            uniform.generateBatch(r[d], rng_batch);
 
-        // rotational updates
-        if (m_aniso)
+        for (unsigned int l = 0; l < n; l++)
             {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            // get body frame ang_mom
-            quat<Scalar> p(h_angmom.data[j]);
-            quat<Scalar> q(h_orientation.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // s is the pure imaginary quaternion with im. part equal to true angular velocity
-            vec3<Scalar> s;
-            s = (Scalar(1./2.) * conj(q) * p).v;
+            unsigned int j = m_group->getMemberIndex(first + l);
+            Scalar rx = r[0][l];
+            Scalar ry = r[1][l];
+            Scalar rz = r[2][l];
+
+            Scalar gamma;
+            if (m_use_lambda)
+                gamma = m_lambda*h_diameter.data[j];
+            else
+                {
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
 
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+            // compute the bd force
+            Scalar coeff = fast::sqrt(Scalar(6.0) *gamma*currentTemp/m_deltaT);
+            if (m_noiseless_t)
+                coeff = Scalar(0.0);
+            Scalar bd_fx = rx*coeff - gamma*h_vel.data[j].x;
+            Scalar bd_fy = ry*coeff - gamma*h_vel.data[j].y;
+            Scalar bd_fz = rz*coeff - gamma*h_vel.data[j].z;
+
+            if (D < 3)
+                bd_fz = Scalar(0.0);
+
+            // then, calculate acceleration from the net force
+            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+            h_accel.data[j].x = (h_net_force.data[j].x + bd_fx)*minv;
+            h_accel.data[j].y = (h_net_force.data[j].y + bd_fy)*minv;
+            h_accel.data[j].z = (h_net_force.data[j].z + bd_fz)*minv;
+
+            // then, update the velocity
+            h_vel.data[j].x += Scalar(1.0/2.0)*h_accel.data[j].x*m_deltaT;
+            h_vel.data[j].y += Scalar(1.0/2.0)*h_accel.data[j].y*m_deltaT;
+            h_vel.data[j].z += Scalar(1.0/2.0)*h_accel.data[j].z*m_deltaT;
+
+            // tally the energy transfer from the bd thermal reservoir to the particles
+            if (m_tally)
+                bd_energy_transfer += bd_fx * h_vel.data[j].x + bd_fy * h_vel.data[j].y + bd_fz * h_vel.data[j].z;
+
+            // rotational updates
+            if (m_aniso)
                 {
-                // first calculate in the body frame random and damping torque imposed by the dynamics
-                vec3<Scalar> bf_torque;
-
-                // original Gaussian random torque
-                Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
-                                               fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
-                if (m_noiseless_r) sigma_r = make_scalar3(0.0,0.0,0.0);
-
-                Scalar rand_x = hoomd::NormalDistribution<Scalar>(sigma_r.x)(rng);
-                Scalar rand_y = hoomd::NormalDistribution<Scalar>(sigma_r.y)(rng);
-                Scalar rand_z = hoomd::NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                // check for degenerate moment of inertia
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
-
-                bf_torque.x = rand_x - gamma_r.x * (s.x / I.x);
-                bf_torque.y = rand_y - gamma_r.y * (s.y / I.y);
-                bf_torque.z = rand_z - gamma_r.z * (s.z / I.z);
-
-                // ignore torque component along an axis for which the moment of inertia zero
-                if (x_zero) bf_torque.x = 0;
-                if (y_zero) bf_torque.y = 0;
-                if (z_zero) bf_torque.z = 0;
-
-                // change to lab frame and update the net torque
-                bf_torque = rotate(q, bf_torque);
-                h_net_torque.data[j].x += bf_torque.x;
-                h_net_torque.data[j].y += bf_torque.y;
-                h_net_torque.data[j].z += bf_torque.z;
-
-                if (D < 3) h_net_torque.data[j].x = 0;
-                if (D < 3) h_net_torque.data[j].y = 0;
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r.data[type_r];
+                // get body frame ang_mom
+                quat<Scalar> p(h_angmom.data[j]);
+                quat<Scalar> q(h_orientation.data[j]);
+                vec3<Scalar> t(h_net_torque.data[j]);
+                vec3<Scalar> I(h_inertia.data[j]);
+
+                // s is the pure imaginary quaternion with im. part equal to true angular velocity
+                vec3<Scalar> s;
+                s = (Scalar(1./2.) * conj(q) * p).v;
+
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+                    {
+                    // continue the stream of particle j
+                    RandomGenerator rng = rng_batch.getGenerator(l);
+
+                    // first calculate in the body frame random and damping torque imposed by the dynamics
+                    vec3<Scalar> bf_torque;
+
+                    // original Gaussian random torque
+                    Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0)*gamma_r.x*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.y*currentTemp/m_deltaT),
+                                                   fast::sqrt(Scalar(2.0)*gamma_r.z*currentTemp/m_deltaT));
+                    if (m_noiseless_r) sigma_r = make_scalar3(0.0,0.0,0.0);
+
+                    Scalar rand_x = hoomd::NormalDistribution<Scalar>(sigma_r.x)(rng);
+                    Scalar rand_y = hoomd::NormalDistribution<Scalar>(sigma_r.y)(rng);
+                    Scalar rand_z = hoomd::NormalDistribution<Scalar>(sigma_r.z)(rng);
+
+                    // check for degenerate moment of inertia
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON); y_zero = (I.y < EPSILON); z_zero = (I.z < EPSILON);
+
+                    bf_torque.x = rand_x - gamma_r.x * (s.x / I.x);
+                    bf_torque.y = rand_y - gamma_r.y * (s.y / I.y);
+                    bf_torque.z = rand_z - gamma_r.z * (s.z / I.z);
+
+                    // ignore torque component along an axis for which the moment of inertia zero
+                    if (x_zero) bf_torque.x = 0;
+                    if (y_zero) bf_torque.y = 0;
+                    if (z_zero) bf_torque.z = 0;
+
+                    // change to lab frame and update the net torque
+                    bf_torque = rotate(q, bf_torque);
+                    h_net_torque.data[j].x += bf_torque.x;
+                    h_net_torque.data[j].y += bf_torque.y;
+                    h_net_torque.data[j].z += bf_torque.z;
+
+                    if (D < 3) h_net_torque.data[j].x = 0;
+                    if (D < 3) h_net_torque.data[j].y = 0;
+                    }
                 }
             }
         }
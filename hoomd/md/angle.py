@@ -374,6 +374,7 @@ class table(force._force):
 
         width (int): Number of points to use to interpolate V and F (see documentation above)
         name (str): Name of the force instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated  angle potential should be added to every bonded triple of particles
     in the simulation.
@@ -391,6 +392,8 @@ class table(force._force):
     between :math:`0` and :math:`\pi`. Values are interpolated linearly between grid points.
     For correctness, you must specify: :math:`T = -\frac{\partial V}{\partial \theta}`
 
+    See :ref:`page-table-interpolation` for ``interpolation='cubic'``.
+
     Parameters:
 
     - :math:`T_{\mathrm{user}}(\theta)` and :math:`V_{\mathrm{user}}(\theta)` - evaluated by `func` (see example)
@@ -424,12 +427,21 @@ class table(force._force):
         btable.set_from_file('polymer', 'angle.dat')
 
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
 
         # initialize the base class
         force._force.__init__(self, name);
 
 
+        # check the interpolation scheme
+        if interpolation not in ('linear', 'cubic'):
+            hoomd.context.current.device.cpp_msg.error("angle.table: interpolation must be 'linear' or 'cubic'\n");
+            raise ValueError("Invalid interpolation scheme");
+
+        if interpolation == 'cubic' and hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("angle.table: cubic interpolation is not supported on the GPU\n");
+            raise RuntimeError("Error initializing angle.table");
+
         # create the c++ mirror class
         if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
             self.cpp_force = _md.TableAngleForceCompute(hoomd.context.current.system_definition, int(width), self.name);
@@ -438,6 +450,9 @@ class table(force._force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
+        if interpolation == 'cubic':
+            self.cpp_force.setCubicInterpolation(True);
+
         # setup the coefficient matrix
         self.angle_coeff = coeff();
 
@@ -373,6 +373,7 @@ class table(force._force):
     Args:
         width (int): Number of points to use to interpolate V and F
         name (str): Name of the potential instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated bond potential should be applied between the two particles in each
     defined bond.
@@ -400,6 +401,8 @@ class table(force._force):
     :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points.
     For correctness, you must specify the force defined by: :math:`F = -\frac{\partial V}{\partial r}`
 
+    See :ref:`page-table-interpolation` for ``interpolation='cubic'``.
+
     The following coefficients must be set for each bond type:
 
     - :math:`F_{\mathrm{user}}(r)` and :math:`V_{\mathrm{user}}(r)` - evaluated by ``func`` (see example)
@@ -442,12 +445,21 @@ class table(force._force):
         Ensure that ``rmin`` and ``rmax`` cover the range of possible bond lengths. When gpu error checking is on, a error will
         be thrown if a bond distance is outside than this range.
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
 
         # initialize the base class
         force._force.__init__(self, name);
 
 
+        # check the interpolation scheme
+        if interpolation not in ('linear', 'cubic'):
+            hoomd.context.current.device.cpp_msg.error("bond.table: interpolation must be 'linear' or 'cubic'\n");
+            raise ValueError("Invalid interpolation scheme");
+
+        if interpolation == 'cubic' and hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("bond.table: cubic interpolation is not supported on the GPU\n");
+            raise RuntimeError("Error initializing bond.table");
+
         # create the c++ mirror class
         if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
             self.cpp_force = _md.BondTablePotential(hoomd.context.current.system_definition, int(width), self.name);
@@ -456,6 +468,9 @@ class table(force._force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
+        if interpolation == 'cubic':
+            self.cpp_force.setCubicInterpolation(True);
+
         # setup the coefficients matrix
         self.bond_coeff = coeff();
 
@@ -233,20 +233,48 @@ class distance(_constraint_force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
-    def set_params(self,rel_tol=None):
+    def set_params(self,rel_tol=None,solver=None,expansion_order=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            solver (str): Solver for the constraint equations, either ``'lu'`` or ``'lincs'`` (**optional**).
+            expansion_order (int): Maximum order of the LINCS matrix expansion (**optional**).
+
+        With ``solver='lu'`` (the default), the constraint equations are solved exactly with a sparse LU decomposition
+        of the global constraint matrix. With ``solver='lincs'``, the inverse of the matrix is approximated by a
+        series expansion as in the LINCS algorithm, which scales linearly with the number of constraints
+        and is evaluated in parallel. The expansion stops after *expansion_order* terms, or earlier when
+        the last term is smaller than *rel_tol* relative to the largest Lagrange multiplier.
+        LINCS is suitable for chains and trees of constraints, but may not converge for coupled rings such as
+        triangles. When the expansion diverges, the solver reverts to ``'lu'``.
+
+        Note:
+            ``solver='lincs'`` is implemented on the CPU only. On the GPU it evaluates the expansion on the host
+            and copies particle data and forces between the host and the device every time step, which is
+            usually slower than the default ``'lu'`` solver on the GPU.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(solver='lincs', expansion_order=8)
         """
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
 
+        if solver is not None:
+            if solver == 'lu':
+                self.cpp_force.setUseLINCS(False)
+            elif solver == 'lincs':
+                self.cpp_force.setUseLINCS(True)
+            else:
+                hoomd.context.current.device.cpp_msg.error("constrain.distance: Unknown solver " + str(solver) + "\n")
+                raise ValueError("Invalid solver")
+
+        if expansion_order is not None:
+            self.cpp_force.setExpansionOrder(int(expansion_order))
+
 class rigid(_constraint_force):
     R""" Constrain particles in rigid bodies.
 
@@ -295,6 +295,7 @@ class table(force._force):
     Args:
         width (int): Number of points to use to interpolate V and T (see documentation above)
         name (str): Name of the force instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated dihedral force should be applied to every define dihedral.
 
@@ -303,6 +304,8 @@ class table(force._force):
     For correctness, you must specify the derivative of the potential with respect to the dihedral angle,
     defined by: :math:`T = -\frac{\partial V}{\partial \theta}`.
 
+    See :ref:`page-table-interpolation` for ``interpolation='cubic'``.
+
     Parameters:
 
     - :math:`T_{\mathrm{user}}(\theta)` and :math:`V_{\mathrm{user}} (\theta)` - evaluated by ``func`` (see example)
@@ -333,12 +336,21 @@ class table(force._force):
         dtable.set_from_file('polymer', 'dihedral.dat')
 
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
 
         # initialize the base class
         force._force.__init__(self, name);
 
 
+        # check the interpolation scheme
+        if interpolation not in ('linear', 'cubic'):
+            hoomd.context.current.device.cpp_msg.error("dihedral.table: interpolation must be 'linear' or 'cubic'\n");
+            raise ValueError("Invalid interpolation scheme");
+
+        if interpolation == 'cubic' and hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("dihedral.table: cubic interpolation is not supported on the GPU\n");
+            raise RuntimeError("Error initializing dihedral.table");
+
         # create the c++ mirror class
         if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
             self.cpp_force = _md.TableDihedralForceCompute(hoomd.context.current.system_definition, int(width), self.name);
@@ -347,6 +359,9 @@ class table(force._force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
+        if interpolation == 'cubic':
+            self.cpp_force.setCubicInterpolation(True);
+
         # setup the coefficient matrix
         self.dihedral_coeff = coeff();
 
@@ -532,3 +532,63 @@ class dipole(_force):
     # there are no coeffs to update in the constant ExternalFieldDipoleForceCompute
     def update_coeffs(self):
         pass
+
+class fused_bonded(_force):
+    R""" Evaluate several bonded forces in one pass.
+
+    Args:
+        forces (list): Bonded forces to evaluate together.
+        name (str): Name of the force instance.
+
+    :py:class:`fused_bonded` evaluates the given bond, angle, dihedral and improper forces together. The particles are
+    processed in windows of consecutive particles in memory order, and all bonded groups of all forces that start in a
+    window are evaluated before the next window. All forces accumulate into one force array, which is zeroed once per
+    step and summed once into the net force, instead of one array per force.
+
+    The following forces can be fused: :py:class:`hoomd.md.bond.harmonic`, :py:class:`hoomd.md.bond.fene`,
+    :py:class:`hoomd.md.angle.harmonic`, :py:class:`hoomd.md.angle.cosinesq`, :py:class:`hoomd.md.dihedral.harmonic`,
+    :py:class:`hoomd.md.dihedral.opls` and :py:class:`hoomd.md.improper.harmonic`.
+
+    The fused forces are disabled with ``log=True``: they are no longer added to the integrator, but their
+    coefficients are still set and their energies can still be logged. Do not enable them again while the
+    :py:class:`fused_bonded` force is enabled, or their forces will be applied twice.
+
+    Note:
+        :py:class:`fused_bonded` is only available on the CPU.
+
+    Examples::
+
+        harmonic = md.bond.harmonic()
+        harmonic.bond_coeff.set('polymer', k=330.0, r0=0.84)
+        angle = md.angle.harmonic()
+        angle.angle_coeff.set('polymer', k=3.0, t0=0.7851)
+        md.force.fused_bonded([harmonic, angle])
+
+    """
+    def __init__(self, forces, name=None):
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("force.fused_bonded is not supported on the GPU\n");
+            raise RuntimeError("Error creating fused bonded force");
+
+        for f in forces:
+            if not f.enabled:
+                hoomd.context.current.device.cpp_msg.error("force.fused_bonded: Cannot fuse a disabled force\n");
+                raise RuntimeError("Error creating fused bonded force");
+
+        # initialize the base class
+        _force.__init__(self, name);
+
+        # create the c++ mirror class
+        self.cpp_force = _md.FusedBondedForceCompute(hoomd.context.current.system_definition);
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        self.forces = list(forces);
+        for f in self.forces:
+            self.cpp_force.addForceCompute(f.cpp_force);
+
+            # the force is evaluated by this one, keep it only to set coefficients and log
+            f.disable(log=True);
+
+    # the coefficients are updated by the fused forces
+    def update_coeffs(self):
+        pass
@@ -52,10 +52,18 @@ class mode_standard(_integrator):
     Args:
         dt (float): Each time step of the simulation :py:func:`hoomd.run()` will advance the real time of the system forward by *dt* (in time units).
         aniso (bool): Whether to integrate rotational degrees of freedom (bool), default None (autodetect).
+        direct_net_force (bool): Whether forces add their contributions directly to the net force (CPU only), default False.
 
     :py:class:`mode_standard` performs a standard time step integration technique to move the system forward. At each time
     step, all of the specified forces are evaluated and used in moving the system forward to the next step.
 
+    By default, every force stores its forces, energies and virials in per-particle arrays, which are then summed up
+    into the net force. With *direct_net_force* set to True, pair and bond forces and :py:class:`hoomd.md.force.fused_bonded`
+    add their contributions directly to the net force instead. Their per-particle arrays are released and only evaluated
+    again when a logger, analyzer, or a method such as :py:meth:`hoomd.md.force._force.get_energy` asks for them. This saves
+    memory and memory traffic in large systems, at the cost of a second evaluation on the steps where per-particle data
+    is requested. Forces without direct accumulation support are summed up as before.
+
     By itself, :py:class:`mode_standard` does nothing. You must specify one or more integration methods to apply to the
     system. Each integration method can be applied to only a specific group of particles enabling advanced simulation
     techniques.
@@ -76,6 +84,7 @@ class mode_standard(_integrator):
 
         integrate.mode_standard(dt=0.005)
         integrator_mode = integrate.mode_standard(dt=0.001)
+        integrate.mode_standard(dt=0.005, direct_net_force=True)
 
     Some integration methods (notable :py:class:`nvt`, :py:class:`npt` and :py:class:`nph` maintain state between
     different :py:func:`hoomd.run()` commands, to allow for restartable simulations. After adding or removing particles, however,
@@ -83,7 +92,7 @@ class mode_standard(_integrator):
     To ensure equilibration from a unique reference state (such as all integrator variables set to zero),
     the method :py:method:reset_methods() can be use to re-initialize the variables.
     """
-    def __init__(self, dt, aniso=None):
+    def __init__(self, dt, aniso=None, direct_net_force=False):
 
         # initialize base class
         _integrator.__init__(self);
@@ -91,7 +100,8 @@ class mode_standard(_integrator):
         # Store metadata
         self.dt = dt
         self.aniso = aniso
-        self.metadata_fields = ['dt', 'aniso']
+        self.direct_net_force = False
+        self.metadata_fields = ['dt', 'aniso', 'direct_net_force']
 
         # initialize the reflected c++ class
         self.cpp_integrator = _md.IntegratorTwoStep(hoomd.context.current.system_definition, dt);
@@ -102,6 +112,9 @@ class mode_standard(_integrator):
         if aniso is not None:
             self.set_params(aniso=aniso)
 
+        if direct_net_force:
+            self.set_params(direct_net_force=direct_net_force)
+
     ## \internal
     #  \brief Cached set of anisotropic mode enums for ease of access
     _aniso_modes = {
@@ -109,17 +122,19 @@ class mode_standard(_integrator):
         True: _md.IntegratorAnisotropicMode.Anisotropic,
         False: _md.IntegratorAnisotropicMode.Isotropic}
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self, dt=None, aniso=None, direct_net_force=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            direct_net_force (bool): Whether forces add their contributions directly to the net force (if set).
 
         Examples::
 
             integrator_mode.set_params(dt=0.007)
             integrator_mode.set_params(dt=0.005, aniso=False)
+            integrator_mode.set_params(direct_net_force=True)
 
         """
         self.check_initialization();
@@ -138,6 +153,13 @@ class mode_standard(_integrator):
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if direct_net_force is not None:
+            if direct_net_force and hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+                hoomd.context.current.device.cpp_msg.error("integrate.mode_standard: direct_net_force is not supported on the GPU.\n");
+                raise RuntimeError("Error setting direct net force mode.");
+            self.direct_net_force = direct_net_force
+            self.cpp_integrator.setDirectNetForce(direct_net_force)
+
     def reset_methods(self):
         R""" (Re-)initialize the integrator variables in all integration methods
 
@@ -23,6 +23,7 @@
 #include "FIREEnergyMinimizer.h"
 #include "ForceComposite.h"
 #include "ForceDistanceConstraint.h"
+#include "FusedBondedForceCompute.h"
 #include "HarmonicAngleForceCompute.h"
 #include "CosineSqAngleForceCompute.h"
 #include "HarmonicDihedralForceCompute.h"
@@ -230,6 +231,7 @@ PYBIND11_MODULE(_md, m)
     export_OPLSDihedralForceCompute(m);
     export_TableDihedralForceCompute(m);
     export_HarmonicImproperForceCompute(m);
+    export_FusedBondedForceCompute(m);
     export_TablePotential(m);
     export_BondTablePotential(m);
     export_PotentialPair<PotentialPairBuckingham>(m, "PotentialPairBuckingham");
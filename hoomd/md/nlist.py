@@ -347,10 +347,11 @@ class nlist:
             set_max_check_period (bool): Set to True to enable automatic setting of the maximum nlist check_period
             quiet (bool): Quiet the individual run() calls.
 
-        :py:meth:`tune()` executes *warmup* time steps. Then it sets the nlist *r_buff* value to *r_min* and runs for
-        *steps* time steps. The TPS value is recorded, and the benchmark moves on to the next *r_buff* value
-        completing at *r_max* in *jumps* jumps. Status information is printed out to the screen, and the optimal
-        *r_buff* value is left set for further :py:func:`hoomd.run()` calls to continue at optimal settings.
+        :py:meth:`tune()` executes *warmup* time steps. Then it scans the *r_buff* values from *r_min* to *r_max* in
+        *jumps* jumps, running *steps* time steps at each point. The wall clock time of the runs is measured natively
+        during the scan, so no intermediate :py:func:`hoomd.run()` calls are made. Status information is printed out
+        to the screen, and the optimal *r_buff* value is left set for further :py:func:`hoomd.run()` calls to
+        continue at optimal settings. In MPI simulations, all ranks contribute timings and agree on the same value.
 
         Each benchmark is repeated 3 times and the median value chosen. Then, *warmup* time steps are run again
         at the optimal *r_buff* in order to determine the maximum value of check_period. In total,
@@ -378,42 +379,33 @@ class nlist:
         # make the warmup run
         hoomd.run(warmup, quiet=quiet);
 
-        # initialize scan variables
-        dr = (r_max - r_min) / (jumps - 1);
-        r_buff_list = [];
-        tps_list = [];
+        # list the r_buff points to scan
+        if jumps > 1:
+            dr = (r_max - r_min) / (jumps - 1);
+        else:
+            dr = 0.0;
+        r_buff_list = [r_min + i * dr for i in range(0,jumps)];
 
-        # loop over all desired r_buff points
-        for i in range(0,jumps):
-            # set the current r_buff
-            r_buff = r_min + i * dr;
-            self.set_params(r_buff=r_buff);
+        # time 3 windows of steps at every r_buff, without periodic rescans during the scan
+        nsamples = 3;
+        self.cpp_nlist.setRBuffTuner(r_buff_list, nsamples, 2**31, steps);
 
-            # run the benchmark 3 times
-            tps = [];
-            hoomd.run(steps, quiet=quiet);
-            tps.append(hoomd.context.current.system.getLastTPS())
-            hoomd.run(steps, quiet=quiet);
-            tps.append(hoomd.context.current.system.getLastTPS())
-            hoomd.run(steps, quiet=quiet);
-            tps.append(hoomd.context.current.system.getLastTPS())
+        # the first step opens the first window
+        hoomd.run(nsamples * jumps * steps + 1, quiet=quiet);
 
-            # record the median tps of the 3
-            tps.sort();
-            tps_list.append(tps[1]);
-            r_buff_list.append(r_buff);
+        if not self.cpp_nlist.isRBuffTunerComplete():
+            hoomd.context.current.device.cpp_msg.warning("nlist.tune: r_buff scan did not complete\n");
 
-        # find the fastest r_buff
-        fastest = tps_list.index(max(tps_list));
-        fastest_r_buff = r_buff_list[fastest];
+        # keep the fastest r_buff
+        self.cpp_nlist.disableRBuffTuner();
+        fastest_r_buff = self.cpp_nlist.getRBuff();
+        self.r_buff = fastest_r_buff;
 
-        # set the fastest and rerun the warmup steps to identify the max check period
-        self.set_params(r_buff=fastest_r_buff);
+        # rerun the warmup steps to identify the max check period
         hoomd.run(warmup, quiet=quiet);
 
         # notify the user of the benchmark results
         hoomd.context.current.device.cpp_msg.notice(2, "r_buff = " + str(r_buff_list) + '\n');
-        hoomd.context.current.device.cpp_msg.notice(2, "tps = " + str(tps_list) + '\n');
         hoomd.context.current.device.cpp_msg.notice(2, "Optimal r_buff: " + str(fastest_r_buff) + '\n');
         hoomd.context.current.device.cpp_msg.notice(2, "Maximum check_period: " + str(self.query_update_period()) + '\n');
 
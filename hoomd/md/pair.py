@@ -974,6 +974,7 @@ class table(force._force):
         width (int): Number of points to use to interpolate V and F.
         nlist (:py:mod:`hoomd.md.nlist`): Neighbor list (default of None automatically creates a global cell-list based neighbor list)
         name (str): Name of the force instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated pair potential should be applied between every
     non-excluded particle pair in the simulation.
@@ -1006,6 +1007,8 @@ class table(force._force):
     :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points.
     For correctness, you must specify the force defined by: :math:`F = -\frac{\partial V}{\partial r}`.
 
+    See :ref:`page-table-interpolation` for ``interpolation='cubic'``.
+
     The following coefficients must be set per unique pair of particle types:
 
     - :math:`V_{\mathrm{user}}(r)` and :math:`F_{\mathrm{user}}(r)` - evaluated by ``func`` (see example)
@@ -1047,7 +1050,7 @@ class table(force._force):
         not diverge near r=0, then a setting of *rmin=0* is valid.
 
     """
-    def __init__(self, width, nlist, name=None):
+    def __init__(self, width, nlist, name=None, interpolation='linear'):
 
         # initialize the base class
         force._force.__init__(self, name);
@@ -1059,6 +1062,15 @@ class table(force._force):
         self.nlist.subscribe(lambda:self.get_rcut())
         self.nlist.update_rcut()
 
+        # check the interpolation scheme
+        if interpolation not in ('linear', 'cubic'):
+            hoomd.context.current.device.cpp_msg.error("pair.table: interpolation must be 'linear' or 'cubic'\n");
+            raise ValueError("Invalid interpolation scheme");
+
+        if interpolation == 'cubic' and hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error("pair.table: cubic interpolation is not supported on the GPU\n");
+            raise RuntimeError("Error initializing pair.table");
+
         # create the c++ mirror class
         if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
             self.cpp_force = _md.TablePotential(hoomd.context.current.system_definition, self.nlist.cpp_nlist, int(width), self.name);
@@ -1068,6 +1080,9 @@ class table(force._force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
+        if interpolation == 'cubic':
+            self.cpp_force.setCubicInterpolation(True);
+
         # stash the width for later use
         self.width = width;
 
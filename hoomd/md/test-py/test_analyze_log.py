@@ -131,6 +131,51 @@ class analyze_log_query_tests (unittest.TestCase):
         hoomd.context.initialize();
 
 
+# test analyze.log_binary against analyze.log
+class analyze_log_binary_tests (unittest.TestCase):
+    def setUp(self):
+        init.create_lattice(lattice.sc(a=1.5),n=[8,8,8]); # must be close enough to interact
+        nl = hoomd.md.nlist.cell()
+        self.pair = hoomd.md.pair.lj(r_cut=2.5, nlist = nl)
+        self.pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        hoomd.md.integrate.mode_standard(dt=0.005);
+        hoomd.md.integrate.langevin(hoomd.group.all(), seed=1, kT=1.0);
+
+        if hoomd.context.current.device.comm.rank == 0:
+            self.tmp_txt = tempfile.mkstemp(suffix='.test.log')[1];
+            self.tmp_bin = tempfile.mkstemp(suffix='.test.bin')[1];
+        else:
+            self.tmp_txt = "invalid";
+            self.tmp_bin = "invalid";
+
+    # binary and text logs must contain the same values
+    def test_compare(self):
+        quantities = ['potential_energy', 'kinetic_energy', 'pressure_xy']
+        hoomd.analyze.log(quantities=quantities, period=10, filename=self.tmp_txt, overwrite=True);
+        log = hoomd.analyze.log_binary(quantities=quantities, period=10, filename=self.tmp_bin, chunk_size=3,
+                                       overwrite=True);
+        hoomd.run(101);
+
+        log.set_params(quantities=['kinetic_energy']);
+        hoomd.run(20);
+
+        if hoomd.context.current.device.comm.rank == 0:
+            text = numpy.genfromtxt(self.tmp_txt, names=True);
+            data = hoomd.analyze.read_log_binary(self.tmp_bin);
+
+            self.assertEqual(len(data['timestep']), 13);
+            numpy.testing.assert_array_equal(data['timestep'], numpy.arange(0, 130, 10));
+            numpy.testing.assert_allclose(data['kinetic_energy'], text['kinetic_energy'], rtol=1e-8);
+            numpy.testing.assert_allclose(data['potential_energy'][:11], text['potential_energy'][:11], rtol=1e-8);
+            self.assertTrue(numpy.all(numpy.isnan(data['potential_energy'][11:])));
+
+    def tearDown(self):
+        self.pair = None;
+        hoomd.context.initialize();
+        if (hoomd.context.current.device.comm.rank==0):
+            os.remove(self.tmp_txt);
+            os.remove(self.tmp_bin);
+
 try:
     import h5py
 except ImportError:
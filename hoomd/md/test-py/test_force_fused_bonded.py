@@ -0,0 +1,128 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+context.initialize()
+import unittest
+import numpy
+
+# tests md.force.fused_bonded
+class force_fused_bonded_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        numpy.random.seed(12345)
+        # chains of 100 particles, so that groups cross the boundaries of the 512 particle windows of
+        # fused_bonded at particles 512 and 1024
+        n_chains = 16
+        n_chain = 100
+        L = 40.0
+        snap = data.make_snapshot(N=n_chains*n_chain,
+                                  box=data.boxdim(L=L),
+                                  particle_types = ['A'],
+                                  bond_types = ['bondA'],
+                                  angle_types = ['angleA'],
+                                  dihedral_types = ['dihedralA'],
+                                  improper_types = ['improperA'])
+
+        if context.current.device.comm.rank == 0:
+            snap.bonds.resize(n_chains*(n_chain-1));
+            snap.angles.resize(n_chains*(n_chain-2));
+            snap.dihedrals.resize(n_chains*(n_chain-3));
+            snap.impropers.resize(n_chains*(n_chain-3));
+
+            for c in range(n_chains):
+                # random walk with steps of the rest length of the bonds, consecutive bonds are never close to
+                # parallel so that the angles and dihedrals are well defined
+                x = numpy.zeros((n_chain, 3));
+                x[0] = numpy.random.uniform(-L/2, L/2, size=3);
+                step = numpy.array([0.84, 0, 0]);
+                for i in range(1, n_chain):
+                    while True:
+                        new_step = numpy.random.normal(size=3);
+                        new_step *= 0.84 / numpy.linalg.norm(new_step);
+                        if abs(numpy.dot(new_step, step)) < 0.8*0.84*0.84:
+                            break
+                    step = new_step;
+                    x[i] = x[i-1] + step;
+                x = numpy.mod(x + L/2, L) - L/2;
+
+                first = c*n_chain;
+                snap.particles.position[first:first+n_chain,:] = x;
+
+                for i in range(n_chain-1):
+                    snap.bonds.group[c*(n_chain-1)+i,:] = [first+i, first+i+1];
+                for i in range(n_chain-2):
+                    snap.angles.group[c*(n_chain-2)+i,:] = [first+i, first+i+1, first+i+2];
+                for i in range(n_chain-3):
+                    snap.dihedrals.group[c*(n_chain-3)+i,:] = [first+i, first+i+1, first+i+2, first+i+3];
+                    snap.impropers.group[c*(n_chain-3)+i,:] = [first+i+3, first+i, first+i+1, first+i+2];
+
+        self.snap = snap
+
+    def create_forces(self):
+        bond = md.bond.harmonic();
+        bond.bond_coeff.set('bondA', k=330.0, r0=0.84)
+        angle = md.angle.harmonic();
+        angle.angle_coeff.set('angleA', k=3.0, t0=0.7851)
+        dihedral = md.dihedral.opls();
+        dihedral.dihedral_coeff.set('dihedralA', k1=1.0, k2=2.0, k3=3.0, k4=4.0)
+        improper = md.improper.harmonic();
+        improper.improper_coeff.set('improperA', k=10.0, chi=1.0)
+        return [bond, angle, dihedral, improper]
+
+    def run_forces(self, fuse):
+        s = init.read_snapshot(self.snap)
+        # keep the particles in tag order, so that the groups above cross the window boundaries
+        context.current.sorter.disable()
+        forces = self.create_forces()
+        if fuse:
+            fused = md.force.fused_bonded(forces)
+            energy_forces = [fused]
+        else:
+            energy_forces = forces
+
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group.all());
+        run(1);
+
+        result = [(s.particles[i].net_force, s.particles[i].net_energy) for i in range(len(s.particles))]
+        energy = sum(f.get_energy(group.all()) for f in energy_forces)
+        context.initialize()
+        return result, energy
+
+    # test that the fused force matches the separate forces
+    def test_fused(self):
+        ref, ref_energy = self.run_forces(fuse=False)
+        fused, energy = self.run_forces(fuse=True)
+
+        self.assertAlmostEqual(energy, ref_energy, places=3)
+        for (f_ref, e_ref), (f, e) in zip(ref, fused):
+            numpy.testing.assert_allclose(f, f_ref, rtol=1e-4, atol=1e-3)
+            self.assertAlmostEqual(e, e_ref, places=4)
+
+    # test that the energies of fused forces can still be logged
+    def test_log(self):
+        init.read_snapshot(self.snap)
+        forces = self.create_forces()
+        md.force.fused_bonded(forces)
+        log = analyze.log(filename=None, quantities=['bond_harmonic_energy', 'angle_harmonic_energy'], period=1)
+
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        run(2);
+
+        self.assertNotEqual(log.query('bond_harmonic_energy'), 0.0)
+        self.assertNotEqual(log.query('angle_harmonic_energy'), 0.0)
+
+    # test that forces without a fused implementation are rejected
+    def test_unsupported(self):
+        init.read_snapshot(self.snap)
+        table = md.bond.table(width=10)
+        self.assertRaises(RuntimeError, md.force.fused_bonded, [table])
+
+    def tearDown(self):
+        context.initialize();
+
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,83 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+context.initialize()
+import unittest
+import numpy
+
+# tests md.integrate.mode_standard(direct_net_force=True)
+class integrate_direct_net_force_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        snap = data.make_snapshot(N=250, box=data.boxdim(L=20), particle_types=['A'], bond_types=['bondA'])
+
+        if context.current.device.comm.rank == 0:
+            numpy.random.seed(12345)
+            snap.particles.position[:] = numpy.random.uniform(-9.5, 9.5, size=(250,3))
+            snap.bonds.resize(100)
+            snap.bonds.group[:] = [[2*i, 2*i+1] for i in range(100)]
+            for i in range(100):
+                snap.particles.position[2*i+1,:] = snap.particles.position[2*i,:] + [0.9, 0.1, 0]
+
+        self.snap = snap
+
+    def create_forces(self):
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=0.8)
+        bond = md.bond.harmonic()
+        bond.bond_coeff.set('bondA', k=100.0, r0=1.0)
+        return [lj, bond]
+
+    def run_forces(self, direct):
+        s = init.read_snapshot(self.snap)
+        forces = self.create_forces()
+        md.integrate.mode_standard(dt=0.001, direct_net_force=direct)
+        md.integrate.nve(group.all())
+        run(10)
+
+        result = [(s.particles[i].net_force, s.particles[i].net_energy) for i in range(len(s.particles))]
+        energy = [f.get_energy(group.all()) for f in forces]
+        context.initialize()
+        return result, energy
+
+    # test that direct accumulation gives the same net force and per-force energies
+    def test_direct(self):
+        if context.current.device.cpp_exec_conf.isCUDAEnabled():
+            init.read_snapshot(self.snap)
+            self.assertRaises(RuntimeError, md.integrate.mode_standard, dt=0.001, direct_net_force=True)
+            return
+
+        ref, ref_energy = self.run_forces(direct=False)
+        direct, energy = self.run_forces(direct=True)
+
+        for e, e_ref in zip(energy, ref_energy):
+            self.assertAlmostEqual(e, e_ref, places=3)
+        for (f_ref, e_ref), (f, e) in zip(ref, direct):
+            numpy.testing.assert_allclose(f, f_ref, rtol=1e-4, atol=1e-3)
+            self.assertAlmostEqual(e, e_ref, places=4)
+
+    # test that logged quantities are evaluated on request
+    def test_log(self):
+        if context.current.device.cpp_exec_conf.isCUDAEnabled():
+            return
+
+        init.read_snapshot(self.snap)
+        self.create_forces()
+        log = analyze.log(filename=None, quantities=['pair_lj_energy', 'bond_harmonic_energy', 'pressure'], period=1)
+        mode = md.integrate.mode_standard(dt=0.001)
+        mode.set_params(direct_net_force=True)
+        md.integrate.nve(group.all())
+        run(2)
+
+        self.assertNotEqual(log.query('pair_lj_energy'), 0.0)
+        self.assertNotEqual(log.query('bond_harmonic_energy'), 0.0)
+        self.assertNotEqual(log.query('pressure'), 0.0)
+
+    def tearDown(self):
+        context.initialize();
+
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
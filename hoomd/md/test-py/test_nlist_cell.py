@@ -46,6 +46,18 @@ class nlist_cell_tests (unittest.TestCase):
     def test_tune(self):
         self.nl.tune(warmup=100, r_min=0.1, r_max=0.25, jumps=10, steps=50)
 
+    # test that tuning picks one of the scanned values and leaves it set
+    def test_tune_choice(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        r_buff, check_period = self.nl.tune(warmup=20, r_min=0.1, r_max=0.4, jumps=4, steps=10, quiet=True)
+        self.assertTrue(min([abs(r_buff - (0.1 + i*0.1)) for i in range(4)]) < 1e-5)
+        self.assertAlmostEqual(self.nl.r_buff, r_buff, places=5)
+        self.assertFalse(self.nl.cpp_nlist.isRBuffTunerComplete())
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
@@ -3,15 +3,17 @@
 
 from hoomd import *
 from hoomd import md;
+from hoomd.md import _md
 context.initialize()
 import unittest
 import os
+import numpy
 
 # md.pair.dpd
 class pair_dpd_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
         self.nl = md.nlist.cell()
         context.current.sorter.set_params(grid=8)
 
@@ -39,8 +41,48 @@ class pair_dpd_tests (unittest.TestCase):
         dpd.update_coeffs();
         dpd.set_params(kT = 2.0);
 
+    # test that both particles of a pair draw the same random number with a full neighbor list
+    def test_momentum(self):
+        dpd = md.pair.dpd(r_cut=3.0, nlist = self.nl, kT=1.0, seed=10);
+        dpd.pair_coeff.set('A', 'A', A=1.0, gamma = 4.5, r_cut=2.5);
+        self.nl.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        run(1);
+
+        f = self.get_forces()
+        numpy.testing.assert_allclose(numpy.sum(f, axis=0), [0, 0, 0], atol=1e-3)
+        self.assertGreater(numpy.max(numpy.abs(f)), 0.0)
+
+        run(100);
+        p = numpy.sum([numpy.array(self.s.particles[i].velocity) * self.s.particles[i].mass
+                       for i in range(len(self.s.particles))], axis=0)
+        numpy.testing.assert_allclose(p, [0, 0, 0], atol=1e-3)
+
+    # test that the half and full neighbor lists give the same forces
+    def test_half_full(self):
+        snap = self.s.take_snapshot()
+        forces = []
+        for mode in [_md.NeighborList.storageMode.half, _md.NeighborList.storageMode.full]:
+            context.initialize()
+            self.s = init.read_snapshot(snap)
+            self.nl = md.nlist.cell()
+            dpd = md.pair.dpd(r_cut=3.0, nlist = self.nl, kT=1.0, seed=10);
+            dpd.pair_coeff.set('A', 'A', A=1.0, gamma = 4.5, r_cut=2.5);
+            self.nl.cpp_nlist.setStorageMode(mode);
+            md.integrate.mode_standard(dt=0.005);
+            md.integrate.nve(group.all());
+            run(1);
+            forces.append(self.get_forces())
+
+        numpy.testing.assert_allclose(forces[1], forces[0], rtol=1e-4, atol=1e-4)
+
+    def get_forces(self):
+        return numpy.array([self.s.particles[i].net_force for i in range(len(self.s.particles))])
+
     def tearDown(self):
         del self.nl
+        del self.s
         context.initialize();
 
 
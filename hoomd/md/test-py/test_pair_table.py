@@ -60,5 +60,48 @@ class pair_table_tests (unittest.TestCase):
         context.initialize();
 
 
+# md.pair.table with cubic interpolation
+class pair_table_cubic_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        snap = data.make_snapshot(N=2, box=data.boxdim(L=10))
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0, 0, 0)
+            snap.particles.position[1] = (1.2345, 0, 0)
+        self.s = init.read_snapshot(snap)
+        self.nl = md.nlist.cell()
+
+    # a coarse cubic table must reproduce the analytic potential closely
+    def test_accuracy(self):
+        if context.current.device.cpp_exec_conf.isCUDAEnabled():
+            self.assertRaises(RuntimeError, md.pair.table, width=30, nlist=self.nl, interpolation='cubic');
+            return
+
+        def lj(r, rmin, rmax, epsilon, sigma):
+            V = 4 * epsilon * ( (sigma / r)**12 - (sigma / r)**6);
+            F = 4 * epsilon / r * ( 12 * (sigma / r)**12 - 6 * (sigma / r)**6);
+            return (V, F)
+
+        table = md.pair.table(width=100, nlist=self.nl, interpolation='cubic');
+        table.pair_coeff.set('A', 'A', func=lj, rmin=0.9, rmax=3.0, coeff=dict(epsilon=1.0, sigma=1.0));
+
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group=group.all());
+        run(1);
+
+        V, F = lj(1.2345, 0.9, 3.0, 1.0, 1.0)
+        self.assertAlmostEqual(self.s.particles[0].net_energy, 0.5*V, places=5);
+        self.assertAlmostEqual(self.s.particles[0].net_force[0], -F, places=3);
+        self.assertAlmostEqual(self.s.particles[1].net_force[0], F, places=3);
+
+    # test invalid interpolation
+    def test_invalid(self):
+        self.assertRaises(ValueError, md.pair.table, width=30, nlist=self.nl, interpolation='quadratic');
+
+    def tearDown(self):
+        del self.s, self.nl
+        context.initialize();
+
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,58 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+context.initialize()
+import unittest
+import numpy
+
+# tests md.pair.tersoff
+class pair_tersoff_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        numpy.random.seed(10)
+        snap = data.make_snapshot(N=216, box=data.boxdim(L=9.0), particle_types=['A'])
+        if context.current.device.comm.rank == 0:
+            x = numpy.arange(6) * 1.5 - 4.5
+            pos = numpy.array([[a, b, c] for a in x for b in x for c in x])
+            snap.particles.position[:] = pos + 0.05 * (numpy.random.random(pos.shape) - 0.5)
+            snap.particles.velocity[:] = numpy.random.normal(0, 0.5, pos.shape)
+        self.snap = snap
+
+    def create_tersoff(self):
+        nl = md.nlist.cell(r_buff=0.3)
+        tersoff = md.pair.tersoff(r_cut=2.0, nlist=nl)
+        tersoff.pair_coeff.set('A', 'A', cutoff_thickness=0.3, C1=1.0, C2=1.0, lambda1=2.0, lambda2=1.0,
+                               dimer_r=1.5, n=1.0, gamma=0.5, lambda3=0.0, c=1.0, d=1.0, m=1.0, alpha=3.0)
+        return tersoff
+
+    def get_forces(self, s):
+        return numpy.array([s.particles[i].net_force for i in range(len(s.particles))])
+
+    # test that the cached short-ranged list is rebuilt after the particles are sorted in a later run
+    def test_rerun_sorted(self):
+        s = init.read_snapshot(self.snap)
+        context.current.sorter.set_period(2)
+        self.create_tersoff()
+        md.integrate.mode_standard(dt=0.002)
+        md.integrate.nve(group.all())
+        run(20)
+        run(20)
+        forces = self.get_forces(s)
+
+        # compute the forces of the final configuration from scratch
+        snap = s.take_snapshot()
+        context.initialize()
+        s = init.read_snapshot(snap)
+        self.create_tersoff()
+        md.integrate.mode_standard(dt=0.0)
+        md.integrate.nve(group.all())
+        run(1)
+        numpy.testing.assert_allclose(self.get_forces(s), forces, rtol=1e-5, atol=1e-5)
+
+    def tearDown(self):
+        context.initialize();
+
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -177,5 +177,55 @@ class wall_shift_tests (unittest.TestCase):
         del self.s
         context.initialize();
 
+# test that many sphere walls give the same forces as a direct evaluation
+class wall_sphere_tests (unittest.TestCase):
+    def setUp(self):
+        np.random.seed(10)
+        self.origins = [(-6.0 + 4.0*(k % 4), -6.0 + 4.0*((k // 4) % 4), -2.0 + 4.0*(k // 16)) for k in range(20)];
+        self.radii = [1.2 + 0.1*(k % 5) for k in range(20)];
+        self.inside = [k % 2 == 0 for k in range(20)];
+
+        snap = data.make_snapshot(N=500, box=data.boxdim(L=20))
+        self.pos = np.random.uniform(-9.0, 9.0, size=(500,3));
+        if context.current.device.comm.rank == 0:
+            snap.particles.position[:] = self.pos;
+        self.s = init.read_snapshot(snap)
+
+        self.walls = md.wall.group();
+        for o, r, ins in zip(self.origins, self.radii, self.inside):
+            self.walls.add_sphere(r=r, origin=o, inside=ins);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group.all());
+        lj_wall = md.wall.lj(self.walls, r_cut=1.5)
+        lj_wall.force_coeff.set('A', epsilon=1.0, sigma=0.5)
+        run(1)
+
+    def lj(self, r):
+        V = lambda x: 4.0 * ((0.5/x)**12 - (0.5/x)**6);
+        F = 4.0 / r * (12.0 * (0.5/r)**12 - 6.0 * (0.5/r)**6);
+        return V(r) - V(1.5), F
+
+    # compare forces and energies with a direct evaluation over all walls
+    def test_forces(self):
+        for i in range(len(self.pos)):
+            f_ref = np.zeros(3);
+            e_ref = 0.0;
+            for o, r, ins in zip(self.origins, self.radii, self.inside):
+                dx = self.pos[i] - np.array(o);
+                dist = np.linalg.norm(dx);
+                d = r - dist if ins else dist - r;
+                if d > 0 and d < 1.5:
+                    e, f = self.lj(d);
+                    n = -dx / dist if ins else dx / dist;
+                    f_ref += f * n;
+                    e_ref += e;
+
+            np.testing.assert_allclose(self.s.particles[i].net_force, f_ref, rtol=1e-4, atol=1e-4);
+            self.assertAlmostEqual(self.s.particles[i].net_energy, e_ref, places=4);
+
+    def tearDown(self):
+        del self.s
+        context.initialize();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
@@ -12,6 +12,10 @@ using namespace std;
 
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 /*! \file EAMForceCompute.cc
@@ -237,6 +241,10 @@ void EAMForceCompute::loadFile(char *filename, int type_of_file)
     interpolation(nr * m_ntypes * m_ntypes, nr, dr, &h_rho, &h_drho);
     interpolation((int) (0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, dr, &h_rphi, &h_drphi);
 
+    // Pack the coefficients for the CPU code path
+    packSplineTable(m_F_spline, nrho * m_ntypes, &h_F, &h_dF);
+    packSplineTable(m_rho_spline, nr * m_ntypes * m_ntypes, &h_rho, &h_drho);
+    packSplineTable(m_rphi_spline, (int) (0.5 * nr * (m_ntypes + 1) * m_ntypes), &h_rphi, &h_drphi);
     }
 
 /*! compute cubic interpolation coefficients
@@ -285,6 +293,33 @@ void EAMForceCompute::interpolation(int num_all, int num_per, Scalar delta, Arra
         }
     }
 
+/*! \param table Packed table to fill
+ \param num_all Total number of data points
+ \param f Interpolation coefficients of the function
+ \param df Interpolation coefficients of the derivative
+ */
+void EAMForceCompute::packSplineTable(GPUArray<EAMSplineInterval>& table, unsigned int num_all,
+        ArrayHandle<Scalar4> *f, ArrayHandle<Scalar4> *df)
+    {
+    GPUArray<EAMSplineInterval> t_table(num_all, m_exec_conf);
+    table.swap(t_table);
+    ArrayHandle<EAMSplineInterval> h_table(table, access_location::host, access_mode::overwrite);
+
+    for (unsigned int m = 0; m < num_all; m++)
+        {
+        EAMSplineInterval s;
+        s.f[0] = f->data[m].w;
+        s.f[1] = f->data[m].z;
+        s.f[2] = f->data[m].y;
+        s.f[3] = f->data[m].x;
+        s.df[0] = df->data[m].z;
+        s.df[1] = df->data[m].y;
+        s.df[2] = df->data[m].x;
+        s.df[3] = 0.0;
+        h_table.data[m] = s;
+        }
+    }
+
 std::vector<std::string> EAMForceCompute::getProvidedLogQuantities()
     {
     vector < string > list;
@@ -336,30 +371,17 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     unsigned int virial_pitch = m_virial.getPitch();
 
     // access potential table
-    ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
-
-    // index and remainder
-    Scalar position;  // look up position, scalar
-    unsigned int int_position;  // look up index for position, integer
-    unsigned int idxs; // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;  // look up remainder in array, integer
-    Scalar4 v, dv;  // value, d(value)
+    ArrayHandle<EAMSplineInterval> h_F(m_F_spline, access_location::host, access_mode::read);
+    ArrayHandle<EAMSplineInterval> h_rho(m_rho_spline, access_location::host, access_mode::read);
+    ArrayHandle<EAMSplineInterval> h_rphi(m_rphi_spline, access_location::host, access_mode::read);
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
     assert(h_F.data);
-    assert(h_dF.data);
     assert(h_rho.data);
-    assert(h_drho.data);
     assert(h_rphi.data);
-    assert(h_drphi.data);
 
     // Zero data for force calculation.
     memset((void *) h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -371,210 +393,218 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
-    // sum up the number of forces calculated
-    int64_t n_calc = 0;
-
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
-    unsigned int ntypes = m_pdata->getNTypes();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int ntypes = m_pdata->getNTypes();
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // parameters for each particle, reallocated only when the number of particles grows
+    if (m_density.getNumElements() < N)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int) h_n_neigh.data[i];
+        GPUArray<Scalar> t_density(N, m_exec_conf);
+        m_density.swap(t_density);
+        GPUArray<Scalar> t_dFdP(N, m_exec_conf);
+        m_dFdP.swap(t_dFdP);
+        }
+    ArrayHandle<Scalar> h_density(m_density, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::overwrite);
+    memset((void *) h_density.data, 0, sizeof(Scalar) * N);
 
-        for (unsigned int j = 0; j < size; j++)
+    // first pass: electron density P = sum{rho}
+    auto density_pass = [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int i = begin; i < end; i++)
             {
-            // increment our calculation counter
-            n_calc++;
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
 
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
-
-            // calculate dr
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            assert(typei < ntypes);
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+            Scalar density_i = 0.0;
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int) h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int) position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                        + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
-                if (third_law)
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N);
+
+                // calculate dr and apply periodic boundary conditions
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = box.minImage(pi - pk);
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                // only compute the density if the particles are closer than the cut-off
+                Scalar rsq = dot(dx, dx);
+                if (rsq < r_cut_sq)
                     {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                            + v.x * remainder * remainder * remainder;
+                    // calculate position r for rho(r)
+                    Scalar position = sqrt(rsq) * rdr;
+                    unsigned int int_position = min((unsigned int) position, nr - 1);
+                    Scalar remainder = position - int_position;
+
+                    density_i += h_rho.data[int_position + nr * (typej * ntypes + typei)].value(remainder);
+
+                    // if third_law, pair it
+                    if (third_law)
+                        h_density.data[k] += h_rho.data[int_position + nr * (typei * ntypes + typej)].value(remainder);
                     }
                 }
+
+            h_density.data[i] += density_i;
             }
-        }
+        };
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // embedding function F(P) and its derivative
+    auto embedding_pass = [&](unsigned int begin, unsigned int end)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int) position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                + v.x * remainder * remainder * remainder;
-
-        }
+        for (unsigned int i = begin; i < end; i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            Scalar position = h_density.data[i] * rdrho;
+            unsigned int int_position = min((unsigned int) position, nrho - 1);
+            Scalar remainder = position - int_position;
+
+            const EAMSplineInterval& F = h_F.data[int_position + typei * nrho];
+            // compute dF / dP
+            h_dFdP.data[i] = F.derivative(remainder);
+            // compute embedded energy F(P), sum up each particle
+            h_force.data[i].w += F.value(remainder);
+            }
+        };
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // second pass: forces
+    auto force_pass = [&](unsigned int begin, unsigned int end)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar fxi = 0.0;
-        Scalar fyi = 0.0;
-        Scalar fzi = 0.0;
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int) h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+        for (unsigned int i = begin; i < end; i++)
             {
-            // increment our calculation counter
-            n_calc++;
-
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
             // sanity check
-            assert(k < m_pdata->getN());
-
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
-
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int) position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift =
-                    (typei >= typej) ?
-                            (int) (0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr :
-                            (int) (0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                    + v.x * remainder * remainder * remainder) * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                    + atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
-            // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
-            viriali[0] += dx.x * dx.x * pairForce;
-            viriali[1] += dx.x * dx.y * pairForce;
-            viriali[2] += dx.x * dx.z * pairForce;
-            viriali[3] += dx.y * dx.y * pairForce;
-            viriali[4] += dx.y * dx.z * pairForce;
-            viriali[5] += dx.z * dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
-
-            if (third_law)
+            assert(typei < ntypes);
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar fxi = 0.0;
+            Scalar fyi = 0.0;
+            Scalar fzi = 0.0;
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (int k = 0; k < 6; k++)
+                viriali[k] = 0.0;
+
+            const Scalar dFdP_i = h_dFdP.data[i];
+
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int) h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N);
+
+                // calculate \Delta r and apply periodic boundary conditions
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = box.minImage(pi - pk);
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
+
+                // calculate position r for phi(r)
+                if (rsq >= r_cut_sq)
+                    continue;
+                Scalar r = sqrt(rsq);
+                Scalar inverseR = 1.0 / r;
+                Scalar position = r * rdr;
+                unsigned int int_position = min((unsigned int) position, nr - 1);
+                Scalar remainder = position - int_position;
+                // calculate the shift position for type ij
+                int shift =
+                        (typei >= typej) ?
+                                (int) (0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr :
+                                (int) (0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
+
+                const EAMSplineInterval& rphi = h_rphi.data[int_position + shift];
+                // pair_eng = phi
+                Scalar pair_eng = rphi.value(remainder) * inverseR;
+                // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+                Scalar derivativePhi = (rphi.derivative(remainder) - pair_eng) * inverseR;
+                // derivativeRhoI = drho / dr of i
+                Scalar derivativeRhoI =
+                        h_rho.data[int_position + typei * ntypes * nr + typej * nr].derivative(remainder);
+                // derivativeRhoJ = drho / dr of j
+                Scalar derivativeRhoJ =
+                        h_rho.data[int_position + typej * ntypes * nr + typei * nr].derivative(remainder);
+                // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
+                Scalar fullDerivativePhi = dFdP_i * derivativeRhoJ + h_dFdP.data[k] * derivativeRhoI + derivativePhi;
+                // compute forces
+                Scalar pairForce = -fullDerivativePhi * inverseR;
+                viriali[0] += dx.x * dx.x * pairForce;
+                viriali[1] += dx.x * dx.y * pairForce;
+                viriali[2] += dx.x * dx.z * pairForce;
+                viriali[3] += dx.y * dx.y * pairForce;
+                viriali[4] += dx.y * dx.z * pairForce;
+                viriali[5] += dx.z * dx.z * pairForce;
+                fxi += dx.x * pairForce;
+                fyi += dx.y * pairForce;
+                fzi += dx.z * pairForce;
+                pei += pair_eng * 0.5;
+
+                if (third_law)
+                    {
+                    h_force.data[k].x -= dx.x * pairForce;
+                    h_force.data[k].y -= dx.y * pairForce;
+                    h_force.data[k].z -= dx.z * pairForce;
+                    h_force.data[k].w += pair_eng * 0.5;
+                    }
                 }
+            h_force.data[i].x += fxi;
+            h_force.data[i].y += fyi;
+            h_force.data[i].z += fzi;
+            h_force.data[i].w += pei;
+            for (int k = 0; k < 6; k++)
+                h_virial.data[k * virial_pitch + i] += viriali[k];
             }
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_force.data[i].w += pei;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k * virial_pitch + i] += viriali[k];
+        };
+
+    #ifdef ENABLE_TBB
+    if (!third_law)
+        {
+        // every particle only writes to its own entries, run the passes in parallel
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r) { density_pass(r.begin(), r.end()); });
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r) { embedding_pass(r.begin(), r.end()); });
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r) { force_pass(r.begin(), r.end()); });
         }
+    else
+    #endif
+        {
+        density_pass(0, N);
+        embedding_pass(0, N);
+        force_pass(0, N);
+        }
+
+    // sum up the number of forces calculated
+    int64_t n_calc = 0;
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += 2 * h_n_neigh.data[i];
 
     int64_t flops = m_pdata->getN() * 5 + n_calc * (3 + 5 + 9 + 1 + 9 + 6 + 8);
     if (third_law)
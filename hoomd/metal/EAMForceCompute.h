@@ -22,6 +22,28 @@
 #ifndef __EAMFORCECOMPUTE_H__
 #define __EAMFORCECOMPUTE_H__
 
+//! Cubic spline coefficients of a tabulated function and of its derivative on a single interval
+/*! Both polynomials are stored in one record, so that a lookup of the value and the derivative touches
+    a single contiguous block of memory.
+ */
+struct EAMSplineInterval
+    {
+    Scalar f[4];   //!< Coefficients of the function, f[0] + f[1] x + f[2] x^2 + f[3] x^3
+    Scalar df[4];  //!< Coefficients of the derivative, df[0] + df[1] x + df[2] x^2 (df[3] is padding)
+
+    //! Evaluate the function at fractional position x within the interval
+    inline Scalar value(Scalar x) const
+        {
+        return f[0] + x * (f[1] + x * (f[2] + x * f[3]));
+        }
+
+    //! Evaluate the derivative at fractional position x within the interval
+    inline Scalar derivative(Scalar x) const
+        {
+        return df[0] + x * (df[1] + x * df[2]);
+        }
+    };
+
 //! Computes the potential and force on each particle based on values given in a EAM potential
 /*! \b Overview
  The total potential and force is computed for each particle when compute() is called. Potentials and
@@ -42,6 +64,15 @@
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ For the CPU code path, the coefficients of every function and its derivative are additionally packed into
+ one EAMSplineInterval record per data point (m_F_spline, m_rho_spline, m_rphi_spline).
+
+ \b Parallelization
+ The force is computed in two passes, the first pass accumulates the electron density and evaluates the
+ derivative of the embedding function of every particle, the second pass computes the forces. With a full
+ neighbor list, each particle only writes to its own entries and both passes are parallelized over particles
+ with TBB. With a half neighbor list, the passes are executed serially.
+
  \ingroup computes
  */
 class EAMForceCompute: public ForceCompute
@@ -92,6 +123,11 @@ protected:
     GPUArray<Scalar4> m_drho;              //!< derivative electron density and its coefficients
     GPUArray<Scalar4> m_drphi;             //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;               //!< derivative F / derivative P
+    GPUArray<Scalar> m_density;            //!< electron density of every particle
+
+    GPUArray<EAMSplineInterval> m_F_spline;    //!< packed coefficients of the embedded function
+    GPUArray<EAMSplineInterval> m_rho_spline;  //!< packed coefficients of the electron density
+    GPUArray<EAMSplineInterval> m_rphi_spline; //!< packed coefficients of the pair wise function
 
     //! Actually compute the forces
     virtual void computeForces(unsigned int timestep);
@@ -106,6 +142,10 @@ protected:
     //! cubic interpolation
     virtual void interpolation(int num_all, int num_per, Scalar delta, ArrayHandle<Scalar4> *f,
             ArrayHandle<Scalar4> *df);
+
+    //! Pack the interpolation coefficients of a function and its derivative into one record per interval
+    void packSplineTable(GPUArray<EAMSplineInterval>& table, unsigned int num_all, ArrayHandle<Scalar4> *f,
+            ArrayHandle<Scalar4> *df);
     };
 
 //! Exports the EAMForceCompute class to python
@@ -87,7 +87,8 @@ class eam(force._force):
 
         #Load neighbor list to compute.
         self.cpp_force.set_neighbor_list(self.nlist.cpp_nlist);
-        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+        # a full neighbor list is required on the GPU, and allows the threaded CPU code path
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled() or hoomd.context.current.device.cpp_exec_conf.getNumThreads() > 1:
             self.nlist.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
 
         hoomd.context.current.device.cpp_msg.notice(2, "Set r_cut = " + str(self.r_cut_new) + " from potential`s file '" +  str(file) + "'.\n");
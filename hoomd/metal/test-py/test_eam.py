@@ -71,6 +71,33 @@ class eam_tests(unittest.TestCase):
 
         os.system('rm -rf ' + tmpd)
 
+    # Unit test: the full neighbor list (parallel) code path reproduces the reference forces
+    def test_force_full_nlist(self):
+        cwd = os.getcwd()
+        tmpd = cwd + '/eamtemp/'
+        potf = tmpd + 'testpot'
+        nl = md.nlist.cell()
+        eam = metal.pair.eam(file=potf, type="Alloy", nlist=nl)
+        nl.cpp_nlist.setStorageMode(md._md.NeighborList.storageMode.full)
+        all = group.all()
+        md.integrate.mode_standard(dt=0.2)
+        md.integrate.nve(group=all)
+        run(1)
+
+        F = numpy.array([x.force for x in eam.forces])
+        U = numpy.array([x.energy for x in eam.forces])
+
+        F_ref = numpy.array([[0.49554526, 1.10342697, -2.7692858],
+                             [0.70281927, -1.43558566, 3.87260803],
+                             [-2.00473055, 1.53052375, -0.60778632],
+                             [0.80636601, -1.19836506, -0.49553591]])
+        U_ref = numpy.array([-0.93424631, -1.23440579, -1.71025268, -1.4023109])
+
+        numpy.testing.assert_allclose(F, F_ref, rtol=1e-5)
+        numpy.testing.assert_allclose(U, U_ref, rtol=1e-6)
+
+        os.system('rm -rf ' + tmpd)
+
     # tearDown is called at the end of every test method
     def tearDown(self):
         context.initialize()
@@ -13,6 +13,7 @@
 #include "Initializers.h"
 #include "GetarInitializer.h"
 #include "GSDReader.h"
+#include "CheckpointReader.h"
 #include "Compute.h"
 #include "ComputeThermo.h"
 #include "ComputeThermoHMA.h"
@@ -26,8 +27,10 @@
 #include "DCDDumpWriter.h"
 #include "GetarDumpWriter.h"
 #include "GSDDumpWriter.h"
+#include "CheckpointWriter.h"
 #include "Logger.h"
 #include "LogPlainTXT.h"
+#include "LogBinary.h"
 #include "LogMatrix.h"
 #include "LogHDF5.h"
 #include "CallbackAnalyzer.h"
@@ -333,6 +336,7 @@ PYBIND11_MODULE(_hoomd, m)
 
     // initializers
     export_GSDReader(m);
+    export_CheckpointReader(m);
     getardump::export_GetarInitializer(m);
 
     // computes
@@ -357,8 +361,10 @@ PYBIND11_MODULE(_hoomd, m)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_CheckpointWriter(m);
     export_Logger(m);
     export_LogPlainTXT(m);
+    export_LogBinary(m);
     export_LogMatrix(m);
     export_LogHDF5(m);
     export_CallbackAnalyzer(m);
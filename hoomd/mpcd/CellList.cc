@@ -10,6 +10,10 @@
 #include "hoomd/Communicator.h"
 #endif // ENABLE_MPI
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*!
  * \file mpcd/CellList.cc
  * \brief Definition of mpcd::CellList
@@ -534,7 +538,22 @@ void mpcd::CellList::buildCellList()
 
     const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
 
+    // The cell list is built as a counting sort. First, every particle is binned independently and its bin is stashed.
+    // Invalid particles are flagged in the scratch array and only raise the error conditions.
+    const unsigned int invalid_bin = 0xffffffff;
+    if (m_bin_scratch.size() < N_tot)
+        m_bin_scratch.resize(N_tot);
+    unsigned int *bins = m_bin_scratch.data();
+
+    #ifdef ENABLE_TBB
+    const uint2 bad = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, N_tot),
+        make_uint2(0,0),
+        [&](const tbb::blocked_range<unsigned int>& r, uint2 bad)->uint2 {
+        for (unsigned int cur_p = r.begin(); cur_p != r.end(); ++cur_p)
+    #else
+    uint2 bad = make_uint2(0,0);
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+    #endif
         {
         Scalar4 postype_i;
         if (cur_p < N_mpcd)
@@ -549,7 +568,8 @@ void mpcd::CellList::buildCellList()
 
         if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
             {
-            conditions.y = cur_p + 1;
+            bad.x = std::max(bad.x, cur_p + 1);
+            bins[cur_p] = invalid_bin;
             continue;
             }
 
@@ -594,30 +614,49 @@ void mpcd::CellList::buildCellList()
             (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
             (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
             {
-            conditions.z = cur_p + 1;
+            bad.y = std::max(bad.y, cur_p + 1);
+            bins[cur_p] = invalid_bin;
             continue;
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
-        unsigned int offset = h_cell_np.data[bin_idx];
-        if (offset < m_cell_np_max)
+        const unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
+        bins[cur_p] = bin_idx;
+
+        // stash the current particle bin into the velocity array
+        if (cur_p < N_mpcd)
             {
-            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
+            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
             }
         else
             {
-            // overflow
-            conditions.x = std::max(conditions.x, offset+1);
+            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
             }
+        }
+    #ifdef ENABLE_TBB
+        return bad;
+        },
+        [](uint2 a, uint2 b)->uint2 { return make_uint2(std::max(a.x, b.x), std::max(a.y, b.y)); });
+    #endif
+    conditions.y = bad.x;
+    conditions.z = bad.y;
+
+    // Then, the particles are scattered into their cells in order, so the cell list does not depend on the number
+    // of threads.
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        {
+        const unsigned int bin_idx = bins[cur_p];
+        if (bin_idx == invalid_bin)
+            continue;
 
-        // stash the current particle bin into the velocity array
-        if (cur_p < N_mpcd)
+        unsigned int offset = h_cell_np.data[bin_idx];
+        if (offset < m_cell_np_max)
             {
-            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
             }
         else
             {
-            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
+            // overflow
+            conditions.x = std::max(conditions.x, offset+1);
             }
 
         // increment the counter always
@@ -26,6 +26,7 @@
 #include <pybind11/pybind11.h>
 
 #include <array>
+#include <vector>
 
 namespace mpcd
 {
@@ -258,6 +259,7 @@ class PYBIND11_EXPORT CellList : public Compute
         GPUVector<unsigned int> m_cell_list;        //!< Cell list of particles
         GPUVector<unsigned int> m_embed_cell_ids;   //!< Cell ids of the embedded particles
         GPUFlags<uint3> m_conditions;               //!< Detect conditions that might fail building cell list
+        std::vector<unsigned int> m_bin_scratch;    //!< Bin of each particle while building the cell list
 
         int3 m_origin_idx;                  //!< Origin as a global index
 
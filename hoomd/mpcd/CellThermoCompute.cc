@@ -11,6 +11,10 @@
 #include "CellThermoCompute.h"
 #include "ReductionOperators.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*!
  * \param sysdata MPCD system data
  * \param suffix Suffix for logged quantities
@@ -213,6 +217,32 @@ struct CellPropertySum
     const unsigned int *embed_idx;  //!< Embedded particle indexes
     const unsigned int N_mpcd;      //!< Number of MPCD particles
     };
+
+//! Partial sums of the net cell properties
+struct NetCellSum
+    {
+    NetCellSum()
+        : momentum(make_double3(0,0,0)), energy(0.0), temp(0.0), n_temp_cells(0)
+        { }
+
+    //! Combine two partial sums
+    NetCellSum operator+(const NetCellSum& other) const
+        {
+        NetCellSum sum;
+        sum.momentum = make_double3(momentum.x + other.momentum.x,
+                                    momentum.y + other.momentum.y,
+                                    momentum.z + other.momentum.z);
+        sum.energy = energy + other.energy;
+        sum.temp = temp + other.temp;
+        sum.n_temp_cells = n_temp_cells + other.n_temp_cells;
+        return sum;
+        }
+
+    double3 momentum;           //!< Net momentum
+    double energy;              //!< Net kinetic energy
+    double temp;                //!< Sum of cell temperatures
+    unsigned int n_temp_cells;  //!< Number of cells with a defined temperature
+    };
 } // end namespace detail
 } // end namespace mpcd
 
@@ -364,42 +394,53 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         }
 
     // iterate over all of the inner cells and compute average velocity, energy, temperature
+    // each cell only reads its own members, so the cells are flattened and processed independently
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int k=lo.z; k < hi.z; ++k)
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    const Index3D inner_ci(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z);
+    const unsigned int n_inner = inner_ci.getNumElements();
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_inner),
+        [&](const tbb::blocked_range<unsigned int>& r)
         {
-        for (unsigned int j=lo.y; j < hi.y; ++j)
-            {
-            for (unsigned int i=lo.x; i < hi.x; ++i)
-                {
-                const unsigned int cur_cell = ci(i,j,k);
+        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+    #else
+    for (unsigned int idx = 0; idx < n_inner; ++idx)
+    #endif
+        {
+        const unsigned int i = lo.x + idx % inner_ci.getW();
+        const unsigned int j = lo.y + (idx / inner_ci.getW()) % inner_ci.getH();
+        const unsigned int k = lo.z + idx / (inner_ci.getW() * inner_ci.getH());
+        const unsigned int cur_cell = ci(i,j,k);
 
-                // compute the cell properties
-                double4 momentum; double ke(0.0); unsigned int np(0);
-                summer.compute(momentum, ke, np, cur_cell, need_energy);
+        // compute the cell properties
+        double4 momentum; double ke(0.0); unsigned int np(0);
+        summer.compute(momentum, ke, np, cur_cell, need_energy);
 
-                const double mass = momentum.w;
-                double3 vel_cm = make_double3(0.0,0.0,0.0);
-                if (mass > 0.)
-                    {
-                    vel_cm.x = momentum.x / mass;
-                    vel_cm.y = momentum.y / mass;
-                    vel_cm.z = momentum.z / mass;
-                    }
+        const double mass = momentum.w;
+        double3 vel_cm = make_double3(0.0,0.0,0.0);
+        if (mass > 0.)
+            {
+            vel_cm.x = momentum.x / mass;
+            vel_cm.y = momentum.y / mass;
+            vel_cm.z = momentum.z / mass;
+            }
 
-                h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
-                if (need_energy)
-                    {
-                    double temp(0.0);
-                    if (np > 1)
-                        {
-                        const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
-                        temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np-1));
-                        }
-                    h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
-                    }
-                } // i
-            } //j
-        } // k
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+        if (need_energy)
+            {
+            double temp(0.0);
+            if (np > 1)
+                {
+                const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (ndim * (np-1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        }
+    #ifdef ENABLE_TBB
+        });
+    #endif
     }
 
 void mpcd::CellThermoCompute::computeNetProperties()
@@ -426,38 +467,53 @@ void mpcd::CellThermoCompute::computeNetProperties()
 
         const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
 
-        double3 net_momentum = make_double3(0,0,0);
-        double energy(0.0), temp(0.0);
-        for (unsigned int k=0; k < upper.z; ++k)
+        // sum over the unique cells, each thread accumulating into its own partial sums
+        const Index3D upper_ci(upper.x, upper.y, upper.z);
+        const unsigned int n_cells = upper_ci.getNumElements();
+        #ifdef ENABLE_TBB
+        const mpcd::detail::NetCellSum net = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_cells),
+            mpcd::detail::NetCellSum(),
+            [&](const tbb::blocked_range<unsigned int>& r, mpcd::detail::NetCellSum net)->mpcd::detail::NetCellSum {
+            for (unsigned int cur = r.begin(); cur != r.end(); ++cur)
+        #else
+        mpcd::detail::NetCellSum net;
+        for (unsigned int cur = 0; cur < n_cells; ++cur)
+        #endif
             {
-            for (unsigned int j=0; j < upper.y; ++j)
+            const unsigned int i = cur % upper_ci.getW();
+            const unsigned int j = (cur / upper_ci.getW()) % upper_ci.getH();
+            const unsigned int k = cur / (upper_ci.getW() * upper_ci.getH());
+            const unsigned int idx = ci(i,j,k);
+
+            const double4 cell_vel_mass = h_cell_vel.data[idx];
+            const double3 cell_vel = make_double3(cell_vel_mass.x, cell_vel_mass.y, cell_vel_mass.z);
+            const double cell_mass = cell_vel_mass.w;
+
+            net.momentum.x += cell_mass * cell_vel.x;
+            net.momentum.y += cell_mass * cell_vel.y;
+            net.momentum.z += cell_mass * cell_vel.z;
+
+            if (need_energy)
                 {
-                for (unsigned int i=0; i < upper.x; ++i)
+                const double3 cell_energy = h_cell_energy.data[idx];
+                net.energy += cell_energy.x;
+
+                if (__double_as_int(cell_energy.z) > 1)
                     {
-                    const unsigned int idx = ci(i,j,k);
-
-                    const double4 cell_vel_mass = h_cell_vel.data[idx];
-                    const double3 cell_vel = make_double3(cell_vel_mass.x, cell_vel_mass.y, cell_vel_mass.z);
-                    const double cell_mass = cell_vel_mass.w;
-
-                    net_momentum.x += cell_mass * cell_vel.x;
-                    net_momentum.y += cell_mass * cell_vel.y;
-                    net_momentum.z += cell_mass * cell_vel.z;
-
-                    if (need_energy)
-                        {
-                        const double3 cell_energy = h_cell_energy.data[idx];
-                        energy += cell_energy.x;
-
-                        if (__double_as_int(cell_energy.z) > 1)
-                            {
-                            temp += cell_energy.y;
-                            ++n_temp_cells;
-                            }
-                        }
+                    net.temp += cell_energy.y;
+                    ++net.n_temp_cells;
                     }
                 }
             }
+        #ifdef ENABLE_TBB
+            return net;
+            },
+            [](const mpcd::detail::NetCellSum& a, const mpcd::detail::NetCellSum& b) { return a + b; });
+        #endif
+        const double3 net_momentum = net.momentum;
+        const double energy = net.energy;
+        const double temp = net.temp;
+        n_temp_cells = net.n_temp_cells;
 
         ArrayHandle<double> h_net_properties(m_net_properties, access_location::host, access_mode::overwrite);
         h_net_properties.data[mpcd::detail::thermo_index::momentum_x] = net_momentum.x;
@@ -99,7 +99,7 @@ void mpcd::Integrator::update(unsigned int timestep)
         m_collide->collide(timestep);
 
     // perform the first MD integration step
-    if (m_prof) m_prof->push("Integrate");
+    if (m_prof) m_prof->push(m_prof_integrate);
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepOne(timestep);
     if (m_prof) m_prof->pop();
@@ -131,7 +131,7 @@ void mpcd::Integrator::update(unsigned int timestep)
         computeNetForce(timestep+1);
 
     // perform the second step of the MD integration
-    if (m_prof) m_prof->push("Integrate");
+    if (m_prof) m_prof->push(m_prof_integrate);
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepTwo(timestep);
     if (m_prof) m_prof->pop();
@@ -0,0 +1,93 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+import hoomd;
+import unittest
+import os
+import numpy
+import shutil
+import tempfile
+
+# unit tests for dump.checkpoint and init.read_checkpoint
+class checkpoint_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+
+        # all ranks write into the same directory
+        self.dirname = os.path.join(tempfile.gettempdir(), 'test_checkpoint');
+        if context.current.device.comm.rank == 0 and os.path.exists(self.dirname):
+            shutil.rmtree(self.dirname);
+        context.current.device.comm.barrier_all();
+
+        self.snapshot = data.make_snapshot(N=4, box=data.boxdim(Lx=10, Ly=20, Lz=30, xy=0.1), bond_types=['bondA'],
+                                           particle_types=['A', 'B'], dtype='double');
+        if context.current.device.comm.rank == 0:
+            self.snapshot.particles.position[:] = [[0,1,2], [1,2,3], [0,-1,-2], [-1,-2,-3]];
+            self.snapshot.particles.velocity[:] = [[10,11,12], [11,12,13], [12,13,14], [13,14,15]];
+            self.snapshot.particles.typeid[:] = [0, 1, 1, 0];
+            self.snapshot.particles.mass[:] = [1, 2, 3, 4];
+            self.snapshot.particles.charge[:] = [-1, 0, 1, 2];
+            self.snapshot.particles.diameter[:] = [0.5, 1.0, 1.5, 2.0];
+            self.snapshot.particles.body[:] = [-1, -1, 1, 1];
+            self.snapshot.particles.image[:] = [[1,2,3], [-1,0,1], [0,0,0], [5,-5,2]];
+            self.snapshot.particles.orientation[:] = [[1,0,0,0], [0,1,0,0], [0,0,1,0], [0,0,0,1]];
+            self.snapshot.particles.angmom[:] = [[0,1,2,3], [1,2,3,4], [2,3,4,5], [3,4,5,6]];
+            self.snapshot.particles.moment_inertia[:] = [[1,2,3], [2,3,4], [3,4,5], [4,5,6]];
+
+            self.snapshot.bonds.resize(2);
+            self.snapshot.bonds.group[:] = [[0, 1], [2, 3]];
+
+        init.read_snapshot(self.snapshot);
+
+    # tests that a checkpoint restores the system exactly
+    def test_write_read(self):
+        run(10);
+        dump.checkpoint(filename=self.dirname, period=None);
+
+        context.initialize();
+        system = init.read_checkpoint(self.dirname);
+        self.assertEqual(get_step(), 10);
+
+        snap = system.take_snapshot(all=True, dtype='double');
+        if context.current.device.comm.rank == 0:
+            self.assertEqual(snap.particles.N, 4);
+            self.assertEqual(snap.particles.types, ['A', 'B']);
+            self.assertAlmostEqual(snap.box.xy, 0.1);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+
+            self.assertEqual(snap.bonds.N, 2);
+            self.assertEqual(snap.bonds.types, ['bondA']);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
+    # tests that a later checkpoint replaces the earlier one
+    def test_periodic(self):
+        dump.checkpoint(filename=self.dirname, period=10, phase=0);
+        run(25);
+
+        context.initialize();
+        init.read_checkpoint(self.dirname);
+        self.assertEqual(get_step(), 20);
+
+    # tests that reading a missing checkpoint fails
+    def test_missing(self):
+        context.initialize();
+        self.assertRaises(RuntimeError, init.read_checkpoint, self.dirname);
+
+    def tearDown(self):
+        context.current.device.comm.barrier_all();
+        if context.current.device.comm.rank == 0 and os.path.exists(self.dirname):
+            shutil.rmtree(self.dirname);
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -164,6 +164,37 @@ class decomposition_tests (unittest.TestCase):
             self.assertAlmostEquals(dd.getCumulativeFractions(2)[0], 0.0)
             self.assertAlmostEquals(dd.getCumulativeFractions(2)[1], 1.0)
 
+    ## Test that the cut planes balance the particles of a snapshot
+    def test_particle_balance(self):
+        if context.current.device.comm.num_ranks == 8:
+            box = data.boxdim(L=10)
+            boxdim = box._getBoxDim()
+
+            # a cube of particles off the center of the box
+            snap = data.make_snapshot(N=1000, box=box)
+            if context.current.device.comm.rank == 0:
+                for i in range(10):
+                    for j in range(10):
+                        for k in range(10):
+                            snap.particles.position[100*i+10*j+k] = (1.0+0.3*i, 1.0+0.3*j, 1.0+0.3*k)
+
+            comm.decomposition(balance=True)
+            dd = hoomd.context.current.decomposition._make_cpp_decomposition(boxdim, snap)
+
+            # a 2x2x2 grid cuts through the middle of the cube
+            for dir in range(3):
+                self.assertEqual(len(dd.getCumulativeFractions(dir)), 3)
+                self.assertAlmostEqual(dd.getCumulativeFractions(dir)[1], 0.735, 5)
+
+            # the minimum width pushes the cut planes away from the cube
+            comm.decomposition(balance=True, min_width=4.5)
+            dd = hoomd.context.current.decomposition._make_cpp_decomposition(boxdim, snap)
+            for dir in range(3):
+                self.assertAlmostEqual(dd.getCumulativeFractions(dir)[1], 0.55, 5)
+
+            with self.assertRaises(RuntimeError):
+                comm.decomposition(x=0.3, balance=True)
+
     ## Test that balancing fails after initialization
     def test_wrong_order(self):
         init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
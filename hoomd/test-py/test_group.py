@@ -214,6 +214,33 @@ class pair_group_tests (unittest.TestCase):
         tags = [(x.tag) for x in B]
         self.assertEqual(tags, [1, 2, 6, 8, 9, 10])
 
+    def test_many_groups(self):
+        # more groups than fit in one word of the membership masks
+        groups = [group.tags(i % 11) for i in range(70)]
+        B = group.type(type='B')
+        tags = [(x.tag) for x in B]
+        self.assertEqual(tags, [1, 2, 5, 8, 9, 10])
+
+        for p in self.s.particles:
+            p.mass = p.tag + 1
+
+        # the total mass sums over the local member indices
+        self.assertAlmostEqual(B.cpp_group.getTotalMass(), 41)
+        self.assertAlmostEqual(groups[69].cpp_group.getTotalMass(), 4)
+
+        # sort the particles
+        run(1)
+        self.assertAlmostEqual(B.cpp_group.getTotalMass(), 41)
+        self.assertAlmostEqual(groups[69].cpp_group.getTotalMass(), 4)
+
+        # groups created after others were deleted reuse their slots
+        del groups
+        gc.collect()
+        A = group.type(type='A')
+        run(1)
+        self.assertAlmostEqual(A.cpp_group.getTotalMass(), 25)
+        self.assertAlmostEqual(B.cpp_group.getTotalMass(), 41)
+
     def tearDown(self):
         del self.s
         context.initialize();
@@ -437,11 +437,106 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file, frame=-1);
 
+    # tests init.read_gsd with every rank reading its own particles
+    def test_read_gsd_distributed(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, frame=-1, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if context.current.device.comm.rank == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            self.assertEqual(snap.angles.N, self.snapshot.angles.N);
+            numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
+    # tests dump.gsd with every rank writing its own particles
+    def test_dump_gsd_distributed(self):
+        # all ranks open the file, so they need the same name
+        fname = os.path.join(tempfile.gettempdir(), 'test_dump_gsd_distributed.gsd');
+        dump.gsd(filename=fname, group=group.all(), period=None, overwrite=True, distributed=True,
+                 dynamic=['attribute', 'momentum', 'topology']);
+
+        snap = data.gsd_snapshot(fname, frame=0);
+        if context.current.device.comm.rank == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            os.remove(fname);
+
     def tearDown(self):
         if context.current.device.comm.rank == 0:
             os.remove(self.tmp_file);
         context.current.device.comm.barrier_all();
 
+# unit tests for dump.gsd with every rank writing the rows of chunks larger than the gsd write buffer
+class gsd_distributed_large_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+
+        # position and velocity chunks exceed half of the 16 MiB gsd write buffer and are written in place,
+        # the single column chunks are gathered on the root rank
+        N = 720000;
+        L = 120.0;
+        self.snapshot = data.make_snapshot(N=N, box=data.boxdim(L=L), particle_types=['A', 'B'], dtype='float');
+        if context.current.device.comm.rank == 0:
+            numpy.random.seed(36);
+            self.snapshot.particles.position[:] = numpy.random.uniform(-L/2, L/2, size=(N, 3));
+            self.snapshot.particles.velocity[:] = numpy.random.normal(size=(N, 3));
+            self.snapshot.particles.typeid[:] = numpy.random.randint(0, 2, size=N);
+            self.snapshot.particles.mass[:] = numpy.random.uniform(0.5, 1.5, size=N);
+
+        init.read_snapshot(self.snapshot);
+
+    # tests that a frame written in place reads back as the snapshot
+    def test_dump_gsd_distributed_in_place(self):
+        # all ranks open the file, so they need the same name
+        fname = os.path.join(tempfile.gettempdir(), 'test_dump_gsd_distributed_in_place.gsd');
+        dump.gsd(filename=fname, group=group.all(), period=None, overwrite=True, distributed=True,
+                 dynamic=['attribute', 'momentum']);
+        context.current.device.comm.barrier_all();
+
+        snap = data.gsd_snapshot(fname, frame=0);
+        if context.current.device.comm.rank == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            os.remove(fname);
+
+    def tearDown(self):
+        context.initialize();
+
 # unit tests for dump.gsd with default type
 class gsd_default_type (unittest.TestCase):
     def setUp(self):
@@ -0,0 +1,56 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+import hoomd
+from hoomd import md
+hoomd.context.initialize()
+import unittest
+import json
+import os
+import shutil
+import tempfile
+
+class run_profile_tests(unittest.TestCase):
+
+    def setUp(self):
+        hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.5), n=[4,4,4]);
+        nl = md.nlist.cell();
+        lj = md.pair.lj(r_cut=2.5, nlist=nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=hoomd.group.all());
+
+        tmp = ''
+        if hoomd.context.current.device.comm.rank == 0:
+            tmp = tempfile.mkdtemp();
+        self.tmp = hoomd._hoomd.mpi_bcast_str(tmp, hoomd.context.current.device.cpp_exec_conf);
+
+    # test that the profile tree is still printed
+    def test_profile(self):
+        hoomd.run(10, profile=True);
+
+    # test that every rank writes a trace that can be loaded
+    def test_trace(self):
+        fname = os.path.join(self.tmp, 'trace.json');
+        hoomd.run(10, profile=fname);
+
+        if hoomd.context.current.device.comm.num_ranks > 1:
+            fname = os.path.join(self.tmp, 'trace.rank{}.json'.format(hoomd.context.current.device.comm.rank));
+
+        with open(fname) as f:
+            trace = json.load(f);
+
+        events = [e for e in trace['traceEvents'] if e['ph'] == 'X'];
+        self.assertGreater(len(events), 0);
+        for e in events:
+            self.assertGreaterEqual(e['dur'], 0.0);
+            self.assertEqual(e['pid'], hoomd.context.current.device.comm.rank);
+
+    def tearDown(self):
+        hoomd.context.current.device.comm.barrier_all();
+        if hoomd.context.current.device.comm.rank == 0:
+            shutil.rmtree(self.tmp);
+        hoomd.context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
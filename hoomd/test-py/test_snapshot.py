@@ -33,6 +33,29 @@ class init_take_restore_snapshot (unittest.TestCase):
         snapshot = self.s.take_snapshot(bonds=True)
         snapshot = self.s.take_snapshot(integrators=True)
 
+    # test taking a distributed snapshot and re-initializing
+    def test_distributed(self):
+        snapshot = self.s.take_snapshot(all=True, distributed=True)
+        self.assertTrue(snapshot.particles_local)
+        self.assertEqual(len(snapshot.particle_tags), snapshot.particles.N)
+        self.assertEqual(len(snapshot.particle_tags), self.s.sysdef.getParticleData().getN())
+
+        before = self.s.take_snapshot()
+        self.s.restore_snapshot(snapshot)
+        after = self.s.take_snapshot()
+        if context.current.device.comm.rank == 0:
+            self.assertEqual(before.particles.N, after.particles.N)
+            numpy.testing.assert_array_equal(before.particles.position, after.particles.position)
+            numpy.testing.assert_array_equal(before.particles.typeid, after.particles.typeid)
+            numpy.testing.assert_array_equal(before.particles.image, after.particles.image)
+
+    # test that a distributed snapshot with an invalid type is rejected on all ranks
+    def test_distributed_invalid_type(self):
+        snapshot = self.s.take_snapshot(all=True, distributed=True)
+        if snapshot.particles.N > 0:
+            snapshot.particles.typeid[0] = len(snapshot.particles.types)
+        self.assertRaises(RuntimeError, self.s.restore_snapshot, snapshot)
+
     def test_read_snapshot(self):
         snapshot = self.s.take_snapshot(all=True)
         del self.s
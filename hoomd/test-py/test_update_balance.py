@@ -22,6 +22,29 @@ class load_balance_tests (unittest.TestCase):
         if hoomd.context.current.decomposition is not None:
             lb.set_params(x=True, y=True, z=True, tolerance=0.95, maxiter=1)
 
+    ## Test balancing weighted by the measured force compute time
+    def test_weight_time(self):
+        if hoomd.context.current.decomposition is None or hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            return
+
+        lb = hoomd.update.balance(tolerance=0.9, period=5, weight='time', damping=0.8)
+        with self.assertRaises(RuntimeError):
+            lb.set_params(weight='work')
+        with self.assertRaises(RuntimeError):
+            lb.set_params(damping=1.0)
+
+        from hoomd import md
+        nl = md.nlist.cell()
+        # gauss is finite for the overlapping particles in the snapshot
+        gauss = md.pair.gauss(r_cut=2.5, nlist=nl)
+        gauss.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.001)
+        md.integrate.nve(group=hoomd.group.all())
+        hoomd.run(20)
+
+        lb.set_params(weight='particles')
+        hoomd.run(10)
+
     def tearDown(self):
         hoomd.context.initialize()
 
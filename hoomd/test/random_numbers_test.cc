@@ -421,6 +421,51 @@ UP_TEST( poisson_large_float_test )
     check_moments(gen, 4000000, mean, var, skew, exkurtosis, 0.03, false);
     }
 
+//! Check that a batch generator reproduces the streams of single generators
+template<class Real>
+void check_batch()
+    {
+    const unsigned int n_lanes = hoomd::RandomGeneratorBatch::n_lanes;
+    hoomd::RandomGeneratorBatch batch(7, 7);
+    for (unsigned int l = 0; l < n_lanes; ++l)
+        batch.setLane(l, 91+l, 3, l);
+
+    Real sigma[n_lanes];
+    for (unsigned int l = 0; l < n_lanes; ++l)
+        sigma[l] = Real(0.5) + Real(l);
+
+    hoomd::UniformDistribution<Real> uniform(-2, 3);
+    hoomd::NormalDistribution<Real> normal(Real(1.5), Real(0.25));
+    Real u[n_lanes], n1[n_lanes], n2[n_lanes];
+    uniform.generateBatch(u, batch);
+    normal.generateBatch(n1, batch);
+    normal.generateBatch(n2, batch, sigma);
+
+    for (unsigned int l = 0; l < n_lanes; ++l)
+        {
+        hoomd::RandomGenerator rng(7, 7, 91+l, 3, l);
+        UP_ASSERT_EQUAL(uniform(rng), u[l]);
+        UP_ASSERT_EQUAL(normal(rng), n1[l]);
+        UP_ASSERT_EQUAL(hoomd::NormalDistribution<Real>(sigma[l], Real(0.25))(rng), n2[l]);
+
+        // the generator of a lane continues its stream
+        hoomd::RandomGenerator lane_rng = batch.getGenerator(l);
+        UP_ASSERT_EQUAL(hoomd::detail::generate_u64(lane_rng), hoomd::detail::generate_u64(rng));
+        }
+    }
+
+//! Test case for RandomGeneratorBatch -- double
+UP_TEST( batch_double_test )
+    {
+    check_batch<double>();
+    }
+
+//! Test case for RandomGeneratorBatch -- float
+UP_TEST( batch_float_test )
+    {
+    check_batch<float>();
+    }
+
 // //! Find performance crossover
 // /*! Note: this code was written for a one time use to find the empirical crossover. It requires that the private:
 //     be commented out in PoissonDistribution.
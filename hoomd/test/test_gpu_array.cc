@@ -343,6 +343,59 @@ UP_TEST( GPUArray_resize_tests )
        }
    }
 
+//! Tests that host arrays reuse blocks from the host memory pool
+UP_TEST( GPUArray_host_pool_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    HostMemoryPool *pool = exec_conf->getHostMemoryPool();
+    UP_ASSERT(pool != NULL);
+
+    // size classes have at most 25% overhead
+    UP_ASSERT_EQUAL(HostMemoryPool::roundToSizeClass(1), (size_t)64);
+    UP_ASSERT_EQUAL(HostMemoryPool::roundToSizeClass(65), (size_t)80);
+    UP_ASSERT_EQUAL(HostMemoryPool::roundToSizeClass(128), (size_t)128);
+    UP_ASSERT_EQUAL(HostMemoryPool::roundToSizeClass(1000), (size_t)1024);
+    UP_ASSERT_EQUAL(HostMemoryPool::roundToSizeClass(1025), (size_t)1280);
+
+    size_t in_use = pool->getBytesInUse();
+        {
+        GPUArray<unsigned int> a(1000, exec_conf);
+        UP_ASSERT(pool->getBytesInUse() > in_use);
+        }
+    // the block is cached instead of freed
+    UP_ASSERT_EQUAL(pool->getBytesInUse(), in_use);
+    UP_ASSERT(pool->getBytesCached() > 0);
+
+    // an array of the same size class is served from the cache
+    size_t hits = pool->getNumHits();
+    GPUArray<unsigned int> b(1000, exec_conf);
+    UP_ASSERT(pool->getNumHits() > hits);
+
+    // repeated resizes keep the contents and reuse the cached blocks
+        {
+        ArrayHandle<unsigned int> h_b(b, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < 1000; i++)
+            h_b.data[i] = i;
+        }
+    b.resize(2000);
+    b.resize(1000);
+    size_t misses = pool->getNumMisses();
+    for (unsigned int iter = 0; iter < 10; iter++)
+        {
+        b.resize(2000);
+        b.resize(1000);
+        }
+    UP_ASSERT_EQUAL(pool->getNumMisses(), misses);
+        {
+        ArrayHandle<unsigned int> h_b(b, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < 1000; i++)
+            UP_ASSERT_EQUAL(h_b.data[i], i);
+        }
+
+    pool->releaseCache();
+    UP_ASSERT_EQUAL(pool->getBytesCached(), (size_t)0);
+    }
+
 //! Tests GPUVector
 UP_TEST( GPUVector_basic_tests )
     {
@@ -144,6 +144,59 @@ UP_TEST( ParticleGroup_copy_test )
         CHECK_EQUAL_UINT(copy2.getMemberIndex(i), i);
         UP_ASSERT(copy2.isMember(i));
         }
+
+    // destroying the copies leaves the original untouched
+    {
+    ParticleGroup copy3(tags_all);
+    ParticleGroup copy4;
+    copy4 = tags_all;
+    }
+    pdata->notifyParticleSort();
+    CHECK_EQUAL_UINT(tags_all.getNumMembers(), pdata->getN());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        UP_ASSERT(tags_all.isMember(i));
+    }
+
+//! Checks that more than 64 groups can share the membership masks
+UP_TEST( ParticleGroup_many_groups_test )
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // one group per tag, repeated so that the masks need more than one word
+    std::vector< std::shared_ptr<ParticleGroup> > groups;
+    for (unsigned int g = 0; g < 150; g++)
+        {
+        const unsigned int tag = g % pdata->getN();
+        std::shared_ptr<ParticleSelector> selector(new ParticleSelectorTag(sysdef, tag, tag));
+        groups.push_back(std::shared_ptr<ParticleGroup>(new ParticleGroup(sysdef, selector)));
+
+        // groups created before the masks grew must still answer correctly
+        for (unsigned int h = 0; h <= g; h++)
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                UP_ASSERT_EQUAL(groups[h]->isMember(i), i == h % pdata->getN());
+        }
+
+    // reverse the particle order
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        h_tag.data[i] = pdata->getN() - 1 - i;
+        h_rtag.data[i] = pdata->getN() - 1 - i;
+        }
+    }
+    pdata->notifyParticleSort();
+
+    for (unsigned int g = 0; g < groups.size(); g++)
+        {
+        const unsigned int tag = g % pdata->getN();
+        CHECK_EQUAL_UINT(groups[g]->getNumMembers(), 1);
+        CHECK_EQUAL_UINT(groups[g]->getMemberIndex(0), pdata->getN() - 1 - tag);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            UP_ASSERT_EQUAL(groups[g]->isMember(i), i == pdata->getN() - 1 - tag);
+        }
     }
 
 //! Checks that ParticleGroup can successfully handle particle resorts
@@ -15,6 +15,7 @@
 #include <iostream>
 
 #include "hoomd/ParticleData.h"
+#include "hoomd/ParticleDataSoA.h"
 #include "hoomd/Initializers.h"
 #include "hoomd/SnapshotSystemData.h"
 
@@ -617,6 +618,85 @@ UP_TEST( ParticleData_test )
     UP_ASSERT(pdata_type_test.getTypeByName("test") == 1);
     }
 
+//! Tests the structure-of-arrays views of the particle data
+UP_TEST( ParticleData_soa_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    ParticleData pdata(5, box, 2, exec_conf);
+
+    UP_ASSERT(pdata.getHotFieldLayout() == ParticleData::aos);
+    pdata.setHotFieldLayout(ParticleData::soa);
+    UP_ASSERT(pdata.getHotFieldLayout() == ParticleData::soa);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(pdata.getVelocities(), access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            h_pos.data[i] = make_scalar4(Scalar(i), Scalar(0.5*i), -Scalar(i), __int_as_scalar(i % 2));
+            h_vel.data[i] = make_scalar4(Scalar(0.1*i), Scalar(0.2*i), Scalar(0.3*i), Scalar(1.0 + i));
+            }
+        }
+
+    Scalar tol = Scalar(1e-6);
+
+    // read views gather the packed arrays
+        {
+        PositionsSoAHandle pos(pdata, access_mode::read);
+        VelocitiesSoAHandle vel(pdata, access_mode::read);
+        UP_ASSERT_EQUAL(pos.N, 5u);
+        UP_ASSERT_EQUAL(vel.N, 5u);
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            MY_CHECK_CLOSE(pos.x[i], Scalar(i), tol);
+            MY_CHECK_CLOSE(pos.y[i], Scalar(0.5*i), tol);
+            MY_CHECK_CLOSE(pos.z[i], -Scalar(i), tol);
+            UP_ASSERT_EQUAL(pos.type[i], i % 2);
+            MY_CHECK_CLOSE(vel.x[i], Scalar(0.1*i), tol);
+            MY_CHECK_CLOSE(vel.y[i], Scalar(0.2*i), tol);
+            MY_CHECK_CLOSE(vel.z[i], Scalar(0.3*i), tol);
+            MY_CHECK_CLOSE(vel.mass[i], Scalar(1.0 + i), tol);
+            }
+
+        // only one view of each field may be held at a time
+        UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ PositionsSoAHandle pos2(pdata, access_mode::read); });
+
+        // the layout cannot change while a view is held
+        UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ pdata.setHotFieldLayout(ParticleData::aos); });
+        }
+
+    // writable views scatter back on destruction
+        {
+        PositionsSoAHandle pos(pdata, access_mode::readwrite);
+        VelocitiesSoAHandle vel(pdata, access_mode::readwrite);
+        for (unsigned int i = 0; i < pos.N; i++)
+            {
+            pos.x[i] += Scalar(1.0);
+            pos.type[i] = 1;
+            vel.z[i] *= Scalar(2.0);
+            }
+        }
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata.getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            MY_CHECK_CLOSE(h_pos.data[i].x, Scalar(i) + Scalar(1.0), tol);
+            MY_CHECK_CLOSE(h_pos.data[i].y, Scalar(0.5*i), tol);
+            MY_CHECK_CLOSE(h_pos.data[i].z, -Scalar(i), tol);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+            MY_CHECK_CLOSE(h_vel.data[i].x, Scalar(0.1*i), tol);
+            MY_CHECK_CLOSE(h_vel.data[i].z, Scalar(0.6*i), tol);
+            MY_CHECK_CLOSE(h_vel.data[i].w, Scalar(1.0 + i), tol);
+            }
+        }
+
+    pdata.setHotFieldLayout(ParticleData::aos);
+    UP_ASSERT(pdata.getHotFieldLayout() == ParticleData::aos);
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST( Random_test )
     {
@@ -393,6 +393,8 @@ class balance(_updater):
         maxiter (int): Maximum number of iterations to attempt in a single step.
         period (int): Balancing will be attempted every \a period time steps
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        weight (str): Quantity that defines the load of a rank, ``'particles'`` or ``'time'``.
+        damping (float): Weight of the previous cost per particle when *weight* is ``'time'`` (0 <= damping < 1).
 
     Every *period* steps, the boundaries of the processor domains are adjusted to distribute the particle load close
     to evenly between them. The load imbalance is defined as the number of particles owned by a rank divided by the
@@ -417,6 +419,14 @@ class balance(_updater):
     have significantly more pair force neighbors than others, this estimate of the load imbalance may not produce the
     optimal results.
 
+    With ``weight='time'``, each rank measures the wall clock time the integrator spends computing forces (including
+    neighbor list builds) between balancing steps. The load of a rank is its number of particles times its measured
+    cost per particle relative to the average over all ranks, so that ranks with expensive particles (dense regions,
+    rigid bodies, many neighbors) receive smaller domains. The cost is averaged over balancing steps as
+    :math:`c \leftarrow d\, c + (1-d)\, c_\mathrm{measured}` with the *damping* :math:`d` to keep timing noise from
+    moving the domain boundaries back and forth. The first balancing step of a run, when no measurement is available
+    yet, uses the particle counts. Time weighting is only available on the CPU.
+
     A load balancing adjustment is only performed when the maximum load imbalance exceeds a *tolerance*. The ideal load
     balance is 1.0, so setting *tolerance* less than 1.0 will force an adjustment every *period*. The load balancer
     can attempt multiple iterations of balancing every *period*, and up to *maxiter* attempts can be made. The optimal
@@ -435,7 +445,7 @@ class balance(_updater):
 
     Balancing is ignored if there is no domain decomposition available (MPI is not built or is running on a single rank).
     """
-    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0):
+    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0, weight='particles', damping=0.5):
 
         # initialize base class
         _updater.__init__(self);
@@ -454,14 +464,14 @@ class balance(_updater):
         self.setupUpdater(period,phase)
 
         # stash arguments to metadata
-        self.metadata_fields = ['tolerance','maxiter','period','phase']
+        self.metadata_fields = ['tolerance','maxiter','period','phase','weight','damping']
         self.period = period
         self.phase = phase
 
         # configure the parameters
-        self.set_params(x,y,z,tolerance, maxiter)
+        self.set_params(x,y,z,tolerance, maxiter, weight, damping)
 
-    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None):
+    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None, weight=None, damping=None):
         R""" Change load balancing parameters.
 
         Args:
@@ -470,12 +480,15 @@ class balance(_updater):
             z (bool): If True, balance in z dimension.
             tolerance (float): Load imbalance tolerance (if <= 1.0, balance every step).
             maxiter (int): Maximum number of iterations to attempt in a single step.
+            weight (str): Quantity that defines the load of a rank, ``'particles'`` or ``'time'``.
+            damping (float): Weight of the previous cost per particle when *weight* is ``'time'``.
 
 
         Examples::
 
             balance.set_params(x=True, y=False)
             balance.set_params(tolerance=0.02, maxiter=5)
+            balance.set_params(weight='time', damping=0.8)
         """
         self.check_initialization()
 
@@ -491,6 +504,27 @@ class balance(_updater):
         if maxiter is not None:
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
+        if weight is not None:
+            if weight == 'particles':
+                mode = _hoomd.LoadBalancer.weightMode.particles
+            elif weight == 'time':
+                if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+                    hoomd.context.current.device.cpp_msg.error("update.balance: weight='time' is not supported on the GPU\n")
+                    raise RuntimeError("Error setting load balancer parameters")
+                mode = _hoomd.LoadBalancer.weightMode.compute_time
+            else:
+                hoomd.context.current.device.cpp_msg.error("update.balance: unknown weight " + str(weight) + "\n")
+                raise RuntimeError("Error setting load balancer parameters")
+            self.weight = weight
+            self.cpp_updater.setWeightMode(mode)
+        if damping is not None:
+            self.damping = damping
+            self.cpp_updater.setDamping(self.damping)
+
+    def _set_integrator(self, integrator):
+        # the integrator measures the force compute time used by weight='time'
+        if self.cpp_updater is not None and integrator is not None:
+            self.cpp_updater.setIntegrator(integrator.cpp_integrator)
 
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;